@@ -1,16 +1,24 @@
 
 #include "AudioDevice.h"
 #include "rocket/Core/debug.h"
+#include "rocket/Core/profiler.h"
+#include "rocket/Core/metrics.h"
+#include "rocket/Core/timer.h"
 
 namespace Rocket {
 	namespace Audio {
 
-		AudioDevice::AudioDevice( unsigned int numChannels, unsigned int sampleRate ) {
+		static Core::Histogram & AudioDevice_CallbackTime = Core::Metrics::histogram( "audio.callback_ns" );
+		static Core::Counter & AudioDevice_Underruns = Core::Metrics::counter( "audio.underruns" );
+
+		AudioDevice::AudioDevice( unsigned int numChannels, unsigned int sampleRate ) : m_addedSounds( MaxSounds ) {
 			m_dac = new RtAudio();
 			if ( m_dac->getDeviceCount() < 1 ) {
 				Debug_ThrowError( "Error: No audio devices detected.", 0 );
 			}
 			m_streamStarted = false;
+			m_profilerThread = nullptr;
+			m_metricsThread = nullptr;
 			m_numChannels = numChannels;
 			m_sampleRate = sampleRate;
 			m_bufferFrames = 256;
@@ -18,6 +26,8 @@ namespace Rocket {
 			m_outputParameters.deviceId = m_dac->getDefaultOutputDevice();
 			m_outputParameters.nChannels = numChannels;
 			m_outputParameters.firstChannel = 0;
+			m_sounds.reserve( MaxSounds );
+			m_soundCount = 0;
 		}
 		AudioDevice::~AudioDevice() {
 			if ( m_streamStarted == true ) {
@@ -33,6 +43,9 @@ namespace Rocket {
 
 		//! Begins generation of the sound stream
 		void AudioDevice::startStream() {
+			// Without a buffer (when the profiler is off as the stream starts) the callback's zones are dropped
+			m_profilerThread = Core::Profiler::enabled() ? Core::Profiler::reserveThread() : nullptr;
+			m_metricsThread = Core::Metrics::reserveThread();
 			try {
 				m_dac->openStream( &m_outputParameters, NULL, RTAUDIO_FLOAT64,
 								m_sampleRate, &m_bufferFrames, &m_callback, this );
@@ -47,9 +60,12 @@ namespace Rocket {
 			m_streamStarted = false;
 		}
 
-		//! Adds a sound to the list of sounds from which the stream is built from
-		void AudioDevice::addSound( Sound * sound ) {
-			m_sounds.push_back( sound->shared_from_this() );
+		//! Adds a sound to the list of sounds from which the stream is built from, from the next buffer on
+		//! Returns false, leaving the stream as it was, if MaxSounds sounds have already been added
+		bool AudioDevice::addSound( Sound * sound ) {
+			if ( m_soundCount == MaxSounds || !m_addedSounds.push( sound->shared_from_this() ) ) return false;
+			m_soundCount++;
+			return true;
 		}
 
 		//! Callback that fills the sound buffer as needed to produce a continuous stream
@@ -59,12 +75,19 @@ namespace Rocket {
 										double streamTime,
 										RtAudioStreamStatus status,
 										void * data ) {
-			double * buffer = (double*)outputBuffer;
 			AudioDevice * device = (AudioDevice*)data;
+			Core::Profiler::attachThread( device->m_profilerThread );
+			Core::Metrics::attachThread( device->m_metricsThread );
+			Rocket_Profile_Zone( "AudioDevice::callback" );
+			unsigned long long start = Core::timer_ns();
+			if ( status & RTAUDIO_OUTPUT_UNDERFLOW ) AudioDevice_Underruns.add();
+			double * buffer = (double*)outputBuffer;
 
 			memset( buffer, 0, numBufferFrames * device->m_numChannels * sizeof( double ) );
 
-			for ( auto sound : device->m_sounds ) {
+			shared_ptr< Sound > added;
+			while ( device->m_addedSounds.pop( added ) ) device->m_sounds.push_back( std::move( added ) );
+			for ( auto & sound : device->m_sounds ) {
 				sound->addToBuffer( buffer, numBufferFrames );
 			}
 
@@ -78,6 +101,7 @@ namespace Rocket {
 				}
 			}
 
+			AudioDevice_CallbackTime.record( Core::timer_ns() - start );
 			return 0;
 		}
 
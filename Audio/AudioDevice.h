@@ -6,6 +6,9 @@
 #include <memory>
 
 #include "rtaudio/RtAudio.h"
+#include "rocket/Core/queues.h"
+#include "rocket/Core/profiler.h"
+#include "rocket/Core/metrics.h"
 
 #include "Sound.h"
 
@@ -22,7 +25,9 @@ namespace Rocket {
 			void startStream();
 			void stopStream();
 
-			void addSound( Sound * sound );
+			// The stream mixes every sound it is given, up to MaxSounds of them; addSound() returns false once there are that many
+			static const unsigned int MaxSounds = 256;
+			bool addSound( Sound * sound );
 
 		private:
 			RtAudio * m_dac;
@@ -39,7 +44,17 @@ namespace Rocket {
 									RtAudioStreamStatus status,
 									void * data );
 
+			// Profiler buffer of the stream's thread, reserved when the stream starts if the profiler is enabled, so that the
+			// callback never allocates it
+			Core::Profiler_ThreadBuffer * m_profilerThread;
+			// Metrics shard of the stream's thread, reserved when the stream starts for the same reason
+			Core::Metrics_ThreadShard * m_metricsThread;
+
+			// Sounds are handed to the stream's thread, which is the only one to use m_sounds
+			// Both hold MaxSounds, so that sounds can wait in the queue until the stream starts and the callback never allocates
+			Core::SPSCQueue< shared_ptr< Sound > > m_addedSounds;
 			vector< shared_ptr< Sound > > m_sounds;
+			unsigned int m_soundCount;			// sounds added, counted on the adding thread
 		};
 
 	}
@@ -0,0 +1,44 @@
+#include "rocket/Benchmark.h"
+
+#include <string.h>
+#include <vector>
+
+#include "rocket/Core/utility.h"
+#include "Sound.h"
+
+using namespace Rocket::Audio;
+
+static const unsigned int BenchmarkSound_Frames = 256;	// frames of an AudioDevice buffer
+static const unsigned int BenchmarkSound_Channels = 2;
+
+// A repeating stereo sound of one second
+static shared_ptr< Sound > BenchmarkSound_Create() {
+	const unsigned int frames = 44100;
+	shared_ptr< double > data( new double[ frames * BenchmarkSound_Channels ], Rocket::Core::array_deleter< double >() );
+	for ( unsigned int i = 0; i < frames * BenchmarkSound_Channels; i++ ) data.get()[i] = ( i % 200 ) * 0.001 - 0.1;
+	shared_ptr< Sound > sound = make_shared< Sound >( BenchmarkSound_Channels, 44100, frames, data );
+	sound->play( true, true );
+	return sound;
+}
+
+// Mixing into one buffer of the audio callback, counted in frames
+Rocket_Benchmark( Sound_AddToBuffer ) {
+	m_items = BenchmarkSound_Frames;
+	static shared_ptr< Sound > sound = BenchmarkSound_Create();
+	static double buffer[ BenchmarkSound_Frames * BenchmarkSound_Channels ];
+	memset( buffer, 0, sizeof( buffer ) );
+	sound->addToBuffer( buffer, BenchmarkSound_Frames );
+	Rocket::Test::doNotOptimize( buffer );
+}
+
+Rocket_Benchmark( Sound_AddToBuffer_16Sounds ) {
+	m_items = BenchmarkSound_Frames * 16;
+	static std::vector< shared_ptr< Sound > > sounds;
+	if ( sounds.empty() ) {
+		for ( unsigned int i = 0; i < 16; i++ ) sounds.push_back( BenchmarkSound_Create() );
+	}
+	static double buffer[ BenchmarkSound_Frames * BenchmarkSound_Channels ];
+	memset( buffer, 0, sizeof( buffer ) );
+	for ( auto & sound : sounds ) sound->addToBuffer( buffer, BenchmarkSound_Frames );
+	Rocket::Test::doNotOptimize( buffer );
+}
@@ -1,6 +1,6 @@
 
 #include "Sound.h"
-#include "rocket/Core/utility.h"
+#include "rocket/Core/memory.h"
 #include "rocket/Core/debug.h"
 
 namespace Rocket {
@@ -19,7 +19,8 @@ namespace Rocket {
 			m_numChannels = sndinfo.channels;
 			m_sampleRate = sndinfo.samplerate;
 			m_numFrames = sf_seek( sndfile, -1, SEEK_END );
-			m_data = shared_ptr< double >( new double[ m_numFrames * m_numChannels ], array_deleter< double >() );
+			size_t samples = (size_t)m_numFrames * m_numChannels;
+			m_data = shared_ptr< double >( Core::Memory::newArray< double >( Core::MemoryTag::Audio, samples ), Core::tagged_array_deleter< double >( Core::MemoryTag::Audio, samples ) );
 			sf_seek( sndfile, 0, SEEK_SET );
 			int numFramesRead = sf_readf_double( sndfile, m_data.get(), m_numFrames );
 			if ( numFramesRead != m_numFrames ) {
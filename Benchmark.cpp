@@ -0,0 +1,242 @@
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <map>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Benchmark.h"
+
+namespace Rocket {
+	namespace Test {
+
+		// Globals
+		std::vector <Rocket::Test::Benchmark*> * benchmarkList = nullptr;
+
+		// Samples taken of each benchmark, at least
+		const unsigned int Benchmark_MinimumSamples = 10;
+
+		// Times of one benchmark; each sample is the mean time of a batch of iterations, so that the clock's resolution and
+		// overhead are small compared with what is measured. The spread (MAD and p99) is therefore that of batch means, which
+		// is that of single iterations only when the batch is 1.
+		struct Benchmark_Result {
+			std::string name;
+			unsigned long long items;
+			unsigned long long iterations;
+			unsigned long long batch;		// iterations per sample
+			std::vector< double > samples;	// ns per iteration
+			double median;
+			double mad;						// median absolute deviation of the samples from the median
+			double p99;						// of the samples
+			double min;
+			double mean;
+		};
+
+		static double Benchmark_Now() {
+			return (double)std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+		}
+
+		// Median of sorted values
+		static double Benchmark_Median( const std::vector< double > & sorted ) {
+			size_t n = sorted.size();
+			return ( n % 2 == 1 ) ? sorted[ n / 2 ] : ( sorted[ n / 2 - 1 ] + sorted[ n / 2 ] ) * 0.5;
+		}
+
+		static void Benchmark_Statistics( Benchmark_Result & result ) {
+			std::vector< double > sorted( result.samples );
+			std::sort( sorted.begin(), sorted.end() );
+			result.median = Benchmark_Median( sorted );
+			result.min = sorted.front();
+			result.p99 = sorted[ (size_t)ceil( 0.99 * sorted.size() ) - 1 ];
+			double sum = 0.0;
+			for ( double sample : sorted ) sum += sample;
+			result.mean = sum / sorted.size();
+
+			std::vector< double > deviations;
+			for ( double sample : sorted ) deviations.push_back( fabs( sample - result.median ) );
+			std::sort( deviations.begin(), deviations.end() );
+			result.mad = Benchmark_Median( deviations );
+		}
+
+		static Benchmark_Result Benchmark_Measure( Benchmark * benchmark, double minimumTime ) {
+			Benchmark_Result result;
+			result.name = benchmark->name();
+
+			// Warm up caches (and any static data the benchmark initializes on first run) for a tenth of the time, which also
+			// estimates the time of an iteration
+			double start = Benchmark_Now(), now = start;
+			unsigned long long warmup = 0;
+			do {
+				benchmark->run();
+				warmup++;
+				now = Benchmark_Now();
+			} while ( now - start < minimumTime * 0.1 );
+			double estimate = ( now - start ) / warmup;
+
+			// Batches of about a fiftieth of the time
+			result.batch = (unsigned long long)( minimumTime / 50.0 / estimate );
+			if ( result.batch == 0 ) result.batch = 1;
+			result.iterations = 0;
+			start = Benchmark_Now();
+			do {
+				double sampleStart = Benchmark_Now();
+				for ( unsigned long long i = 0; i < result.batch; i++ ) benchmark->run();
+				now = Benchmark_Now();
+				result.samples.push_back( ( now - sampleStart ) / result.batch );
+				result.iterations += result.batch;
+			} while ( now - start < minimumTime || result.samples.size() < Benchmark_MinimumSamples );
+
+			// m_items may be set by run()
+			result.items = benchmark->items();
+			Benchmark_Statistics( result );
+			return result;
+		}
+
+		// Median times by benchmark name, from a file written by Benchmark_WriteJSON
+		static std::map< std::string, double > Benchmark_ReadBaseline( const std::string & file ) {
+			std::map< std::string, double > baseline;
+			std::ifstream in( file.c_str() );
+			if ( !in.is_open() ) {
+				std::cerr << "Couldn't open benchmark baseline " << file << ".\n";
+				return baseline;
+			}
+			std::stringstream buffer;
+			buffer << in.rdbuf();
+			std::string text = buffer.str();
+
+			size_t position = 0;
+			while ( ( position = text.find( "\"name\"", position ) ) != std::string::npos ) {
+				size_t open = text.find( '"', text.find( ':', position ) );
+				size_t close = text.find( '"', open + 1 );
+				size_t next = text.find( "\"name\"", close );
+				size_t median = text.find( "\"median_ns\"", close );
+				if ( open == std::string::npos || close == std::string::npos || median == std::string::npos ) break;
+				if ( median < next ) {
+					baseline[ text.substr( open + 1, close - open - 1 ) ] = atof( text.c_str() + text.find( ':', median ) + 1 );
+				}
+				position = close;
+			}
+			return baseline;
+		}
+
+		static void Benchmark_WriteJSON( const std::string & file, const std::vector< Benchmark_Result > & results ) {
+			std::ofstream out( file.c_str() );
+			if ( !out.is_open() ) {
+				std::cerr << "Couldn't write benchmark results to " << file << ".\n";
+				return;
+			}
+			out.precision( 10 );
+			out << "{\n\t\"benchmarks\": [";
+			for ( size_t i = 0; i < results.size(); i++ ) {
+				const Benchmark_Result & result = results[i];
+				out << ( i > 0 ? "," : "" ) << "\n\t\t{\n";
+				out << "\t\t\t\"name\": \"" << result.name << "\",\n";
+				out << "\t\t\t\"iterations\": " << result.iterations << ",\n";
+				out << "\t\t\t\"samples\": " << result.samples.size() << ",\n";
+				out << "\t\t\t\"iterations_per_sample\": " << result.batch << ",\n";
+				out << "\t\t\t\"median_ns\": " << result.median << ",\n";
+				out << "\t\t\t\"sample_mad_ns\": " << result.mad << ",\n";
+				out << "\t\t\t\"sample_p99_ns\": " << result.p99 << ",\n";
+				out << "\t\t\t\"min_ns\": " << result.min << ",\n";
+				out << "\t\t\t\"mean_ns\": " << result.mean << ",\n";
+				out << "\t\t\t\"items\": " << result.items << "\n";
+				out << "\t\t}";
+			}
+			out << "\n\t]\n}\n";
+		}
+
+		Benchmark::Benchmark( std::string name ) : m_name(name), m_items( 1 ) {
+			Rocket::Test::Benchmarks_registerBenchmark( this );
+		}
+		Benchmark::~Benchmark() {
+		}
+
+		// Add a benchmark to the list of all benchmarks
+		void Benchmarks_registerBenchmark( Rocket::Test::Benchmark * benchmark ) {
+			if (benchmarkList == nullptr) {
+				benchmarkList = new std::vector <Rocket::Test::Benchmark*>();
+			}
+
+			benchmarkList->push_back( benchmark );
+		}
+
+		// Run all registered benchmarks and output the statistics of the time per iteration
+		int Benchmarks_runAll( int argc, char ** argv ) {
+			if (benchmarkList == nullptr) return 0;	// No benchmarks to run
+
+			std::string filter, outFile, baselineFile;
+			double minimumTime = 200.0e6, threshold = 0.1;
+			for ( int i = 1; i < argc; i++ ) {
+				std::string argument = argv[i];
+				std::string value = argument.substr( argument.find( '=' ) + 1 );
+				if ( argument.find( "--benchmark_filter=" ) == 0 ) filter = value;
+				else if ( argument.find( "--benchmark_min_time=" ) == 0 ) minimumTime = atof( value.c_str() ) * 1.0e6;
+				else if ( argument.find( "--benchmark_out=" ) == 0 ) outFile = value;
+				else if ( argument.find( "--benchmark_baseline=" ) == 0 ) baselineFile = value;
+				else if ( argument.find( "--benchmark_threshold=" ) == 0 ) threshold = atof( value.c_str() );
+			}
+			std::map< std::string, double > baseline;
+			if ( !baselineFile.empty() ) baseline = Benchmark_ReadBaseline( baselineFile );
+
+			std::cerr << "Running " << benchmarkList->size() << " benchmarks:\n";
+
+			std::vector< Benchmark_Result > results;
+			int regressions = 0;
+			for (unsigned int i = 0; i < benchmarkList->size(); i++) {
+				Rocket::Test::Benchmark * benchmark = (*benchmarkList)[i];
+				if ( !filter.empty() && benchmark->name().find( filter ) == std::string::npos ) continue;
+
+				Benchmark_Result result = Benchmark_Measure( benchmark, minimumTime );
+				std::cerr << "\t" << result.name << ": " << result.median << " ns/iteration (means of " << result.batch << " iterations: MAD " << result.mad << ", p99 " << result.p99 << ")";
+				if ( result.items > 1 ) {
+					std::cerr << " (" << result.items * 1.0e3 / result.median << " M items/s)";
+				}
+
+				std::map< std::string, double >::iterator previous = baseline.find( result.name );
+				if ( previous != baseline.end() && previous->second > 0.0 ) {
+					double change = result.median / previous->second - 1.0;
+					std::cerr << " [" << ( change >= 0.0 ? "+" : "" ) << change * 100.0 << "% vs baseline";
+					if ( change > threshold ) {
+						std::cerr << ", REGRESSION";
+						regressions++;
+					}
+					std::cerr << "]";
+				}
+				std::cerr << "\n";
+				results.push_back( result );
+			}
+
+			if ( !outFile.empty() ) Benchmark_WriteJSON( outFile, results );
+			if ( !baseline.empty() ) {
+				std::cerr << "Regressions: " << regressions << " of " << results.size() << " benchmarks are more than " << threshold * 100.0 << "% slower than the baseline.\n";
+			}
+
+			Benchmarks_cleanup();
+			return regressions;
+		}
+
+		void Benchmarks_cleanup() {
+			if (benchmarkList == nullptr) return;
+
+			for (unsigned int i = 0; i < benchmarkList->size(); i++) {
+				delete (*benchmarkList)[i];
+			}
+
+			benchmarkList->clear();
+			delete benchmarkList;
+			benchmarkList = nullptr;
+		}
+
+		// Out of line, so that the compiler cannot see that p is not used (for compilers without inline assembly)
+		const volatile void * volatile Benchmark_escaped = nullptr;
+		void Benchmarks_escape( const volatile void * p ) {
+			Benchmark_escaped = p;
+		}
+
+	}
+}
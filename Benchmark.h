@@ -0,0 +1,82 @@
+
+#ifndef Rocket_ZTest_Benchmark_H
+#define Rocket_ZTest_Benchmark_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Rocket {
+	namespace Test {
+
+		class Benchmark {
+		public:
+			Benchmark( std::string name );
+			virtual ~Benchmark();
+			virtual void run() = 0;
+
+			std::string name() { return m_name; }
+			unsigned long long items() { return m_items; }
+
+		protected:
+			std::string m_name;
+			unsigned long long m_items;		// number of items processed by one call to run() (used to report throughput)
+		};
+
+		void Benchmarks_registerBenchmark( Rocket::Test::Benchmark * benchmark );
+		// Run the registered benchmarks, and return how many regressed against the baseline. Command line options:
+		//	--benchmark_filter=<text>			only run benchmarks whose name contains text
+		//	--benchmark_min_time=<ms>			time spent measuring each benchmark (200 by default)
+		//	--benchmark_out=<file>				write the results as JSON
+		//	--benchmark_baseline=<file>			compare the results with JSON written by an earlier run
+		//	--benchmark_threshold=<fraction>	slowdown of the median that counts as a regression (0.1 by default)
+		int Benchmarks_runAll( int argc = 0, char ** argv = nullptr );
+		void Benchmarks_cleanup();
+
+		void Benchmarks_escape( const volatile void * p );
+
+		// Makes the compiler assume that value is read, so that the code computing it is not optimized away
+		template < typename T >
+		inline void doNotOptimize( const T & value ) {
+#if defined( __GNUC__ ) || defined( __clang__ )
+			asm volatile( "" : : "m"( value ) : "memory" );
+#else
+			Benchmarks_escape( &value );
+#endif
+		}
+		// Makes the compiler assume that value is read and changed, so that it is not kept in a register or folded into constants
+		template < typename T >
+		inline void doNotOptimize( T & value ) {
+#if defined( __GNUC__ ) || defined( __clang__ )
+			asm volatile( "" : "+m"( value ) : : "memory" );
+#else
+			Benchmarks_escape( &value );
+#endif
+		}
+
+		// Makes the compiler assume that all memory is read and written, so that pending stores are done before this point
+		inline void clobberMemory() {
+#if defined( __GNUC__ ) || defined( __clang__ )
+			asm volatile( "" : : : "memory" );
+#else
+			Benchmarks_escape( nullptr );
+#endif
+		}
+
+	}
+}
+
+// Benchmark Macro : Begin
+#define Rocket_Benchmark( benchmark_name ) \
+class benchmark_name##Benchmark : public Rocket::Test::Benchmark \
+{ \
+	public: \
+		benchmark_name##Benchmark() : Rocket::Test::Benchmark(#benchmark_name) { } \
+		virtual ~benchmark_name##Benchmark() { } \
+		void run(); \
+}; \
+benchmark_name##Benchmark * benchmark_name##_benchmark = new benchmark_name##Benchmark; \
+void benchmark_name##Benchmark::run()
+// Benchmark Macro : End (brackets '{' and '}' following the call of this macro will be defined as that class's run(), which is timed over many iterations)
+
+#endif
@@ -0,0 +1,79 @@
+#include "rocket/Benchmark.h"
+
+#include <memory>
+#include <vector>
+
+#include "allocators.h"
+
+using namespace Rocket::Core;
+
+static void * volatile BenchmarkAllocators_Sink;
+
+struct BenchmarkAllocators_Glyph {
+	float x, y, width, height;
+};
+
+// 1000 allocations of 48 bytes that are freed together, counted in allocations
+Rocket_Benchmark( Allocate_Heap ) {
+	m_items = 1000;
+	void * blocks[ 1000 ];
+	for ( unsigned int i = 0; i < 1000; i++ ) blocks[i] = ::operator new( 48 );
+	BenchmarkAllocators_Sink = blocks[ 500 ];
+	for ( unsigned int i = 0; i < 1000; i++ ) ::operator delete( blocks[i] );
+}
+
+Rocket_Benchmark( Allocate_Arena ) {
+	m_items = 1000;
+	Arena & arena = scratchArena();
+	ArenaScope scope( arena );
+	for ( unsigned int i = 0; i < 1000; i++ ) BenchmarkAllocators_Sink = arena.allocate( 48 );
+}
+
+Rocket_Benchmark( Allocate_FixedPool ) {
+	m_items = 1000;
+	static FixedPool pool( 48 );
+	void * blocks[ 1000 ];
+	for ( unsigned int i = 0; i < 1000; i++ ) blocks[i] = pool.allocate();
+	BenchmarkAllocators_Sink = blocks[ 500 ];
+	for ( unsigned int i = 0; i < 1000; i++ ) pool.deallocate( blocks[i] );
+}
+
+Rocket_Benchmark( Allocate_SharedPool ) {
+	m_items = 1000;
+	void * blocks[ 1000 ];
+	for ( unsigned int i = 0; i < 1000; i++ ) blocks[i] = SharedPool< 48, 16 >::allocate();
+	BenchmarkAllocators_Sink = blocks[ 500 ];
+	for ( unsigned int i = 0; i < 1000; i++ ) SharedPool< 48, 16 >::deallocate( blocks[i] );
+}
+
+// 1000 shared_ptrs created and released, counted in shared_ptrs
+Rocket_Benchmark( SharedPtr_MakeShared ) {
+	m_items = 1000;
+	std::vector< std::shared_ptr< BenchmarkAllocators_Glyph > > glyphs( 1000 );
+	for ( auto & glyph : glyphs ) glyph = std::make_shared< BenchmarkAllocators_Glyph >();
+	BenchmarkAllocators_Sink = glyphs[ 500 ].get();
+}
+
+Rocket_Benchmark( SharedPtr_AllocateShared_Pool ) {
+	m_items = 1000;
+	std::vector< std::shared_ptr< BenchmarkAllocators_Glyph > > glyphs( 1000 );
+	for ( auto & glyph : glyphs ) glyph = std::allocate_shared< BenchmarkAllocators_Glyph >( PoolAllocator< BenchmarkAllocators_Glyph >() );
+	BenchmarkAllocators_Sink = glyphs[ 500 ].get();
+}
+
+// A temporary vector of 1000 floats, counted in vectors
+Rocket_Benchmark( Vector_Heap ) {
+	m_items = 1;
+	std::vector< float > values;
+	for ( unsigned int i = 0; i < 1000; i++ ) values.push_back( float( i ) );
+	BenchmarkAllocators_Sink = values.data();
+}
+
+Rocket_Benchmark( Vector_ScratchArena ) {
+	m_items = 1;
+	Arena & arena = scratchArena();
+	ArenaScope scope( arena );
+	std::vector< float, ArenaAllocator< float > > values( ( ArenaAllocator< float >( arena ) ) );
+	for ( unsigned int i = 0; i < 1000; i++ ) values.push_back( float( i ) );
+	BenchmarkAllocators_Sink = values.data();
+}
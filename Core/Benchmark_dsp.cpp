@@ -0,0 +1,221 @@
+#include "rocket/Benchmark.h"
+
+#include <math.h>
+#include <vector>
+
+#include "dsp.h"
+
+using namespace Rocket::DigitalSignalProcessing;
+
+// Test signal of size samples (a mix of tones)
+static std::vector< ComplexData > BenchmarkDSP_Signal( unsigned int size ) {
+	std::vector< ComplexData > signal( size );
+	for ( unsigned int n = 0; n < size; n++ ) {
+		signal[n].r = sin( n * 0.05 ) + 0.5 * sin( n * 0.73 );
+		signal[n].i = 0.0;
+	}
+	return signal;
+}
+
+static volatile double BenchmarkDSP_Sink;
+
+// The original interface: a plan and an output array for every transform
+Rocket_Benchmark( FFT_1024_Allocating ) {
+	static std::vector< ComplexData > signal = BenchmarkDSP_Signal( 1024 );
+	m_items = 1024;
+	ComplexData * result = FFT( signal.data(), 1024 );
+	BenchmarkDSP_Sink = result[1].r;
+	delete [] result;
+}
+
+Rocket_Benchmark( FFT_1024_Plan ) {
+	static std::vector< ComplexData > signal = BenchmarkDSP_Signal( 1024 ), output( 1024 );
+	static FFTPlan plan( 1024 );
+	m_items = 1024;
+	plan.execute( signal.data(), output.data() );
+	BenchmarkDSP_Sink = output[1].r;
+}
+
+// Includes restoring the input, since transforming the same buffer over and over would overflow it
+Rocket_Benchmark( FFT_1024_PlanInPlace ) {
+	static std::vector< ComplexData > signal = BenchmarkDSP_Signal( 1024 ), data( 1024 );
+	static FFTPlan plan( 1024 );
+	m_items = 1024;
+	data = signal;
+	plan.execute( data.data() );
+	BenchmarkDSP_Sink = data[1].r;
+}
+
+Rocket_Benchmark( FFT_8192_Plan ) {
+	static std::vector< ComplexData > signal = BenchmarkDSP_Signal( 8192 ), output( 8192 );
+	static FFTPlan plan( 8192 );
+	m_items = 8192;
+	plan.execute( signal.data(), output.data() );
+	BenchmarkDSP_Sink = output[1].r;
+}
+
+// Batches of 256 frames of 1024 points, counted in transforms: one at a time, and batched over 1, 2, 4 and 8 threads
+static const unsigned int BenchmarkDSP_BatchFrames = 256;
+
+static std::vector< ComplexData > & BenchmarkDSP_BatchInput() {
+	static std::vector< ComplexData > input;
+	if ( input.empty() ) {
+		std::vector< ComplexData > frame = BenchmarkDSP_Signal( 1024 );
+		for ( unsigned int f = 0; f < BenchmarkDSP_BatchFrames; f++ ) input.insert( input.end(), frame.begin(), frame.end() );
+	}
+	return input;
+}
+
+static void BenchmarkDSP_Batch( unsigned int threadCount ) {
+	static std::vector< ComplexData > output( BenchmarkDSP_BatchFrames * 1024 );
+	static FFTPlan plan( 1024 );
+	plan.executeBatch( BenchmarkDSP_BatchInput().data(), output.data(), BenchmarkDSP_BatchFrames, threadCount );
+	BenchmarkDSP_Sink = output[1].r;
+}
+
+Rocket_Benchmark( FFT_1024_Batch_Sequential ) {
+	static std::vector< ComplexData > output( BenchmarkDSP_BatchFrames * 1024 );
+	static FFTPlan plan( 1024 );
+	m_items = BenchmarkDSP_BatchFrames;
+	const std::vector< ComplexData > & input = BenchmarkDSP_BatchInput();
+	for ( unsigned int f = 0; f < BenchmarkDSP_BatchFrames; f++ ) plan.execute( &input[ f * 1024 ], &output[ f * 1024 ] );
+	BenchmarkDSP_Sink = output[1].r;
+}
+
+Rocket_Benchmark( FFT_1024_Batch_1Thread ) {
+	m_items = BenchmarkDSP_BatchFrames;
+	BenchmarkDSP_Batch( 1 );
+}
+
+Rocket_Benchmark( FFT_1024_Batch_2Threads ) {
+	m_items = BenchmarkDSP_BatchFrames;
+	BenchmarkDSP_Batch( 2 );
+}
+
+Rocket_Benchmark( FFT_1024_Batch_4Threads ) {
+	m_items = BenchmarkDSP_BatchFrames;
+	BenchmarkDSP_Batch( 4 );
+}
+
+Rocket_Benchmark( FFT_1024_Batch_8Threads ) {
+	m_items = BenchmarkDSP_BatchFrames;
+	BenchmarkDSP_Batch( 8 );
+}
+
+// Real signals: a complex transform with zero imaginary parts, and the half-size real transform
+Rocket_Benchmark( FFT_1024_RealAsComplex ) {
+	static std::vector< ComplexData > signal = BenchmarkDSP_Signal( 1024 ), output( 1024 );
+	static FFTPlan plan( 1024 );
+	m_items = 1024;
+	plan.execute( signal.data(), output.data() );
+	BenchmarkDSP_Sink = output[1].r;
+}
+
+Rocket_Benchmark( FFT_1024_Real ) {
+	static std::vector< ComplexData > signal = BenchmarkDSP_Signal( 1024 ), output( 513 );
+	static std::vector< double > samples( 1024 );
+	static RealFFTPlan plan( 1024 );
+	m_items = 1024;
+	for ( unsigned int n = 0; n < 1024; n++ ) samples[n] = signal[n].r;
+	plan.execute( samples.data(), output.data() );
+	BenchmarkDSP_Sink = output[1].r;
+}
+
+// Spectrogram of a stereo stream: 1024-sample Hann frames every 256 samples, counted in samples
+Rocket_Benchmark( STFT_1024_Hop256 ) {
+	static const unsigned int BlockFrames = 4096;
+	static std::vector< double > stereo( BlockFrames * 2 );
+	static STFT stft( 1024, 256 );
+	static std::vector< double > rows( ( BlockFrames / 256 + 1 ) * stft.binCount() );
+	static bool initialized = false;
+	if ( initialized == false ) {
+		std::vector< ComplexData > signal = BenchmarkDSP_Signal( BlockFrames );
+		for ( unsigned int n = 0; n < BlockFrames; n++ ) stereo[n*2] = stereo[n*2 + 1] = signal[n].r;
+		initialized = true;
+	}
+	m_items = BlockFrames;
+	unsigned int frames = stft.process( stereo.data(), BlockFrames, rows.data(), 2 );
+	BenchmarkDSP_Sink = rows[ ( frames - 1 ) * stft.binCount() + 1 ];
+}
+
+// Filters and resamplers on stereo blocks, counted in frames
+static const unsigned int BenchmarkDSP_FilterFrames = 4096;
+
+static const std::vector< double > & BenchmarkDSP_Stereo() {
+	static std::vector< double > stereo;
+	if ( stereo.empty() ) {
+		std::vector< ComplexData > signal = BenchmarkDSP_Signal( BenchmarkDSP_FilterFrames );
+		stereo.resize( BenchmarkDSP_FilterFrames * 2 );
+		for ( unsigned int n = 0; n < BenchmarkDSP_FilterFrames; n++ ) {
+			stereo[n*2] = signal[n].r;
+			stereo[n*2 + 1] = signal[n].i;
+		}
+	}
+	return stereo;
+}
+
+// The textbook loop over taps for each output, as a baseline
+Rocket_Benchmark( FIR_64Taps_Stereo_Direct ) {
+	static std::vector< ComplexData > taps = BenchmarkDSP_Signal( 64 );
+	static std::vector< double > output( BenchmarkDSP_FilterFrames * 2 );
+	const std::vector< double > & input = BenchmarkDSP_Stereo();
+	m_items = BenchmarkDSP_FilterFrames;
+	for ( unsigned int n = 0; n < BenchmarkDSP_FilterFrames; n++ ) {
+		for ( unsigned int c = 0; c < 2; c++ ) {
+			double sum = 0.0;
+			for ( unsigned int k = 0; k < 64 && k <= n; k++ ) sum += taps[k].r * input[ ( n - k ) * 2 + c ];
+			output[ n * 2 + c ] = sum;
+		}
+	}
+	BenchmarkDSP_Sink = output[1];
+}
+
+Rocket_Benchmark( FIR_64Taps_Stereo ) {
+	static std::vector< double > coefficients;
+	static std::vector< double > output( BenchmarkDSP_FilterFrames * 2 );
+	if ( coefficients.empty() ) {
+		std::vector< ComplexData > taps = BenchmarkDSP_Signal( 64 );
+		for ( unsigned int k = 0; k < 64; k++ ) coefficients.push_back( taps[k].r );
+	}
+	static FIRFilter filter( coefficients.data(), 64, 2 );
+	m_items = BenchmarkDSP_FilterFrames;
+	filter.process( BenchmarkDSP_Stereo().data(), output.data(), BenchmarkDSP_FilterFrames );
+	BenchmarkDSP_Sink = output[1];
+}
+
+Rocket_Benchmark( Biquad_4Sections_Stereo ) {
+	static const BiquadCoefficients sections[] = {
+		BiquadCoefficients::highPass( 48000.0, 40.0 ), BiquadCoefficients::lowShelf( 48000.0, 200.0, 3.0 ),
+		BiquadCoefficients::peaking( 48000.0, 2500.0, 1.5, -4.0 ), BiquadCoefficients::lowPass( 48000.0, 16000.0 )
+	};
+	static BiquadCascade cascade( sections, 4, 2 );
+	static std::vector< double > output( BenchmarkDSP_FilterFrames * 2 );
+	m_items = BenchmarkDSP_FilterFrames;
+	cascade.process( BenchmarkDSP_Stereo().data(), output.data(), BenchmarkDSP_FilterFrames );
+	BenchmarkDSP_Sink = output[1];
+}
+
+// Counted in input frames
+Rocket_Benchmark( Resample_44100_48000_Stereo ) {
+	static Resampler resampler( 44100.0, 48000.0, 2 );
+	static std::vector< double > output( ( BenchmarkDSP_FilterFrames * 48 / 44 + 2 ) * 2 );
+	m_items = BenchmarkDSP_FilterFrames;
+	unsigned int frames = resampler.process( BenchmarkDSP_Stereo().data(), BenchmarkDSP_FilterFrames, output.data() );
+	BenchmarkDSP_Sink = output[ frames - 1 ];
+}
+
+// A one second reverb tail at 48 kHz on stereo blocks of 256 frames, counted in frames
+static const unsigned int BenchmarkDSP_ReverbLength = 48000;
+
+Rocket_Benchmark( Convolve_48000Taps_Stereo_Block256 ) {
+	static std::vector< double > response;
+	if ( response.empty() ) {
+		std::vector< ComplexData > noise = BenchmarkDSP_Signal( BenchmarkDSP_ReverbLength );
+		for ( unsigned int n = 0; n < BenchmarkDSP_ReverbLength; n++ ) response.push_back( noise[n].r * exp( -6.9 * n / BenchmarkDSP_ReverbLength ) );
+	}
+	static Convolver convolver( response.data(), BenchmarkDSP_ReverbLength, 256, 2 );
+	static std::vector< double > output( 256 * 2 );
+	m_items = 256;
+	convolver.process( BenchmarkDSP_Stereo().data(), output.data() );
+	BenchmarkDSP_Sink = output[1];
+}
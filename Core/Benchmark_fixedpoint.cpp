@@ -0,0 +1,141 @@
+#include "rocket/Benchmark.h"
+
+#include <math.h>
+
+#include "fixedpoint.h"
+#include "fixedmath.h"
+
+using namespace Rocket::Core;
+
+static const unsigned int BenchmarkFixed_Count = 4096;
+
+// Multiply-accumulate over an array (the inner loop of most of our simulation code)
+template< class T > static T BenchmarkFixed_MultiplyAdd() {
+	static T values[ BenchmarkFixed_Count ];
+	static bool initialized = false;
+	if ( initialized == false ) {
+		for ( unsigned int i = 0; i < BenchmarkFixed_Count; i++ ) values[i] = T( 1.0f + ( i % 64 ) * 0.015625f );
+		initialized = true;
+	}
+	T sum = T( 0.0f );
+	T scale = T( 0.5f );
+	for ( unsigned int i = 0; i < BenchmarkFixed_Count; i++ ) {
+		sum += values[i] * scale;
+		if ( sum > T( 1000.0f ) ) sum -= T( 1000.0f );
+	}
+	return sum;
+}
+
+static volatile float BenchmarkFixed_Sink;
+
+Rocket_Benchmark( FixedMultiplyAdd_float ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_Sink = BenchmarkFixed_MultiplyAdd< float >();
+}
+
+Rocket_Benchmark( FixedMultiplyAdd_fixed16_16 ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_Sink = BenchmarkFixed_MultiplyAdd< fixed16_16 >().toFloat();
+}
+
+Rocket_Benchmark( FixedMultiplyAdd_fixed32_32 ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_Sink = BenchmarkFixed_MultiplyAdd< fixed32_32 >().toFloat();
+}
+
+Rocket_Benchmark( FixedMultiplyAdd_fixedpoint ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_Sink = BenchmarkFixed_MultiplyAdd< fixedpoint >().toValue();
+}
+
+
+// Transcendental functions: libc float, scalar fixed-point and batch (SIMD) fixed-point
+static fixed16_16 BenchmarkFixed_Inputs[ BenchmarkFixed_Count ];
+static fixed16_16 BenchmarkFixed_ReversedInputs[ BenchmarkFixed_Count ];		// the x of atan2( y, x )
+static fixed16_16 BenchmarkFixed_Outputs[ BenchmarkFixed_Count ];
+static float BenchmarkFixed_FloatInputs[ BenchmarkFixed_Count ];
+static float BenchmarkFixed_FloatOutputs[ BenchmarkFixed_Count ];
+
+// Fills the inputs on the first call only, so that the conversions are not timed
+static void BenchmarkFixed_InitializeInputs() {
+	static bool initialized = false;
+	if ( initialized ) return;
+	for ( unsigned int i = 0; i < BenchmarkFixed_Count; i++ ) {
+		BenchmarkFixed_Inputs[i] = fixed16_16( 0.01 + i * 0.0078125 );
+		BenchmarkFixed_FloatInputs[i] = BenchmarkFixed_Inputs[i].toFloat();
+	}
+	for ( unsigned int i = 0; i < BenchmarkFixed_Count; i++ ) BenchmarkFixed_ReversedInputs[i] = BenchmarkFixed_Inputs[ BenchmarkFixed_Count - 1 - i ];
+	initialized = true;
+}
+
+Rocket_Benchmark( FixedSqrt_float ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_InitializeInputs();
+	for ( unsigned int i = 0; i < BenchmarkFixed_Count; i++ ) BenchmarkFixed_FloatOutputs[i] = sqrtf( BenchmarkFixed_FloatInputs[i] );
+	BenchmarkFixed_Sink = BenchmarkFixed_FloatOutputs[ BenchmarkFixed_Count / 2 ];
+}
+
+Rocket_Benchmark( FixedSqrt_scalar ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_InitializeInputs();
+	for ( unsigned int i = 0; i < BenchmarkFixed_Count; i++ ) BenchmarkFixed_Outputs[i] = FixedMath::sqrt( BenchmarkFixed_Inputs[i] );
+	BenchmarkFixed_Sink = BenchmarkFixed_Outputs[ BenchmarkFixed_Count / 2 ].toFloat();
+}
+
+Rocket_Benchmark( FixedSqrt_batch ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_InitializeInputs();
+	FixedMath::sqrt( BenchmarkFixed_Inputs, BenchmarkFixed_Outputs, BenchmarkFixed_Count );
+	BenchmarkFixed_Sink = BenchmarkFixed_Outputs[ BenchmarkFixed_Count / 2 ].toFloat();
+}
+
+Rocket_Benchmark( FixedSin_float ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_InitializeInputs();
+	for ( unsigned int i = 0; i < BenchmarkFixed_Count; i++ ) BenchmarkFixed_FloatOutputs[i] = sinf( BenchmarkFixed_FloatInputs[i] );
+	BenchmarkFixed_Sink = BenchmarkFixed_FloatOutputs[ BenchmarkFixed_Count / 2 ];
+}
+
+Rocket_Benchmark( FixedSin_scalar ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_InitializeInputs();
+	for ( unsigned int i = 0; i < BenchmarkFixed_Count; i++ ) BenchmarkFixed_Outputs[i] = FixedMath::sin( BenchmarkFixed_Inputs[i] );
+	BenchmarkFixed_Sink = BenchmarkFixed_Outputs[ BenchmarkFixed_Count / 2 ].toFloat();
+}
+
+Rocket_Benchmark( FixedSin_batch ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_InitializeInputs();
+	FixedMath::sin( BenchmarkFixed_Inputs, BenchmarkFixed_Outputs, BenchmarkFixed_Count );
+	BenchmarkFixed_Sink = BenchmarkFixed_Outputs[ BenchmarkFixed_Count / 2 ].toFloat();
+}
+
+Rocket_Benchmark( FixedAtan2_scalar ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_InitializeInputs();
+	for ( unsigned int i = 0; i < BenchmarkFixed_Count; i++ ) {
+		BenchmarkFixed_Outputs[i] = FixedMath::atan2( BenchmarkFixed_Inputs[i], BenchmarkFixed_ReversedInputs[i] );
+	}
+	BenchmarkFixed_Sink = BenchmarkFixed_Outputs[ BenchmarkFixed_Count / 2 ].toFloat();
+}
+
+Rocket_Benchmark( FixedAtan2_batch ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_InitializeInputs();
+	FixedMath::atan2( BenchmarkFixed_Inputs, BenchmarkFixed_ReversedInputs, BenchmarkFixed_Outputs, BenchmarkFixed_Count );
+	BenchmarkFixed_Sink = BenchmarkFixed_Outputs[ BenchmarkFixed_Count / 2 ].toFloat();
+}
+
+Rocket_Benchmark( FixedExp_scalar ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_InitializeInputs();
+	FixedMath::exp( BenchmarkFixed_Inputs, BenchmarkFixed_Outputs, BenchmarkFixed_Count );
+	BenchmarkFixed_Sink = BenchmarkFixed_Outputs[ BenchmarkFixed_Count / 2 ].toFloat();
+}
+
+Rocket_Benchmark( FixedLog_scalar ) {
+	m_items = BenchmarkFixed_Count;
+	BenchmarkFixed_InitializeInputs();
+	FixedMath::log( BenchmarkFixed_Inputs, BenchmarkFixed_Outputs, BenchmarkFixed_Count );
+	BenchmarkFixed_Sink = BenchmarkFixed_Outputs[ BenchmarkFixed_Count / 2 ].toFloat();
+}
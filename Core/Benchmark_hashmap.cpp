@@ -0,0 +1,211 @@
+#include "rocket/Benchmark.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hashmap.h"
+#include "rstring.h"
+
+using namespace Rocket::Core;
+
+static const int BenchmarkHashMap_Count = 4096;
+
+// Keys in a table of BenchmarkHashMap_Count elements (hits), and keys that are not (misses), in a scrambled order
+static const std::vector< int > & BenchmarkHashMap_Keys( bool hits ) {
+	static std::vector< int > keys[2];
+	std::vector< int > & result = keys[ hits ? 1 : 0 ];
+	if ( result.empty() ) {
+		for ( int i = 0; i < BenchmarkHashMap_Count; i++ ) result.push_back( ( ( i * 2654435761u ) % BenchmarkHashMap_Count ) + ( hits ? 0 : BenchmarkHashMap_Count ) );
+	}
+	return result;
+}
+
+template < typename Table >
+static Table & BenchmarkHashMap_IntTable() {
+	static Table table;
+	if ( table.empty() ) {
+		for ( int i = 0; i < BenchmarkHashMap_Count; i++ ) table[ i ] = i;
+	}
+	return table;
+}
+
+template < typename Table >
+static void BenchmarkHashMap_Find( bool hits ) {
+	Table & table = BenchmarkHashMap_IntTable< Table >();
+	int sum = 0;
+	for ( int key : BenchmarkHashMap_Keys( hits ) ) {
+		auto found = table.find( key );
+		if ( found != table.end() ) sum += found->second;
+	}
+	Rocket::Test::doNotOptimize( sum );
+}
+
+// Lookups of int keys (such as Input's key states), counted in lookups
+Rocket_Benchmark( HashMap_Int_Find_Std ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_Find< std::unordered_map< int, int > >( true );
+}
+
+Rocket_Benchmark( HashMap_Int_Find_Flat ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_Find< FlatHashMap< int, int > >( true );
+}
+
+Rocket_Benchmark( HashMap_Int_Find_Node ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_Find< NodeHashMap< int, int > >( true );
+}
+
+Rocket_Benchmark( HashMap_Int_Miss_Std ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_Find< std::unordered_map< int, int > >( false );
+}
+
+Rocket_Benchmark( HashMap_Int_Miss_Flat ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_Find< FlatHashMap< int, int > >( false );
+}
+
+// Lookups of the key codes of a keyboard in a table of their states, as Input::getKey() does, counted in lookups
+static const int BenchmarkHashMap_KeyCodes = 120;
+
+template < typename Table >
+static void BenchmarkHashMap_Keyboard() {
+	static Table table;
+	if ( table.empty() ) {
+		for ( int i = 0; i < BenchmarkHashMap_KeyCodes; i++ ) table[ 32 + i * 3 ] = i;
+	}
+	int sum = 0;
+	for ( int i = 0; i < BenchmarkHashMap_KeyCodes * 2; i++ ) {
+		auto found = table.find( 32 + ( i * 7 ) % ( BenchmarkHashMap_KeyCodes * 2 ) * 3 / 2 );
+		if ( found != table.end() ) sum += found->second;
+	}
+	Rocket::Test::doNotOptimize( sum );
+}
+
+Rocket_Benchmark( HashMap_Keyboard_Find_Std ) {
+	m_items = BenchmarkHashMap_KeyCodes * 2;
+	BenchmarkHashMap_Keyboard< std::unordered_map< int, int > >();
+}
+
+Rocket_Benchmark( HashMap_Keyboard_Find_Flat ) {
+	m_items = BenchmarkHashMap_KeyCodes * 2;
+	BenchmarkHashMap_Keyboard< FlatHashMap< int, int > >();
+}
+
+// Lookups by pointer (as of Scenes and sockets), of objects allocated over time, counted in lookups
+template < typename Table >
+static void BenchmarkHashMap_Pointers() {
+	static std::vector< int * > objects;
+	static Table table;
+	if ( objects.empty() ) {
+		for ( int i = 0; i < BenchmarkHashMap_Count; i++ ) objects.push_back( new int( i ) );
+		for ( int i = 0; i < BenchmarkHashMap_Count; i++ ) table[ objects[i] ] = i;
+	}
+	int sum = 0;
+	for ( int key : BenchmarkHashMap_Keys( true ) ) {
+		auto found = table.find( objects[ key ] );
+		if ( found != table.end() ) sum += found->second;
+	}
+	Rocket::Test::doNotOptimize( sum );
+}
+
+Rocket_Benchmark( HashMap_Pointer_Find_Std ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_Pointers< std::unordered_map< int *, int > >();
+}
+
+Rocket_Benchmark( HashMap_Pointer_Find_Flat ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_Pointers< FlatHashMap< int *, int > >();
+}
+
+// Building a table and erasing every element, counted in elements
+template < typename Table >
+static void BenchmarkHashMap_InsertErase() {
+	Table table;
+	for ( int i = 0; i < BenchmarkHashMap_Count; i++ ) table[ i ] = i;
+	for ( int key : BenchmarkHashMap_Keys( true ) ) table.erase( key );
+	Rocket::Test::doNotOptimize( table );
+}
+
+Rocket_Benchmark( HashMap_InsertErase_Std ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_InsertErase< std::unordered_map< int, int > >();
+}
+
+Rocket_Benchmark( HashMap_InsertErase_Flat ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_InsertErase< FlatHashMap< int, int > >();
+}
+
+Rocket_Benchmark( HashMap_InsertErase_Node ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_InsertErase< NodeHashMap< int, int > >();
+}
+
+// Iteration over all elements, counted in elements
+template < typename Table >
+static void BenchmarkHashMap_Iterate() {
+	int sum = 0;
+	for ( auto & element : BenchmarkHashMap_IntTable< Table >() ) sum += element.second;
+	Rocket::Test::doNotOptimize( sum );
+}
+
+Rocket_Benchmark( HashMap_Iterate_Std ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_Iterate< std::unordered_map< int, int > >();
+}
+
+Rocket_Benchmark( HashMap_Iterate_Flat ) {
+	m_items = BenchmarkHashMap_Count;
+	BenchmarkHashMap_Iterate< FlatHashMap< int, int > >();
+}
+
+// Lookups of "IP:port" strings, as for Network's UDP connections, from an address built in a StringBuilder
+// The std table needs a std::string to search with; the flat table searches with the builder's characters.
+static const int BenchmarkHashMap_Addresses = 64;
+
+static void BenchmarkHashMap_Address( StringBuilder & builder, int i ) {
+	builder.clear();
+	builder << "192.168.0." << i % 256 << ":" << 9000 + i;
+}
+
+Rocket_Benchmark( HashMap_String_Find_Std ) {
+	m_items = BenchmarkHashMap_Addresses;
+	static std::unordered_map< std::string, int > table;
+	StringBuilder builder;
+	if ( table.empty() ) {
+		for ( int i = 0; i < BenchmarkHashMap_Addresses; i++ ) {
+			BenchmarkHashMap_Address( builder, i );
+			table[ std::string( builder.c_str(), builder.length() ) ] = i;
+		}
+	}
+	int sum = 0;
+	for ( int i = 0; i < BenchmarkHashMap_Addresses; i++ ) {
+		BenchmarkHashMap_Address( builder, i );
+		auto found = table.find( std::string( builder.c_str(), builder.length() ) );
+		if ( found != table.end() ) sum += found->second;
+	}
+	Rocket::Test::doNotOptimize( sum );
+}
+
+Rocket_Benchmark( HashMap_String_Find_Flat ) {
+	m_items = BenchmarkHashMap_Addresses;
+	static FlatHashMap< std::string, int, StringHash, StringEqual > table;
+	StringBuilder builder;
+	if ( table.empty() ) {
+		for ( int i = 0; i < BenchmarkHashMap_Addresses; i++ ) {
+			BenchmarkHashMap_Address( builder, i );
+			table[ std::string( builder.c_str(), builder.length() ) ] = i;
+		}
+	}
+	int sum = 0;
+	for ( int i = 0; i < BenchmarkHashMap_Addresses; i++ ) {
+		BenchmarkHashMap_Address( builder, i );
+		auto found = table.find( builder );
+		if ( found != table.end() ) sum += found->second;
+	}
+	Rocket::Test::doNotOptimize( sum );
+}
@@ -0,0 +1,103 @@
+#include "rocket/Benchmark.h"
+
+#include <math.h>
+#include <memory>
+#include <vector>
+
+#include "jobs.h"
+
+using namespace Rocket::Core;
+
+static const unsigned int BenchmarkJobs_Count = 1 << 18;
+
+static volatile double BenchmarkJobs_Sink;
+
+// A JobSystem with workerCount workers (~0u for the default), replacing the previous one so that only one runs at a time
+static JobSystem & BenchmarkJobs_System( unsigned int workerCount ) {
+	static std::unique_ptr< JobSystem > system;
+	if ( workerCount == ~0u ) workerCount = JobSystem::defaultWorkerCount();
+	if ( system == nullptr || system->workerCount() != workerCount ) {
+		system.reset();
+		system.reset( new JobSystem( workerCount ) );
+	}
+	return *system;
+}
+
+// Input of the scaling benchmarks, and a kernel of about 30 ns per element
+static const std::vector< double > & BenchmarkJobs_Input() {
+	static std::vector< double > input;
+	if ( input.empty() ) {
+		for ( unsigned int i = 0; i < BenchmarkJobs_Count; i++ ) input.push_back( i * 0.001 );
+	}
+	return input;
+}
+
+static double BenchmarkJobs_Kernel( double x ) {
+	return sin( x ) * cos( x * 0.5 ) + sqrt( x + 1.0 );
+}
+
+static void BenchmarkJobs_ParallelFor( unsigned int workerCount ) {
+	JobSystem & jobs = BenchmarkJobs_System( workerCount );
+	const std::vector< double > & input = BenchmarkJobs_Input();
+	static std::vector< double > output( BenchmarkJobs_Count );
+	jobs.parallel_for( 0, BenchmarkJobs_Count, [ &input ] ( unsigned int first, unsigned int last ) {
+		for ( unsigned int i = first; i < last; i++ ) output[i] = BenchmarkJobs_Kernel( input[i] );
+	} );
+	BenchmarkJobs_Sink = output[ BenchmarkJobs_Count / 2 ];
+}
+
+// The same kernel over 2^18 elements on one thread and with parallel_for on 1 to all hardware threads, counted in elements
+Rocket_Benchmark( Kernel_SingleThread ) {
+	m_items = BenchmarkJobs_Count;
+	const std::vector< double > & input = BenchmarkJobs_Input();
+	static std::vector< double > output( BenchmarkJobs_Count );
+	for ( unsigned int i = 0; i < BenchmarkJobs_Count; i++ ) output[i] = BenchmarkJobs_Kernel( input[i] );
+	BenchmarkJobs_Sink = output[ BenchmarkJobs_Count / 2 ];
+}
+
+Rocket_Benchmark( ParallelFor_1Thread ) {
+	m_items = BenchmarkJobs_Count;
+	BenchmarkJobs_ParallelFor( 0 );
+}
+
+Rocket_Benchmark( ParallelFor_2Threads ) {
+	m_items = BenchmarkJobs_Count;
+	BenchmarkJobs_ParallelFor( 1 );
+}
+
+Rocket_Benchmark( ParallelFor_4Threads ) {
+	m_items = BenchmarkJobs_Count;
+	BenchmarkJobs_ParallelFor( 3 );
+}
+
+Rocket_Benchmark( ParallelFor_AllThreads ) {
+	m_items = BenchmarkJobs_Count;
+	BenchmarkJobs_ParallelFor( ~0u );
+}
+
+// Overhead of one job: queued and waited for by the same thread, counted in jobs
+Rocket_Benchmark( Jobs_RunWait ) {
+	JobSystem & jobs = BenchmarkJobs_System( ~0u );
+	m_items = 1000;
+	unsigned int count = 0;
+	for ( unsigned int i = 0; i < 1000; i++ ) jobs.wait( jobs.run( [ &count ] () { count++; } ) );
+	BenchmarkJobs_Sink = count;
+}
+
+// Overhead of splitting: parallel_for of 1000 empty single-index ranges, counted in ranges
+Rocket_Benchmark( ParallelFor_EmptyRanges ) {
+	JobSystem & jobs = BenchmarkJobs_System( ~0u );
+	m_items = 1000;
+	jobs.parallel_for( 0, 1000, [] ( unsigned int, unsigned int ) {}, 1 );
+}
+
+// A chain of 100 dependent jobs, counted in jobs
+Rocket_Benchmark( Jobs_DependencyChain ) {
+	JobSystem & jobs = BenchmarkJobs_System( ~0u );
+	m_items = 100;
+	unsigned int count = 0;
+	JobHandle previous;
+	for ( unsigned int i = 0; i < 100; i++ ) previous = jobs.run( [ &count ] () { count++; }, previous );
+	jobs.wait( previous );
+	BenchmarkJobs_Sink = count;
+}
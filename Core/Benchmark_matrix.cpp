@@ -0,0 +1,92 @@
+#include "rocket/Benchmark.h"
+
+#include "matrix.h"
+#include "fixedvector.h"
+
+using namespace Rocket::Core;
+
+static const unsigned int BenchmarkMatrix_VertexCount = 4096;
+
+static mat4 BenchmarkMatrix_Transform = Translate( vec3( 1.0f, 2.0f, 3.0f ) ) * Rotate( 0.5f, vec3( 0.0f, 1.0f, 0.0f ) ) * Scale( vec3( 2.0f, 2.0f, 2.0f ) );
+
+static vec4 * BenchmarkMatrix_Vertices() {
+	static vec4 * vertices = nullptr;
+	if ( vertices == nullptr ) {
+		vertices = new vec4[ BenchmarkMatrix_VertexCount ];
+		for ( unsigned int i = 0; i < BenchmarkMatrix_VertexCount; i++ ) {
+			vertices[i] = vec4( i * 0.25f, i * -0.5f, i * 0.125f, 1.0f );
+		}
+	}
+	return vertices;
+}
+static vec4 BenchmarkMatrix_Output[ BenchmarkMatrix_VertexCount ];
+
+// Baseline: one Eigen temporary per vertex
+Rocket_Benchmark( MatrixTransform_PerVertex ) {
+	m_items = BenchmarkMatrix_VertexCount;
+	vec4 * in = BenchmarkMatrix_Vertices();
+	for ( unsigned int i = 0; i < BenchmarkMatrix_VertexCount; i++ ) {
+		BenchmarkMatrix_Output[i] = BenchmarkMatrix_Transform * in[i];
+	}
+}
+
+Rocket_Benchmark( MatrixTransform_Batch ) {
+	m_items = BenchmarkMatrix_VertexCount;
+	transform( BenchmarkMatrix_Transform, BenchmarkMatrix_Vertices(), BenchmarkMatrix_Output, BenchmarkMatrix_VertexCount );
+}
+
+Rocket_Benchmark( MatrixTransform_BatchAffine ) {
+	m_items = BenchmarkMatrix_VertexCount;
+	transformAffine( BenchmarkMatrix_Transform, BenchmarkMatrix_Vertices(), BenchmarkMatrix_Output, BenchmarkMatrix_VertexCount );
+}
+
+Rocket_Benchmark( MatrixTransform_BatchSoA ) {
+	static vec4_batch in( BenchmarkMatrix_Vertices(), BenchmarkMatrix_VertexCount );
+	static vec4_batch out;
+	m_items = BenchmarkMatrix_VertexCount;
+	transform( BenchmarkMatrix_Transform, in, out );
+}
+
+Rocket_Benchmark( MatrixTransform_BatchAffineSoA ) {
+	static vec3_batch in( BenchmarkMatrix_Vertices(), BenchmarkMatrix_VertexCount );
+	static vec3_batch out;
+	m_items = BenchmarkMatrix_VertexCount;
+	transformAffine( BenchmarkMatrix_Transform, in, out );
+}
+
+// Fixed-point (deterministic) transforms
+static fmat4 BenchmarkMatrix_FixedTransform( BenchmarkMatrix_Transform );
+
+static fvec4 * BenchmarkMatrix_FixedVertices() {
+	static fvec4 * vertices = nullptr;
+	if ( vertices == nullptr ) {
+		vertices = new fvec4[ BenchmarkMatrix_VertexCount ];
+		for ( unsigned int i = 0; i < BenchmarkMatrix_VertexCount; i++ ) vertices[i] = fvec4( vec4( BenchmarkMatrix_Vertices()[i] * 0.01f ) );
+	}
+	return vertices;
+}
+static fvec4 BenchmarkMatrix_FixedOutput[ BenchmarkMatrix_VertexCount ];
+
+// Baseline: scalar sums of products
+Rocket_Benchmark( MatrixTransform_FixedScalar ) {
+	m_items = BenchmarkMatrix_VertexCount;
+	fvec4 * in = BenchmarkMatrix_FixedVertices();
+	for ( unsigned int i = 0; i < BenchmarkMatrix_VertexCount; i++ ) {
+		for ( unsigned int r = 0; r < 4; r++ ) {
+			BenchmarkMatrix_FixedOutput[i][r] = FixedLinear::dot( BenchmarkMatrix_FixedTransform.m_matrix[r], in[i].m_elements, 4 );
+		}
+	}
+}
+
+Rocket_Benchmark( MatrixTransform_FixedPerVertex ) {
+	m_items = BenchmarkMatrix_VertexCount;
+	fvec4 * in = BenchmarkMatrix_FixedVertices();
+	for ( unsigned int i = 0; i < BenchmarkMatrix_VertexCount; i++ ) {
+		BenchmarkMatrix_FixedOutput[i] = BenchmarkMatrix_FixedTransform * in[i];
+	}
+}
+
+Rocket_Benchmark( MatrixTransform_FixedBatch ) {
+	m_items = BenchmarkMatrix_VertexCount;
+	transform( BenchmarkMatrix_FixedTransform, BenchmarkMatrix_FixedVertices(), BenchmarkMatrix_FixedOutput, BenchmarkMatrix_VertexCount );
+}
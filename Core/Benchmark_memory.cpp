@@ -0,0 +1,35 @@
+#include "rocket/Benchmark.h"
+
+#include "memory.h"
+
+using namespace Rocket::Core;
+
+static const int BenchmarkMemory_Count = 1000;
+
+// The cost of accounting: recording an allocation and its free, counted in pairs
+Rocket_Benchmark( Memory_Record ) {
+	m_items = BenchmarkMemory_Count;
+	for ( int i = 0; i < BenchmarkMemory_Count; i++ ) {
+		Memory::recordAllocation( MemoryTag::Scene, 64 );
+		Memory::recordFree( MemoryTag::Scene, 64 );
+	}
+}
+
+// Buffers of a packet's size from new [], untagged and tagged, counted in buffers
+Rocket_Benchmark( Memory_NewArray_Untagged ) {
+	m_items = BenchmarkMemory_Count;
+	for ( int i = 0; i < BenchmarkMemory_Count; i++ ) {
+		char * buffer = new char[ 1024 ];
+		Rocket::Test::doNotOptimize( buffer );
+		delete [] buffer;
+	}
+}
+
+Rocket_Benchmark( Memory_NewArray_Tagged ) {
+	m_items = BenchmarkMemory_Count;
+	for ( int i = 0; i < BenchmarkMemory_Count; i++ ) {
+		char * buffer = Memory::newArray< char >( MemoryTag::Network, 1024 );
+		Rocket::Test::doNotOptimize( buffer );
+		Memory::deleteArray( MemoryTag::Network, buffer, 1024 );
+	}
+}
@@ -0,0 +1,139 @@
+#include "rocket/Benchmark.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "queues.h"
+
+using namespace Rocket::Core;
+
+static const unsigned int BenchmarkQueues_Count = 100000;
+
+static volatile unsigned long long BenchmarkQueues_Sink;
+
+// A std::deque behind a mutex, as the baseline
+class BenchmarkQueues_Locked {
+public:
+	explicit BenchmarkQueues_Locked( unsigned int capacity ) : m_capacity( capacity ) {}
+	bool push( unsigned int value ) {
+		std::lock_guard< std::mutex > lock( m_mutex );
+		if ( m_items.size() >= m_capacity ) return false;
+		m_items.push_back( value );
+		return true;
+	}
+	bool pop( unsigned int & value ) {
+		std::lock_guard< std::mutex > lock( m_mutex );
+		if ( m_items.empty() ) return false;
+		value = m_items.front();
+		m_items.pop_front();
+		return true;
+	}
+private:
+	std::mutex m_mutex;
+	std::deque< unsigned int > m_items;
+	unsigned int m_capacity;
+};
+
+// BenchmarkQueues_Count items through queue from producers to consumers threads, waiting by yielding when it is full or empty
+template < typename Queue >
+static void BenchmarkQueues_Threads( Queue & queue, unsigned int producers, unsigned int consumers ) {
+	std::vector< std::thread > threads;
+	unsigned int perProducer = BenchmarkQueues_Count / producers;
+	std::atomic< unsigned int > remaining( perProducer * producers );
+	std::atomic< unsigned long long > sum( 0 );
+	for ( unsigned int p = 0; p < producers; p++ ) {
+		threads.push_back( std::thread( [ &queue, perProducer ] () {
+			for ( unsigned int i = 0; i < perProducer; i++ ) {
+				while ( !queue.push( i ) ) std::this_thread::yield();
+			}
+		} ) );
+	}
+	for ( unsigned int c = 0; c < consumers; c++ ) {
+		threads.push_back( std::thread( [ &queue, &remaining, &sum ] () {
+			unsigned long long partial = 0;
+			unsigned int value;
+			while ( remaining.load( std::memory_order_relaxed ) > 0 ) {
+				if ( queue.pop( value ) ) {
+					partial += value;
+					remaining.fetch_sub( 1, std::memory_order_relaxed );
+				} else {
+					std::this_thread::yield();
+				}
+			}
+			sum += partial;
+		} ) );
+	}
+	for ( auto & thread : threads ) thread.join();
+	BenchmarkQueues_Sink = sum.load();
+}
+
+// Push and pop on one thread, counted in items
+Rocket_Benchmark( Queue_Locked_SameThread ) {
+	m_items = 1000;
+	static BenchmarkQueues_Locked queue( 1024 );
+	unsigned int value = 0;
+	for ( unsigned int i = 0; i < 1000; i++ ) queue.push( i );
+	for ( unsigned int i = 0; i < 1000; i++ ) queue.pop( value );
+	BenchmarkQueues_Sink = value;
+}
+
+Rocket_Benchmark( Queue_SPSC_SameThread ) {
+	m_items = 1000;
+	static SPSCQueue< unsigned int > queue( 1024 );
+	unsigned int value = 0;
+	for ( unsigned int i = 0; i < 1000; i++ ) queue.push( i );
+	for ( unsigned int i = 0; i < 1000; i++ ) queue.pop( value );
+	BenchmarkQueues_Sink = value;
+}
+
+Rocket_Benchmark( Queue_SPSC_Batch16_SameThread ) {
+	m_items = 1024;
+	static SPSCQueue< unsigned int > queue( 1024 );
+	unsigned int items[ 16 ] = {};
+	for ( unsigned int i = 0; i < 64; i++ ) queue.push( items, 16 );
+	for ( unsigned int i = 0; i < 64; i++ ) queue.pop( items, 16 );
+	BenchmarkQueues_Sink = items[0];
+}
+
+Rocket_Benchmark( Queue_MPMC_SameThread ) {
+	m_items = 1000;
+	static MPMCQueue< unsigned int > queue( 1024 );
+	unsigned int value = 0;
+	for ( unsigned int i = 0; i < 1000; i++ ) queue.push( i );
+	for ( unsigned int i = 0; i < 1000; i++ ) queue.pop( value );
+	BenchmarkQueues_Sink = value;
+}
+
+// Throughput between threads, counted in items
+Rocket_Benchmark( Queue_Locked_1to1 ) {
+	m_items = BenchmarkQueues_Count;
+	BenchmarkQueues_Locked queue( 1024 );
+	BenchmarkQueues_Threads( queue, 1, 1 );
+}
+
+Rocket_Benchmark( Queue_SPSC_1to1 ) {
+	m_items = BenchmarkQueues_Count;
+	SPSCQueue< unsigned int > queue( 1024 );
+	BenchmarkQueues_Threads( queue, 1, 1 );
+}
+
+Rocket_Benchmark( Queue_MPMC_1to1 ) {
+	m_items = BenchmarkQueues_Count;
+	MPMCQueue< unsigned int > queue( 1024 );
+	BenchmarkQueues_Threads( queue, 1, 1 );
+}
+
+Rocket_Benchmark( Queue_Locked_4to4 ) {
+	m_items = BenchmarkQueues_Count;
+	BenchmarkQueues_Locked queue( 1024 );
+	BenchmarkQueues_Threads( queue, 4, 4 );
+}
+
+Rocket_Benchmark( Queue_MPMC_4to4 ) {
+	m_items = BenchmarkQueues_Count;
+	MPMCQueue< unsigned int > queue( 1024 );
+	BenchmarkQueues_Threads( queue, 4, 4 );
+}
@@ -0,0 +1,141 @@
+#include "rocket/Benchmark.h"
+
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+
+#include "rstring.h"
+#include "stringid.h"
+
+using namespace Rocket::Core;
+
+static const unsigned int BenchmarkString_Count = 1000;
+
+static volatile size_t BenchmarkString_Sink;
+
+// The previous rstring appends: each one built a new string from a copy of the whole value
+static void BenchmarkString_CopyingAppend( std::string & value, const std::string & s ) {
+	value = std::string( value + s );
+}
+
+// The previous rstring::tostring( unsigned int ): one recursive call and one copying append per digit
+static void BenchmarkString_RecursiveDigits( unsigned int i, std::string & s ) {
+	unsigned int n = i % 10;
+	unsigned int rest = ( i - n ) / 10;
+	if ( rest > 0 ) BenchmarkString_RecursiveDigits( rest, s );
+	s = s + char( '0' + n );
+}
+
+// Building a 1000-element comma separated list, counted in elements
+Rocket_Benchmark( StringAppend_Copying ) {
+	m_items = BenchmarkString_Count;
+	std::string value;
+	std::string piece = "item,";
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) BenchmarkString_CopyingAppend( value, piece );
+	BenchmarkString_Sink = value.length();
+}
+
+Rocket_Benchmark( StringAppend_rstring ) {
+	m_items = BenchmarkString_Count;
+	rstring value;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) value << "item,";
+	BenchmarkString_Sink = value.length();
+}
+
+Rocket_Benchmark( StringAppend_Builder ) {
+	m_items = BenchmarkString_Count;
+	StringBuilder value;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) value << "item,";
+	BenchmarkString_Sink = value.length();
+}
+
+// Formatting integers of every length, counted in integers
+Rocket_Benchmark( FormatUnsigned_Recursive ) {
+	m_items = BenchmarkString_Count;
+	size_t total = 0;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) {
+		std::string s;
+		BenchmarkString_RecursiveDigits( i * 4294967u, s );
+		total += s.length();
+	}
+	BenchmarkString_Sink = total;
+}
+
+Rocket_Benchmark( FormatUnsigned_snprintf ) {
+	m_items = BenchmarkString_Count;
+	char buffer[ FormatBufferSize ];
+	size_t total = 0;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) total += snprintf( buffer, sizeof( buffer ), "%u", i * 4294967u );
+	BenchmarkString_Sink = total;
+}
+
+Rocket_Benchmark( FormatUnsigned_Table ) {
+	m_items = BenchmarkString_Count;
+	char buffer[ FormatBufferSize ];
+	size_t total = 0;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) total += formatUnsigned( i * 4294967u, buffer );
+	BenchmarkString_Sink = total;
+}
+
+Rocket_Benchmark( FormatDouble_snprintf ) {
+	m_items = BenchmarkString_Count;
+	char buffer[ FormatBufferSize ];
+	size_t total = 0;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) total += snprintf( buffer, sizeof( buffer ), "%.6f", i * 1234.5678901 - 50000.0 );
+	BenchmarkString_Sink = total;
+}
+
+Rocket_Benchmark( FormatDouble_Table ) {
+	m_items = BenchmarkString_Count;
+	char buffer[ FormatBufferSize ];
+	size_t total = 0;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) total += formatDouble( i * 1234.5678901 - 50000.0, buffer );
+	BenchmarkString_Sink = total;
+}
+
+// "IP:port" keys as built when a UDP packet arrives, counted in keys
+Rocket_Benchmark( AddressKey_Copying ) {
+	m_items = BenchmarkString_Count;
+	size_t total = 0;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) {
+		std::string key = "192.168.1.20", port;
+		BenchmarkString_CopyingAppend( key, ":" );
+		BenchmarkString_RecursiveDigits( 40000 + i, port );
+		BenchmarkString_CopyingAppend( key, port );
+		total += key.length();
+	}
+	BenchmarkString_Sink = total;
+}
+
+Rocket_Benchmark( AddressKey_Builder ) {
+	m_items = BenchmarkString_Count;
+	size_t total = 0;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) {
+		StringBuilder key;
+		key << "192.168.1.20" << ':' << 40000 + i;
+		total += key.length();
+	}
+	BenchmarkString_Sink = total;
+}
+
+// Asset lookups by literal name, as in Universe::getMesh( "SPRITE_MESH" ), counted in lookups
+static const char * const BenchmarkString_AssetNames[] = { "SPRITE_MESH", "human", "planet", "test_happyface", "test_planet", "test_human", "test_font", "texture" };
+
+Rocket_Benchmark( AssetLookup_String ) {
+	static std::unordered_map< std::string, int > assets;
+	if ( assets.empty() ) for ( unsigned int i = 0; i < 8; i++ ) assets[ BenchmarkString_AssetNames[i] ] = i;
+	m_items = BenchmarkString_Count;
+	size_t total = 0;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) total += assets.find( ( i & 1 ) ? "test_planet" : "SPRITE_MESH" )->second;
+	BenchmarkString_Sink = total;
+}
+
+Rocket_Benchmark( AssetLookup_StringId ) {
+	static std::unordered_map< StringId, int > assets;
+	if ( assets.empty() ) for ( unsigned int i = 0; i < 8; i++ ) assets[ StringId::intern( BenchmarkString_AssetNames[i] ) ] = i;
+	static constexpr StringId Planet( "test_planet" ), Sprite( "SPRITE_MESH" );
+	m_items = BenchmarkString_Count;
+	size_t total = 0;
+	for ( unsigned int i = 0; i < BenchmarkString_Count; i++ ) total += assets.find( ( i & 1 ) ? Planet : Sprite )->second;
+	BenchmarkString_Sink = total;
+}
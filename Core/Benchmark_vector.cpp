@@ -0,0 +1,38 @@
+#include "rocket/Benchmark.h"
+
+#include "vector.h"
+
+using namespace Rocket::Core;
+
+static const unsigned int BenchmarkVector_Count = 4096;
+
+struct BenchmarkVector_Data {
+	vec3 a[ BenchmarkVector_Count ];
+	vec3 b[ BenchmarkVector_Count ];
+	vec3 out[ BenchmarkVector_Count ];
+
+	BenchmarkVector_Data() {
+		for ( unsigned int i = 0; i < BenchmarkVector_Count; i++ ) {
+			a[i] = vec3( i * 0.25f, i * -0.5f, i * 0.125f );
+			b[i] = vec3( 1.0f, i * 0.75f, -2.0f );
+		}
+	}
+};
+static BenchmarkVector_Data BenchmarkVector_Vectors;
+
+// The same arithmetic chain written with the T_vec operators and with raw Eigen; the two should run at the same speed
+Rocket_Benchmark( VectorChain_Wrapper ) {
+	m_items = BenchmarkVector_Count;
+	BenchmarkVector_Data & d = BenchmarkVector_Vectors;
+	for ( unsigned int i = 0; i < BenchmarkVector_Count; i++ ) {
+		d.out[i] += d.a[i] * 0.5f - d.b[i] * 0.25f + d.a[i];
+	}
+}
+
+Rocket_Benchmark( VectorChain_Eigen ) {
+	m_items = BenchmarkVector_Count;
+	BenchmarkVector_Data & d = BenchmarkVector_Vectors;
+	for ( unsigned int i = 0; i < BenchmarkVector_Count; i++ ) {
+		d.out[i].m_elements += d.a[i].m_elements * 0.5f - d.b[i].m_elements * 0.25f + d.a[i].m_elements;
+	}
+}
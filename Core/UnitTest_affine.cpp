@@ -0,0 +1,72 @@
+#include "rocket/UnitTest.h"
+
+#include "affine.h"
+
+using namespace Rocket::Core;
+
+// Largest element-wise difference between an affine transform and a 4x4 matrix
+static float maxDifference( const affine & a, const mat4 & m ) {
+	return ( a.toMatrix().m_matrix - m.m_matrix ).cwiseAbs().maxCoeff();
+}
+
+Rocket_UnitTest( VectorMath_affine ) {
+	vec3 translation( 1.0f, -2.0f, 3.5f );
+	quat rotation( 0.8f, vec3( 1, 2, 3 ) );
+	vec3 scale( 2.0f, 0.5f, 3.0f );
+
+	// Direct TRS construction
+	affine a( translation, rotation, scale );
+	mat4 m = Translate( translation ) * QuaternionRotate( rotation ) * Scale( scale );
+	Rocket_UnitTest_Check_FloatEqual( maxDifference( a, m ), 0.0f, 0.0001f );
+
+	// Composition
+	affine b( vec3( -4.0f, 0.0f, 1.0f ), quat( -0.3f, vec3( 0, 1, 0 ) ), vec3( 1.0f, 1.0f, 1.0f ) );
+	Rocket_UnitTest_Check_FloatEqual( maxDifference( a * b, m * b.toMatrix() ), 0.0f, 0.0001f );
+	affine ab = a;
+	ab *= b;
+	Rocket_UnitTest_Check_FloatEqual( maxDifference( ab, m * b.toMatrix() ), 0.0f, 0.0001f );
+
+	// Conversion from mat4
+	Rocket_UnitTest_Check_FloatEqual( maxDifference( affine( m ), m ), 0.0f, 0.0001f );
+
+	// Points and directions
+	vec4 p( 0.5f, 1.0f, -1.0f, 1.0f );
+	vec4 ap = a * p;
+	vec4 mp = m * p;
+	Rocket_UnitTest_Check_FloatEqual( ap.x(), mp.x(), 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( ap.y(), mp.y(), 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( ap.z(), mp.z(), 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( ap.w(), 1.0f, 0.0001f );
+	vec3 point = a.transformPoint( p.xyz() );
+	Rocket_UnitTest_Check_FloatEqual( point.z(), mp.z(), 0.0001f );
+	vec3 direction = a.transformVector( p.xyz() );
+	vec4 md = m * vec4( p.x(), p.y(), p.z(), 0.0f );
+	Rocket_UnitTest_Check_FloatEqual( direction.x(), md.x(), 0.0001f );
+
+	// Inverses
+	mat4 inverse = m.inverse();
+	Rocket_UnitTest_Check_FloatEqual( maxDifference( a.inverse(), inverse ), 0.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( maxDifference( a.inverseScaled(), inverse ), 0.0f, 0.0001f );
+
+	affine rigid( translation, rotation, vec3( 1.0f, 1.0f, 1.0f ) );
+	mat4 rigidMatrix = Translate( translation ) * QuaternionRotate( rotation );
+	Rocket_UnitTest_Check_FloatEqual( maxDifference( rigid.inverseRigid(), rigidMatrix.inverse() ), 0.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( maxDifference( rigid * rigid.inverseRigid(), mat4() ), 0.0f, 0.0001f );
+}
+
+Rocket_UnitTest( VectorMath_affineCamera ) {
+	// Scene's camera orientation is translate * rotate; its affine inverse matches the general 4x4 inverse
+	quat rotation( -1.1f, vec3( 0.2f, 1.0f, -0.4f ) );
+	mat4 camera = Translate( vec3( 3.0f, -7.5f, 12.0f ) ) * QuaternionRotate( rotation );
+	mat4 inverse = camera.inverse();
+	Rocket_UnitTest_Check_FloatEqual( maxDifference( affine( camera ).inverseRigid(), inverse ), 0.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( maxDifference( affine( camera ).inverseScaled(), inverse ), 0.0f, 0.0001f );
+
+	// The camera's position, as Scene::calculateNewPosition() finds it
+	vec3 translation( -camera(0,3), -camera(1,3), -camera(2,3) );
+	vec4 expected = inverse * vec4( translation, 0.0f );
+	vec3 position = affine( camera ).inverseScaled().transformVector( translation );
+	Rocket_UnitTest_Check_FloatEqual( position.x(), expected.x(), 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( position.y(), expected.y(), 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( position.z(), expected.z(), 0.0001f );
+}
@@ -0,0 +1,201 @@
+#include "rocket/UnitTest.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "allocators.h"
+
+using namespace Rocket::Core;
+
+Rocket_UnitTest( Allocators_Arena ) {
+	Arena arena( 1024 );
+	Rocket_UnitTest_Check_Equal( arena.bytesUsed(), size_t( 0 ) );
+
+	// Allocations are aligned and do not overlap
+	char * a = (char *)arena.allocate( 3, 1 );
+	double * b = arena.allocate< double >( 4 );
+	char * c = (char *)arena.allocate( 10, 64 );
+	Rocket_UnitTest_Check_Equal( (size_t)b % alignof( double ), size_t( 0 ) );
+	Rocket_UnitTest_Check_Equal( (size_t)c % 64, size_t( 0 ) );
+	Rocket_UnitTest_Check_Expression( a + 3 <= (char *)b && (char *)( b + 4 ) <= c );
+
+	// Freeing back to a mark reuses the same memory
+	Arena::Marker marker = arena.mark();
+	size_t used = arena.bytesUsed();
+	void * first = arena.allocate( 100 );
+	arena.allocate( 5000 );				// larger than a block
+	arena.allocate( 900 );
+	Rocket_UnitTest_Check_Expression( arena.bytesUsed() > used + 6000 );
+	arena.reset( marker );
+	Rocket_UnitTest_Check_Equal( arena.bytesUsed(), used );
+	Rocket_UnitTest_Check_Expression( arena.allocate( 100 ) == first );
+
+	// Once the arena has grown, the same sequence allocates nothing from the heap
+	size_t reserved = arena.bytesReserved();
+	arena.reset();
+	Rocket_UnitTest_Check_Equal( arena.bytesUsed(), size_t( 0 ) );
+	Rocket_UnitTest_Check_NoAllocations( {
+		arena.allocate( 3, 1 );
+		arena.allocate< double >( 4 );
+		arena.allocate( 10, 64 );
+		arena.allocate( 100 );
+		arena.allocate( 5000 );
+		arena.allocate( 900 );
+	} );
+	Rocket_UnitTest_Check_Equal( arena.bytesReserved(), reserved );
+
+	// Scopes free their own allocations
+	{
+		ArenaScope scope( arena );
+		arena.allocate( 2000 );
+	}
+	Rocket_UnitTest_Check_Expression( arena.bytesUsed() < reserved );
+}
+
+Rocket_UnitTest( Allocators_ArenaAllocator ) {
+	Arena & arena = scratchArena();
+	ArenaScope scope( arena );
+	size_t used = arena.bytesUsed();
+
+	std::vector< int, ArenaAllocator< int > > values( ( ArenaAllocator< int >( arena ) ) );
+	for ( int i = 0; i < 1000; i++ ) values.push_back( i );
+	int sum = 0;
+	for ( int value : values ) sum += value;
+	Rocket_UnitTest_Check_Equal( sum, 499500 );
+	Rocket_UnitTest_Check_Expression( arena.bytesUsed() >= used + 1000 * sizeof( int ) );
+
+	// The scratch arena belongs to the calling thread
+	Arena * other = nullptr;
+	std::thread thread( [ &other ] () { other = &scratchArena(); } );
+	thread.join();
+	Rocket_UnitTest_Check_Expression( other != &arena );
+}
+
+Rocket_UnitTest( Allocators_FixedPool ) {
+	FixedPool pool( 24, 32, 4 );
+	Rocket_UnitTest_Check_Equal( pool.blockSize(), size_t( 32 ) );
+	Rocket_UnitTest_Check_Equal( pool.capacity(), size_t( 0 ) );
+
+	// Distinct aligned blocks, over several chunks
+	std::set< void * > blocks;
+	for ( unsigned int i = 0; i < 100; i++ ) {
+		void * block = pool.allocate();
+		Rocket_UnitTest_Check_Equal( (size_t)block % 32, size_t( 0 ) );
+		Rocket_UnitTest_Check_Expression( pool.owns( block ) );
+		blocks.insert( block );
+	}
+	Rocket_UnitTest_Check_Equal( blocks.size(), size_t( 100 ) );
+	Rocket_UnitTest_Check_Expression( pool.capacity() >= 100 );
+	int outside = 0;
+	Rocket_UnitTest_Check_Expression( pool.owns( &outside ) == false );
+
+	// Freed blocks are reused without growing or allocating
+	size_t capacity = pool.capacity();
+	for ( void * block : blocks ) pool.deallocate( block );
+	Rocket_UnitTest_Check_NoAllocations( {
+		for ( unsigned int i = 0; i < 100; i++ ) {
+			void * block = pool.allocate();
+			if ( blocks.count( block ) == 0 ) blocks.clear();
+			pool.deallocate( block );
+		}
+	} );
+	Rocket_UnitTest_Check_Equal( blocks.size(), size_t( 100 ) );
+	Rocket_UnitTest_Check_Equal( pool.capacity(), capacity );
+
+	// Batches
+	void * batch[ 50 ];
+	pool.allocate( batch, 50 );
+	std::set< void * > batchBlocks( batch, batch + 50 );
+	Rocket_UnitTest_Check_Equal( batchBlocks.size(), size_t( 50 ) );
+	pool.deallocate( batch, 50 );
+	pool.allocate( batch, 50 );
+	Rocket_UnitTest_Check_Equal( std::set< void * >( batch, batch + 50 ).size(), size_t( 50 ) );
+	Rocket_UnitTest_Check_Equal( pool.capacity(), capacity );
+}
+
+Rocket_UnitTest( Allocators_FixedPool_Threads ) {
+	// Threads take and return blocks concurrently; a block held by two threads at once shows up as a changed value
+	FixedPool pool( sizeof( unsigned int ), alignof( unsigned int ), 16 );
+	std::atomic< unsigned int > errors( 0 );
+	std::vector< std::thread > threads;
+	for ( unsigned int t = 0; t < 4; t++ ) {
+		threads.push_back( std::thread( [ &pool, &errors, t ] () {
+			unsigned int * held[ 8 ];
+			for ( unsigned int i = 0; i < 20000; i++ ) {
+				unsigned int count = 1 + ( i + t ) % 8;
+				for ( unsigned int j = 0; j < count; j++ ) {
+					held[j] = (unsigned int *)pool.allocate();
+					*held[j] = t * 1000 + j;
+				}
+				for ( unsigned int j = 0; j < count; j++ ) {
+					if ( *held[j] != t * 1000 + j ) errors++;
+					pool.deallocate( held[j] );
+				}
+			}
+		} ) );
+	}
+	for ( auto & thread : threads ) thread.join();
+	Rocket_UnitTest_Check_Equal( errors.load(), 0u );
+	Rocket_UnitTest_Check_Expression( pool.capacity() <= 16 * 7 );
+
+	// The same through the caches of a SharedPool, with blocks freed by other threads than the ones that allocated them
+	typedef SharedPool< 40, 8 > Shared;
+	std::vector< void * > blocks[ 4 ];
+	threads.clear();
+	for ( unsigned int t = 0; t < 4; t++ ) {
+		threads.push_back( std::thread( [ &blocks, &errors, t ] () {
+			for ( unsigned int i = 0; i < 5000; i++ ) {
+				unsigned int * block = (unsigned int *)Shared::allocate();
+				*block = t;
+				blocks[t].push_back( block );
+				if ( i % 3 == 0 ) {
+					if ( *(unsigned int *)blocks[t].back() != t ) errors++;
+					Shared::deallocate( blocks[t].back() );
+					blocks[t].pop_back();
+				}
+			}
+			for ( void * block : blocks[t] ) {
+				if ( *(unsigned int *)block != t ) errors++;
+			}
+		} ) );
+	}
+	for ( auto & thread : threads ) thread.join();
+	std::set< void * > held;
+	for ( unsigned int t = 0; t < 4; t++ ) {
+		held.insert( blocks[t].begin(), blocks[t].end() );
+		for ( void * block : blocks[ ( t + 1 ) % 4 ] ) Shared::deallocate( block );
+	}
+	Rocket_UnitTest_Check_Equal( errors.load(), 0u );
+	Rocket_UnitTest_Check_Equal( held.size(), size_t( 4 * ( 5000 - 1667 ) ) );
+}
+
+Rocket_UnitTest( Allocators_PoolAllocator ) {
+	// allocate_shared puts the object and its reference counts in one pooled block
+	struct Glyph {
+		float x, y, width, height;
+	};
+	std::shared_ptr< Glyph > glyph = std::allocate_shared< Glyph >( PoolAllocator< Glyph >() );
+	glyph->x = 1.0f;
+	std::weak_ptr< Glyph > weak = glyph;
+	glyph.reset();
+	Rocket_UnitTest_Check_Expression( weak.expired() );
+
+	// Once a block has been freed, the next shared_ptr reuses it
+	glyph = std::allocate_shared< Glyph >( PoolAllocator< Glyph >() );
+	glyph.reset();
+	weak.reset();
+	Rocket_UnitTest_Check_NoAllocations( std::allocate_shared< Glyph >( PoolAllocator< Glyph >() ) );
+
+	// Node containers
+	std::list< int, PoolAllocator< int > > values;
+	for ( int i = 0; i < 100; i++ ) values.push_back( i );
+	values.clear();
+	Rocket_UnitTest_Check_NoAllocations( {
+		for ( int i = 0; i < 100; i++ ) values.push_back( i );
+	} );
+	Rocket_UnitTest_Check_Equal( values.size(), size_t( 100 ) );
+}
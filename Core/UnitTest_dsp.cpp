@@ -0,0 +1,458 @@
+#include "rocket/UnitTest.h"
+
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#include "dsp.h"
+
+using namespace Rocket::DigitalSignalProcessing;
+
+// Deterministic pseudo-random signal in [-1, 1)
+static std::vector< ComplexData > DSP_RandomSignal( unsigned int size, unsigned int seed ) {
+	std::vector< ComplexData > signal( size );
+	for ( unsigned int n = 0; n < size; n++ ) {
+		seed = seed * 1664525u + 1013904223u;
+		signal[n].r = ( seed >> 8 ) / double( 1 << 23 ) - 1.0;
+		seed = seed * 1664525u + 1013904223u;
+		signal[n].i = ( seed >> 8 ) / double( 1 << 23 ) - 1.0;
+	}
+	return signal;
+}
+
+// Largest difference between the elements of a and b
+static double DSP_MaxError( const std::vector< ComplexData > & a, const std::vector< ComplexData > & b ) {
+	double maxError = 0.0;
+	for ( unsigned int n = 0; n < a.size(); n++ ) {
+		double error = fabs( a[n].r - b[n].r ) + fabs( a[n].i - b[n].i );
+		if ( error > maxError ) maxError = error;
+	}
+	return maxError;
+}
+
+// O(N^2) discrete Fourier transform with long double accumulation
+static std::vector< ComplexData > DSP_ReferenceDFT( const std::vector< ComplexData > & x, double sign ) {
+	const long double twoPi = 6.283185307179586476925L;
+	unsigned int size = (unsigned int)x.size();
+	std::vector< ComplexData > X( size );
+	for ( unsigned int k = 0; k < size; k++ ) {
+		long double r = 0.0L, i = 0.0L;
+		for ( unsigned int n = 0; n < size; n++ ) {
+			long double angle = sign * twoPi * ( ( (unsigned long long)n * k ) % size ) / size;
+			r += x[n].r * cosl( angle ) - x[n].i * sinl( angle );
+			i += x[n].r * sinl( angle ) + x[n].i * cosl( angle );
+		}
+		X[k].r = double( r );
+		X[k].i = double( i );
+	}
+	return X;
+}
+
+Rocket_UnitTest( DSP_FFTPlan ) {
+	// Every radix-2 / radix-4 stage combination up to 1024 points
+	for ( unsigned int size = 1; size <= 1024; size *= 2 ) {
+		std::vector< ComplexData > x = DSP_RandomSignal( size, size );
+		FFTPlan forward( size );
+		FFTPlan inverse( size, FFTPlan::Inverse );
+
+		std::vector< ComplexData > outOfPlace( size );
+		forward.execute( x.data(), outOfPlace.data() );
+		Rocket_UnitTest_Check_Expression( DSP_MaxError( outOfPlace, DSP_ReferenceDFT( x, -1.0 ) ) < 1e-12 * size );
+
+		std::vector< ComplexData > inPlace = x;
+		forward.execute( inPlace.data() );
+		Rocket_UnitTest_Check_Expression( DSP_MaxError( inPlace, outOfPlace ) == 0.0 );
+
+		std::vector< ComplexData > backward( size );
+		inverse.execute( x.data(), backward.data() );
+		Rocket_UnitTest_Check_Expression( DSP_MaxError( backward, DSP_ReferenceDFT( x, 1.0 ) ) < 1e-12 * size );
+
+		// The inverse of the forward transform is the input scaled by size
+		inverse.execute( inPlace.data() );
+		for ( unsigned int n = 0; n < size; n++ ) {
+			inPlace[n].r /= size;
+			inPlace[n].i /= size;
+		}
+		Rocket_UnitTest_Check_Expression( DSP_MaxError( inPlace, x ) < 1e-14 * size );
+	}
+
+	// An impulse transforms to a constant and a pure tone to a single bin
+	std::vector< ComplexData > impulse( 64 ), tone( 64 );
+	for ( unsigned int n = 0; n < 64; n++ ) {
+		impulse[n].r = ( n == 0 ) ? 1.0 : 0.0;
+		impulse[n].i = 0.0;
+		tone[n].r = cos( 6.283185307179586 * 5 * n / 64 );
+		tone[n].i = sin( 6.283185307179586 * 5 * n / 64 );
+	}
+	FFTPlan plan( 64 );
+	plan.execute( impulse.data() );
+	plan.execute( tone.data() );
+	for ( unsigned int k = 0; k < 64; k++ ) {
+		Rocket_UnitTest_Check_Expression( impulse[k].r == 1.0 && impulse[k].i == 0.0 );
+		Rocket_UnitTest_Check_Expression( fabs( tone[k].r - ( ( k == 5 ) ? 64.0 : 0.0 ) ) < 1e-12 && fabs( tone[k].i ) < 1e-12 );
+	}
+
+	// Executing a plan never allocates
+	std::vector< ComplexData > x = DSP_RandomSignal( 4096, 7 ), y( 4096 );
+	FFTPlan large( 4096 );
+	Rocket_UnitTest_Check_NoAllocations( large.execute( x.data() ) );
+	Rocket_UnitTest_Check_NoAllocations( large.execute( x.data(), y.data() ) );
+}
+
+Rocket_UnitTest( DSP_FFTBatch ) {
+	// Sizes with a radix-2 and a radix-4 first stage, frame counts that do and don't divide evenly between threads
+	const unsigned int sizes[] = { 1, 2, 4, 8, 64, 512 };
+	const unsigned int counts[] = { 0, 1, 5, 16, 37 };
+	for ( unsigned int s = 0; s < 6; s++ ) {
+		for ( unsigned int c = 0; c < 5; c++ ) {
+			for ( unsigned int threads = 1; threads <= 3; threads++ ) {
+				unsigned int size = sizes[s], count = counts[c];
+				FFTPlan plan( size, ( threads == 2 ) ? FFTPlan::Inverse : FFTPlan::Forward );
+				std::vector< ComplexData > input = DSP_RandomSignal( size * count, size + count ), expected( size * count );
+				for ( unsigned int f = 0; f < count; f++ ) plan.execute( &input[ f * size ], &expected[ f * size ] );
+
+				std::vector< ComplexData > output( size * count );
+				plan.executeBatch( input.data(), output.data(), count, threads );
+				Rocket_UnitTest_Check_Expression( DSP_MaxError( output, expected ) < 1e-13 * size );
+
+				plan.executeBatch( input.data(), input.data(), count, threads );
+				Rocket_UnitTest_Check_Expression( DSP_MaxError( input, output ) == 0.0 );
+			}
+		}
+	}
+
+	// One thread per hardware thread
+	std::vector< ComplexData > input = DSP_RandomSignal( 256 * 64, 11 ), expected( input.size() ), output( input.size() );
+	FFTPlan plan( 256 );
+	for ( unsigned int f = 0; f < 64; f++ ) plan.execute( &input[ f * 256 ], &expected[ f * 256 ] );
+	plan.executeBatch( input.data(), output.data(), 64 );
+	Rocket_UnitTest_Check_Expression( DSP_MaxError( output, expected ) < 1e-13 * 256 );
+}
+
+Rocket_UnitTest( DSP_FFT ) {
+	// The original interface returns a new array with the forward transform
+	std::vector< ComplexData > x = DSP_RandomSignal( 256, 3 ), expected( 256 );
+	FFTPlan( 256 ).execute( x.data(), expected.data() );
+	ComplexData * result = FFT( x.data(), 256 );
+	std::vector< ComplexData > output( result, result + 256 );
+	delete [] result;
+	Rocket_UnitTest_Check_Expression( DSP_MaxError( output, expected ) == 0.0 );
+
+	result = FFT( x.data(), 1 );
+	Rocket_UnitTest_Check_Expression( result != x.data() && result[0].r == x[0].r && result[0].i == x[0].i );
+	delete [] result;
+}
+
+Rocket_UnitTest( DSP_RealFFTPlan ) {
+	for ( unsigned int size = 2; size <= 4096; size *= 2 ) {
+		std::vector< ComplexData > x = DSP_RandomSignal( size, size + 1 );
+		std::vector< double > samples( size );
+		for ( unsigned int n = 0; n < size; n++ ) {
+			samples[n] = x[n].r;
+			x[n].i = 0.0;
+		}
+
+		std::vector< ComplexData > expected( size );
+		FFTPlan( size ).execute( x.data(), expected.data() );
+		expected.resize( size / 2 + 1 );
+
+		RealFFTPlan plan( size );
+		std::vector< ComplexData > bins( plan.binCount() );
+		plan.execute( samples.data(), bins.data() );
+		Rocket_UnitTest_Check_Expression( DSP_MaxError( bins, expected ) < 1e-13 * size );
+		Rocket_UnitTest_Check_NoAllocations( plan.execute( samples.data(), bins.data() ) );
+
+		// The inverse gives size times the samples back
+		RealFFTPlan inverse( size, FFTPlan::Inverse );
+		std::vector< double > restored( size );
+		Rocket_UnitTest_Check_NoAllocations( inverse.execute( bins.data(), restored.data() ) );
+		double maxError = 0.0;
+		for ( unsigned int n = 0; n < size; n++ ) maxError = std::max( maxError, fabs( restored[n] / size - samples[n] ) );
+		Rocket_UnitTest_Check_Expression( maxError < 1e-14 * size );
+	}
+}
+
+Rocket_UnitTest( DSP_STFT ) {
+	const unsigned int frameSize = 256, hopSize = 64, count = 5000;
+	std::vector< double > samples( count ), stereo( count * 2 );
+	for ( unsigned int n = 0; n < count; n++ ) {
+		samples[n] = sin( 6.283185307179586 * 20.0 * n / frameSize ) + 0.1 * cos( n * 1.3 );
+		stereo[n*2] = 0.0;
+		stereo[n*2 + 1] = samples[n];
+	}
+
+	// All samples at once
+	STFT whole( frameSize, hopSize );
+	unsigned int frames = whole.frameCount( count );
+	Rocket_UnitTest_Check_Equal( frames, 1 + ( count - frameSize ) / hopSize );
+	std::vector< double > expected( frames * whole.binCount() );
+	Rocket_UnitTest_Check_Equal( whole.process( samples.data(), count, expected.data() ), frames );
+
+	// The tone is in bin 20 of every frame
+	for ( unsigned int f = 0; f < frames; f++ ) {
+		const double * row = &expected[ f * whole.binCount() ];
+		unsigned int peak = 0;
+		for ( unsigned int k = 1; k < whole.binCount(); k++ ) {
+			if ( row[k] > row[peak] ) peak = k;
+		}
+		Rocket_UnitTest_Check_Equal( peak, 20u );
+	}
+
+	// The same rows from one channel of an interleaved stream, in blocks of varying length, without allocating
+	STFT streaming( frameSize, hopSize );
+	std::vector< double > rows( expected.size() );
+	unsigned int written = 0;
+	for ( unsigned int start = 0, block = 1; start < count; start += block, block = block * 7 % 509 + 1 ) {
+		unsigned int length = ( start + block > count ) ? count - start : block;
+		unsigned int predicted = streaming.frameCount( length );
+		unsigned int produced;
+		Rocket_UnitTest_Check_NoAllocations( produced = streaming.process( &stereo[ start * 2 + 1 ], length, &rows[ written * streaming.binCount() ], 2 ) );
+		Rocket_UnitTest_Check_Equal( produced, predicted );
+		written += produced;
+	}
+	Rocket_UnitTest_Check_Equal( written, frames );
+	Rocket_UnitTest_Check_Expression( rows == expected );
+
+	// Hops longer than a frame skip samples; magnitudes are the square roots of powers
+	STFT sparse( 128, 300, STFT::Blackman, STFT::Magnitude );
+	STFT dense( 128, 300, STFT::Blackman, STFT::Power );
+	frames = sparse.frameCount( count );
+	Rocket_UnitTest_Check_Equal( frames, 1 + ( count - 128 ) / 300 );
+	std::vector< double > magnitudes( frames * sparse.binCount() ), powers( magnitudes.size() );
+	Rocket_UnitTest_Check_Equal( sparse.process( samples.data(), count, magnitudes.data() ), frames );
+	Rocket_UnitTest_Check_Equal( dense.process( samples.data(), count, powers.data() ), frames );
+	for ( unsigned int i = 0; i < magnitudes.size(); i++ ) Rocket_UnitTest_Check_Expression( fabs( magnitudes[i] * magnitudes[i] - powers[i] ) <= 1e-9 * ( 1.0 + powers[i] ) );
+
+	// Frame f of the sparse transform starts at sample 300f
+	RealFFTPlan plan( 128 );
+	std::vector< double > windowed( 128 );
+	std::vector< ComplexData > bins( plan.binCount() );
+	for ( unsigned int n = 0; n < 128; n++ ) {
+		double x = 6.283185307179586 * n / 128;
+		windowed[n] = samples[ 600 + n ] * ( 0.42 - 0.5 * cos( x ) + 0.08 * cos( 2.0 * x ) );
+	}
+	plan.execute( windowed.data(), bins.data() );
+	for ( unsigned int k = 0; k < plan.binCount(); k++ ) {
+		double magnitude = sqrt( bins[k].r * bins[k].r + bins[k].i * bins[k].i );
+		Rocket_UnitTest_Check_Expression( fabs( magnitudes[ 2 * plan.binCount() + k ] - magnitude ) < 1e-12 );
+	}
+
+	// After reset(), a full frame is needed again
+	sparse.reset();
+	Rocket_UnitTest_Check_Equal( sparse.frameCount( 127 ), 0u );
+	Rocket_UnitTest_Check_Equal( sparse.frameCount( 128 ), 1u );
+}
+
+// Deterministic pseudo-random real signal in [-1, 1)
+static std::vector< double > DSP_RandomSamples( unsigned int size, unsigned int seed ) {
+	std::vector< double > samples( size );
+	for ( unsigned int n = 0; n < size; n++ ) {
+		seed = seed * 1664525u + 1013904223u;
+		samples[n] = ( seed >> 8 ) / double( 1 << 23 ) - 1.0;
+	}
+	return samples;
+}
+
+Rocket_UnitTest( DSP_FIRFilter ) {
+	const unsigned int frames = 1500;
+	for ( unsigned int taps = 1; taps <= 70; taps += 23 ) {
+		std::vector< double > coefficients = DSP_RandomSamples( taps, taps );
+		for ( unsigned int channels = 1; channels <= 3; channels++ ) {
+			std::vector< double > input = DSP_RandomSamples( frames * channels, 7 * channels );
+
+			// Direct convolution of each channel
+			std::vector< double > expected( input.size() );
+			for ( unsigned int n = 0; n < frames; n++ ) {
+				for ( unsigned int c = 0; c < channels; c++ ) {
+					double sum = 0.0;
+					for ( unsigned int k = 0; k < taps && k <= n; k++ ) sum += coefficients[k] * input[ ( n - k ) * channels + c ];
+					expected[ n * channels + c ] = sum;
+				}
+			}
+
+			// Blocks of varying length, filtered in place
+			FIRFilter filter( coefficients.data(), taps, channels );
+			std::vector< double > output = input;
+			for ( unsigned int start = 0, block = 1; start < frames; start += block, block = block * 5 % 601 + 1 ) {
+				unsigned int length = ( start + block > frames ) ? frames - start : block;
+				Rocket_UnitTest_Check_NoAllocations( filter.process( &output[ start * channels ], &output[ start * channels ], length ) );
+			}
+			double maxError = 0.0;
+			for ( unsigned int i = 0; i < output.size(); i++ ) maxError = std::max( maxError, fabs( output[i] - expected[i] ) );
+			Rocket_UnitTest_Check_Expression( maxError < 1e-12 );
+
+			// After reset(), the filter starts again from silence
+			filter.reset();
+			filter.process( input.data(), output.data(), frames );
+			maxError = 0.0;
+			for ( unsigned int i = 0; i < output.size(); i++ ) maxError = std::max( maxError, fabs( output[i] - expected[i] ) );
+			Rocket_UnitTest_Check_Expression( maxError < 1e-12 );
+		}
+	}
+}
+
+// Gain of a section at frequency w (in radians per sample)
+static double DSP_BiquadGain( const BiquadCoefficients & q, double w ) {
+	double nr = q.b0 + q.b1 * cos( w ) + q.b2 * cos( 2.0 * w ), ni = -q.b1 * sin( w ) - q.b2 * sin( 2.0 * w );
+	double dr = 1.0 + q.a1 * cos( w ) + q.a2 * cos( 2.0 * w ), di = -q.a1 * sin( w ) - q.a2 * sin( 2.0 * w );
+	return sqrt( ( nr * nr + ni * ni ) / ( dr * dr + di * di ) );
+}
+
+Rocket_UnitTest( DSP_Biquad ) {
+	const double pi = 3.141592653589793;
+	const double rate = 48000.0;
+
+	// Designs have the gains of the cookbook at DC, the corner frequency and Nyquist
+	BiquadCoefficients lowPass = BiquadCoefficients::lowPass( rate, 1000.0 );
+	BiquadCoefficients highPass = BiquadCoefficients::highPass( rate, 1000.0 );
+	BiquadCoefficients bandPass = BiquadCoefficients::bandPass( rate, 2000.0, 2.0 );
+	BiquadCoefficients notch = BiquadCoefficients::notch( rate, 2000.0, 2.0 );
+	BiquadCoefficients peaking = BiquadCoefficients::peaking( rate, 3000.0, 1.0, 6.0 );
+	BiquadCoefficients lowShelf = BiquadCoefficients::lowShelf( rate, 200.0, -9.0 );
+	BiquadCoefficients highShelf = BiquadCoefficients::highShelf( rate, 8000.0, 4.0 );
+	double corner = 2.0 * pi * 1000.0 / rate, center = 2.0 * pi * 2000.0 / rate;
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( lowPass, 0.0 ) - 1.0 ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( DSP_BiquadGain( lowPass, pi ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( lowPass, corner ) - sqrt( 0.5 ) ) < 1e-9 );
+	Rocket_UnitTest_Check_Expression( DSP_BiquadGain( highPass, 0.0 ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( highPass, pi ) - 1.0 ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( highPass, corner ) - sqrt( 0.5 ) ) < 1e-9 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( bandPass, center ) - 1.0 ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( DSP_BiquadGain( notch, center ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( notch, 0.0 ) - 1.0 ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( peaking, 2.0 * pi * 3000.0 / rate ) - pow( 10.0, 6.0 / 20.0 ) ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( peaking, 0.0 ) - 1.0 ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( lowShelf, 0.0 ) - pow( 10.0, -9.0 / 20.0 ) ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( lowShelf, pi ) - 1.0 ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( highShelf, 0.0 ) - 1.0 ) < 1e-12 );
+	Rocket_UnitTest_Check_Expression( fabs( DSP_BiquadGain( highShelf, pi ) - pow( 10.0, 4.0 / 20.0 ) ) < 1e-12 );
+
+	// Cascades match one section at a time in direct form I, for every channel count and any block lengths
+	const BiquadCoefficients sections[] = { lowPass, peaking, highShelf };
+	const unsigned int frames = 2000;
+	for ( unsigned int channels = 1; channels <= 5; channels++ ) {
+		std::vector< double > input = DSP_RandomSamples( frames * channels, channels );
+		std::vector< double > expected = input;
+		for ( unsigned int s = 0; s < 3; s++ ) {
+			const BiquadCoefficients & q = sections[s];
+			for ( unsigned int c = 0; c < channels; c++ ) {
+				double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+				for ( unsigned int n = 0; n < frames; n++ ) {
+					double x = expected[ n * channels + c ];
+					double y = q.b0 * x + q.b1 * x1 + q.b2 * x2 - q.a1 * y1 - q.a2 * y2;
+					x2 = x1;
+					x1 = x;
+					y2 = y1;
+					y1 = y;
+					expected[ n * channels + c ] = y;
+				}
+			}
+		}
+
+		BiquadCascade cascade( sections, 3, channels );
+		Rocket_UnitTest_Check_Equal( cascade.sectionCount(), 3u );
+		std::vector< double > output( input.size() );
+		for ( unsigned int start = 0, block = 1; start < frames; start += block, block = block * 3 % 257 + 1 ) {
+			unsigned int length = ( start + block > frames ) ? frames - start : block;
+			Rocket_UnitTest_Check_NoAllocations( cascade.process( &input[ start * channels ], &output[ start * channels ], length ) );
+		}
+		double maxError = 0.0;
+		for ( unsigned int i = 0; i < output.size(); i++ ) maxError = std::max( maxError, fabs( output[i] - expected[i] ) );
+		Rocket_UnitTest_Check_Expression( maxError < 1e-9 );
+
+		// In place, after reset()
+		cascade.reset();
+		cascade.process( input.data(), input.data(), frames );
+		maxError = 0.0;
+		for ( unsigned int i = 0; i < output.size(); i++ ) maxError = std::max( maxError, fabs( input[i] - output[i] ) );
+		Rocket_UnitTest_Check_Expression( maxError < 1e-12 );
+	}
+}
+
+Rocket_UnitTest( DSP_Resampler ) {
+	const double pi = 3.141592653589793;
+	const double rates[][2] = { { 44100.0, 48000.0 }, { 48000.0, 22050.0 }, { 16000.0, 32000.0 }, { 48000.0, 48000.0 } };
+	for ( unsigned int r = 0; r < 4; r++ ) {
+		double inputRate = rates[r][0], outputRate = rates[r][1];
+		const unsigned int frames = 9000;
+
+		// A different tone on each of two channels, well inside both passbands
+		std::vector< double > input( frames * 2 );
+		for ( unsigned int n = 0; n < frames; n++ ) {
+			input[ n * 2 ] = sin( 2.0 * pi * 1000.0 * n / inputRate );
+			input[ n * 2 + 1 ] = 0.5 * cos( 2.0 * pi * 3100.0 * n / inputRate );
+		}
+
+		// Blocks of varying length produce the predicted number of frames
+		Resampler resampler( inputRate, outputRate, 2, 32 );
+		std::vector< double > output( ( resampler.outputCount( frames ) + 1 ) * 2 );
+		unsigned int written = 0;
+		unsigned int total = resampler.outputCount( frames );
+		for ( unsigned int start = 0, block = 1; start < frames; start += block, block = block * 7 % 997 + 1 ) {
+			unsigned int length = ( start + block > frames ) ? frames - start : block;
+			unsigned int predicted = resampler.outputCount( length );
+			unsigned int produced;
+			Rocket_UnitTest_Check_NoAllocations( produced = resampler.process( &input[ start * 2 ], length, &output[ written * 2 ] ) );
+			Rocket_UnitTest_Check_Equal( produced, predicted );
+			written += produced;
+		}
+		Rocket_UnitTest_Check_Equal( written, total );
+		Rocket_UnitTest_Check_Expression( fabs( written - ( frames - 16.0 ) * outputRate / inputRate ) <= 1.0 );
+
+		// Away from the silence before the first input, output m is the tones at input time m * inputRate / outputRate
+		double maxError = 0.0;
+		for ( unsigned int m = 0; m < written; m++ ) {
+			double t = m * inputRate / outputRate;
+			if ( t < 16.0 ) continue;
+			maxError = std::max( maxError, fabs( output[ m * 2 ] - sin( 2.0 * pi * 1000.0 * t / inputRate ) ) );
+			maxError = std::max( maxError, fabs( output[ m * 2 + 1 ] - 0.5 * cos( 2.0 * pi * 3100.0 * t / inputRate ) ) );
+		}
+		Rocket_UnitTest_Check_Expression( maxError < 1e-3 );
+
+		// After reset(), one call gives the same frames
+		resampler.reset();
+		std::vector< double > whole( output.size() );
+		Rocket_UnitTest_Check_Equal( resampler.process( input.data(), frames, whole.data() ), written );
+		Rocket_UnitTest_Check_Expression( whole == output );
+	}
+}
+
+Rocket_UnitTest( DSP_Convolver ) {
+	// Responses shorter than a block, a whole number of blocks, and a partial last partition
+	const unsigned int lengths[] = { 1, 50, 256, 1000 };
+	for ( unsigned int l = 0; l < 4; l++ ) {
+		unsigned int length = lengths[l];
+		std::vector< double > response = DSP_RandomSamples( length, length );
+		for ( unsigned int blockSize = 1; blockSize <= 128; blockSize *= 8 ) {
+			const unsigned int channels = 2, blocks = 2000 / blockSize;
+			const unsigned int frames = blocks * blockSize;
+			std::vector< double > input = DSP_RandomSamples( frames * channels, blockSize );
+
+			std::vector< double > expected( input.size() );
+			for ( unsigned int n = 0; n < frames; n++ ) {
+				for ( unsigned int c = 0; c < channels; c++ ) {
+					double sum = 0.0;
+					for ( unsigned int k = 0; k < length && k <= n; k++ ) sum += response[k] * input[ ( n - k ) * channels + c ];
+					expected[ n * channels + c ] = sum;
+				}
+			}
+
+			Convolver convolver( response.data(), length, blockSize, channels );
+			Rocket_UnitTest_Check_Equal( convolver.partitionCount(), ( length + blockSize - 1 ) / blockSize );
+			std::vector< double > output( input.size() );
+			for ( unsigned int b = 0; b < blocks; b++ ) {
+				Rocket_UnitTest_Check_NoAllocations( convolver.process( &input[ b * blockSize * channels ], &output[ b * blockSize * channels ] ) );
+			}
+			double maxError = 0.0;
+			for ( unsigned int i = 0; i < output.size(); i++ ) maxError = std::max( maxError, fabs( output[i] - expected[i] ) );
+			Rocket_UnitTest_Check_Expression( maxError < 1e-11 * ( 1.0 + sqrt( double( length ) ) ) );
+
+			// In place, after reset()
+			convolver.reset();
+			for ( unsigned int b = 0; b < blocks; b++ ) convolver.process( &input[ b * blockSize * channels ], &input[ b * blockSize * channels ] );
+			maxError = 0.0;
+			for ( unsigned int i = 0; i < output.size(); i++ ) maxError = std::max( maxError, fabs( input[i] - output[i] ) );
+			Rocket_UnitTest_Check_Expression( maxError < 1e-12 );
+		}
+	}
+}
@@ -0,0 +1,153 @@
+#include "rocket/UnitTest.h"
+
+#include <math.h>
+#include <vector>
+
+#include "fixedmath.h"
+
+using namespace Rocket::Core;
+
+// Errors are measured in units of the last place (2^-16 for fixed16_16)
+static const double FixedMath_Ulp = 1.0 / 65536.0;
+
+// Raw fixed16_16 values from first to last in steps of step (always including last)
+static std::vector< fixed16_16 > FixedMath_Sweep( int32_t first, int32_t last, int32_t step ) {
+	std::vector< fixed16_16 > values;
+	for ( int64_t raw = first; raw <= last; raw += step ) values.push_back( fixed16_16::fromRaw( int32_t( raw ) ) );
+	values.push_back( fixed16_16::fromRaw( last ) );
+	return values;
+}
+
+// Number of values where the batch function differs from the scalar function
+static unsigned int FixedMath_BatchMismatches( const std::vector< fixed16_16 > & batch, const std::vector< fixed16_16 > & scalar ) {
+	unsigned int mismatches = 0;
+	for ( unsigned int i = 0; i < batch.size(); i++ ) {
+		if ( batch[i] != scalar[i] ) mismatches++;
+	}
+	return mismatches;
+}
+
+Rocket_UnitTest( FixedMath_sqrt ) {
+	std::vector< fixed16_16 > in = FixedMath_Sweep( -65536, 0x7fffffff, 997 );
+	std::vector< fixed16_16 > scalar( in.size() ), batch( in.size() );
+
+	// The result is exact: r * r <= x < ( r + 1 ) * ( r + 1 )
+	unsigned int wrong = 0;
+	for ( unsigned int i = 0; i < in.size(); i++ ) {
+		scalar[i] = FixedMath::sqrt( in[i] );
+		uint64_t x = ( in[i].m_value < 0 ) ? 0 : uint64_t( in[i].m_value ) << 16;
+		uint64_t r = uint64_t( scalar[i].m_value );
+		if ( r * r > x || ( r + 1 ) * ( r + 1 ) <= x ) wrong++;
+	}
+	Rocket_UnitTest_Check_Equal( wrong, 0u );
+
+	FixedMath::sqrt( &in[0], &batch[0], (unsigned int)in.size() );
+	Rocket_UnitTest_Check_Equal( FixedMath_BatchMismatches( batch, scalar ), 0u );
+
+	Rocket_UnitTest_Check_Expression( FixedMath::sqrt( fixed16_16( 16 ) ) == fixed16_16( 4 ) );
+	Rocket_UnitTest_Check_Expression( fabs( FixedMath::sqrt( fixed32_32( 2 ) ).toDouble() - 1.4142135623730951 ) < 1e-9 );
+	Rocket_UnitTest_Check_Expression( FixedMath::sqrt( fixed16_16( -4 ) ) == fixed16_16( 0 ) );
+}
+
+Rocket_UnitTest( FixedMath_rsqrt ) {
+	std::vector< fixed16_16 > in = FixedMath_Sweep( 1, 0x7fffffff, 997 );
+	double maxError = 0.0;
+	for ( unsigned int i = 0; i < in.size(); i++ ) {
+		double error = fabs( FixedMath::rsqrt( in[i] ).toDouble() - 1.0 / ::sqrt( in[i].toDouble() ) );
+		if ( error > maxError ) maxError = error;
+	}
+	Rocket_UnitTest_Check_Expression( maxError <= FixedMath_Ulp );
+	Rocket_UnitTest_Check_Expression( FixedMath::rsqrt( fixed16_16( 0.25 ) ) == fixed16_16( 2 ) );
+	Rocket_UnitTest_Check_Expression( fabs( FixedMath::rsqrt( fixed32_32( 2 ) ).toDouble() - 0.7071067811865476 ) < 1e-9 );
+}
+
+Rocket_UnitTest( FixedMath_sincos ) {
+	// Every 97th angle in [-1024, 1024] radians
+	std::vector< fixed16_16 > in = FixedMath_Sweep( -1024 * 65536, 1024 * 65536, 97 );
+	std::vector< fixed16_16 > scalarSin( in.size() ), scalarCos( in.size() ), batchSin( in.size() ), batchCos( in.size() );
+
+	double maxError = 0.0;
+	for ( unsigned int i = 0; i < in.size(); i++ ) {
+		FixedMath::sincos( in[i], scalarSin[i], scalarCos[i] );
+		double sinError = fabs( scalarSin[i].toDouble() - ::sin( in[i].toDouble() ) );
+		double cosError = fabs( scalarCos[i].toDouble() - ::cos( in[i].toDouble() ) );
+		if ( sinError > maxError ) maxError = sinError;
+		if ( cosError > maxError ) maxError = cosError;
+	}
+	Rocket_UnitTest_Check_Expression( maxError <= FixedMath_Ulp );
+
+	FixedMath::sincos( &in[0], &batchSin[0], &batchCos[0], (unsigned int)in.size() );
+	Rocket_UnitTest_Check_Equal( FixedMath_BatchMismatches( batchSin, scalarSin ), 0u );
+	Rocket_UnitTest_Check_Equal( FixedMath_BatchMismatches( batchCos, scalarCos ), 0u );
+	FixedMath::sin( &in[0], &batchSin[0], (unsigned int)in.size() );
+	FixedMath::cos( &in[0], &batchCos[0], (unsigned int)in.size() );
+	Rocket_UnitTest_Check_Equal( FixedMath_BatchMismatches( batchSin, scalarSin ), 0u );
+	Rocket_UnitTest_Check_Equal( FixedMath_BatchMismatches( batchCos, scalarCos ), 0u );
+
+	Rocket_UnitTest_Check_Expression( FixedMath::sin( fixed16_16( 0 ) ) == fixed16_16( 0 ) );
+	Rocket_UnitTest_Check_Expression( FixedMath::cos( fixed16_16( 0 ) ) == fixed16_16( 1 ) );
+	Rocket_UnitTest_Check_Expression( fabs( FixedMath::sin( fixed32_32( 1 ) ).toDouble() - 0.8414709848078965 ) < 1e-9 );
+	Rocket_UnitTest_Check_Expression( fabs( FixedMath::cos( fixed32_32( -100 ) ).toDouble() - 0.8623188722876839 ) < 1e-9 );
+}
+
+Rocket_UnitTest( FixedMath_atan2 ) {
+	// Grid of points, including the axes and both extremes
+	std::vector< fixed16_16 > coordinates = FixedMath_Sweep( -0x7fffffff, 0x7fffffff, 0x7fffffff / 150 );
+	coordinates.push_back( fixed16_16( 0 ) );
+	coordinates.push_back( fixed16_16::epsilon() );
+	coordinates.push_back( -fixed16_16::epsilon() );
+	std::vector< fixed16_16 > y, x;
+	for ( unsigned int i = 0; i < coordinates.size(); i++ ) {
+		for ( unsigned int j = 0; j < coordinates.size(); j++ ) {
+			y.push_back( coordinates[i] );
+			x.push_back( fixed16_16::fromRaw( coordinates[j].m_value / ( 1 + int32_t( j % 7 ) * 1000 ) ) );
+		}
+	}
+	std::vector< fixed16_16 > scalar( y.size() ), batch( y.size() );
+
+	double maxError = 0.0;
+	for ( unsigned int i = 0; i < y.size(); i++ ) {
+		scalar[i] = FixedMath::atan2( y[i], x[i] );
+		double error = fabs( scalar[i].toDouble() - ::atan2( y[i].toDouble(), x[i].toDouble() ) );
+		if ( error > maxError ) maxError = error;
+	}
+	Rocket_UnitTest_Check_Expression( maxError <= FixedMath_Ulp );
+
+	FixedMath::atan2( &y[0], &x[0], &batch[0], (unsigned int)y.size() );
+	Rocket_UnitTest_Check_Equal( FixedMath_BatchMismatches( batch, scalar ), 0u );
+
+	Rocket_UnitTest_Check_Expression( FixedMath::atan2( fixed16_16( 0 ), fixed16_16( 0 ) ) == fixed16_16( 0 ) );
+	Rocket_UnitTest_Check_Expression( fabs( FixedMath::atan2( fixed32_32( 1 ), fixed32_32( -1 ) ).toDouble() - 2.356194490192345 ) < 1e-9 );
+}
+
+Rocket_UnitTest( FixedMath_exp ) {
+	// exp overflows fixed16_16 just above 10.39 and rounds to 0 below -11.8
+	std::vector< fixed16_16 > in = FixedMath_Sweep( -16 * 65536, 10 * 65536, 13 );
+	// Absolute error below 1, relative error above
+	double maxError = 0.0;
+	for ( unsigned int i = 0; i < in.size(); i++ ) {
+		double expected = ::exp( in[i].toDouble() );
+		double error = fabs( FixedMath::exp( in[i] ).toDouble() - expected ) / ( expected > 1.0 ? expected : 1.0 );
+		if ( error > maxError ) maxError = error;
+	}
+	Rocket_UnitTest_Check_Expression( maxError <= FixedMath_Ulp );
+
+	Rocket_UnitTest_Check_Expression( FixedMath::exp( fixed16_16( 0 ) ) == fixed16_16( 1 ) );
+	Rocket_UnitTest_Check_Expression( FixedMath::exp( fixed16_16( 11 ) ) == fixed16_16::maximum() );
+	Rocket_UnitTest_Check_Expression( FixedMath::exp( fixed16_16( -100 ) ) == fixed16_16( 0 ) );
+	Rocket_UnitTest_Check_Expression( fabs( FixedMath::exp( fixed32_32( 1 ) ).toDouble() - 2.718281828459045 ) < 1e-9 );
+}
+
+Rocket_UnitTest( FixedMath_log ) {
+	std::vector< fixed16_16 > in = FixedMath_Sweep( 1, 0x7fffffff, 997 );
+	double maxError = 0.0;
+	for ( unsigned int i = 0; i < in.size(); i++ ) {
+		double error = fabs( FixedMath::log( in[i] ).toDouble() - ::log( in[i].toDouble() ) );
+		if ( error > maxError ) maxError = error;
+	}
+	Rocket_UnitTest_Check_Expression( maxError <= FixedMath_Ulp );
+
+	Rocket_UnitTest_Check_Expression( FixedMath::log( fixed16_16( 1 ) ) == fixed16_16( 0 ) );
+	Rocket_UnitTest_Check_Expression( FixedMath::log( fixed16_16( 0 ) ) == fixed16_16::minimum() );
+	Rocket_UnitTest_Check_Expression( fabs( FixedMath::log( fixed32_32( 10 ) ).toDouble() - 2.302585092994046 ) < 1e-9 );
+}
@@ -63,4 +63,61 @@ Rocket_UnitTest( fixedpoint_OtherFunctions ) {
 
 Rocket_UnitTest( fixedpoint_StringFunctions ) {
 	Rocket_UnitTest_Check_CharStringEqual( fixedpoint(123.456f).toString().c_str(), "123.456" );
-}
\ No newline at end of file
+}
+
+Rocket_UnitTest( fixed_BasicMath ) {
+	// Conversions are resolved at compile time
+	static_assert( fixed16_16( 1.5 ).m_value == 3 << 15, "fixed16_16( 1.5 ) should be evaluated at compile time" );
+	static_assert( ( fixed16_16( 2 ) * fixed16_16( -0.25 ) ).toDouble() == -0.5, "fixed16_16 multiplication should be constexpr" );
+	static_assert( fixed16_16( 3 ) > fixed16_16( 2.5f ), "fixed16_16 comparison should be constexpr" );
+
+	fixed16_16 x = 0;
+	x -= 10;
+	Rocket_UnitTest_Check_FloatEqual( x.toFloat(), -10.0f, 0.0001f );
+	x += 10.1337f;
+	Rocket_UnitTest_Check_FloatEqual( x.toFloat(), 0.1337f, 0.0001f );
+	x /= 0.1337f;
+	Rocket_UnitTest_Check_FloatEqual( x.toFloat(), 1.0f, 0.001f );
+
+	x = fixed16_16( 5.5 ) * fixed16_16( -3 );
+	Rocket_UnitTest_Check_Expression( x == fixed16_16( -16.5 ) );
+	x = fixed16_16( 7 ) / fixed16_16( 2 );
+	Rocket_UnitTest_Check_Expression( x == fixed16_16( 3.5 ) );
+	Rocket_UnitTest_Check_Expression( -x < x );
+	Rocket_UnitTest_Check_Expression( x >= fixed16_16( 3.5 ) );
+	Rocket_UnitTest_Check_Expression( x != fixed16_16( 3.5 ) + fixed16_16::epsilon() );
+
+	// 64-bit formats use 128-bit intermediates
+	fixed32_32 big = 40000;
+	big = big * big / fixed32_32( 1000 );
+	Rocket_UnitTest_Check_Equal( big.toInt(), 1600000 );
+
+	// Rounding
+	Rocket_UnitTest_Check_FloatEqual( fixed16_16( 123.456 ).floor().toFloat(), 123.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( fixed16_16( 123.456 ).ceiling().toFloat(), 124.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( fixed16_16( 123.654 ).round().toFloat(), 124.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( fixed16_16( -1.25 ).floor().toFloat(), -2.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( fixed16_16( -1.25 ).ceiling().toFloat(), -1.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( fixed16_16( -1.25 ).abs().toFloat(), 1.25f, 0.0001f );
+	Rocket_UnitTest_Check_Equal( fixed16_16( -1.25 ).toInt(), -2 );
+
+	// Format conversion
+	fixed32_32 wide = fixed32_32( fixed16_16( -2.75 ) );
+	Rocket_UnitTest_Check_FloatEqual( wide.toFloat(), -2.75f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( fixed16_16( wide ).toFloat(), -2.75f, 0.0001f );
+
+	Rocket_UnitTest_Check_CharStringEqual( fixed16_16( 0.5 ).toString().c_str(), "0.5" );
+}
+
+Rocket_UnitTest( fixedpoint_Compatibility ) {
+	// Base factor constructor: value = baseFactor * scalingFactor / 10^precision
+	Rocket_UnitTest_Check_FloatEqual( fixedpoint( 12345, 1, 2 ).toValue(), 123.45f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( fixedpoint( 12345, 10, 4 ).toValue(), 12.345f, 0.0001f );
+
+	fixedpoint x( 2.5f );
+	Rocket_UnitTest_Check_Expression( x.value() == fixed32_32( 2.5 ) );
+	fixedpoint y = x.convert( 100, 2 );
+	Rocket_UnitTest_Check_Equal( y.getScalingFactor(), 100 );
+	Rocket_UnitTest_Check_Expression( x == y );
+	Rocket_UnitTest_Check_FloatEqual( fixedpoint::sqrt( 16.0f ), 4.0f, 0.0001f );
+}
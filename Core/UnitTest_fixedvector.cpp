@@ -0,0 +1,140 @@
+#include "rocket/UnitTest.h"
+
+#include <math.h>
+
+#include "fixedvector.h"
+
+using namespace Rocket::Core;
+
+// Deterministic pseudo-random fixed16_16 values in [-range, range)
+static fixed16_16 FixedVector_Random( uint32_t & state, int range ) {
+	state = state * 1664525u + 1013904223u;
+	return fixed16_16::fromRaw( int32_t( int64_t( state >> 8 ) * range * 2 * 65536 / ( 1 << 24 ) - int64_t( range ) * 65536 ) );
+}
+
+Rocket_UnitTest( FixedVector_vec ) {
+	fvec3 a( 1, 2.5, -3 );
+	fvec3 b( 0.5f, -1, 4 );
+
+	Rocket_UnitTest_Check_Expression( a + b == fvec3( 1.5, 1.5, 1 ) );
+	Rocket_UnitTest_Check_Expression( a - b == fvec3( 0.5, 3.5, -7 ) );
+	Rocket_UnitTest_Check_Expression( -a == fvec3( -1, -2.5, 3 ) );
+	Rocket_UnitTest_Check_Expression( a * fixed16_16( 2 ) == fvec3( 2, 5, -6 ) );
+	Rocket_UnitTest_Check_Expression( 2 * a == a * 2 );
+	Rocket_UnitTest_Check_Expression( a / fixed16_16( 2 ) == fvec3( 0.5, 1.25, -1.5 ) );
+	Rocket_UnitTest_Check_Expression( dot( a, b ) == fixed16_16( -14 ) );
+	Rocket_UnitTest_Check_Expression( cross( a, b ) == fvec3( 7, -5.5, -2.25 ) );
+	Rocket_UnitTest_Check_Expression( fvec3( 3, 0, 4 ).length() == fixed16_16( 5 ) );
+	Rocket_UnitTest_Check_Expression( normalize( fvec2( 0, -8 ) ) == fvec2( 0, -1 ) );
+
+	fvec3 c = a;
+	c += b;
+	c -= a;
+	Rocket_UnitTest_Check_Expression( c == b );
+	c *= fixed16_16( 0.5 );
+	Rocket_UnitTest_Check_Expression( c == fvec3( 0.25, -0.5, 2 ) );
+
+	// Conversion to and from float vectors
+	vec3 f = a.toFloat();
+	Rocket_UnitTest_Check_Expression( f == vec3( 1.0f, 2.5f, -3.0f ) );
+	Rocket_UnitTest_Check_Expression( fvec3( f ) == a );
+
+	// 64-bit formats take the scalar path
+	T_vec< fixed32_32, 3 > wide( 1, 2, 2 );
+	Rocket_UnitTest_Check_Expression( wide.length() == fixed32_32( 3 ) );
+	Rocket_UnitTest_Check_Expression( dot( wide, wide ) == fixed32_32( 9 ) );
+}
+
+Rocket_UnitTest( FixedVector_mat ) {
+	uint32_t state = 12345;
+
+	// M * V and M * M match the scalar dot products bit for bit (the SIMD kernels only change how they are computed)
+	unsigned int mismatches = 0;
+	for ( unsigned int test = 0; test < 200; test++ ) {
+		fmat4 a, b;
+		fvec4 v;
+		int range = ( test % 2 == 0 ) ? 4 : 180;
+		for ( unsigned int r = 0; r < 4; r++ ) {
+			v[r] = FixedVector_Random( state, range );
+			for ( unsigned int c = 0; c < 4; c++ ) {
+				a( r, c ) = FixedVector_Random( state, range );
+				b( r, c ) = FixedVector_Random( state, range );
+			}
+		}
+
+		fvec4 av = a * v;
+		fmat4 ab = a * b;
+		fmat4 bt = b.transposed();
+		for ( unsigned int r = 0; r < 4; r++ ) {
+			if ( av[r] != FixedLinear::dot( a.m_matrix[r], v.m_elements, 4 ) ) mismatches++;
+			for ( unsigned int c = 0; c < 4; c++ ) {
+				if ( ab( r, c ) != FixedLinear::dot( a.m_matrix[r], bt.m_matrix[c], 4 ) ) mismatches++;
+			}
+		}
+
+		// Batch transform
+		fvec4 batch[3] = { v, -v, v * fixed16_16( 0.25 ) };
+		transform( a, batch, batch, 3 );
+		if ( batch[0] != av || batch[1] != a * -v || batch[2] != a * ( v * fixed16_16( 0.25 ) ) ) mismatches++;
+	}
+	Rocket_UnitTest_Check_Equal( mismatches, 0u );
+
+	// An empty batch does not touch its arrays
+	transform( fmat4(), nullptr, nullptr, 0 );
+
+	// Agreement with float matrices
+	mat4 fm = Translate( vec3( 1.0f, -2.0f, 3.0f ) ) * Rotate( 0.7f, vec3( 0.0f, 0.0f, 1.0f ) ) * Scale( vec3( 2.0f, 2.0f, 2.0f ) );
+	fmat4 m( fm );
+	vec4 fp( 0.5f, -1.5f, 2.0f, 1.0f );
+	vec4 expected = fm * fp;
+	vec4 result = ( m * fvec4( fp ) ).toFloat();
+	for ( unsigned int i = 0; i < 4; i++ ) Rocket_UnitTest_Check_Expression( fabs( result[i] - expected[i] ) < 0.0005f );
+
+	fmat3 identity;
+	fvec3 p( 1, 2, 3 );
+	Rocket_UnitTest_Check_Expression( identity * p == p );
+	Rocket_UnitTest_Check_Expression( fmat3( 0, 1, 0, 1, 0, 0, 0, 0, 1 ) * p == fvec3( 2, 1, 3 ) );
+	Rocket_UnitTest_Check_Expression( m * fmat4() == m );
+}
+
+Rocket_UnitTest( FixedVector_quat ) {
+	fquat a( fixed16_16( 0.8 ), fvec3( 1, 2, 3 ) );
+	fquat b( fixed16_16( -1.3 ), fvec3( 0, 1, 0 ) );
+	quat fa( 0.8f, vec3( 1, 2, 3 ) );
+	quat fb( -1.3f, vec3( 0, 1, 0 ) );
+
+	quat ab = ( a * b ).toFloat();
+	quat fab = fa * fb;
+	Rocket_UnitTest_Check_Expression( fabs( ab.x() - fab.x() ) < 0.0002f );
+	Rocket_UnitTest_Check_Expression( fabs( ab.y() - fab.y() ) < 0.0002f );
+	Rocket_UnitTest_Check_Expression( fabs( ab.z() - fab.z() ) < 0.0002f );
+	Rocket_UnitTest_Check_Expression( fabs( ab.w() - fab.w() ) < 0.0002f );
+
+	vec3 rotated = ( a * fvec3( 1, 0, -2 ) ).toFloat();
+	vec3 expected = fa * vec3( 1.0f, 0.0f, -2.0f );
+	Rocket_UnitTest_Check_Expression( fabs( rotated.x() - expected.x() ) < 0.0005f );
+	Rocket_UnitTest_Check_Expression( fabs( rotated.y() - expected.y() ) < 0.0005f );
+	Rocket_UnitTest_Check_Expression( fabs( rotated.z() - expected.z() ) < 0.0005f );
+
+	fquat identity = a * a.conjugate();
+	Rocket_UnitTest_Check_Expression( fabs( identity.w().toFloat() - 1.0f ) < 0.0001f );
+	Rocket_UnitTest_Check_Expression( fvec3( identity.x(), identity.y(), identity.z() ).length() < fixed16_16( 0.0001 ) );
+	Rocket_UnitTest_Check_Expression( fquat( fa ) == fquat( fa.x(), fa.y(), fa.z(), fa.w() ) );
+	Rocket_UnitTest_Check_Expression( fquat( fixed16_16( 1 ), fvec3( 0, 0, 0 ) ) == fquat() );
+}
+
+Rocket_UnitTest( FixedVector_wide ) {
+	// An acceleration of 1e-7 per ms^2 over a 16 ms frame is below fixed16_16's resolution but not fixed32_32's
+	fvec3_32 v( 0, 0, 0.001 );
+	fvec3_32 a( vec3( 1e-7f, -1e-7f, 0 ) );
+	for ( int i = 0; i < 100; i++ ) v += a * fixed32_32( 16.0f );
+	// 1e-7 is stored to within 2^-33, about 0.1% of it
+	Rocket_UnitTest_Check_FloatEqual( v.x().toFloat(), 1.6e-4f, 2e-7f );
+	Rocket_UnitTest_Check_FloatEqual( v.y().toFloat(), -1.6e-4f, 2e-7f );
+	Rocket_UnitTest_Check_FloatEqual( v.z().toFloat(), 0.001f, 1e-9f );
+	Rocket_UnitTest_Check_Expression( fvec3( vec3( 1e-7f, -1e-7f, 0 ) ) * fixed16_16( 16.0f ) == fvec3( 0, 0, 0 ) );
+
+	fquat_32 q( fixed32_32( 1e-6 ), fvec3_32( 0, 0, 1 ) );
+	Rocket_UnitTest_Check_FloatEqual( q.z().toFloat(), 5e-7f, 1e-9f );
+	Rocket_UnitTest_Check_FloatEqual( q.w().toFloat(), 1.0f, 1e-9f );
+}
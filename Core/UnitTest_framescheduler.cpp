@@ -0,0 +1,60 @@
+#include "rocket/UnitTest.h"
+
+#include <math.h>
+
+#include "framescheduler.h"
+#include "timer.h"
+
+using namespace Rocket::Core;
+
+Rocket_UnitTest( FrameScheduler_Steps ) {
+	FrameScheduler scheduler( 100.0, 0.0, 4 );
+	unsigned long long step = scheduler.stepNanoseconds();
+	Rocket_UnitTest_Check_Equal( step, 10000000ull );
+	Rocket_UnitTest_Check_Expression( fabs( scheduler.stepMilliseconds() - 10.0f ) < 1e-6f );
+
+	// Whole steps are taken from the accumulator, and the remainder is the interpolation alpha
+	Rocket_UnitTest_Check_Equal( scheduler.advance( step / 4 ), 0u );
+	Rocket_UnitTest_Check_Expression( fabs( scheduler.alpha() - 0.25 ) < 1e-12 );
+	Rocket_UnitTest_Check_Equal( scheduler.advance( step * 2 ), 2u );
+	Rocket_UnitTest_Check_Expression( fabs( scheduler.alpha() - 0.25 ) < 1e-12 );
+	Rocket_UnitTest_Check_Equal( scheduler.advance( step * 3 / 4 ), 1u );
+	Rocket_UnitTest_Check_Expression( scheduler.alpha() == 0.0 );
+
+	// A long frame runs at most maxSteps steps, and the rest of its time is dropped
+	Rocket_UnitTest_Check_Equal( scheduler.advance( step * 10 + step / 2 ), 4u );
+	Rocket_UnitTest_Check_Expression( fabs( scheduler.alpha() - 0.5 ) < 1e-12 );
+	Rocket_UnitTest_Check_Equal( scheduler.stats().droppedNanoseconds, step * 6 );
+
+	// The simulation rate does not depend on the render rate
+	FrameScheduler fast( 100.0, 0.0 );
+	unsigned int steps = 0;
+	for ( unsigned int frame = 0; frame < 144; frame++ ) steps += fast.advance( 1000000000ull / 144 );
+	Rocket_UnitTest_Check_Equal( steps, 99u );
+}
+
+Rocket_UnitTest( FrameScheduler_Pacing ) {
+	// Waits end shortly after their deadline, whatever the resolution of sleeping
+	FrameScheduler scheduler( 120.0, 250.0 );
+	unsigned long long late = 0;
+	for ( unsigned int i = 0; i < 5; i++ ) {
+		unsigned long long deadline = timer_ns() + 3000000ull;
+		scheduler.waitUntil( deadline );
+		unsigned long long now = timer_ns();
+		Rocket_UnitTest_Check_Expression( now >= deadline );
+		late += now - deadline;
+	}
+	Rocket_UnitTest_Check_Expression( late / 5 < 500000ull );
+
+	// Frames are paced to the render period
+	scheduler.reset();
+	unsigned int steps = 0;
+	for ( unsigned int frame = 0; frame < 50; frame++ ) steps += scheduler.beginFrame();
+	FrameStats stats = scheduler.stats();
+	Rocket_UnitTest_Check_Equal( stats.frames, 50ull );
+	Rocket_UnitTest_Check_Expression( stats.mean > 3900000ull && stats.mean < 4500000ull );
+	Rocket_UnitTest_Check_Expression( stats.min <= stats.mean && stats.mean <= stats.max && stats.p99 <= stats.max );
+	Rocket_UnitTest_Check_Expression( stats.last >= stats.min && stats.last <= stats.max );
+	// 50 frames of 4 ms are 200 ms, or 24 steps at 120 Hz
+	Rocket_UnitTest_Check_Expression( steps >= 23 && steps <= 27 );
+}
@@ -0,0 +1,184 @@
+#include "rocket/UnitTest.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hashmap.h"
+#include "rstring.h"
+#include "UnitTest_liveitem.h"
+
+using namespace Rocket::Core;
+
+// All keys hash to one of two values, so that groups fill up and searches go on past them
+struct HashMapTest_BadHash {
+	size_t operator () ( int key ) const { return (size_t)( key & 1 ); }
+};
+
+Rocket_UnitTest( HashMap_Basics ) {
+	FlatHashMap< int, int > table;
+	Rocket_UnitTest_Check_Expression( table.empty() );
+	Rocket_UnitTest_Check_Equal( table.capacity(), 0u );
+	Rocket_UnitTest_Check_Expression( table.find( 1 ) == table.end() );
+	Rocket_UnitTest_Check_Expression( table.begin() == table.end() );
+	Rocket_UnitTest_Check_Equal( table.erase( 1 ), 0u );
+
+	Rocket_UnitTest_Check_Expression( table.insert( std::make_pair( 1, 10 ) ).second );
+	Rocket_UnitTest_Check_Expression( table.insert( std::make_pair( 1, 20 ) ).second == false );
+	Rocket_UnitTest_Check_Equal( table[ 1 ], 10 );
+	table[ 2 ] = 20;
+	Rocket_UnitTest_Check_Equal( table.size(), 2u );
+	Rocket_UnitTest_Check_Equal( table.find( 2 )->second, 20 );
+	Rocket_UnitTest_Check_Equal( table.count( 3 ), 0u );
+	Rocket_UnitTest_Check_Expression( table.try_emplace( 3, 30 ).second );
+	Rocket_UnitTest_Check_Equal( table.count( 3 ), 1u );
+
+	// Grows past many groups, and keeps every element
+	for ( int i = 0; i < 10000; i++ ) table[ i ] = i * 3;
+	Rocket_UnitTest_Check_Equal( table.size(), 10000u );
+	Rocket_UnitTest_Check_Expression( table.size() <= table.capacity() - table.capacity() / 8 );
+	int wrong = 0;
+	for ( int i = 0; i < 10000; i++ ) {
+		auto found = table.find( i );
+		if ( found == table.end() || found->first != i || found->second != i * 3 ) wrong++;
+	}
+	Rocket_UnitTest_Check_Equal( wrong, 0 );
+	Rocket_UnitTest_Check_Expression( table.find( -1 ) == table.end() );
+
+	// Iteration visits every element once
+	long long sum = 0;
+	size_t visited = 0;
+	for ( auto & element : table ) {
+		sum += element.second;
+		visited++;
+	}
+	Rocket_UnitTest_Check_Equal( visited, 10000u );
+	Rocket_UnitTest_Check_Equal( sum, 3ll * 9999 * 10000 / 2 );
+
+	// Lookups and overwrites do not allocate
+	Rocket_UnitTest_Check_NoAllocations( table.find( 500 ); table[ 600 ] = 1; table.count( 20000 ) );
+
+	table.clear();
+	Rocket_UnitTest_Check_Expression( table.empty() );
+	Rocket_UnitTest_Check_Expression( table.find( 5 ) == table.end() );
+	Rocket_UnitTest_Check_Expression( table.capacity() > 0 );
+}
+
+Rocket_UnitTest( HashMap_Erase ) {
+	// Erasing while iterating visits the rest, and the other elements stay where they are
+	FlatHashMap< int, int > table;
+	for ( int i = 0; i < 1000; i++ ) table[ i ] = i;
+	int * kept = &table.find( 1 )->second;
+	for ( auto iter = table.begin(); iter != table.end(); ) {
+		if ( iter->first % 2 == 0 ) {
+			iter = table.erase( iter );
+		} else {
+			iter++;
+		}
+	}
+	Rocket_UnitTest_Check_Equal( table.size(), 500u );
+	Rocket_UnitTest_Check_Expression( kept == &table.find( 1 )->second );
+	Rocket_UnitTest_Check_Expression( table.find( 2 ) == table.end() );
+	Rocket_UnitTest_Check_Equal( table.erase( 3 ), 1u );
+	Rocket_UnitTest_Check_Equal( table.erase( 3 ), 0u );
+
+	// Deleted slots are reused, so churn at a steady size does not grow a table whose groups fill up
+	FlatHashMap< int, int, HashMapTest_BadHash > crowded;
+	for ( int i = 0; i < 100; i++ ) crowded[ i ] = i;
+	size_t capacity = crowded.capacity();
+	for ( int i = 100; i < 5000; i++ ) {
+		crowded.erase( i - 100 );
+		crowded[ i ] = i;
+	}
+	Rocket_UnitTest_Check_Equal( crowded.size(), 100u );
+	Rocket_UnitTest_Check_Equal( crowded.capacity(), capacity );
+	int wrong = 0;
+	for ( int i = 4900; i < 5000; i++ ) {
+		if ( crowded.find( i ) == crowded.end() ) wrong++;
+	}
+	Rocket_UnitTest_Check_Equal( wrong, 0 );
+	Rocket_UnitTest_Check_Expression( crowded.find( 4899 ) == crowded.end() );
+
+	// Same results as std::unordered_map under random inserts and erases
+	FlatHashMap< unsigned int, unsigned int > flat;
+	std::unordered_map< unsigned int, unsigned int > reference;
+	unsigned int random = 12345;
+	for ( int i = 0; i < 100000; i++ ) {
+		random = random * 1664525u + 1013904223u;
+		unsigned int key = ( random >> 8 ) % 3000;
+		if ( random & 0x80 ) {
+			flat[ key ] = i;
+			reference[ key ] = i;
+		} else {
+			Rocket_UnitTest_Check_Equal( flat.erase( key ), reference.erase( key ) );
+		}
+	}
+	Rocket_UnitTest_Check_Equal( flat.size(), reference.size() );
+	wrong = 0;
+	for ( auto & element : reference ) {
+		auto found = flat.find( element.first );
+		if ( found == flat.end() || found->second != element.second ) wrong++;
+	}
+	Rocket_UnitTest_Check_Equal( wrong, 0 );
+}
+
+Rocket_UnitTest( HashMap_Strings ) {
+	// Heterogeneous lookup finds std::string keys from other strings, without building a std::string
+	FlatHashMap< std::string, int, StringHash, StringEqual > table;
+	table[ "127.0.0.1:9001" ] = 1;
+	table[ std::string( "10.0.0.2:9001" ) ] = 2;
+	rstring address( "10.0.0.2:9001" );
+	StringBuilder builder;
+	builder << "127.0.0.1:" << 9001;
+
+	Rocket_UnitTest_Check_Equal( table.find( "10.0.0.2:9001" )->second, 2 );
+	Rocket_UnitTest_Check_Equal( table.find( address )->second, 2 );
+	Rocket_UnitTest_Check_Equal( table.find( builder )->second, 1 );
+	Rocket_UnitTest_Check_Equal( table.find( StringKey( "127.0.0.1:90010", 14 ) )->second, 1 );
+	Rocket_UnitTest_Check_Expression( table.find( "127.0.0.1:900" ) == table.end() );
+	Rocket_UnitTest_Check_NoAllocations( table.find( builder ); table.find( "10.0.0.2:9001" ); table.count( address ) );
+	Rocket_UnitTest_Check_Equal( table.erase( builder ), 1u );
+	Rocket_UnitTest_Check_Equal( table.size(), 1u );
+
+	// Copies are deep and moves take the elements
+	FlatHashMap< std::string, int, StringHash, StringEqual > copy( table );
+	copy[ "other" ] = 3;
+	Rocket_UnitTest_Check_Equal( table.size(), 1u );
+	Rocket_UnitTest_Check_Equal( copy.size(), 2u );
+	FlatHashMap< std::string, int, StringHash, StringEqual > moved( std::move( copy ) );
+	Rocket_UnitTest_Check_Equal( moved.size(), 2u );
+	Rocket_UnitTest_Check_Expression( copy.empty() );
+	Rocket_UnitTest_Check_Equal( moved.find( "other" )->second, 3 );
+	copy = moved;
+	Rocket_UnitTest_Check_Equal( copy.find( "10.0.0.2:9001" )->second, 2 );
+}
+
+Rocket_UnitTest( HashMap_Nodes ) {
+	// Elements of a NodeHashMap stay where they are while the table grows
+	NodeHashMap< int, std::vector< int > > table;
+	std::vector< int > * first = &table[ 0 ];
+	first->push_back( 7 );
+	const int * firstKey = &table.find( 0 )->first;
+	for ( int i = 1; i < 5000; i++ ) table[ i ].push_back( i );
+	Rocket_UnitTest_Check_Expression( first == &table.find( 0 )->second );
+	Rocket_UnitTest_Check_Expression( firstKey == &table.find( 0 )->first );
+	Rocket_UnitTest_Check_Equal( ( *first )[0], 7 );
+	Rocket_UnitTest_Check_Equal( table.find( 4999 )->second[0], 4999 );
+
+	// Both kinds of table destroy their elements when erased, cleared and destroyed
+	{
+		NodeHashMap< int, UnitTest_LiveItem > nodes;
+		FlatHashMap< int, UnitTest_LiveItem > flat;
+		for ( int i = 0; i < 100; i++ ) {
+			nodes.try_emplace( i, i );
+			flat.try_emplace( i, i );
+		}
+		Rocket_UnitTest_Check_Equal( UnitTest_LiveItem::live(), 200 );
+		nodes.erase( 5 );
+		flat.erase( 5 );
+		Rocket_UnitTest_Check_Equal( UnitTest_LiveItem::live(), 198 );
+		flat.clear();
+		Rocket_UnitTest_Check_Equal( UnitTest_LiveItem::live(), 99 );
+	}
+	Rocket_UnitTest_Check_Equal( UnitTest_LiveItem::live(), 0 );
+}
@@ -0,0 +1,134 @@
+#include "rocket/UnitTest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "jobs.h"
+
+using namespace Rocket::Core;
+
+Rocket_UnitTest( Jobs_Run ) {
+	JobSystem jobs( 3 );
+	Rocket_UnitTest_Check_Equal( jobs.workerCount(), 3u );
+
+	std::atomic< unsigned int > count( 0 );
+	std::vector< JobHandle > handles;
+	for ( unsigned int i = 0; i < 1000; i++ ) {
+		handles.push_back( jobs.run( [ &count ] () { count++; } ) );
+	}
+	for ( auto handle : handles ) jobs.wait( handle );
+	Rocket_UnitTest_Check_Equal( count.load(), 1000u );
+	for ( auto handle : handles ) Rocket_UnitTest_Check_Expression( handle.done() );
+	Rocket_UnitTest_Check_Expression( JobHandle().done() );
+
+	// More jobs than a thread's pool: old jobs are reused once they are done
+	count = 0;
+	JobHandle last;
+	for ( unsigned int i = 0; i < 5 * JobSystem::PoolSize; i++ ) {
+		last = jobs.run( [ &count ] () { count++; } );
+	}
+	jobs.wait( last );
+	while ( count.load() < 5 * JobSystem::PoolSize ) jobs.wait( jobs.run( [] () {} ) );
+	Rocket_UnitTest_Check_Equal( count.load(), 5 * JobSystem::PoolSize );
+
+	// Jobs can be created and waited for without allocating
+	unsigned int value = 0;
+	Rocket_UnitTest_Check_NoAllocations( jobs.wait( jobs.run( [ &value ] () { value = 42; } ) ) );
+	Rocket_UnitTest_Check_Equal( value, 42u );
+
+	// Jobs can be queued by threads that are not part of the system
+	std::atomic< unsigned int > external( 0 );
+	std::thread thread( [ &jobs, &external ] () {
+		JobHandle handle;
+		for ( unsigned int i = 0; i < 100; i++ ) handle = jobs.run( [ &external ] () { external++; } );
+		jobs.wait( handle );
+	} );
+	thread.join();
+	while ( external.load() < 100 ) jobs.wait( jobs.run( [] () {} ) );
+	Rocket_UnitTest_Check_Equal( external.load(), 100u );
+
+	// Without workers, jobs run on the thread that waits
+	JobSystem alone( 0 );
+	unsigned int ran = 0;
+	JobHandle handle = alone.run( [ &ran ] () { ran++; } );
+	Rocket_UnitTest_Check_Expression( handle.done() == false );
+	alone.wait( handle );
+	Rocket_UnitTest_Check_Equal( ran, 1u );
+}
+
+Rocket_UnitTest( Jobs_Dependencies ) {
+	JobSystem jobs( 3 );
+
+	// Each job of a chain starts after the previous one is done
+	for ( unsigned int repeat = 0; repeat < 20; repeat++ ) {
+		std::vector< unsigned int > order;
+		std::mutex mutex;
+		JobHandle previous;
+		for ( unsigned int i = 0; i < 50; i++ ) {
+			previous = jobs.run( [ &order, &mutex, i ] () {
+				std::lock_guard< std::mutex > lock( mutex );
+				order.push_back( i );
+			}, previous );
+		}
+		jobs.wait( previous );
+		bool ordered = ( order.size() == 50 );
+		for ( unsigned int i = 0; i < order.size(); i++ ) {
+			if ( order[i] != i ) ordered = false;
+		}
+		Rocket_UnitTest_Check_Expression( ordered );
+	}
+
+	// A job that depends on several others, and more dependents of one job than fit in its continuations
+	std::atomic< unsigned int > stage( 0 ), wrong( 0 );
+	JobHandle first = jobs.run( [ &stage ] () { std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) ); stage++; } );
+	JobHandle dependents[ 10 ];
+	for ( unsigned int i = 0; i < 10; i++ ) {
+		dependents[i] = jobs.run( [ &stage, &wrong ] () { if ( stage.load() < 1 ) wrong++; stage++; }, first );
+	}
+	JobHandle joined = jobs.run( [ &stage, &wrong ] () { if ( stage.load() != 11 ) wrong++; }, dependents, 10 );
+	jobs.wait( joined );
+	Rocket_UnitTest_Check_Equal( wrong.load(), 0u );
+	Rocket_UnitTest_Check_Equal( stage.load(), 11u );
+
+	// A dependency that is already done
+	unsigned int value = 0;
+	jobs.wait( jobs.run( [ &value ] () { value++; }, first ) );
+	Rocket_UnitTest_Check_Equal( value, 1u );
+}
+
+Rocket_UnitTest( Jobs_ParallelFor ) {
+	JobSystem jobs( 3 );
+	const unsigned int count = 1000003;
+	std::vector< std::atomic< unsigned char > > visits( count );
+	for ( auto & visit : visits ) visit.store( 0 );
+	std::atomic< unsigned long long > sum( 0 );
+	jobs.parallel_for( 0, count, [ &visits, &sum ] ( unsigned int first, unsigned int last ) {
+		unsigned long long partial = 0;
+		for ( unsigned int i = first; i < last; i++ ) {
+			visits[i]++;
+			partial += i;
+		}
+		sum += partial;
+	} );
+	bool once = true;
+	for ( auto & visit : visits ) {
+		if ( visit.load() != 1 ) once = false;
+	}
+	Rocket_UnitTest_Check_Expression( once );
+	Rocket_UnitTest_Check_Equal( sum.load(), (unsigned long long)count * ( count - 1 ) / 2 );
+
+	// Small ranges, explicit grains, and an empty range
+	for ( unsigned int size = 0; size < 40; size++ ) {
+		std::atomic< unsigned int > covered( 0 );
+		jobs.parallel_for( 5, 5 + size, [ &covered ] ( unsigned int first, unsigned int last ) { covered += last - first; }, 1 + size % 3 );
+		Rocket_UnitTest_Check_Equal( covered.load(), size );
+	}
+
+	// Nested inside a job
+	std::atomic< unsigned int > inner( 0 );
+	jobs.wait( jobs.run( [ &jobs, &inner ] () {
+		jobs.parallel_for( 0, 1000, [ &inner ] ( unsigned int first, unsigned int last ) { inner += last - first; } );
+	} ) );
+	Rocket_UnitTest_Check_Equal( inner.load(), 1000u );
+}
@@ -0,0 +1,25 @@
+#ifndef Rocket_Core_UnitTest_LiveItem_H
+#define Rocket_Core_UnitTest_LiveItem_H
+
+#include <atomic>
+
+// Test item that counts its live instances, to check that containers destroy what they hold
+// The count is atomic, since queue tests create and destroy items on several threads
+struct UnitTest_LiveItem {
+	int value;
+	UnitTest_LiveItem( int v = 0 ) : value( v ) { count()++; }
+	UnitTest_LiveItem( const UnitTest_LiveItem & other ) : value( other.value ) { count()++; }
+	UnitTest_LiveItem & operator = ( const UnitTest_LiveItem & other ) { value = other.value; return *this; }
+	~UnitTest_LiveItem() { count()--; }
+
+	// Instances constructed and not yet destroyed, over every test
+	static int live() { return count().load(); }
+
+private:
+	static std::atomic< int > & count() {
+		static std::atomic< int > instances( 0 );
+		return instances;
+	}
+};
+
+#endif
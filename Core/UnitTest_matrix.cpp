@@ -115,3 +115,80 @@ Rocket_UnitTest ( VectorMath_mat4 ) {
 	Rocket_UnitTest_Check_FloatEqual( quat.w(), 0.73029f, 0.0001f );
 }
 
+
+Rocket_UnitTest ( VectorMath_mat4BatchTransform ) {
+	Rocket::Core::mat4 m = Rocket::Core::Translate( Rocket::Core::vec3( 1, 2, 3 ) ) * Rocket::Core::Rotate( 0.5f, Rocket::Core::vec3( 0, 1, 0 ) ) * Rocket::Core::Scale( Rocket::Core::vec3( 2, 3, 4 ) );
+	m(3,0) = 0.5f;		// non-affine bottom row
+
+	// Odd count to exercise the remainder paths
+	const unsigned int count = 7;
+	Rocket::Core::vec4 in[count];
+	for ( unsigned int i = 0; i < count; i++ ) in[i] = Rocket::Core::vec4( i * 1.0f, i * -2.0f, 0.5f, ( i % 2 ) * 1.0f );
+
+	Rocket::Core::vec4 out[count];
+	Rocket::Core::transform( m, in, out, count );
+	for ( unsigned int i = 0; i < count; i++ ) {
+		Rocket::Core::vec4 expected = m * in[i];
+		for ( unsigned int c = 0; c < 4; c++ ) Rocket_UnitTest_Check_FloatEqual( out[i][c], expected[c], 0.0001f );
+	}
+
+	Rocket::Core::transformAffine( m, in, out, count );
+	for ( unsigned int i = 0; i < count; i++ ) {
+		Rocket::Core::vec4 expected = m * in[i];
+		for ( unsigned int c = 0; c < 3; c++ ) Rocket_UnitTest_Check_FloatEqual( out[i][c], expected[c], 0.0001f );
+		Rocket_UnitTest_Check_FloatEqual( out[i].w(), in[i].w(), 0.0001f );
+	}
+
+	// The last vector of an odd count is rounded the same as the others
+	Rocket::Core::vec4 same[3] = { in[5], in[5], in[5] };
+	Rocket::Core::transform( m, same, same, 3 );
+	Rocket_UnitTest_Check_Expression( same[2] == same[0] );
+
+	// In place
+	Rocket::Core::vec4 inPlace[count];
+	for ( unsigned int i = 0; i < count; i++ ) inPlace[i] = in[i];
+	Rocket::Core::transform( m, inPlace, inPlace, count );
+	Rocket::Core::transform( m, in, out, count );
+	for ( unsigned int i = 0; i < count; i++ ) Rocket_UnitTest_Check_Expression( inPlace[i] == out[i] );
+
+	// Structure-of-arrays
+	Rocket::Core::vec4_batch batchIn( in, count );
+	Rocket::Core::vec4_batch batchOut;
+	Rocket::Core::transform( m, batchIn, batchOut );
+	for ( unsigned int i = 0; i < count; i++ ) {
+		for ( unsigned int c = 0; c < 4; c++ ) Rocket_UnitTest_Check_FloatEqual( batchOut[i][c], out[i][c], 0.0001f );
+	}
+
+	Rocket::Core::vec3_batch pointsIn( in, count );
+	Rocket::Core::vec3_batch pointsOut;
+	Rocket::Core::transformAffine( m, pointsIn, pointsOut );
+	for ( unsigned int i = 0; i < count; i++ ) {
+		Rocket::Core::vec4 expected = m * Rocket::Core::vec4( in[i].xyz(), 1.0f );
+		for ( unsigned int c = 0; c < 3; c++ ) Rocket_UnitTest_Check_FloatEqual( pointsOut[i][c], expected[c], 0.0001f );
+	}
+}
+
+Rocket_UnitTest( VectorMath_allocationFree ) {
+	using namespace Rocket::Core;
+
+	vec3 a( 1.0f, 2.0f, 3.0f );
+	vec4 b( 4.0f, 5.0f, 6.0f, 7.0f );
+	mat4 m = Translate( a ) * Scale( a );
+	mat4 r;
+	vec4 v;
+	vec3 w;
+	mat3 rows;
+
+	Rocket_UnitTest_Check_NoAllocations( v = vec4( a, 1.0f ) );
+	Rocket_UnitTest_Check_NoAllocations( v = vec4( b.xy(), 0.0f, 1.0f ) );
+	Rocket_UnitTest_Check_NoAllocations( v = vec4( b.xy(), a.xy() ) );
+	Rocket_UnitTest_Check_NoAllocations( w = b.xyz() + a.zyx() * 2.0f );
+	Rocket_UnitTest_Check_NoAllocations( w = cross( a, b.xyz() ).normalized() );
+	Rocket_UnitTest_Check_NoAllocations( rows = mat3( a, b.xyz(), a.zyx() ) );
+	Rocket_UnitTest_Check_NoAllocations( r = m * Rotate( 0.5f, a ) * m.inverse() );
+	Rocket_UnitTest_Check_NoAllocations( v = m * ( b - v ) );
+
+	Rocket_UnitTest_Check_FloatEqual( rows(1,0), 4.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( rows(2,0), 3.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( rows.minor( 0, 0 )(1,1), 1.0f, 0.0001f );
+}
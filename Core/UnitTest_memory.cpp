@@ -0,0 +1,128 @@
+#include "rocket/UnitTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "memory.h"
+#include "metrics.h"
+#include "allocators.h"
+
+using namespace Rocket::Core;
+
+// Constructed before its thread records an allocation, so destroyed after the thread's shard is released
+struct MemoryTest_ThreadLocal {
+	char * buffer = nullptr;
+	~MemoryTest_ThreadLocal() { Memory::deleteArray( MemoryTag::Audio, buffer, 64 ); }
+};
+
+// Tests use the Audio and Scene tags, which nothing else in Core allocates with, and check changes rather than totals
+Rocket_UnitTest( Memory_Accounting ) {
+	MemorySnapshot before = Memory::snapshot();
+	const MemorySnapshot::Tag & audio = before[ MemoryTag::Audio ];
+
+	double * samples = Memory::newArray< double >( MemoryTag::Audio, 1000 );
+	void * raw = Memory::allocate( MemoryTag::Audio, 24 );
+	Rocket_UnitTest_Check_Equal( Memory::liveBytes( MemoryTag::Audio ) - audio.liveBytes, 8024ll );
+	Rocket_UnitTest_Check_Expression( Memory::peakBytes( MemoryTag::Audio ) >= audio.liveBytes + 8024 );
+	Memory::deleteArray( MemoryTag::Audio, samples, 1000 );
+	Memory::deallocate( MemoryTag::Audio, raw, 24 );
+	Memory::deleteArray< double >( MemoryTag::Audio, nullptr, 1000 );
+
+	MemorySnapshot after = Memory::snapshot();
+	Rocket_UnitTest_Check_Equal( after[ MemoryTag::Audio ].liveBytes, audio.liveBytes );
+	Rocket_UnitTest_Check_Equal( after[ MemoryTag::Audio ].allocations - audio.allocations, 2ull );
+	Rocket_UnitTest_Check_Equal( after[ MemoryTag::Audio ].frees - audio.frees, 2ull );
+	Rocket_UnitTest_Check_Expression( after[ MemoryTag::Audio ].peakBytes >= audio.liveBytes + 8024 );
+
+	// Peaks start again from what is live
+	Memory::resetPeaks();
+	Rocket_UnitTest_Check_Equal( Memory::peakBytes( MemoryTag::Audio ), Memory::liveBytes( MemoryTag::Audio ) );
+
+	// Recording does not allocate
+	Rocket_UnitTest_Check_NoAllocations( Memory::recordAllocation( MemoryTag::Audio, 100 ); Memory::recordFree( MemoryTag::Audio, 100 ) );
+
+	// Shared arrays and containers give back what they took
+	long long scene = Memory::liveBytes( MemoryTag::Scene );
+	{
+		std::shared_ptr< double > shared( Memory::newArray< double >( MemoryTag::Scene, 64 ), tagged_array_deleter< double >( MemoryTag::Scene, 64 ) );
+		std::shared_ptr< double > copy = shared;
+		std::vector< int, TaggedAllocator< int, MemoryTag::Scene > > list;
+		for ( int i = 0; i < 1000; i++ ) list.push_back( i );
+		Rocket_UnitTest_Check_Expression( Memory::liveBytes( MemoryTag::Scene ) - scene >= 64 * 8 + 1000 * 4 );
+	}
+	Rocket_UnitTest_Check_Equal( Memory::liveBytes( MemoryTag::Scene ), scene );
+
+	// Threads allocating and freeing together leave the totals balanced
+	std::vector< std::thread > threads;
+	for ( unsigned int t = 0; t < 4; t++ ) {
+		threads.push_back( std::thread( [] () {
+			for ( unsigned int i = 0; i < 10000; i++ ) {
+				Memory::recordAllocation( MemoryTag::Scene, 16 );
+				Memory::recordFree( MemoryTag::Scene, 16 );
+			}
+		} ) );
+	}
+	for ( auto & thread : threads ) thread.join();
+	Rocket_UnitTest_Check_Equal( Memory::liveBytes( MemoryTag::Scene ), scene );
+
+	// Frees recorded by a thread's thread_local objects after its shard is released still count
+	unsigned long long frees = Memory::snapshot()[ MemoryTag::Audio ].frees;
+	std::thread( [] () {
+		static thread_local MemoryTest_ThreadLocal local;
+		local.buffer = Memory::newArray< char >( MemoryTag::Audio, 64 );
+	} ).join();
+	Rocket_UnitTest_Check_Equal( Memory::snapshot()[ MemoryTag::Audio ].frees - frees, 1ull );
+	Rocket_UnitTest_Check_Equal( Memory::liveBytes( MemoryTag::Audio ), audio.liveBytes );
+}
+
+Rocket_UnitTest( Memory_Snapshot ) {
+	// Allocators' blocks count towards Core
+	long long core = Memory::liveBytes( MemoryTag::Core );
+	{
+		Arena arena( 4096 );
+		arena.allocate( 100 );
+		Rocket_UnitTest_Check_Expression( Memory::liveBytes( MemoryTag::Core ) >= core + 4096 );
+	}
+	Rocket_UnitTest_Check_Equal( Memory::liveBytes( MemoryTag::Core ), core );
+
+	MemorySnapshot snapshot = Memory::snapshot();
+	Rocket_UnitTest_Check_Equal( snapshot.tags.size(), (size_t)Memory::TagCount );
+	Rocket_UnitTest_Check_Equal( snapshot[ MemoryTag::Network ].name, std::string( "network" ) );
+	Rocket_UnitTest_Check_Equal( std::string( Memory::tagName( MemoryTag::Graphics ) ), std::string( "graphics" ) );
+	std::string text = snapshot.text();
+	Rocket_UnitTest_Check_Expression( text.find( "memory scene live=" ) != std::string::npos );
+	std::string json = snapshot.json();
+	Rocket_UnitTest_Check_Expression( json.find( "\"audio\": { \"live\": " ) != std::string::npos );
+	Rocket_UnitTest_Check_Expression( json.find( "\"memory\": {" ) != std::string::npos && json.back() == '}' );
+
+	// update() publishes gauges, and dumps a line of JSON once the interval has passed
+	Memory::recordAllocation( MemoryTag::Scene, 1 << 20 );
+	Memory::update();
+	Rocket_UnitTest_Check_Equal( Metrics::gauge( "memory.scene.live_bytes" ).value(), Memory::liveBytes( MemoryTag::Scene ) );
+	Rocket_UnitTest_Check_Expression( Metrics::gauge( "memory.scene.peak_bytes" ).value() >= ( 1 << 20 ) );
+	Memory::recordFree( MemoryTag::Scene, 1 << 20 );
+
+	const char * file = "UnitTest_memory_dump.json";
+	remove( file );
+	Memory::setDumpInterval( 1, file );
+	std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+	Memory::update();
+	Memory::setDumpInterval( 0 );
+	Memory::update();
+	std::string dumped;
+	FILE * in = fopen( file, "r" );
+	if ( in != nullptr ) {
+		char buffer[ 1024 ];
+		while ( fgets( buffer, sizeof( buffer ), in ) != nullptr ) dumped += buffer;
+		fclose( in );
+	}
+	remove( file );
+	Rocket_UnitTest_Check_Expression( dumped.find( "{ \"time\": " ) == 0 );
+	Rocket_UnitTest_Check_Expression( dumped.find( "\"core\"" ) != std::string::npos );
+	Rocket_UnitTest_Check_Equal( (int)std::count( dumped.begin(), dumped.end(), '\n' ), 1 );
+}
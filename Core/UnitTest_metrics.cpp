@@ -0,0 +1,117 @@
+#include "rocket/UnitTest.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "metrics.h"
+
+using namespace Rocket::Core;
+
+Rocket_UnitTest( Metrics_Counter ) {
+	Counter & counter = Metrics::counter( "test.counter" );
+	Rocket_UnitTest_Check_Expression( &Metrics::counter( "test.counter" ) == &counter );
+	Rocket_UnitTest_Check_Equal( counter.value(), 0ull );
+
+	counter.add();
+	counter.add( 41 );
+	Rocket_UnitTest_Check_Equal( counter.value(), 42ull );
+	Rocket_UnitTest_Check_NoAllocations( counter.add( 8 ) );
+
+	// Every thread's share counts, including threads that have exited
+	std::vector< std::thread > threads;
+	for ( unsigned int t = 0; t < 4; t++ ) {
+		threads.push_back( std::thread( [ &counter ] () {
+			for ( unsigned int i = 0; i < 10000; i++ ) counter.add();
+		} ) );
+	}
+	for ( auto & thread : threads ) thread.join();
+	Rocket_UnitTest_Check_Equal( counter.value(), 40050ull );
+
+	// A thread given a reserved shard does not allocate on its first update
+	Metrics_ThreadShard * reserved = Metrics::reserveThread();
+	unsigned long long reservedAllocations = 1;
+	std::thread( [ &counter, &reservedAllocations, reserved ] () {
+		unsigned long long before = Rocket::Test::UnitTests_allocationCount();
+		Metrics::attachThread( reserved );
+		counter.add( 50 );
+		reservedAllocations = Rocket::Test::UnitTests_allocationCount() - before;
+	} ).join();
+	Rocket_UnitTest_Check_Equal( reservedAllocations, 0ull );
+	Rocket_UnitTest_Check_Equal( counter.value(), 40100ull );
+}
+
+Rocket_UnitTest( Metrics_Gauge ) {
+	Gauge & gauge = Metrics::gauge( "test.gauge" );
+	Rocket_UnitTest_Check_Equal( gauge.value(), 0ll );
+	gauge.set( 12 );
+	gauge.set( -3 );
+	Rocket_UnitTest_Check_Equal( gauge.value(), -3ll );
+}
+
+Rocket_UnitTest( Metrics_Histogram ) {
+	// Buckets are exact below 16, then split each power of 2 into 16
+	for ( unsigned long long value = 0; value < 16; value++ ) {
+		Rocket_UnitTest_Check_Equal( Histogram::bucket( value ), (unsigned int)value );
+		Rocket_UnitTest_Check_Equal( Histogram::bucketLimit( (unsigned int)value ), value );
+	}
+	unsigned int previous = 0;
+	bool ordered = true, bounded = true;
+	for ( unsigned long long value = 16; value < ( 1ull << 40 ); value += value / 7 + 1 ) {
+		unsigned int bucket = Histogram::bucket( value );
+		unsigned long long limit = Histogram::bucketLimit( bucket );
+		if ( bucket < previous ) ordered = false;
+		if ( limit < value || limit - value > value / 16 ) bounded = false;
+		previous = bucket;
+	}
+	Rocket_UnitTest_Check_Expression( ordered );
+	Rocket_UnitTest_Check_Expression( bounded );
+	Rocket_UnitTest_Check_Equal( Histogram::bucket( 31 ), 31u );
+	Rocket_UnitTest_Check_Equal( Histogram::bucket( 32 ), 32u );
+	Rocket_UnitTest_Check_Equal( Histogram::bucket( 34 ), 33u );
+	Rocket_UnitTest_Check_Equal( Histogram::bucket( 1ull << 50 ), Histogram::BucketCount - 1 );
+
+	// 1 to 1000: percentiles are within a bucket of the exact values
+	Histogram & histogram = Metrics::histogram( "test.histogram" );
+	for ( unsigned long long value = 1; value <= 1000; value++ ) histogram.record( value );
+	Rocket_UnitTest_Check_NoAllocations( histogram.record( 1000 ) );
+	MetricsSnapshot::Distribution summary = histogram.summary();
+	Rocket_UnitTest_Check_Equal( summary.count, 1001ull );
+	Rocket_UnitTest_Check_Equal( summary.sum, 501500ull );
+	Rocket_UnitTest_Check_Equal( summary.max, 1000ull );
+	Rocket_UnitTest_Check_Expression( summary.p50 >= 501 && summary.p50 <= 501 + 501 / 16 );
+	Rocket_UnitTest_Check_Expression( summary.p90 >= 901 && summary.p90 <= 901 + 901 / 16 );
+	Rocket_UnitTest_Check_Expression( summary.p99 >= 991 && summary.p99 <= 1000 );
+	Rocket_UnitTest_Check_Equal( summary.p999, 1000ull );
+}
+
+Rocket_UnitTest( Metrics_Snapshot ) {
+	Metrics::counter( "snapshot.bytes" ).add( 1234 );
+	Metrics::gauge( "snapshot.depth" ).set( 7 );
+	Metrics::histogram( "snapshot.\"latency\"" ).record( 5 );
+
+	MetricsSnapshot snapshot = Metrics::snapshot();
+	bool foundCounter = false, foundGauge = false, foundHistogram = false;
+	for ( auto & counter : snapshot.counters ) {
+		if ( counter.name == "snapshot.bytes" ) foundCounter = ( counter.value == 1234 );
+	}
+	for ( auto & gauge : snapshot.gauges ) {
+		if ( gauge.name == "snapshot.depth" ) foundGauge = ( gauge.value == 7 );
+	}
+	for ( auto & histogram : snapshot.histograms ) {
+		if ( histogram.name == "snapshot.\"latency\"" ) foundHistogram = ( histogram.count == 1 && histogram.p50 == 5 );
+	}
+	Rocket_UnitTest_Check_Expression( foundCounter && foundGauge && foundHistogram );
+
+	std::string text = snapshot.text();
+	Rocket_UnitTest_Check_Expression( text.find( "counter snapshot.bytes 1234\n" ) != std::string::npos );
+	Rocket_UnitTest_Check_Expression( text.find( "gauge snapshot.depth 7\n" ) != std::string::npos );
+	Rocket_UnitTest_Check_Expression( text.find( "histogram snapshot.\"latency\" count=1 sum=5 max=5 p50=5 p90=5 p99=5 p999=5\n" ) != std::string::npos );
+
+	std::string json = snapshot.json();
+	Rocket_UnitTest_Check_Expression( json.compare( 0, 10, "{ \"time\": " ) == 0 );
+	Rocket_UnitTest_Check_Expression( json.find( "\"snapshot.bytes\": 1234" ) != std::string::npos );
+	Rocket_UnitTest_Check_Expression( json.find( "\"gauges\": {" ) != std::string::npos );
+	Rocket_UnitTest_Check_Expression( json.find( "\"snapshot.\\\"latency\\\"\": { \"count\": 1, \"sum\": 5, \"max\": 5, \"p50\": 5" ) != std::string::npos );
+	Rocket_UnitTest_Check_Expression( json.compare( json.length() - 4, 4, "} } " ) == 0 || json.compare( json.length() - 3, 3, "} }" ) == 0 );
+}
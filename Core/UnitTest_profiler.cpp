@@ -0,0 +1,145 @@
+#include "rocket/UnitTest.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "profiler.h"
+#include "timer.h"
+
+using namespace Rocket::Core;
+
+// Stats of the zone called name in the last frame, or nullptr
+static const ProfileZoneStats * Profiler_Find( const char * name ) {
+	for ( const ProfileZoneStats & stats : Profiler::frameStats() ) {
+		if ( strcmp( stats.name, name ) == 0 ) return &stats;
+	}
+	return nullptr;
+}
+
+static void Profiler_Nested( unsigned int inner ) {
+	Rocket_Profile_Zone( "outer" );
+	for ( unsigned int i = 0; i < inner; i++ ) {
+		Rocket_Profile_Zone( "inner" );
+		Rocket::Core::sleep( 1 );
+	}
+}
+
+Rocket_UnitTest( Profiler_Clock ) {
+	unsigned long long start = timer_ns();
+	Rocket::Core::sleep( 2 );
+	unsigned long long elapsed = timer_ns() - start;
+	Rocket_UnitTest_Check_Expression( elapsed >= 1500000ull && elapsed < 1000000000ull );
+
+	// The time stamp counter, where there is one, agrees with timer_ns()
+	if ( Profiler::useTimeStampCounter() ) {
+		long long difference = (long long)( Profiler::now() - timer_ns() );
+		Rocket_UnitTest_Check_Expression( difference > -1000000 && difference < 1000000 );
+	}
+	unsigned long long a = Profiler::now(), b = Profiler::now();
+	Rocket_UnitTest_Check_Expression( b >= a );
+}
+
+Rocket_UnitTest( Profiler_Zones ) {
+	// Nothing is recorded while the profiler is disabled, and ending a frame does not allocate
+	Profiler_Nested( 1 );
+	Rocket_UnitTest_Check_NoAllocations( Profiler::endFrame() );
+	Rocket_UnitTest_Check_Expression( Profiler_Find( "outer" ) == nullptr );
+
+	Profiler::setEnabled( true );
+	Profiler::startCapture();
+	Profiler_Nested( 3 );
+	Profiler::endFrame();
+	const ProfileZoneStats * outer = Profiler_Find( "outer" );
+	const ProfileZoneStats * inner = Profiler_Find( "inner" );
+	Rocket_UnitTest_Check_Expression( outer != nullptr && inner != nullptr );
+	if ( outer != nullptr && inner != nullptr ) {
+		Rocket_UnitTest_Check_Equal( outer->calls, 1u );
+		Rocket_UnitTest_Check_Equal( inner->calls, 3u );
+		Rocket_UnitTest_Check_Expression( inner->totalNanoseconds >= 3000000ull );
+		Rocket_UnitTest_Check_Expression( inner->totalNanoseconds <= outer->totalNanoseconds );
+		Rocket_UnitTest_Check_Expression( inner->maxNanoseconds <= inner->totalNanoseconds );
+		Rocket_UnitTest_Check_Expression( Profiler::frameNanoseconds() >= outer->totalNanoseconds );
+	}
+
+	// Zones from several threads are collected by one endFrame()
+	std::vector< std::thread > threads;
+	for ( unsigned int t = 0; t < 4; t++ ) {
+		threads.push_back( std::thread( [] () {
+			for ( unsigned int i = 0; i < 100; i++ ) {
+				Rocket_Profile_Zone( "worker" );
+			}
+		} ) );
+	}
+	for ( auto & thread : threads ) thread.join();
+	{
+		// Once a thread has its buffer, zones do not allocate
+		Rocket_Profile_Zone( "first" );
+	}
+	Rocket_UnitTest_Check_NoAllocations( { Rocket_Profile_Zone( "allocation free" ); } );
+
+	// A thread given a reserved buffer does not allocate on its first zone
+	Profiler_ThreadBuffer * reserved = Profiler::reserveThread();
+	unsigned long long reservedAllocations = 1;
+	std::thread( [&] () {
+		unsigned long long before = Rocket::Test::UnitTests_allocationCount();
+		Profiler::attachThread( reserved );
+		{
+			Rocket_Profile_Zone( "reserved" );
+		}
+		reservedAllocations = Rocket::Test::UnitTests_allocationCount() - before;
+	} ).join();
+	Rocket_UnitTest_Check_Equal( reservedAllocations, 0ull );
+
+	// A thread attached to nullptr drops its zones instead of taking a buffer
+	unsigned long long detachedAllocations = 1;
+	std::thread( [&] () {
+		unsigned long long before = Rocket::Test::UnitTests_allocationCount();
+		Profiler::attachThread( nullptr );
+		{
+			Rocket_Profile_Zone( "detached" );
+		}
+		detachedAllocations = Rocket::Test::UnitTests_allocationCount() - before;
+	} ).join();
+	Rocket_UnitTest_Check_Equal( detachedAllocations, 0ull );
+
+	Profiler::endFrame();
+	const ProfileZoneStats * worker = Profiler_Find( "worker" );
+	Rocket_UnitTest_Check_Expression( worker != nullptr && worker->calls == 400 );
+	const ProfileZoneStats * reservedZone = Profiler_Find( "reserved" );
+	Rocket_UnitTest_Check_Expression( reservedZone != nullptr && reservedZone->calls == 1 );
+	Rocket_UnitTest_Check_Expression( Profiler_Find( "detached" ) == nullptr );
+	Rocket_UnitTest_Check_Expression( Profiler_Find( "outer" ) == nullptr );
+
+	// A full buffer drops zones instead of blocking
+	unsigned long long dropped = Profiler::droppedEvents();
+	for ( unsigned int i = 0; i < 10000; i++ ) {
+		Rocket_Profile_Zone( "flood" );
+	}
+	Profiler::endFrame();
+	const ProfileZoneStats * flood = Profiler_Find( "flood" );
+	Rocket_UnitTest_Check_Expression( flood != nullptr && flood->calls < 10000 );
+	if ( flood != nullptr ) Rocket_UnitTest_Check_Equal( Profiler::droppedEvents() - dropped, 10000ull - flood->calls );
+
+	// Chrome trace of the captured frames
+	Profiler::stopCapture();
+	Profiler::setEnabled( false );
+	const char * path = "UnitTest_profiler_trace.json";
+	Rocket_UnitTest_Check_Expression( Profiler::writeChromeTrace( path ) );
+	std::string trace;
+	FILE * file = fopen( path, "r" );
+	if ( file != nullptr ) {
+		char buffer[ 4096 ];
+		size_t count;
+		while ( ( count = fread( buffer, 1, sizeof( buffer ), file ) ) > 0 ) trace.append( buffer, count );
+		fclose( file );
+		remove( path );
+	}
+	Rocket_UnitTest_Check_Expression( trace.compare( 0, 35, "{ \"displayTimeUnit\": \"ns\", \"traceEv" ) == 0 );
+	Rocket_UnitTest_Check_Expression( trace.find( "{ \"name\": \"outer\", \"ph\": \"X\", \"ts\": " ) != std::string::npos );
+	Rocket_UnitTest_Check_Expression( trace.find( "{ \"name\": \"Frame\", \"ph\": \"X\"" ) != std::string::npos );
+	Rocket_UnitTest_Check_Expression( trace.find( "\"name\": \"worker\"" ) != std::string::npos );
+	Rocket_UnitTest_Check_Expression( trace.compare( trace.length() - 4, 4, "\n] }" ) == 0 || trace.compare( trace.length() - 5, 5, "\n] }\n" ) == 0 );
+}
@@ -0,0 +1,62 @@
+#include "rocket/UnitTest.h"
+
+#include "quaternion.h"
+
+using namespace Rocket::Core;
+
+Rocket_UnitTest( VectorMath_quat ) {
+	quat identity;
+	Rocket_UnitTest_Check_FloatEqual( identity.w(), 1.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( identity.length(), 1.0f, 0.0001f );
+
+	// Axis-angle construction matches the vec4 helper for unit axes
+	quat q1( 0.7f, vec3( 0, 1, 0 ) );
+	vec4 v1 = Quaternion( 0.7f, vec3( 0, 1, 0 ) );
+	Rocket_UnitTest_Check_FloatEqual( q1.y(), v1.y(), 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( q1.w(), v1.w(), 0.0001f );
+
+	// Non-unit axes are normalized
+	quat q2( 0.7f, vec3( 0, 5, 0 ) );
+	Rocket_UnitTest_Check_FloatEqual( q2.y(), q1.y(), 0.0001f );
+
+	// Hamilton product matches matrix composition
+	quat a( 0.3f, vec3( 1, 0, 0 ) );
+	quat b( -1.1f, vec3( 1, 2, 3 ) );
+	mat4 fromQuat = ( a * b ).toMatrix();
+	mat4 fromMatrices = QuaternionRotate( a.xyzw() ) * QuaternionRotate( b.xyzw() );
+	for ( unsigned int r = 0; r < 4; r++ ) {
+		for ( unsigned int c = 0; c < 4; c++ ) Rocket_UnitTest_Check_FloatEqual( fromQuat(r,c), fromMatrices(r,c), 0.0001f );
+	}
+
+	// Matrix round trip
+	quat c = quat( fromQuat );
+	quat ab = a * b;
+	Rocket_UnitTest_Check_FloatEqual( fabs( c.dot( ab ) ), 1.0f, 0.0001f );
+
+	// Vector rotation
+	vec3 rotated = quat( Rocket::MathConstants::PI / 2.0f, vec3( 0, 0, 1 ) ) * vec3( 1, 0, 0 );
+	Rocket_UnitTest_Check_FloatEqual( rotated.x(), 0.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( rotated.y(), 1.0f, 0.0001f );
+
+	vec3 direction = QuaternionToUnitVector( b );
+	vec3 directionVec4 = QuaternionToUnitVector( b.xyzw() );
+	Rocket_UnitTest_Check_FloatEqual( direction.x(), directionVec4.x(), 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( direction.z(), directionVec4.z(), 0.0001f );
+
+	// Interpolation
+	quat start( 0.0f, vec3( 0, 1, 0 ) );
+	quat end( 1.0f, vec3( 0, 1, 0 ) );
+	quat half = slerp( start, end, 0.5f );
+	quat expected( 0.5f, vec3( 0, 1, 0 ) );
+	Rocket_UnitTest_Check_FloatEqual( half.y(), expected.y(), 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( half.w(), expected.w(), 0.0001f );
+
+	half = nlerp( start, end, 0.5f );
+	Rocket_UnitTest_Check_FloatEqual( half.length(), 1.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( half.y(), expected.y(), 0.0001f );
+
+	// Shortest path: -end represents the same rotation as end
+	quat negatedEnd( -end.x(), -end.y(), -end.z(), -end.w() );
+	half = nlerp( start, negatedEnd, 0.5f );
+	Rocket_UnitTest_Check_FloatEqual( fabs( half.y() ), expected.y(), 0.0001f );
+}
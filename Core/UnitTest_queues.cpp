@@ -0,0 +1,161 @@
+#include "rocket/UnitTest.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "queues.h"
+#include "UnitTest_liveitem.h"
+
+using namespace Rocket::Core;
+
+Rocket_UnitTest( Queues_SPSC ) {
+	SPSCQueue< unsigned int > queue( 5 );
+	Rocket_UnitTest_Check_Equal( queue.capacity(), 8u );
+	Rocket_UnitTest_Check_Expression( queue.empty() );
+
+	// Fills up, and wraps around
+	unsigned int value = 0;
+	for ( unsigned int i = 0; i < 8; i++ ) Rocket_UnitTest_Check_Expression( queue.push( i ) );
+	Rocket_UnitTest_Check_Expression( queue.push( 8u ) == false );
+	Rocket_UnitTest_Check_Equal( queue.size(), 8u );
+	for ( unsigned int i = 0; i < 100; i++ ) {
+		Rocket_UnitTest_Check_Expression( queue.pop( value ) );
+		Rocket_UnitTest_Check_Equal( value, i );
+		Rocket_UnitTest_Check_Expression( queue.push( i + 8 ) );
+	}
+
+	// Batches stop at what fits, or what there is
+	unsigned int items[ 16 ];
+	Rocket_UnitTest_Check_Equal( queue.pop( items, 3 ), 3u );
+	Rocket_UnitTest_Check_Equal( items[2], 102u );
+	for ( unsigned int i = 0; i < 16; i++ ) items[i] = 1000 + i;
+	Rocket_UnitTest_Check_Equal( queue.push( items, 16 ), 3u );
+	Rocket_UnitTest_Check_Equal( queue.pop( items, 16 ), 8u );
+	Rocket_UnitTest_Check_Equal( items[4], 107u );
+	Rocket_UnitTest_Check_Equal( items[7], 1002u );
+	Rocket_UnitTest_Check_Expression( queue.pop( value ) == false );
+	Rocket_UnitTest_Check_NoAllocations( queue.push( 1u ); queue.pop( value ) );
+
+	// Items left in a queue are destroyed with it, and move-only items can be queued
+	{
+		SPSCQueue< UnitTest_LiveItem > items( 4 );
+		items.emplace( 1u );
+		items.push( UnitTest_LiveItem( 2 ) );
+		UnitTest_LiveItem item;
+		items.pop( item );
+		Rocket_UnitTest_Check_Equal( item.value, 1 );
+		Rocket_UnitTest_Check_Equal( UnitTest_LiveItem::live(), 2 );
+	}
+	Rocket_UnitTest_Check_Equal( UnitTest_LiveItem::live(), 0 );
+	SPSCQueue< std::unique_ptr< int > > pointers( 2 );
+	pointers.push( std::unique_ptr< int >( new int( 7 ) ) );
+	std::unique_ptr< int > pointer;
+	pointers.pop( pointer );
+	Rocket_UnitTest_Check_Equal( *pointer, 7 );
+}
+
+Rocket_UnitTest( Queues_SPSC_Threads ) {
+	// Every item arrives once and in order, one at a time and in batches
+	const unsigned int count = 200000;
+	SPSCQueue< unsigned int > queue( 64 );
+	std::thread producer( [ &queue, count ] () {
+		unsigned int batch[ 7 ];
+		unsigned int next = 0;
+		while ( next < count ) {
+			if ( next % 3 == 0 ) {
+				unsigned int size = 0;
+				while ( size < 7 && next + size < count ) { batch[ size ] = next + size; size++; }
+				next += queue.push( batch, size );
+			} else if ( queue.push( next ) ) {
+				next++;
+			}
+			if ( queue.size() == queue.capacity() ) std::this_thread::yield();
+		}
+	} );
+
+	unsigned int expected = 0, wrong = 0;
+	unsigned int batch[ 5 ];
+	while ( expected < count ) {
+		unsigned int popped = queue.pop( batch, 1 + expected % 5 );
+		for ( unsigned int i = 0; i < popped; i++ ) {
+			if ( batch[i] != expected ) wrong++;
+			expected++;
+		}
+		if ( popped == 0 ) std::this_thread::yield();
+	}
+	producer.join();
+	Rocket_UnitTest_Check_Equal( wrong, 0u );
+	Rocket_UnitTest_Check_Expression( queue.empty() );
+}
+
+Rocket_UnitTest( Queues_MPMC ) {
+	MPMCQueue< unsigned int > queue( 4 );
+	Rocket_UnitTest_Check_Equal( queue.capacity(), 4u );
+	unsigned int value = 0;
+	Rocket_UnitTest_Check_Expression( queue.pop( value ) == false );
+	for ( unsigned int i = 0; i < 4; i++ ) Rocket_UnitTest_Check_Expression( queue.push( i ) );
+	Rocket_UnitTest_Check_Expression( queue.push( 4u ) == false );
+	Rocket_UnitTest_Check_Equal( queue.size(), 4u );
+	for ( unsigned int i = 0; i < 50; i++ ) {
+		Rocket_UnitTest_Check_Expression( queue.pop( value ) );
+		Rocket_UnitTest_Check_Equal( value, i );
+		Rocket_UnitTest_Check_Expression( queue.push( i + 4 ) );
+	}
+	Rocket_UnitTest_Check_NoAllocations( queue.pop( value ); queue.push( 1u ) );
+
+	{
+		MPMCQueue< UnitTest_LiveItem > items( 4 );
+		items.emplace( 1u );
+		items.emplace( 2u );
+		Rocket_UnitTest_Check_Equal( UnitTest_LiveItem::live(), 2 );
+	}
+	Rocket_UnitTest_Check_Equal( UnitTest_LiveItem::live(), 0 );
+}
+
+Rocket_UnitTest( Queues_MPMC_Threads ) {
+	// Four producers and four consumers: every item is taken exactly once, and each consumer sees each producer's items in order
+	const unsigned int producers = 4, consumers = 4, perProducer = 50000;
+	MPMCQueue< unsigned int > queue( 128 );
+	std::vector< std::atomic< unsigned char > > taken( producers * perProducer );
+	for ( auto & t : taken ) t.store( 0 );
+	std::atomic< unsigned int > remaining( producers * perProducer ), disorder( 0 );
+
+	std::vector< std::thread > threads;
+	for ( unsigned int p = 0; p < producers; p++ ) {
+		threads.push_back( std::thread( [ &queue, p, perProducer ] () {
+			for ( unsigned int i = 0; i < perProducer; i++ ) {
+				while ( !queue.push( p * perProducer + i ) ) std::this_thread::yield();
+			}
+		} ) );
+	}
+	for ( unsigned int c = 0; c < consumers; c++ ) {
+		threads.push_back( std::thread( [ &queue, &taken, &remaining, &disorder, perProducer ] () {
+			unsigned int last[ producers ] = {};
+			bool first[ producers ] = { true, true, true, true };
+			unsigned int value;
+			while ( remaining.load() > 0 ) {
+				if ( !queue.pop( value ) ) {
+					std::this_thread::yield();
+					continue;
+				}
+				taken[ value ]++;
+				remaining--;
+				unsigned int p = value / perProducer;
+				if ( !first[p] && value <= last[p] ) disorder++;
+				first[p] = false;
+				last[p] = value;
+			}
+		} ) );
+	}
+	for ( auto & thread : threads ) thread.join();
+
+	bool once = true;
+	for ( auto & t : taken ) {
+		if ( t.load() != 1 ) once = false;
+	}
+	Rocket_UnitTest_Check_Expression( once );
+	Rocket_UnitTest_Check_Equal( disorder.load(), 0u );
+	Rocket_UnitTest_Check_Expression( queue.empty() );
+}
@@ -1,6 +1,9 @@
 
 #include "rocket/UnitTest.h"
 
+#include <math.h>
+#include <stdio.h>
+
 #include "rstring.h"
 
 using namespace Rocket::Core;
@@ -38,3 +41,87 @@ Rocket_UnitTest ( String_Basic ) {
 	Rocket_UnitTest_Check_CharStringEqual( str5.c_str(), "test 1 2 3" );
 }
 
+
+Rocket_UnitTest ( String_Append ) {
+	rstring str;
+	str.reserve( 64 );
+	const char * before = str.c_str();
+	Rocket_UnitTest_Check_NoAllocations( str << "abc" << -12 << 7u );
+	Rocket_UnitTest_Check_CharStringEqual( str.c_str(), "abc-127" );
+	Rocket_UnitTest_Check_Expression( str.c_str() == before );
+
+	// Appending to itself
+	str = "ab";
+	str << str;
+	str += str;
+	Rocket_UnitTest_Check_CharStringEqual( str.c_str(), "abababab" );
+	str += 'c';
+	str.append( "defg", 2 );
+	Rocket_UnitTest_Check_CharStringEqual( str.c_str(), "ababababcde" );
+	Rocket_UnitTest_Check_Equal( str.length(), 11u );
+
+	rstring number;
+	number << 0.5;
+	Rocket_UnitTest_Check_CharStringEqual( number.c_str(), "0.500000" );
+	Rocket_UnitTest_Check_CharStringEqual( rstring::tostring( -2147483647 - 1 ).c_str(), "-2147483648" );
+	Rocket_UnitTest_Check_CharStringEqual( rstring::tostring( 4294967295u ).c_str(), "4294967295" );
+	Rocket_UnitTest_Check_CharStringEqual( rstring::tostring( 0 ).c_str(), "0" );
+}
+
+Rocket_UnitTest ( String_Format ) {
+	char buffer[ FormatBufferSize ], expected[ 64 ];
+
+	// Integers match printf, around every power of 10
+	unsigned int mismatches = 0;
+	for ( unsigned long long power = 1; power != 0 && power <= 10000000000000000000ull; power = ( power > 1844674407370955161ull ) ? 0 : power * 10 ) {
+		for ( unsigned long long value = power - 2; value != power + 2; value++ ) {
+			snprintf( expected, sizeof( expected ), "%llu", value );
+			if ( std::string( buffer, formatUnsigned( value, buffer ) ) != expected ) mismatches++;
+			snprintf( expected, sizeof( expected ), "%lld", -(long long)value );
+			if ( std::string( buffer, formatSigned( -(long long)value, buffer ) ) != expected ) mismatches++;
+		}
+	}
+	Rocket_UnitTest_Check_Equal( mismatches, 0u );
+	Rocket_UnitTest_Check_Expression( std::string( buffer, formatUnsigned( 18446744073709551615ull, buffer ) ) == "18446744073709551615" );
+	Rocket_UnitTest_Check_Expression( std::string( buffer, formatSigned( -9223372036854775807ll - 1, buffer ) ) == "-9223372036854775808" );
+
+	// Doubles match printf when they have enough fraction bits not to be exactly halfway between two outputs
+	unsigned int state = 1;
+	for ( unsigned int i = 0; i < 2000; i++ ) {
+		state = state * 1664525u + 1013904223u;
+		double value = ( ( state >> 8 ) / double( 1 << 24 ) - 0.5 ) * pow( 10.0, double( i % 12 ) - 5.0 );
+		unsigned int precision = i % 10;
+		snprintf( expected, sizeof( expected ), "%.*f", precision, value );
+		if ( std::string( buffer, formatDouble( value, buffer, precision ) ) != expected ) mismatches++;
+	}
+	Rocket_UnitTest_Check_Equal( mismatches, 0u );
+	Rocket_UnitTest_Check_Expression( std::string( buffer, formatDouble( 0.125, buffer, 2 ) ) == "0.13" );
+	Rocket_UnitTest_Check_Expression( std::string( buffer, formatDouble( 0.9999999, buffer, 3 ) ) == "1.000" );
+	Rocket_UnitTest_Check_Expression( std::string( buffer, formatDouble( -0.0, buffer, 1 ) ) == "-0.0" );
+	Rocket_UnitTest_Check_Expression( std::string( buffer, formatDouble( 12.0, buffer, 0 ) ) == "12" );
+	Rocket_UnitTest_Check_Expression( std::string( buffer, formatDouble( 2.5e20, buffer, 2 ) ) == "2.50e+20" );
+	Rocket_UnitTest_Check_Expression( std::string( buffer, formatDouble( -HUGE_VAL, buffer ) ) == "-inf" );
+	Rocket_UnitTest_Check_Expression( std::string( buffer, formatDouble( nan( "" ), buffer ) ) == "nan" );
+}
+
+Rocket_UnitTest ( String_Builder ) {
+	// Short strings stay in the inline buffer
+	StringBuilder address;
+	Rocket_UnitTest_Check_NoAllocations( address << "192.168.0." << 12 << ':' << (unsigned short)8080 );
+	Rocket_UnitTest_Check_CharStringEqual( address.c_str(), "192.168.0.12:8080" );
+	Rocket_UnitTest_Check_Expression( address.str() == "192.168.0.12:8080" );
+
+	address.clear();
+	address << rstring( "x=" ) << -1.25 << std::string( " n=" ) << 3000000000u << ' ' << -5000000000ll << ' ' << (size_t)7;
+	Rocket_UnitTest_Check_CharStringEqual( address.c_str(), "x=-1.250000 n=3000000000 -5000000000 7" );
+
+	// Long strings move to the heap and keep their contents
+	StringBuilder log;
+	std::string expected;
+	for ( unsigned int i = 0; i < 1000; i++ ) {
+		log << i << ",";
+		expected += std::to_string( i ) + ",";
+	}
+	Rocket_UnitTest_Check_Equal( log.length(), expected.length() );
+	Rocket_UnitTest_Check_CharStringEqual( log.c_str(), expected.c_str() );
+}
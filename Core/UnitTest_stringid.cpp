@@ -0,0 +1,56 @@
+#include "rocket/UnitTest.h"
+
+#include <string.h>
+#include <unordered_map>
+
+#include "stringid.h"
+#include "rstring.h"
+
+using namespace Rocket::Core;
+
+// Literal names are hashed at compile time
+static constexpr StringId StringId_Walk( "walk" );
+static_assert( StringId_Walk.hash() == 0x5e76bbf62c1e0a30ull, "StringId is a constant expression" );
+static_assert( StringId( "" ).hash() == 14695981039346656037ull, "the empty name hashes to the FNV offset basis" );
+static_assert( StringId( "a" ).hash() == 0xaf63dc4c8601ec8cull, "FNV-1a of \"a\"" );
+
+Rocket_UnitTest ( StringId_Hash ) {
+	// Compile-time, runtime and interned ids of the same name are equal
+	char buffer[] = "walk";
+	std::string text = "walk";
+	Rocket_UnitTest_Check_Expression( StringId( buffer ) == StringId_Walk );
+	Rocket_UnitTest_Check_Expression( StringId( text ) == StringId_Walk );
+	Rocket_UnitTest_Check_Expression( StringId::intern( buffer ) == StringId_Walk );
+	Rocket_UnitTest_Check_Expression( StringId( "run" ) != StringId_Walk );
+	Rocket_UnitTest_Check_Expression( fnv1a( "foobar" ) == 0x85944171f73967e8ull );
+	Rocket_UnitTest_Check_Expression( fnv1a( "foobar", 6 ) == fnv1a( "foobar" ) );
+
+	// rstring hashes the same way
+	rstring name = "walk";
+	Rocket_UnitTest_Check_Expression( name( name ) == (size_t)StringId_Walk.hash() );
+	std::unordered_map< rstring, int, rstring > byName;
+	byName[ rstring( "a" ) ] = 1;
+	byName[ rstring( "b" ) ] = 2;
+	Rocket_UnitTest_Check_Equal( byName[ rstring( "b" ) ], 2 );
+}
+
+Rocket_UnitTest ( StringId_Intern ) {
+	StringId jump = StringId::intern( std::string( "jump" ) );
+	Rocket_UnitTest_Check_CharStringEqual( jump.name(), "jump" );
+	Rocket_UnitTest_Check_CharStringEqual( StringId( "jump" ).name(), "jump" );
+	Rocket_UnitTest_Check_Expression( StringId( "never interned" ).name() == nullptr );
+
+	// Interning again gives the same id and text
+	Rocket_UnitTest_Check_Expression( StringId::intern( "jump" ) == jump );
+	Rocket_UnitTest_Check_Expression( jump.name() == StringId::intern( "jump" ).name() );
+
+	// Usable as a key of unordered and ordered containers
+	std::unordered_map< StringId, int > frames;
+	frames[ "idle" ] = 1;
+	frames[ jump ] = 4;
+	Rocket_UnitTest_Check_Equal( frames.size(), (size_t)2 );
+	Rocket_UnitTest_Check_Equal( frames[ StringId( "jump" ) ], 4 );
+	Rocket_UnitTest_Check_Expression( frames.find( "fall" ) == frames.end() );
+	if ( sizeof( size_t ) == 8 ) Rocket_UnitTest_Check_Equal( (unsigned long long)std::hash< StringId >()( jump ), jump.hash() );
+	Rocket_UnitTest_Check_Expression( ( StringId( "idle" ) < jump ) != ( jump < StringId( "idle" ) ) );
+}
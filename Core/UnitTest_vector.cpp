@@ -1,6 +1,7 @@
 
 #include "rocket/UnitTest.h"
 
+#include "matrix.h"
 #include "vector.h"
 
 Rocket_UnitTest ( VectorMath_vec2 ) {
@@ -87,3 +88,91 @@ Rocket_UnitTest( VectorMath_Quaternions ) {
 	Rocket_UnitTest_Check_FloatEqual( quat3.w(), -1.5f, 0.0001f );
 }
 
+
+Rocket_UnitTest( VectorMath_vecBatch ) {
+	Rocket::Core::vec4 points[5] = {
+		Rocket::Core::vec4( 2, 0, 0, 1 ),
+		Rocket::Core::vec4( 0, 3, 0, 1 ),
+		Rocket::Core::vec4( 0, 0, 0, 1 ),
+		Rocket::Core::vec4( 1, 2, 2, 1 ),
+		Rocket::Core::vec4( -4, 0, 3, 1 )
+	};
+
+	// xyz of each vec4
+	Rocket::Core::vec3_batch a( points, 5 );
+	Rocket_UnitTest_Check_Equal( a.size(), 5u );
+	Rocket_UnitTest_Check_FloatEqual( a[3].z(), 2.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( a.component( 0 )[4], -4.0f, 0.0001f );
+
+	Rocket::Core::vec3_batch::scalarBatchType lengths;
+	Rocket::Core::length( a, lengths );
+	Rocket_UnitTest_Check_FloatEqual( lengths[0], 2.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( lengths[3], 3.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( lengths[4], 5.0f, 0.0001f );
+
+	Rocket::Core::vec3_batch n;
+	Rocket::Core::normalize( a, n );
+	Rocket_UnitTest_Check_FloatEqual( n[1].y(), 1.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( n[2].length(), 0.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( n[4].x(), -0.8f, 0.0001f );
+
+	Rocket::Core::vec3_batch b( 5 );
+	for ( unsigned int i = 0; i < b.size(); i++ ) b.set( i, Rocket::Core::vec3( 0, 0, 1 ) );
+
+	Rocket::Core::vec3_batch c;
+	Rocket::Core::cross( a, b, c );
+	Rocket::Core::vec3 expected = Rocket::Core::cross( a[3], b[3] );
+	Rocket_UnitTest_Check_Expression( c[3] == expected );
+
+	Rocket::Core::vec3_batch::scalarBatchType dots;
+	Rocket::Core::dot( a, b, dots );
+	Rocket_UnitTest_Check_FloatEqual( dots[4], 3.0f, 0.0001f );
+
+	Rocket::Core::add( a, b, c );
+	Rocket::Core::scale( c, 2.0f, c );
+	Rocket::Core::vec3 out[5];
+	c.toArray( out );
+	Rocket_UnitTest_Check_FloatEqual( out[3].x(), 2.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( out[3].z(), 6.0f, 0.0001f );
+
+	// Empty arrays are not read or written
+	Rocket::Core::vec3_batch empty( static_cast< const Rocket::Core::vec4 * >( nullptr ), 0 );
+	Rocket_UnitTest_Check_Equal( empty.size(), 0u );
+	empty.toArray( static_cast< Rocket::Core::vec3 * >( nullptr ) );
+}
+
+Rocket_UnitTest( VectorMath_vecExpressions ) {
+	Rocket::Core::vec3 a( 1.0f, 2.0f, 3.0f );
+	Rocket::Core::vec3 b( -2.0f, 0.5f, 4.0f );
+	Rocket::Core::vec3 c( 0.0f, 1.0f, -1.0f );
+
+	// Chains are evaluated when converted to a T_vec
+	Rocket::Core::vec3 r = a * 2.0f - b + 0.5f * c;
+	Rocket_UnitTest_Check_FloatEqual( r.x(), 4.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( r.y(), 4.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( r.z(), 1.5f, 0.0001f );
+
+	// Expressions can be read, compared and used in vector operations without being stored first
+	Rocket_UnitTest_Check_FloatEqual( ( a + b ).z(), 7.0f, 0.0001f );
+	Rocket_UnitTest_Check_Expression( a - b == Rocket::Core::vec3( 3.0f, 1.5f, -1.0f ) );
+	Rocket_UnitTest_Check_Expression( -a != a );
+	Rocket_UnitTest_Check_FloatEqual( ( a - a ).length(), 0.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( ( a + c ) * b, 7.5f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( Rocket::Core::dot( a * 2.0f, c ), -2.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( Rocket::Core::normalize( b - a ).length(), 1.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( ( a * 3.0f ).xy().y(), 6.0f, 0.0001f );
+
+	// Compound assignment from an expression
+	r = a;
+	r += b * 2.0f - c;
+	Rocket_UnitTest_Check_FloatEqual( r.x(), -3.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( r.z(), 12.0f, 0.0001f );
+	r -= -a;
+	Rocket_UnitTest_Check_FloatEqual( r.x(), -2.0f, 0.0001f );
+
+	// Matrix * expression
+	Rocket::Core::mat4 m = Rocket::Core::Translate( Rocket::Core::vec3( 1.0f, 0.0f, 0.0f ) );
+	Rocket::Core::vec4 p = m * ( Rocket::Core::vec4( 1.0f, 1.0f, 1.0f, 1.0f ) * 2.0f );
+	Rocket_UnitTest_Check_FloatEqual( p.x(), 4.0f, 0.0001f );
+	Rocket_UnitTest_Check_FloatEqual( p.w(), 2.0f, 0.0001f );
+}
@@ -0,0 +1,119 @@
+
+#ifndef Rocket_Core_Affine_H
+#define Rocket_Core_Affine_H
+
+#include <math.h>
+#include <iostream>
+
+#include "matrix.h"
+#include "vector.h"
+#include "quaternion.h"
+
+namespace Rocket {
+	namespace Core {
+
+		// 3x4 affine transform: the top three rows of a 4x4 matrix whose bottom row is implicitly (0, 0, 0, 1)
+		// 00 01 02 03
+		// 10 11 12 13
+		// 20 21 22 23
+		// The left 3x3 block is the linear part (rotation * scale), column 3 is the translation
+		template< class T > class T_affine {
+		public:
+			Eigen::Matrix< T, 3, 4 > m_matrix;
+
+			// Constructors
+
+			// Default is the identity transform
+			T_affine() { m_matrix.setIdentity(); }
+			T_affine( const Eigen::Matrix< T, 3, 4 > & matrix ) : m_matrix( matrix ) {}
+
+			// Top three rows of a 4x4 matrix (the bottom row is assumed to be (0, 0, 0, 1))
+			explicit T_affine( const T_mat< T, 4, 4 > & m ) : m_matrix( m.m_matrix.template topRows< 3 >() ) {}
+
+			// Equivalent to Translate( translation ) * QuaternionRotate( rotation ) * Scale( scale ), without the 4x4 products
+			T_affine( const T_vec< T, 3 > & translation, const T_quat< T > & rotation, const T_vec< T, 3 > & scale ) {
+				m_matrix.template leftCols< 3 >() = rotation.m_quaternion.toRotationMatrix();
+				for ( unsigned int c = 0; c < 3; c++ ) m_matrix.col( c ) *= scale[c];
+				m_matrix.col( 3 ) = translation.m_elements;
+			}
+
+			// Array Subscript
+			T & operator () ( unsigned int row, unsigned col ) { return m_matrix( row, col ); }
+			const T & operator () ( unsigned int row, unsigned col ) const { return m_matrix( row, col ); }
+
+			T_vec< T, 3 > translation() const { return T_vec< T, 3 >( Eigen::Matrix< T, 3, 1 >( m_matrix.col( 3 ) ) ); }
+			T_mat< T, 3, 3 > linear() const { return T_mat< T, 3, 3 >( Eigen::Matrix< T, 3, 3 >( m_matrix.template leftCols< 3 >() ) ); }
+
+			// Arithmetic
+			// A * A (27 multiplies for the linear part and 9 for the translation, instead of 64)
+			T_affine operator * ( const T_affine & R ) const {
+				T_affine r;
+				r.m_matrix.template leftCols< 3 >().noalias() = m_matrix.template leftCols< 3 >() * R.m_matrix.template leftCols< 3 >();
+				r.m_matrix.col( 3 ).noalias() = m_matrix.template leftCols< 3 >() * R.m_matrix.col( 3 );
+				r.m_matrix.col( 3 ) += m_matrix.col( 3 );
+				return r;
+			}
+			T_affine & operator *= ( const T_affine & R ) { *this = *this * R; return *this; }
+
+			// A * V (w is passed through, so w = 1 transforms a point and w = 0 transforms a direction)
+			T_vec< T, 4 > operator * ( const T_vec< T, 4 > & v ) const {
+				Eigen::Matrix< T, 4, 1 > r;
+				r.template head< 3 >().noalias() = m_matrix * v.m_elements;
+				r[3] = v.w();
+				return T_vec< T, 4 >( r );
+			}
+
+			T_vec< T, 3 > transformPoint( const T_vec< T, 3 > & p ) const {
+				return T_vec< T, 3 >( Eigen::Matrix< T, 3, 1 >( m_matrix.template leftCols< 3 >() * p.m_elements + m_matrix.col( 3 ) ) );
+			}
+			T_vec< T, 3 > transformVector( const T_vec< T, 3 > & v ) const {
+				return T_vec< T, 3 >( Eigen::Matrix< T, 3, 1 >( m_matrix.template leftCols< 3 >() * v.m_elements ) );
+			}
+
+			// Inverses
+
+			// Inverse of any invertible affine transform
+			T_affine inverse() const {
+				T_affine r;
+				r.m_matrix.template leftCols< 3 >() = m_matrix.template leftCols< 3 >().inverse();
+				r.m_matrix.col( 3 ).noalias() = -r.m_matrix.template leftCols< 3 >() * m_matrix.col( 3 );
+				return r;
+			}
+			// Inverse of a rotation + translation (the linear part must be orthonormal)
+			T_affine inverseRigid() const {
+				T_affine r;
+				r.m_matrix.template leftCols< 3 >() = m_matrix.template leftCols< 3 >().transpose();
+				r.m_matrix.col( 3 ).noalias() = -r.m_matrix.template leftCols< 3 >() * m_matrix.col( 3 );
+				return r;
+			}
+			// Inverse of a rotation + scale + translation (the columns of the linear part must be orthogonal and non-zero)
+			// ( R * S )^-1 = S^-1 * R^T, and row i of S^-1 * R^T is column i of R * S divided by its squared length
+			T_affine inverseScaled() const {
+				T_affine r;
+				for ( unsigned int i = 0; i < 3; i++ ) {
+					r.m_matrix.row( i ).template head< 3 >() = m_matrix.col( i ).transpose() / m_matrix.col( i ).squaredNorm();
+				}
+				r.m_matrix.col( 3 ).noalias() = -r.m_matrix.template leftCols< 3 >() * m_matrix.col( 3 );
+				return r;
+			}
+
+			// Expands to a 4x4 matrix (for GPU upload and interoperability with mat4)
+			T_mat< T, 4, 4 > toMatrix() const {
+				T_mat< T, 4, 4 > r;
+				r.m_matrix.template topRows< 3 >() = m_matrix;
+				return r;
+			}
+
+			friend std::ostream & operator << ( std::ostream& stream, const T_affine< T > & a ) {
+				return stream << a.toMatrix();
+			}
+		};
+
+		// Typedefs
+		typedef T_affine< float > affine;
+		typedef T_affine< double > affined;
+
+	}
+}
+
+#endif
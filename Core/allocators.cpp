@@ -0,0 +1,224 @@
+
+#include <algorithm>
+
+#include "allocators.h"
+#include "memory.h"
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace Rocket {
+	namespace Core {
+
+		// --------------------------------------------------------------------------------------------------------------------
+		// Arena
+		// --------------------------------------------------------------------------------------------------------------------
+
+		Arena::Arena( size_t blockSize ) : m_first( nullptr ), m_current( nullptr ), m_position( nullptr ), m_end( nullptr ), m_blockSize( blockSize ) {
+		}
+
+		Arena::~Arena() {
+			while ( m_first != nullptr ) {
+				Block * next = m_first->next;
+				Memory::deallocate( MemoryTag::Core, m_first, sizeof( Block ) + m_first->size );
+				m_first = next;
+			}
+		}
+
+		char * Arena::grow( size_t size, size_t alignment ) {
+			// Move to the next free block, unless it is too small for this allocation, in which case a new one goes before it
+			size_t needed = size + ( ( alignment > alignof( Block ) ) ? alignment - alignof( Block ) : 0 );
+			Block * next = ( m_current != nullptr ) ? m_current->next : m_first;
+			if ( next == nullptr || next->size < needed ) {
+				size_t blockSize = std::max( m_blockSize, needed );
+				Block * block = (Block *)Memory::allocate( MemoryTag::Core, sizeof( Block ) + blockSize );
+				block->next = next;
+				block->size = blockSize;
+				if ( m_current != nullptr ) {
+					m_current->next = block;
+				} else {
+					m_first = block;
+				}
+				next = block;
+			}
+
+			m_current = next;
+			m_end = next->begin() + next->size;
+			return (char *)( ( (size_t)next->begin() + alignment - 1 ) & ~( alignment - 1 ) );
+		}
+
+		void Arena::reset( Marker marker ) {
+			if ( marker.block == nullptr ) {
+				reset();
+			} else {
+				m_current = (Block *)marker.block;
+				m_position = marker.position;
+				m_end = m_current->begin() + m_current->size;
+			}
+		}
+
+		void Arena::reset() {
+			m_current = m_first;
+			m_position = ( m_first != nullptr ) ? m_first->begin() : nullptr;
+			m_end = ( m_first != nullptr ) ? m_first->begin() + m_first->size : nullptr;
+		}
+
+		size_t Arena::bytesUsed() const {
+			if ( m_current == nullptr ) return 0;
+			size_t used = 0;
+			for ( Block * block = m_first; block != m_current; block = block->next ) used += block->size;
+			return used + size_t( m_position - m_current->begin() );
+		}
+
+		size_t Arena::bytesReserved() const {
+			size_t reserved = 0;
+			for ( Block * block = m_first; block != nullptr; block = block->next ) reserved += block->size;
+			return reserved;
+		}
+
+		Arena & scratchArena() {
+			static thread_local Arena arena;
+			return arena;
+		}
+
+		// --------------------------------------------------------------------------------------------------------------------
+		// FixedPool
+		// --------------------------------------------------------------------------------------------------------------------
+
+		// Index of the highest set bit of value, which must not be 0
+		static inline unsigned int FixedPool_HighestBit( unsigned int value ) {
+#if defined( _MSC_VER )
+			unsigned long highest;
+			_BitScanReverse( &highest, value );
+			return (unsigned int)highest;
+#else
+			return 31 - __builtin_clz( value );
+#endif
+		}
+
+		FixedPool::FixedPool( size_t blockSize, size_t alignment, unsigned int blocksPerChunk ) : m_head( 0 ), m_chunkCount( 0 ) {
+			m_alignment = std::max< size_t >( alignment, 1 );
+			m_blockSize = ( std::max< size_t >( blockSize, 1 ) + m_alignment - 1 ) & ~( m_alignment - 1 );
+			// Rounded down to a power of 2, and small enough for the indices of all chunks to fit in 32 bits
+			m_chunkShift = FixedPool_HighestBit( std::min( std::max( blocksPerChunk, 1u ), 1u << 15 ) );
+			for ( unsigned int i = 0; i < MaxChunks; i++ ) {
+				m_chunks[i].store( nullptr, std::memory_order_relaxed );
+				m_next[i] = nullptr;
+				m_memory[i] = nullptr;
+			}
+		}
+
+		FixedPool::~FixedPool() {
+			for ( unsigned int i = 0; i < MaxChunks; i++ ) {
+				size_t count = size_t( 1 ) << ( m_chunkShift + i );
+				Memory::deallocate( MemoryTag::Core, m_memory[i], count * m_blockSize + m_alignment );
+				Memory::deleteArray( MemoryTag::Core, m_next[i], count );
+			}
+		}
+
+		void * FixedPool::allocate() {
+			void * block;
+			allocate( &block, 1 );
+			return block;
+		}
+
+		void FixedPool::deallocate( void * block ) {
+			if ( block == nullptr ) return;
+			unsigned int index = indexOf( block );
+			push( index, index );
+		}
+
+		void FixedPool::allocate( void ** blocks, unsigned int count ) {
+			unsigned long long head = m_head.load( std::memory_order_acquire );
+			while ( count > 0 ) {
+				if ( (unsigned int)head == 0 ) {
+					grow();
+					head = m_head.load( std::memory_order_acquire );
+					continue;
+				}
+
+				// Follow the stack down count blocks; if another thread pops or pushes meanwhile, the links may be stale, but then the
+				// counter has changed and the exchange fails
+				unsigned int chunkCount = m_chunkCount.load( std::memory_order_acquire );
+				unsigned int taken = 0, next = (unsigned int)head;
+				while ( taken < count && next != 0 ) {
+					unsigned int index = next - 1;
+					unsigned int chunk = FixedPool_HighestBit( ( index >> m_chunkShift ) + 1 );
+					if ( chunk >= chunkCount ) break;
+					unsigned int offset = index - firstIndex( chunk );
+					blocks[ taken++ ] = m_chunks[ chunk ].load( std::memory_order_relaxed ) + offset * m_blockSize;
+					next = m_next[ chunk ][ offset ].load( std::memory_order_relaxed );
+				}
+
+				unsigned long long exchanged = ( ( ( head >> 32 ) + 1 ) << 32 ) | next;
+				if ( m_head.compare_exchange_weak( head, exchanged, std::memory_order_acquire, std::memory_order_acquire ) ) {
+					blocks += taken;
+					count -= taken;
+				}
+			}
+		}
+
+		void FixedPool::deallocate( void * const * blocks, unsigned int count ) {
+			if ( count == 0 ) return;
+			// Chain the blocks in order, and push them all at once
+			unsigned int first = indexOf( blocks[0] ), last = first;
+			for ( unsigned int i = 1; i < count; i++ ) {
+				unsigned int index = indexOf( blocks[i] );
+				unsigned int chunk = FixedPool_HighestBit( ( last >> m_chunkShift ) + 1 );
+				m_next[ chunk ][ last - firstIndex( chunk ) ].store( index + 1, std::memory_order_relaxed );
+				last = index;
+			}
+			push( first, last );
+		}
+
+		void FixedPool::push( unsigned int first, unsigned int last ) {
+			unsigned int chunk = FixedPool_HighestBit( ( last >> m_chunkShift ) + 1 );
+			std::atomic< unsigned int > & link = m_next[ chunk ][ last - firstIndex( chunk ) ];
+			unsigned long long head = m_head.load( std::memory_order_relaxed );
+			unsigned long long exchanged;
+			do {
+				link.store( (unsigned int)head, std::memory_order_relaxed );
+				exchanged = ( ( ( head >> 32 ) + 1 ) << 32 ) | ( first + 1 );
+			} while ( !m_head.compare_exchange_weak( head, exchanged, std::memory_order_release, std::memory_order_relaxed ) );
+		}
+
+		unsigned int FixedPool::chunkOf( const void * block ) const {
+			unsigned int count = m_chunkCount.load( std::memory_order_acquire );
+			for ( unsigned int i = 0; i < count; i++ ) {
+				const char * begin = m_chunks[i].load( std::memory_order_relaxed );
+				if ( block >= begin && block < begin + ( size_t( 1 ) << ( m_chunkShift + i ) ) * m_blockSize ) return i;
+			}
+			return MaxChunks;
+		}
+
+		unsigned int FixedPool::indexOf( const void * block ) const {
+			unsigned int chunk = chunkOf( block );
+			size_t offset = size_t( (const char *)block - m_chunks[ chunk ].load( std::memory_order_relaxed ) );
+			return firstIndex( chunk ) + (unsigned int)( offset / m_blockSize );
+		}
+
+		size_t FixedPool::capacity() const {
+			return firstIndex( m_chunkCount.load( std::memory_order_acquire ) );
+		}
+
+		void FixedPool::grow() {
+			std::lock_guard< std::mutex > lock( m_growMutex );
+			if ( (unsigned int)m_head.load( std::memory_order_acquire ) != 0 ) return;		// another thread has grown the pool, or blocks were freed
+			unsigned int chunk = m_chunkCount.load( std::memory_order_relaxed );
+			if ( chunk == MaxChunks ) throw std::bad_alloc();
+
+			size_t count = size_t( 1 ) << ( m_chunkShift + chunk );
+			m_memory[ chunk ] = Memory::allocate( MemoryTag::Core, count * m_blockSize + m_alignment );
+			char * blocks = (char *)( ( (size_t)m_memory[ chunk ] + m_alignment - 1 ) & ~( m_alignment - 1 ) );
+			m_next[ chunk ] = Memory::newArray< std::atomic< unsigned int > >( MemoryTag::Core, count );
+
+			unsigned int first = firstIndex( chunk );
+			for ( size_t i = 0; i + 1 < count; i++ ) m_next[ chunk ][i].store( first + (unsigned int)i + 2, std::memory_order_relaxed );
+			m_chunks[ chunk ].store( blocks, std::memory_order_relaxed );
+			m_chunkCount.store( chunk + 1, std::memory_order_release );
+			push( first, first + (unsigned int)count - 1 );
+		}
+
+	}
+}
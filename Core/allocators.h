@@ -0,0 +1,252 @@
+
+#ifndef Rocket_Core_Allocators_H
+#define Rocket_Core_Allocators_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace Rocket {
+	namespace Core {
+
+		// Linear allocator: each allocation bumps a pointer through blocks of memory, and everything is freed at once by reset()
+		// Blocks are kept for reuse, so an arena that is reset every frame stops allocating once it has held the largest frame.
+		// Destructors are not called, and an Arena must only be used by one thread at a time.
+		class Arena {
+		public:
+			static const size_t DefaultBlockSize = 64 * 1024;
+
+			// A position in the arena, to free everything allocated after it
+			struct Marker {
+				void * block;
+				char * position;
+			};
+
+			explicit Arena( size_t blockSize = DefaultBlockSize );
+			~Arena();
+
+			// Allocations larger than the block size get a block of their own
+			void * allocate( size_t size, size_t alignment = alignof( std::max_align_t ) ) {
+				char * p = (char *)( ( (size_t)m_position + alignment - 1 ) & ~( alignment - 1 ) );
+				if ( m_current == nullptr || p > m_end || size > size_t( m_end - p ) ) p = grow( size, alignment );
+				m_position = p + size;
+				return p;
+			}
+			template < typename T >
+			T * allocate( size_t count = 1 ) { return (T *)allocate( count * sizeof( T ), alignof( T ) ); }
+
+			Marker mark() const { Marker marker = { m_current, m_position }; return marker; }
+			// Frees everything allocated since marker was taken
+			void reset( Marker marker );
+			// Frees everything
+			void reset();
+
+			size_t bytesUsed() const;		// allocated since the last reset, including alignment padding
+			size_t bytesReserved() const;	// in all blocks
+
+		private:
+			struct alignas( 16 ) Block {
+				Block * next;
+				size_t size;
+				char * begin() { return (char *)( this + 1 ); }
+			};
+
+			Arena( const Arena & ) = delete;
+			Arena & operator = ( const Arena & ) = delete;
+
+			char * grow( size_t size, size_t alignment );
+
+			Block * m_first;				// blocks in the order they are used
+			Block * m_current;
+			char * m_position;
+			char * m_end;
+			size_t m_blockSize;
+		};
+
+		// Frees everything allocated in arena during its lifetime
+		class ArenaScope {
+		public:
+			explicit ArenaScope( Arena & arena ) : m_arena( arena ), m_marker( arena.mark() ) {}
+			~ArenaScope() { m_arena.reset( m_marker ); }
+
+		private:
+			ArenaScope( const ArenaScope & ) = delete;
+			ArenaScope & operator = ( const ArenaScope & ) = delete;
+
+			Arena & m_arena;
+			Arena::Marker m_marker;
+		};
+
+		// Arena of the calling thread for temporaries; allocate from it inside an ArenaScope, so that every user frees only its own
+		Arena & scratchArena();
+
+		// Pool of blocks of one size, allocated and freed by any thread without locking
+		// The free blocks form a stack whose head carries a counter, so that a block popped and pushed again between the read and the
+		// exchange of another thread's pop is noticed (ABA). The pool grows by chunks of twice as many blocks as the previous one,
+		// which are only freed with the pool.
+		class FixedPool {
+		public:
+			FixedPool( size_t blockSize, size_t alignment = alignof( std::max_align_t ), unsigned int blocksPerChunk = 256 );
+			~FixedPool();
+
+			void * allocate();
+			// blocks must come from this pool
+			void deallocate( void * block );
+
+			// Moves count blocks in or out of the pool with a single exchange
+			void allocate( void ** blocks, unsigned int count );
+			void deallocate( void * const * blocks, unsigned int count );
+
+			bool owns( const void * block ) const { return chunkOf( block ) < MaxChunks; }
+			size_t blockSize() const { return m_blockSize; }
+			size_t capacity() const;		// blocks in all chunks
+
+		private:
+			static const unsigned int MaxChunks = 16;
+
+			FixedPool( const FixedPool & ) = delete;
+			FixedPool & operator = ( const FixedPool & ) = delete;
+
+			unsigned int firstIndex( unsigned int chunk ) const { return ( ( 1u << chunk ) - 1 ) << m_chunkShift; }
+			unsigned int chunkOf( const void * block ) const;
+			unsigned int indexOf( const void * block ) const;
+			void push( unsigned int first, unsigned int last );
+			void grow();
+
+			// Counter in the upper 32 bits and the index + 1 of the first free block in the lower ones (0 when there is none)
+			std::atomic< unsigned long long > m_head;
+			std::atomic< unsigned int > m_chunkCount;
+			std::atomic< char * > m_chunks[ MaxChunks ];
+			std::atomic< unsigned int > * m_next[ MaxChunks ];		// index + 1 of the free block below each block
+			void * m_memory[ MaxChunks ];
+			std::mutex m_growMutex;
+			size_t m_blockSize;			// rounded up to the alignment
+			size_t m_alignment;
+			unsigned int m_chunkShift;	// the first chunk has 2^m_chunkShift blocks
+		};
+
+		// Pool shared by everything that allocates blocks of Size bytes aligned to Alignment
+		// Each thread keeps up to CacheSize free blocks, and moves half of them at a time to and from the FixedPool, so that most
+		// allocations touch nothing shared. The pool is never destroyed, as blocks may be freed during exit.
+		template < size_t Size, size_t Alignment >
+		class SharedPool {
+		public:
+			static const unsigned int CacheSize = 32;
+
+			static void * allocate() {
+				Cache & cache = t_cache;
+				if ( cache.count == 0 ) {
+					if ( cache.state != Cache::Active && !activate() ) return pool().allocate();
+					pool().allocate( cache.blocks, CacheSize / 2 );
+					cache.count = CacheSize / 2;
+				}
+				return cache.blocks[ --cache.count ];
+			}
+
+			static void deallocate( void * block ) {
+				Cache & cache = t_cache;
+				if ( cache.count == CacheSize ) {
+					pool().deallocate( cache.blocks + CacheSize / 2, CacheSize / 2 );
+					cache.count = CacheSize / 2;
+				} else if ( cache.state != Cache::Active && !activate() ) {
+					pool().deallocate( block );
+					return;
+				}
+				cache.blocks[ cache.count++ ] = block;
+			}
+
+			static FixedPool & pool() {
+				static FixedPool * pool = new FixedPool( Size, Alignment );
+				return *pool;
+			}
+
+		private:
+			// Plain data, so that it needs no construction and can still be used by destructors that run after the thread's exit
+			struct Cache {
+				enum State { Unused = 0, Active, Exited };
+				void * blocks[ CacheSize ];
+				unsigned int count;
+				unsigned int state;
+			};
+			// Returns the cached blocks when the thread exits
+			struct Flush {
+				~Flush() {
+					pool().deallocate( t_cache.blocks, t_cache.count );
+					t_cache.count = 0;
+					t_cache.state = Cache::Exited;
+				}
+			};
+
+			// Returns false once the thread has exited
+			static bool activate() {
+				if ( t_cache.state == Cache::Exited ) return false;
+				static thread_local Flush flush;
+				(void)flush;
+				t_cache.state = Cache::Active;
+				return true;
+			}
+
+			static thread_local Cache t_cache;
+		};
+
+		template < size_t Size, size_t Alignment >
+		thread_local typename SharedPool< Size, Alignment >::Cache SharedPool< Size, Alignment >::t_cache;
+
+		// Standard allocator from an Arena: deallocate() does nothing, and the memory is freed when the arena is reset
+		template < typename T >
+		class ArenaAllocator {
+		public:
+			typedef T value_type;
+
+			explicit ArenaAllocator( Arena & arena ) : m_arena( &arena ) {}
+			template < typename U >
+			ArenaAllocator( const ArenaAllocator< U > & other ) : m_arena( other.arena() ) {}
+
+			T * allocate( size_t count ) { return m_arena->allocate< T >( count ); }
+			void deallocate( T *, size_t ) {}
+
+			Arena * arena() const { return m_arena; }
+
+		private:
+			Arena * m_arena;
+		};
+
+		template < typename T, typename U >
+		bool operator == ( const ArenaAllocator< T > & a, const ArenaAllocator< U > & b ) { return a.arena() == b.arena(); }
+		template < typename T, typename U >
+		bool operator != ( const ArenaAllocator< T > & a, const ArenaAllocator< U > & b ) { return a.arena() != b.arena(); }
+
+		// Standard allocator that takes single objects from the SharedPool of their size, e.g. the nodes of a std::list or the
+		// object and reference counts of std::allocate_shared; arrays come from operator new
+		template < typename T >
+		class PoolAllocator {
+		public:
+			typedef T value_type;
+
+			PoolAllocator() {}
+			template < typename U >
+			PoolAllocator( const PoolAllocator< U > & ) {}
+
+			T * allocate( size_t count ) {
+				if ( count == 1 ) return (T *)SharedPool< sizeof( T ), alignof( T ) >::allocate();
+				return (T *)::operator new( count * sizeof( T ) );
+			}
+			void deallocate( T * p, size_t count ) {
+				if ( count == 1 ) {
+					SharedPool< sizeof( T ), alignof( T ) >::deallocate( p );
+				} else {
+					::operator delete( p );
+				}
+			}
+		};
+
+		template < typename T, typename U >
+		bool operator == ( const PoolAllocator< T > &, const PoolAllocator< U > & ) { return true; }
+		template < typename T, typename U >
+		bool operator != ( const PoolAllocator< T > &, const PoolAllocator< U > & ) { return false; }
+
+	}
+}
+
+#endif
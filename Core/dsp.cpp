@@ -1,88 +1,714 @@
-
 #include "dsp.h"
 
 #include <math.h>
+#include <string.h>
+#include <assert.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#if defined( __AVX__ )
+#include <immintrin.h>
+#elif defined( __SSE3__ )
+#include <pmmintrin.h>
+#define ROCKET_DSP_SSE
+#elif defined( __SSE2__ ) || defined( _M_X64 )
+#include <emmintrin.h>
+#define ROCKET_DSP_SSE
+#endif
 
 namespace Rocket {
 	namespace DigitalSignalProcessing {
 
-		// Fast Fourier Transform
-		// FourierDecimation must be a power of 2
-		ComplexData * FFT( ComplexData * data, unsigned int FourierDecimation ) {
-			if ( FourierDecimation == 1 ) {
-				return data;
+		static const double TwoPi = 6.283185307179586476925;
+
+		// Complex numbers in SIMD registers, stored the same way as ComplexData (real, imaginary)
+#if defined( __AVX__ )
+		// 2 complex numbers
+		typedef __m256d complexes;
+		static const unsigned int ComplexLanes = 2;
+		static inline complexes complexes_load( const ComplexData * p ) { return _mm256_loadu_pd( &p->r ); }
+		static inline void complexes_store( ComplexData * p, complexes v ) { _mm256_storeu_pd( &p->r, v ); }
+		static inline complexes complexes_set( double r, double i ) { return _mm256_setr_pd( r, i, r, i ); }
+		static inline complexes complexes_add( complexes a, complexes b ) { return _mm256_add_pd( a, b ); }
+		static inline complexes complexes_sub( complexes a, complexes b ) { return _mm256_sub_pd( a, b ); }
+		// a * w
+		static inline complexes complexes_multiply( complexes a, complexes w ) {
+			complexes products = _mm256_mul_pd( _mm256_permute_pd( a, 0x5 ), _mm256_permute_pd( w, 0xF ) );		// ( a.i * w.i, a.r * w.i )
+#if defined( __FMA__ )
+			return _mm256_fmaddsub_pd( a, _mm256_movedup_pd( w ), products );
+#else
+			return _mm256_addsub_pd( _mm256_mul_pd( a, _mm256_movedup_pd( w ) ), products );
+#endif
+		}
+		// ( a.i * signs.r, a.r * signs.i ), which is a * -i for signs ( 1, -1 ) and a * i for signs ( -1, 1 )
+		static inline complexes complexes_rotate( complexes a, complexes signs ) { return _mm256_mul_pd( _mm256_permute_pd( a, 0x5 ), signs ); }
+#elif defined( ROCKET_DSP_SSE )
+		// 1 complex number
+		typedef __m128d complexes;
+		static const unsigned int ComplexLanes = 1;
+		static inline complexes complexes_load( const ComplexData * p ) { return _mm_loadu_pd( &p->r ); }
+		static inline void complexes_store( ComplexData * p, complexes v ) { _mm_storeu_pd( &p->r, v ); }
+		static inline complexes complexes_set( double r, double i ) { return _mm_setr_pd( r, i ); }
+		static inline complexes complexes_add( complexes a, complexes b ) { return _mm_add_pd( a, b ); }
+		static inline complexes complexes_sub( complexes a, complexes b ) { return _mm_sub_pd( a, b ); }
+		static inline complexes complexes_multiply( complexes a, complexes w ) {
+			complexes products = _mm_mul_pd( _mm_shuffle_pd( a, a, 1 ), _mm_unpackhi_pd( w, w ) );
+#if defined( __SSE3__ )
+			return _mm_addsub_pd( _mm_mul_pd( a, _mm_unpacklo_pd( w, w ) ), products );
+#else
+			return _mm_add_pd( _mm_mul_pd( a, _mm_unpacklo_pd( w, w ) ), _mm_xor_pd( products, _mm_setr_pd( -0.0, 0.0 ) ) );
+#endif
+		}
+		static inline complexes complexes_rotate( complexes a, complexes signs ) { return _mm_mul_pd( _mm_shuffle_pd( a, a, 1 ), signs ); }
+#else
+		// 1 complex number
+		typedef ComplexData complexes;
+		static const unsigned int ComplexLanes = 1;
+		static inline complexes complexes_load( const ComplexData * p ) { return *p; }
+		static inline void complexes_store( ComplexData * p, complexes v ) { *p = v; }
+		static inline complexes complexes_set( double r, double i ) { complexes c = { r, i }; return c; }
+		static inline complexes complexes_add( complexes a, complexes b ) { return complexes_set( a.r + b.r, a.i + b.i ); }
+		static inline complexes complexes_sub( complexes a, complexes b ) { return complexes_set( a.r - b.r, a.i - b.i ); }
+		static inline complexes complexes_multiply( complexes a, complexes w ) { return complexes_set( a.r * w.r - a.i * w.i, a.i * w.r + a.r * w.i ); }
+		static inline complexes complexes_rotate( complexes a, complexes signs ) { return complexes_set( a.i * signs.r, a.r * signs.i ); }
+#endif
+
+		// Real samples in SIMD registers, for the filters
+#if defined( __AVX__ )
+		typedef __m256d doubles;
+		static const unsigned int DoubleLanes = 4;
+		static inline doubles doubles_load( const double * p ) { return _mm256_loadu_pd( p ); }
+		static inline void doubles_store( double * p, doubles v ) { _mm256_storeu_pd( p, v ); }
+		static inline doubles doubles_set( double v ) { return _mm256_set1_pd( v ); }
+		static inline doubles doubles_sub( doubles a, doubles b ) { return _mm256_sub_pd( a, b ); }
+		// a * b + c
+		static inline doubles doubles_madd( doubles a, doubles b, doubles c ) {
+#if defined( __FMA__ )
+			return _mm256_fmadd_pd( a, b, c );
+#else
+			return _mm256_add_pd( _mm256_mul_pd( a, b ), c );
+#endif
+		}
+		static inline double doubles_sum( doubles v ) {
+			__m128d pair = _mm_add_pd( _mm256_castpd256_pd128( v ), _mm256_extractf128_pd( v, 1 ) );
+			return _mm_cvtsd_f64( _mm_add_sd( pair, _mm_unpackhi_pd( pair, pair ) ) );
+		}
+#elif defined( ROCKET_DSP_SSE )
+		typedef __m128d doubles;
+		static const unsigned int DoubleLanes = 2;
+		static inline doubles doubles_load( const double * p ) { return _mm_loadu_pd( p ); }
+		static inline void doubles_store( double * p, doubles v ) { _mm_storeu_pd( p, v ); }
+		static inline doubles doubles_set( double v ) { return _mm_set1_pd( v ); }
+		static inline doubles doubles_sub( doubles a, doubles b ) { return _mm_sub_pd( a, b ); }
+		static inline doubles doubles_madd( doubles a, doubles b, doubles c ) { return _mm_add_pd( _mm_mul_pd( a, b ), c ); }
+		static inline double doubles_sum( doubles v ) { return _mm_cvtsd_f64( _mm_add_sd( v, _mm_unpackhi_pd( v, v ) ) ); }
+#else
+		typedef double doubles;
+		static const unsigned int DoubleLanes = 1;
+		static inline doubles doubles_load( const double * p ) { return *p; }
+		static inline void doubles_store( double * p, doubles v ) { *p = v; }
+		static inline doubles doubles_set( double v ) { return v; }
+		static inline doubles doubles_sub( doubles a, doubles b ) { return a - b; }
+		static inline doubles doubles_madd( doubles a, doubles b, doubles c ) { return a * b + c; }
+		static inline double doubles_sum( doubles v ) { return v; }
+#endif
+
+		// The transform is decimation in time: the input is put in bit-reversed order, after which each stage combines
+		// sub-transforms of size quarter into transforms of size 4 * quarter (or 2 * quarter for a first radix-2 stage when
+		// log2( size ) is odd). In bit-reversed order, the sub-transforms of the elements n = 4j + 0, 1, 2, 3 are stored at
+		// offsets 0, 2, 1, 3 times quarter.
+
+		// First stage when log2( size ) is odd: transforms of size 2
+		static void radix2FirstStage( ComplexData * data, unsigned int size ) {
+			for ( unsigned int n = 0; n < size; n += 2 ) {
+				ComplexData a = data[n], b = data[n + 1];
+				data[n].r = a.r + b.r;
+				data[n].i = a.i + b.i;
+				data[n + 1].r = a.r - b.r;
+				data[n + 1].i = a.i - b.i;
+			}
+		}
+
+		// First stage when log2( size ) is even: transforms of size 4, which need no twiddles
+		static void radix4FirstStage( ComplexData * data, unsigned int size, complexes signs ) {
+			for ( unsigned int n = 0; n < size; n += 4 ) {
+#if defined( __AVX__ )
+				// Both halves of a register at once: ( t0, t1 ) = ( p0 + p1, p0 - p1 ) and ( t2, t3 ) = ( p2 + p3, rotate( p2 - p3 ) )
+				const __m256d negateHigh = _mm256_setr_pd( 1.0, 1.0, -1.0, -1.0 );
+				__m256d p01 = complexes_load( data + n ), p23 = complexes_load( data + n + 2 );
+				__m256d t01 = _mm256_add_pd( _mm256_permute2f128_pd( p01, p01, 0x00 ), _mm256_mul_pd( _mm256_permute2f128_pd( p01, p01, 0x11 ), negateHigh ) );
+				__m256d t23 = _mm256_add_pd( _mm256_permute2f128_pd( p23, p23, 0x00 ), _mm256_mul_pd( _mm256_permute2f128_pd( p23, p23, 0x11 ), negateHigh ) );
+				t23 = _mm256_blend_pd( t23, complexes_rotate( t23, signs ), 0xC );
+				complexes_store( data + n, complexes_add( t01, t23 ) );
+				complexes_store( data + n + 2, complexes_sub( t01, t23 ) );
+#else
+				complexes p0 = complexes_load( data + n ), p1 = complexes_load( data + n + 1 );
+				complexes p2 = complexes_load( data + n + 2 ), p3 = complexes_load( data + n + 3 );
+				complexes t0 = complexes_add( p0, p1 ), t1 = complexes_sub( p0, p1 );
+				complexes t2 = complexes_add( p2, p3 ), t3 = complexes_rotate( complexes_sub( p2, p3 ), signs );
+				complexes_store( data + n, complexes_add( t0, t2 ) );
+				complexes_store( data + n + 1, complexes_add( t1, t3 ) );
+				complexes_store( data + n + 2, complexes_sub( t0, t2 ) );
+				complexes_store( data + n + 3, complexes_sub( t1, t3 ) );
+#endif
+			}
+		}
+
+		// Later stages: quarter is a multiple of ComplexLanes, and twiddles holds W^k, then W^2k, then W^3k for k < quarter
+		static void radix4Stage( ComplexData * data, unsigned int size, unsigned int quarter, const ComplexData * twiddles, complexes signs ) {
+			const ComplexData * w1 = twiddles;
+			const ComplexData * w2 = twiddles + quarter;
+			const ComplexData * w3 = twiddles + 2*quarter;
+			for ( unsigned int base = 0; base < size; base += 4*quarter ) {
+				ComplexData * p0 = data + base;
+				ComplexData * p1 = p0 + quarter;
+				ComplexData * p2 = p1 + quarter;
+				ComplexData * p3 = p2 + quarter;
+				for ( unsigned int k = 0; k < quarter; k += ComplexLanes ) {
+					complexes a0 = complexes_load( p0 + k );
+					complexes a1 = complexes_multiply( complexes_load( p2 + k ), complexes_load( w1 + k ) );
+					complexes a2 = complexes_multiply( complexes_load( p1 + k ), complexes_load( w2 + k ) );
+					complexes a3 = complexes_multiply( complexes_load( p3 + k ), complexes_load( w3 + k ) );
+					complexes t0 = complexes_add( a0, a2 );
+					complexes t1 = complexes_sub( a0, a2 );
+					complexes t2 = complexes_add( a1, a3 );
+					complexes t3 = complexes_rotate( complexes_sub( a1, a3 ), signs );
+					complexes_store( p0 + k, complexes_add( t0, t2 ) );
+					complexes_store( p1 + k, complexes_add( t1, t3 ) );
+					complexes_store( p2 + k, complexes_sub( t0, t2 ) );
+					complexes_store( p3 + k, complexes_sub( t1, t3 ) );
+				}
+			}
+		}
+
+		FFTPlan::FFTPlan( unsigned int size, Direction direction ) : m_size( size ), m_log2Size( 0 ), m_direction( direction ) {
+			assert( size > 0 && ( size & ( size - 1 ) ) == 0 );
+			while ( ( 1u << m_log2Size ) < size ) m_log2Size++;
+
+			m_bitReverse.resize( size );
+			m_bitReverse[0] = 0;
+			for ( unsigned int n = 1; n < size; n++ ) m_bitReverse[n] = ( m_bitReverse[n >> 1] >> 1 ) | ( ( n & 1 ) << ( m_log2Size - 1 ) );
+
+			double sign = ( direction == Forward ) ? -1.0 : 1.0;
+			for ( unsigned int stageSize = ( m_log2Size % 2 == 1 ) ? 8 : 16; stageSize <= size; stageSize *= 4 ) {
+				unsigned int quarter = stageSize / 4;
+				for ( unsigned int power = 1; power <= 3; power++ ) {
+					for ( unsigned int k = 0; k < quarter; k++ ) {
+						double angle = sign * TwoPi * ( power * k ) / stageSize;
+						ComplexData w = { cos( angle ), sin( angle ) };
+						m_twiddles.push_back( w );
+					}
+				}
+			}
+		}
+
+		void FFTPlan::butterflies( ComplexData * data ) const {
+			if ( m_size < 2 ) return;
+
+			// Multiplying by -i for forward transforms and by i for inverse transforms (see complexes_rotate())
+			complexes signs = ( m_direction == Forward ) ? complexes_set( 1.0, -1.0 ) : complexes_set( -1.0, 1.0 );
+			unsigned int stageSize;
+			if ( m_log2Size % 2 == 1 ) {
+				radix2FirstStage( data, m_size );
+				stageSize = 2;
 			} else {
-				unsigned int halfDecimation = FourierDecimation / 2;
-				double pi2oDecimation = 6.28318 / ( FourierDecimation * 1.0f ); //+1.570795
+				radix4FirstStage( data, m_size, signs );
+				stageSize = 4;
+			}
 
-				ComplexData * output = new ComplexData[ FourierDecimation ];
-				ComplexData * spliteven = new ComplexData[ halfDecimation ];
-				ComplexData * splitodd = new ComplexData[ halfDecimation ];
+			const ComplexData * twiddles = m_twiddles.data();
+			for ( stageSize *= 4; stageSize <= m_size; stageSize *= 4 ) {
+				unsigned int quarter = stageSize / 4;
+				radix4Stage( data, m_size, quarter, twiddles, signs );
+				twiddles += 3*quarter;
+			}
+		}
 
-				for ( unsigned int i = 0; i < halfDecimation; i++ ) {
-					spliteven[i].r = data[ i*2 ].r;
-					spliteven[i].i = data[ i*2 ].i;
+		void FFTPlan::execute( ComplexData * data ) const {
+			for ( unsigned int n = 0; n < m_size; n++ ) {
+				unsigned int r = m_bitReverse[n];
+				if ( n < r ) {
+					ComplexData swap = data[n];
+					data[n] = data[r];
+					data[r] = swap;
 				}
-				ComplexData * even = FFT( spliteven, halfDecimation );
+			}
+			butterflies( data );
+		}
+
+		void FFTPlan::execute( const ComplexData * input, ComplexData * output ) const {
+			for ( unsigned int n = 0; n < m_size; n++ ) output[ m_bitReverse[n] ] = input[n];
+			butterflies( output );
+		}
+
+		void FFTPlan::executeBatch( const ComplexData * input, ComplexData * output, unsigned int count, unsigned int threadCount ) const {
+			if ( threadCount == 0 ) threadCount = std::thread::hardware_concurrency();
+			if ( threadCount > count ) threadCount = count;
+			if ( threadCount == 0 ) threadCount = 1;
+
+			// Threads take runs of frames in order until there are none left; each run is about 64 KB of frames
+			const unsigned int runLength = ( m_size >= 4096 ) ? 1 : 4096 / m_size;
+			std::atomic< unsigned int > nextRun( 0 );
+			auto worker = [&]() {
+				for ( unsigned int first = runLength * nextRun++; first < count; first = runLength * nextRun++ ) {
+					unsigned int last = ( first + runLength < count ) ? first + runLength : count;
+					for ( unsigned int frame = first; frame < last; frame++ ) {
+						if ( input == output ) {
+							execute( output + frame * m_size );
+						} else {
+							execute( input + frame * m_size, output + frame * m_size );
+						}
+					}
+				}
+			};
+			std::vector< std::thread > threads;
+			for ( unsigned int t = 1; t < threadCount; t++ ) threads.push_back( std::thread( worker ) );
+			worker();
+			for ( unsigned int t = 0; t < threads.size(); t++ ) threads[t].join();
+		}
+
+		// Forward transform of x[0..size) through the complex transform Z of z[n] = x[2n] + i x[2n + 1], of size M = size / 2:
+		// with E[k] = ( Z[k] + conj( Z[M - k] ) ) / 2 and O[k] = ( Z[k] - conj( Z[M - k] ) ) / 2i (the transforms of the even
+		// and odd samples), X[k] = E[k] + W^k O[k] and X[M - k] = conj( E[k] - W^k O[k] )
+		RealFFTPlan::RealFFTPlan( unsigned int size, FFTPlan::Direction direction ) : m_size( size ), m_half( size / 2, direction ) {
+			assert( size >= 2 );
+			for ( unsigned int k = 0; k <= size / 4; k++ ) {
+				double angle = -TwoPi * k / size;
+				ComplexData w = { cos( angle ), sin( angle ) };
+				m_twiddles.push_back( w );
+			}
+		}
+
+		void RealFFTPlan::execute( const double * input, ComplexData * output ) const {
+			static_assert( sizeof( ComplexData ) == 2 * sizeof( double ), "pairs of real samples are transformed as complex numbers" );
+			assert( direction() == FFTPlan::Forward );
+			unsigned int half = m_size / 2;
+			m_half.execute( (const ComplexData *)input, output );
+
+			ComplexData z0 = output[0];
+			output[0].r = z0.r + z0.i;
+			output[0].i = 0.0;
+			output[half].r = z0.r - z0.i;
+			output[half].i = 0.0;
+			for ( unsigned int k = 1; k <= half / 2; k++ ) {
+				ComplexData zk = output[k], zm = output[half - k];
+				double evenR = 0.5 * ( zk.r + zm.r ), evenI = 0.5 * ( zk.i - zm.i );
+				double oddR = 0.5 * ( zk.i + zm.i ), oddI = -0.5 * ( zk.r - zm.r );
+				const ComplexData & w = m_twiddles[k];
+				double twiddledR = w.r * oddR - w.i * oddI, twiddledI = w.r * oddI + w.i * oddR;
+				output[k].r = evenR + twiddledR;
+				output[k].i = evenI + twiddledI;
+				output[half - k].r = evenR - twiddledR;
+				output[half - k].i = twiddledI - evenI;
+			}
+		}
+
+		// Undoes the post-processing of the forward transform: Z[k] = E[k] + i W^-k O[k], with E[k] = X[k] + conj( X[half - k] )
+		// and O[k] = X[k] - conj( X[half - k] ), so that the inverse complex transform of Z gives size * ( x[2n] + i x[2n + 1] )
+		void RealFFTPlan::execute( const ComplexData * input, double * output ) const {
+			assert( direction() == FFTPlan::Inverse );
+			unsigned int half = m_size / 2;
+			ComplexData * z = (ComplexData *)output;
+
+			z[0].r = input[0].r + input[half].r;
+			z[0].i = input[0].r - input[half].r;
+			for ( unsigned int k = 1; k <= half / 2; k++ ) {
+				ComplexData xk = input[k], xm = input[half - k];
+				double evenR = xk.r + xm.r, evenI = xk.i - xm.i;
+				double oddR = xk.r - xm.r, oddI = xk.i + xm.i;
+				const ComplexData & w = m_twiddles[k];
+				double twiddledR = w.r * oddR + w.i * oddI, twiddledI = w.r * oddI - w.i * oddR;
+				z[k].r = evenR - twiddledI;
+				z[k].i = evenI + twiddledR;
+				z[half - k].r = evenR + twiddledI;
+				z[half - k].i = twiddledR - evenI;
+			}
+			m_half.execute( z );
+		}
 
-				for ( unsigned int i = 0; i < halfDecimation; i++) {
-					splitodd[i].r = data[ i*2 + 1 ].r;
-					splitodd[i].i = data[ i*2 + 1 ].i;
+		STFT::STFT( unsigned int frameSize, unsigned int hopSize, Window window, Bins bins ) :
+			m_plan( frameSize ), m_hopSize( hopSize ), m_bins( bins ),
+			m_window( frameSize ), m_frame( frameSize ), m_windowed( frameSize ), m_spectrum( frameSize / 2 + 1 ),
+			m_filled( 0 ), m_skip( 0 ) {
+			assert( hopSize > 0 );
+			// Periodic windows, so that overlapping frames sum to a constant
+			for ( unsigned int n = 0; n < frameSize; n++ ) {
+				double x = TwoPi * n / frameSize;
+				switch ( window ) {
+				case Rectangular: m_window[n] = 1.0; break;
+				case Hann: m_window[n] = 0.5 - 0.5 * cos( x ); break;
+				case Hamming: m_window[n] = 0.54 - 0.46 * cos( x ); break;
+				case Blackman: m_window[n] = 0.42 - 0.5 * cos( x ) + 0.08 * cos( 2.0 * x ); break;
 				}
-				ComplexData * odd = FFT( splitodd, halfDecimation );
-
-				for ( unsigned int k = 0; k < halfDecimation; k++ ) {
-					double A = pi2oDecimation * k;
-					double cosA = cos( A );
-					double sinA = sin( A );
-					double oddk_r = odd[k].r * cosA + odd[k].i * sinA;		//e^A = cosA + sinA
-					double oddk_i = -odd[k].r * sinA + odd[k].i * cosA;		//e^A = sinA - cosA
-					output[k].r = even[k].r + oddk_r;
-					output[k].i = even[k].i + oddk_i;
-					output[ k + halfDecimation ].r = even[k].r - oddk_r;
-					output[ k + halfDecimation ].i = even[k].i - oddk_i;
+			}
+		}
+
+		unsigned int STFT::frameCount( unsigned int count ) const {
+			unsigned int untilFrame = m_skip + ( frameSize() - m_filled );
+			if ( count < untilFrame ) return 0;
+			return 1 + ( count - untilFrame ) / m_hopSize;
+		}
+
+		unsigned int STFT::process( const double * samples, unsigned int count, double * output, unsigned int stride ) {
+			unsigned int size = frameSize();
+			unsigned int frames = 0;
+			unsigned int i = 0;
+			while ( i < count ) {
+				if ( m_skip > 0 ) {
+					unsigned int skipped = ( m_skip < count - i ) ? m_skip : count - i;
+					m_skip -= skipped;
+					i += skipped;
+					continue;
 				}
 
-				delete [] spliteven;
-				delete [] splitodd;
-				delete [] even;
-				delete [] odd;
-				return output;
+				unsigned int copied = ( size - m_filled < count - i ) ? size - m_filled : count - i;
+				for ( unsigned int n = 0; n < copied; n++ ) m_frame[ m_filled + n ] = samples[ ( i + n ) * stride ];
+				m_filled += copied;
+				i += copied;
+
+				if ( m_filled == size ) {
+					transformFrame( output + frames * binCount() );
+					frames++;
+					if ( m_hopSize < size ) {
+						memmove( m_frame.data(), m_frame.data() + m_hopSize, ( size - m_hopSize ) * sizeof( double ) );
+						m_filled = size - m_hopSize;
+					} else {
+						m_filled = 0;
+						m_skip = m_hopSize - size;
+					}
+				}
+			}
+			return frames;
+		}
+
+		void STFT::reset() {
+			m_filled = 0;
+			m_skip = 0;
+		}
+
+		void STFT::transformFrame( double * output ) {
+			for ( unsigned int n = 0; n < frameSize(); n++ ) m_windowed[n] = m_frame[n] * m_window[n];
+			m_plan.execute( m_windowed.data(), m_spectrum.data() );
+			for ( unsigned int k = 0; k < binCount(); k++ ) {
+				double power = m_spectrum[k].r * m_spectrum[k].r + m_spectrum[k].i * m_spectrum[k].i;
+				output[k] = ( m_bins == Power ) ? power : sqrt( power );
 			}
 		}
 
-		// generatePowerSpectrum() returns a two-dimensional array of the maximum power over that point of resolution
-		// data is a list of imaginary numbers (with real and imaginary components)
-		// N is the number of elements in data
-		// FourierDecimation is the decimation value used for the FFT (must be a power of 2)
-		// PowerResolution is the width of the power spectrum
-		double ** generatePowerSpectrum( ComplexData * data, unsigned int N, unsigned int FourierDecimation, unsigned int PowerResolution ) {
-			if ( PowerResolution > FourierDecimation ) PowerResolution = FourierDecimation;
+		// Filters and resamplers work through their input in blocks of this many frames
+		static const unsigned int FilterBlockSize = 256;
 
-			double ** power = new double*[ N ];
-			for ( unsigned int x = 0; x < N; x++ ) power[x] = new double[ PowerResolution ];
+		FIRFilter::FIRFilter( const double * coefficients, unsigned int tapCount, unsigned int channelCount ) :
+			m_channelCount( channelCount ), m_coefficients( coefficients, coefficients + tapCount ),
+			m_history( channelCount * ( tapCount - 1 + FilterBlockSize ), 0.0 ) {
+			assert( tapCount > 0 && channelCount > 0 );
+			std::reverse( m_coefficients.begin(), m_coefficients.end() );
+		}
 
-			for ( unsigned int row = 0; row < N/PowerResolution; row++ ) {
-				ComplexData * fftData = FFT( data, FourierDecimation );
-				int block = FourierDecimation / PowerResolution;
-				int shift = PowerResolution / 2;
+		void FIRFilter::process( const double * input, double * output, unsigned int frameCount ) {
+			const unsigned int taps = tapCount();
+			const unsigned int historyLength = taps - 1 + FilterBlockSize;
+			const double * c = m_coefficients.data();
+			for ( unsigned int start = 0; start < frameCount; start += FilterBlockSize ) {
+				unsigned int block = ( frameCount - start < FilterBlockSize ) ? frameCount - start : FilterBlockSize;
+				for ( unsigned int channel = 0; channel < m_channelCount; channel++ ) {
+					// x[n + k] is input n + k - ( taps - 1 ) of the block, which is multiplied by c[k]
+					double * x = &m_history[ channel * historyLength ];
+					const double * in = input + start * m_channelCount + channel;
+					double * out = output + start * m_channelCount + channel;
+					for ( unsigned int n = 0; n < block; n++ ) x[ taps - 1 + n ] = in[ n * m_channelCount ];
 
-				for ( unsigned int y = 0; y < PowerResolution; y++ ) {
-					double max = 0.0;
-					for ( unsigned int x = y*block; x < y*block + block; x++ ) {
-						double nm = fftData[x].r * fftData[x].r  +  fftData[x].i * fftData[x].i;
-						if (nm > max) max = nm;
+					// Several outputs per register, with the coefficients broadcast
+					double sums[ 4 * DoubleLanes ];
+					unsigned int n = 0;
+					for ( ; n + 4 * DoubleLanes <= block; n += 4 * DoubleLanes ) {
+						doubles s0 = doubles_set( 0.0 ), s1 = s0, s2 = s0, s3 = s0;
+						for ( unsigned int k = 0; k < taps; k++ ) {
+							doubles ck = doubles_set( c[k] );
+							const double * xk = x + n + k;
+							s0 = doubles_madd( ck, doubles_load( xk ), s0 );
+							s1 = doubles_madd( ck, doubles_load( xk + DoubleLanes ), s1 );
+							s2 = doubles_madd( ck, doubles_load( xk + 2 * DoubleLanes ), s2 );
+							s3 = doubles_madd( ck, doubles_load( xk + 3 * DoubleLanes ), s3 );
+						}
+						doubles_store( sums, s0 );
+						doubles_store( sums + DoubleLanes, s1 );
+						doubles_store( sums + 2 * DoubleLanes, s2 );
+						doubles_store( sums + 3 * DoubleLanes, s3 );
+						for ( unsigned int i = 0; i < 4 * DoubleLanes; i++ ) out[ ( n + i ) * m_channelCount ] = sums[i];
+					}
+					for ( ; n < block; n++ ) {
+						double sum = 0.0;
+						for ( unsigned int k = 0; k < taps; k++ ) sum += c[k] * x[ n + k ];
+						out[ n * m_channelCount ] = sum;
 					}
-					if ( y >= PowerResolution / 2 ) shift = -(int)(PowerResolution / 2);
 
-					power[ row ][ y+shift ] = max;
+					memmove( x, x + block, ( taps - 1 ) * sizeof( double ) );
 				}
+			}
+		}
+
+		void FIRFilter::reset() {
+			std::fill( m_history.begin(), m_history.end(), 0.0 );
+		}
+
+		static BiquadCoefficients normalizedBiquad( double b0, double b1, double b2, double a0, double a1, double a2 ) {
+			BiquadCoefficients c = { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+			return c;
+		}
+
+		BiquadCoefficients BiquadCoefficients::lowPass( double sampleRate, double frequency, double q ) {
+			double w = TwoPi * frequency / sampleRate, cosw = cos( w ), alpha = sin( w ) / ( 2.0 * q );
+			return normalizedBiquad( ( 1.0 - cosw ) / 2.0, 1.0 - cosw, ( 1.0 - cosw ) / 2.0, 1.0 + alpha, -2.0 * cosw, 1.0 - alpha );
+		}
+
+		BiquadCoefficients BiquadCoefficients::highPass( double sampleRate, double frequency, double q ) {
+			double w = TwoPi * frequency / sampleRate, cosw = cos( w ), alpha = sin( w ) / ( 2.0 * q );
+			return normalizedBiquad( ( 1.0 + cosw ) / 2.0, -( 1.0 + cosw ), ( 1.0 + cosw ) / 2.0, 1.0 + alpha, -2.0 * cosw, 1.0 - alpha );
+		}
+
+		// Peak gain of 0 dB
+		BiquadCoefficients BiquadCoefficients::bandPass( double sampleRate, double frequency, double q ) {
+			double w = TwoPi * frequency / sampleRate, cosw = cos( w ), alpha = sin( w ) / ( 2.0 * q );
+			return normalizedBiquad( alpha, 0.0, -alpha, 1.0 + alpha, -2.0 * cosw, 1.0 - alpha );
+		}
+
+		BiquadCoefficients BiquadCoefficients::notch( double sampleRate, double frequency, double q ) {
+			double w = TwoPi * frequency / sampleRate, cosw = cos( w ), alpha = sin( w ) / ( 2.0 * q );
+			return normalizedBiquad( 1.0, -2.0 * cosw, 1.0, 1.0 + alpha, -2.0 * cosw, 1.0 - alpha );
+		}
+
+		BiquadCoefficients BiquadCoefficients::peaking( double sampleRate, double frequency, double q, double gain ) {
+			double w = TwoPi * frequency / sampleRate, cosw = cos( w ), alpha = sin( w ) / ( 2.0 * q );
+			double A = pow( 10.0, gain / 40.0 );
+			return normalizedBiquad( 1.0 + alpha * A, -2.0 * cosw, 1.0 - alpha * A, 1.0 + alpha / A, -2.0 * cosw, 1.0 - alpha / A );
+		}
+
+		// Shelves with a slope of 1, for which 2 sqrt( A ) alpha = sqrt( 2 A ) sin( w )
+		BiquadCoefficients BiquadCoefficients::lowShelf( double sampleRate, double frequency, double gain ) {
+			double w = TwoPi * frequency / sampleRate, cosw = cos( w );
+			double A = pow( 10.0, gain / 40.0 ), beta = sqrt( 2.0 * A ) * sin( w );
+			return normalizedBiquad( A * ( ( A + 1.0 ) - ( A - 1.0 ) * cosw + beta ), 2.0 * A * ( ( A - 1.0 ) - ( A + 1.0 ) * cosw ), A * ( ( A + 1.0 ) - ( A - 1.0 ) * cosw - beta ),
+									( A + 1.0 ) + ( A - 1.0 ) * cosw + beta, -2.0 * ( ( A - 1.0 ) + ( A + 1.0 ) * cosw ), ( A + 1.0 ) + ( A - 1.0 ) * cosw - beta );
+		}
+
+		BiquadCoefficients BiquadCoefficients::highShelf( double sampleRate, double frequency, double gain ) {
+			double w = TwoPi * frequency / sampleRate, cosw = cos( w );
+			double A = pow( 10.0, gain / 40.0 ), beta = sqrt( 2.0 * A ) * sin( w );
+			return normalizedBiquad( A * ( ( A + 1.0 ) + ( A - 1.0 ) * cosw + beta ), -2.0 * A * ( ( A - 1.0 ) + ( A + 1.0 ) * cosw ), A * ( ( A + 1.0 ) + ( A - 1.0 ) * cosw - beta ),
+									( A + 1.0 ) - ( A - 1.0 ) * cosw + beta, 2.0 * ( ( A - 1.0 ) - ( A + 1.0 ) * cosw ), ( A + 1.0 ) - ( A - 1.0 ) * cosw - beta );
+		}
+
+		BiquadCascade::BiquadCascade( const BiquadCoefficients * sections, unsigned int sectionCount, unsigned int channelCount ) :
+			m_channelCount( channelCount ), m_sections( sections, sections + sectionCount ), m_state( 2 * sectionCount * channelCount, 0.0 ) {
+			assert( channelCount > 0 );
+		}
+
+		void BiquadCascade::process( const double * input, double * output, unsigned int frameCount ) {
+			const unsigned int stride = m_channelCount;
+			if ( m_sections.empty() && input != output ) memmove( output, input, frameCount * stride * sizeof( double ) );
+
+			for ( unsigned int s = 0; s < m_sections.size(); s++ ) {
+				const BiquadCoefficients & q = m_sections[s];
+				const double * in = ( s == 0 ) ? input : output;
+				double * z1 = &m_state[ 2 * s * m_channelCount ];
+				double * z2 = z1 + m_channelCount;
+
+				// y = b0 x + z1, z1 = b1 x - a1 y + z2, z2 = b2 x - a2 y
+				unsigned int channel = 0;
+#if defined( __SSE2__ ) || defined( _M_X64 )
+				const __m128d b0 = _mm_set1_pd( q.b0 ), b1 = _mm_set1_pd( q.b1 ), b2 = _mm_set1_pd( q.b2 );
+				const __m128d a1 = _mm_set1_pd( q.a1 ), a2 = _mm_set1_pd( q.a2 );
+				for ( ; channel + 2 <= m_channelCount; channel += 2 ) {
+					__m128d s1 = _mm_loadu_pd( z1 + channel ), s2 = _mm_loadu_pd( z2 + channel );
+					for ( unsigned int n = 0; n < frameCount; n++ ) {
+						__m128d x = _mm_loadu_pd( in + n * stride + channel );
+						__m128d y = _mm_add_pd( _mm_mul_pd( b0, x ), s1 );
+						s1 = _mm_add_pd( _mm_sub_pd( _mm_mul_pd( b1, x ), _mm_mul_pd( a1, y ) ), s2 );
+						s2 = _mm_sub_pd( _mm_mul_pd( b2, x ), _mm_mul_pd( a2, y ) );
+						_mm_storeu_pd( output + n * stride + channel, y );
+					}
+					_mm_storeu_pd( z1 + channel, s1 );
+					_mm_storeu_pd( z2 + channel, s2 );
+				}
+#endif
+				for ( ; channel < m_channelCount; channel++ ) {
+					double s1 = z1[channel], s2 = z2[channel];
+					for ( unsigned int n = 0; n < frameCount; n++ ) {
+						double x = in[ n * stride + channel ];
+						double y = q.b0 * x + s1;
+						s1 = q.b1 * x - q.a1 * y + s2;
+						s2 = q.b2 * x - q.a2 * y;
+						output[ n * stride + channel ] = y;
+					}
+					z1[channel] = s1;
+					z2[channel] = s2;
+				}
+			}
+		}
+
+		void BiquadCascade::reset() {
+			std::fill( m_state.begin(), m_state.end(), 0.0 );
+		}
+
+		// Output time x (in inputs from the start of m_history) is computed from inputs floor( x ) - tapCount / 2 + 1 to floor( x ) + tapCount / 2,
+		// with the phase of the fraction of x interpolated between two rows of m_phases
+		Resampler::Resampler( double inputRate, double outputRate, unsigned int channelCount, unsigned int tapCount ) :
+			m_channelCount( channelCount ), m_tapCount( tapCount ),
+			m_step( (unsigned long long)( inputRate / outputRate * 4294967296.0 + 0.5 ) ),
+			m_phases( ( PhaseCount + 1 ) * tapCount ), m_history( channelCount * ( tapCount + FilterBlockSize ) ) {
+			assert( channelCount > 0 && tapCount >= 4 && tapCount % 4 == 0 );
+			assert( inputRate / outputRate < FilterBlockSize );
 
-				delete [] fftData;
+			// Windowed sinc, with the cutoff below the lower of the two Nyquist frequencies by about half the transition width of the window
+			double cutoff = ( ( outputRate < inputRate ) ? outputRate / inputRate : 1.0 ) * ( 0.5 - 2.75 / tapCount );
+			double halfWidth = tapCount / 2.0;
+			for ( unsigned int p = 0; p <= PhaseCount; p++ ) {
+				double * row = &m_phases[ p * tapCount ];
+				double sum = 0.0;
+				for ( unsigned int k = 0; k < tapCount; k++ ) {
+					double t = k - ( halfWidth - 1.0 ) - double( p ) / PhaseCount;
+					double x = TwoPi * cutoff * t;
+					double sinc = ( x == 0.0 ) ? 1.0 : sin( x ) / x;
+					double window = 0.42 + 0.5 * cos( TwoPi / 2.0 * t / halfWidth ) + 0.08 * cos( TwoPi * t / halfWidth );
+					row[k] = sinc * window;
+					sum += row[k];
+				}
+				// Unity gain at DC for every phase
+				for ( unsigned int k = 0; k < tapCount; k++ ) row[k] /= sum;
+			}
+			reset();
+		}
+
+		unsigned int Resampler::outputCount( unsigned int inputFrameCount ) const {
+			unsigned long long available = m_filled + (unsigned long long)inputFrameCount;
+			if ( available <= m_tapCount / 2 ) return 0;
+			unsigned long long limit = ( available - m_tapCount / 2 ) << 32;
+			if ( m_position >= limit ) return 0;
+			return (unsigned int)( ( limit - 1 - m_position ) / m_step + 1 );
+		}
+
+		unsigned int Resampler::process( const double * input, unsigned int inputFrameCount, double * output ) {
+			const unsigned int half = m_tapCount / 2;
+			const unsigned int capacity = m_tapCount + FilterBlockSize;
+			unsigned int produced = 0;
+			for ( unsigned int consumed = 0; consumed < inputFrameCount; ) {
+				unsigned int chunk = ( capacity - m_filled < inputFrameCount - consumed ) ? capacity - m_filled : inputFrameCount - consumed;
+				for ( unsigned int channel = 0; channel < m_channelCount; channel++ ) {
+					double * history = &m_history[ channel * capacity ] + m_filled;
+					const double * in = input + consumed * m_channelCount + channel;
+					for ( unsigned int n = 0; n < chunk; n++ ) history[n] = in[ n * m_channelCount ];
+				}
+				m_filled += chunk;
+				consumed += chunk;
+
+				// Every output whose last input has arrived
+				while ( ( m_position >> 32 ) + half < m_filled ) {
+					unsigned int first = (unsigned int)( m_position >> 32 ) - ( half - 1 );
+					unsigned int fraction = (unsigned int)m_position;
+					const double * c0 = &m_phases[ ( fraction >> 24 ) * m_tapCount ];
+					const double * c1 = c0 + m_tapCount;
+					double a = ( fraction & 0xffffff ) / 16777216.0;
+					for ( unsigned int channel = 0; channel < m_channelCount; channel++ ) {
+						const double * x = &m_history[ channel * capacity + first ];
+						doubles s0 = doubles_set( 0.0 ), s1 = s0;
+						for ( unsigned int k = 0; k < m_tapCount; k += DoubleLanes ) {
+							doubles xk = doubles_load( x + k );
+							s0 = doubles_madd( doubles_load( c0 + k ), xk, s0 );
+							s1 = doubles_madd( doubles_load( c1 + k ), xk, s1 );
+						}
+						double y0 = doubles_sum( s0 );
+						output[ produced * m_channelCount + channel ] = y0 + a * ( doubles_sum( s1 ) - y0 );
+					}
+					produced++;
+					m_position += m_step;
+				}
+
+				// Drop the inputs that no later output needs
+				unsigned long long needed = ( m_position >> 32 ) - ( half - 1 );
+				unsigned int drop = ( needed < m_filled ) ? (unsigned int)needed : m_filled;
+				for ( unsigned int channel = 0; channel < m_channelCount; channel++ ) {
+					double * history = &m_history[ channel * capacity ];
+					memmove( history, history + drop, ( m_filled - drop ) * sizeof( double ) );
+				}
+				m_filled -= drop;
+				m_position -= (unsigned long long)drop << 32;
+			}
+			return produced;
+		}
+
+		void Resampler::reset() {
+			std::fill( m_history.begin(), m_history.end(), 0.0 );
+			m_filled = m_tapCount / 2 - 1;
+			m_position = (unsigned long long)( m_tapCount / 2 - 1 ) << 32;
+		}
+
+		Convolver::Convolver( const double * impulseResponse, unsigned int length, unsigned int blockSize, unsigned int channelCount ) :
+			m_blockSize( blockSize ), m_channelCount( channelCount ), m_partitionCount( ( length + blockSize - 1 ) / blockSize ),
+			m_binStride( blockSize + 2 ), m_newest( 0 ),
+			m_forward( 2 * blockSize ), m_inverse( 2 * blockSize, FFTPlan::Inverse ), m_sum( m_binStride ), m_result( 2 * blockSize ) {
+			assert( blockSize > 0 && ( blockSize & ( blockSize - 1 ) ) == 0 && channelCount > 0 );
+			if ( m_partitionCount == 0 ) m_partitionCount = 1;
+
+			ComplexData zero = { 0.0, 0.0 };
+			m_partitions.assign( m_partitionCount * m_binStride, zero );
+			m_delayLine.assign( channelCount * m_partitionCount * m_binStride, zero );
+			m_windows.assign( channelCount * 2 * blockSize, 0.0 );
+
+			// Each partition is zero padded to the window size
+			std::vector< double > padded( 2 * blockSize );
+			double scale = 1.0 / ( 2 * blockSize );
+			for ( unsigned int p = 0; p < m_partitionCount; p++ ) {
+				std::fill( padded.begin(), padded.end(), 0.0 );
+				for ( unsigned int n = 0; n < blockSize && p * blockSize + n < length; n++ ) padded[n] = impulseResponse[ p * blockSize + n ] * scale;
+				m_forward.execute( padded.data(), &m_partitions[ p * m_binStride ] );
 			}
+		}
+
+		void Convolver::process( const double * input, double * output ) {
+			const unsigned int bins = m_blockSize + 1;
+			const unsigned int spectraLength = m_partitionCount * m_binStride;
+			m_newest = ( m_newest + 1 ) % m_partitionCount;
+
+			for ( unsigned int channel = 0; channel < m_channelCount; channel++ ) {
+				double * window = &m_windows[ channel * 2 * m_blockSize ];
+				memcpy( window, window + m_blockSize, m_blockSize * sizeof( double ) );
+				for ( unsigned int n = 0; n < m_blockSize; n++ ) window[ m_blockSize + n ] = input[ n * m_channelCount + channel ];
+
+				ComplexData * delayLine = &m_delayLine[ channel * spectraLength ];
+				m_forward.execute( window, delayLine + m_newest * m_binStride );
+
+				// Partition p is applied to the input spectrum from p blocks ago
+				for ( unsigned int k = 0; k < bins; k += ComplexLanes ) complexes_store( &m_sum[k], complexes_set( 0.0, 0.0 ) );
+				for ( unsigned int p = 0, slot = m_newest; p < m_partitionCount; p++, slot = ( slot == 0 ) ? m_partitionCount - 1 : slot - 1 ) {
+					const ComplexData * h = &m_partitions[ p * m_binStride ];
+					const ComplexData * x = delayLine + slot * m_binStride;
+					for ( unsigned int k = 0; k < bins; k += ComplexLanes ) {
+						complexes_store( &m_sum[k], complexes_add( complexes_load( &m_sum[k] ), complexes_multiply( complexes_load( x + k ), complexes_load( h + k ) ) ) );
+					}
+				}
 
-			return power;
+				// The second half of the circular convolution is the linear convolution of the new block
+				m_inverse.execute( m_sum.data(), m_result.data() );
+				for ( unsigned int n = 0; n < m_blockSize; n++ ) output[ n * m_channelCount + channel ] = m_result[ m_blockSize + n ];
+			}
+		}
+
+		void Convolver::reset() {
+			ComplexData zero = { 0.0, 0.0 };
+			std::fill( m_delayLine.begin(), m_delayLine.end(), zero );
+			std::fill( m_windows.begin(), m_windows.end(), 0.0 );
+		}
+
+		// Fast Fourier Transform
+		// FourierDecimation must be a power of 2
+		// This builds a plan for every call; code that transforms repeatedly should keep an FFTPlan instead
+		ComplexData * FFT( ComplexData * data, unsigned int FourierDecimation ) {
+			ComplexData * output = new ComplexData[ FourierDecimation ];
+			FFTPlan( FourierDecimation ).execute( data, output );
+			return output;
 		}
 
 	}
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 #ifndef Rocket_Core_DSP_H
 #define Rocket_Core_DSP_H
 
+#include <vector>
 
 namespace Rocket {
 	namespace DigitalSignalProcessing {
@@ -13,14 +14,244 @@ namespace Rocket {
 			complexSubType i;
 		};
 
+		// Precomputed bit-reversal and twiddle tables for Fast Fourier Transforms of one size
+		// Only construction and executeBatch() allocate: execute() can be called any number of times on any number of buffers
+		// Forward computes X[k] = sum( x[n] * e^(-2 pi i n k / size) ); Inverse uses e^(+2 pi i n k / size) and is not scaled by 1 / size
+		class FFTPlan {
+		public:
+			enum Direction {
+				Forward,
+				Inverse
+			};
+
+			// size must be a power of 2
+			FFTPlan( unsigned int size, Direction direction = Forward );
+
+			unsigned int size() const { return m_size; }
+			Direction direction() const { return m_direction; }
+
+			// Transforms size() elements of data in place
+			void execute( ComplexData * data ) const;
+			// Transforms size() elements of input into output (input and output must not overlap)
+			void execute( const ComplexData * input, ComplexData * output ) const;
+
+			// Transforms count frames of size() elements, stored one after another, spread over threadCount threads (0 for one per hardware thread)
+			// output may be the same array as input (the frames are then transformed in place)
+			// Every call starts and joins its threads, which allocates, so real-time code should call execute() instead
+			void executeBatch( const ComplexData * input, ComplexData * output, unsigned int count, unsigned int threadCount = 0 ) const;
+
+		private:
+			unsigned int m_size;
+			unsigned int m_log2Size;
+			Direction m_direction;
+			std::vector< unsigned int > m_bitReverse;		// m_bitReverse[n] is n with its log2( size ) bits reversed
+			std::vector< ComplexData > m_twiddles;			// W^k, W^2k and W^3k for each radix-4 stage after the first (see dsp.cpp)
+
+			void butterflies( ComplexData * data ) const;
+		};
+
+		// Fast Fourier Transforms of real signals of one size, computed as a complex transform of half the size
+		// Only the first size / 2 + 1 bins are used, since the others are their complex conjugates
+		class RealFFTPlan {
+		public:
+			// size must be a power of 2 of at least 2
+			RealFFTPlan( unsigned int size, FFTPlan::Direction direction = FFTPlan::Forward );
+
+			unsigned int size() const { return m_size; }
+			unsigned int binCount() const { return m_size / 2 + 1; }
+			FFTPlan::Direction direction() const { return m_half.direction(); }
+
+			// Forward: transforms size() samples of input into binCount() bins of output (input and output must not overlap)
+			void execute( const double * input, ComplexData * output ) const;
+			// Inverse: transforms binCount() bins of input into size() samples of output, not scaled by 1 / size (input and output must not overlap)
+			// The imaginary parts of the first and last bins are ignored
+			void execute( const ComplexData * input, double * output ) const;
+
+		private:
+			unsigned int m_size;
+			FFTPlan m_half;
+			std::vector< ComplexData > m_twiddles;			// W^k for k <= size / 4
+		};
+
+		// Streaming short-time Fourier transform
+		// Samples can be added in blocks of any length. Every hopSize samples, the last frameSize samples form a frame, which is
+		// windowed and transformed, and its spectrum is written as one row of binCount() values. The spectra are not normalized.
+		class STFT {
+		public:
+			enum Window {
+				Rectangular,
+				Hann,
+				Hamming,
+				Blackman
+			};
+			enum Bins {
+				Magnitude,		// |X[k]|
+				Power			// |X[k]|^2
+			};
+
+			// frameSize must be a power of 2 of at least 2; hopSize may be larger than frameSize, in which case samples between frames are skipped
+			STFT( unsigned int frameSize, unsigned int hopSize, Window window = Hann, Bins bins = Power );
+
+			unsigned int frameSize() const { return m_plan.size(); }
+			unsigned int hopSize() const { return m_hopSize; }
+			unsigned int binCount() const { return m_plan.binCount(); }
+
+			// Number of frames that the next count samples will complete
+			unsigned int frameCount( unsigned int count ) const;
+
+			// Adds count samples, taking every stride-th value of samples (e.g. one channel of an interleaved buffer)
+			// A row of binCount() values is written to output for each completed frame, so output must have room for frameCount( count ) rows
+			// Returns the number of rows written
+			unsigned int process( const double * samples, unsigned int count, double * output, unsigned int stride = 1 );
+
+			// Discards the samples of the current frame
+			void reset();
+
+		private:
+			RealFFTPlan m_plan;
+			unsigned int m_hopSize;
+			Bins m_bins;
+			std::vector< double > m_window;
+			std::vector< double > m_frame;					// samples of the current frame, oldest first
+			std::vector< double > m_windowed;
+			std::vector< ComplexData > m_spectrum;
+			unsigned int m_filled;							// number of samples in m_frame
+			unsigned int m_skip;							// number of samples to skip before the next frame starts
+
+			void transformFrame( double * output );
+		};
+
+		// Block filters and resamplers
+		// Buffers hold frames of channelCount interleaved samples, and are processed a whole buffer per call; state is kept between
+		// calls, so a stream can be processed in buffers of any length. Processing never allocates.
+
+		// Finite impulse response filter: output[n] = sum( coefficients[k] * input[n - k] ) for each channel
+		class FIRFilter {
+		public:
+			FIRFilter( const double * coefficients, unsigned int tapCount, unsigned int channelCount = 1 );
+
+			unsigned int tapCount() const { return (unsigned int)m_coefficients.size(); }
+			unsigned int channelCount() const { return m_channelCount; }
+
+			// Filters frameCount frames from input to output (which may be the same buffer)
+			void process( const double * input, double * output, unsigned int frameCount );
+			// Clears the previous inputs
+			void reset();
+
+		private:
+			unsigned int m_channelCount;
+			std::vector< double > m_coefficients;			// in reverse order, so that each output is a dot product with consecutive inputs
+			std::vector< double > m_history;				// per channel: tapCount() - 1 previous inputs, then room for a block of inputs
+		};
+
+		// Coefficients of a second order section, normalized so that a0 = 1:
+		// H(z) = ( b0 + b1 z^-1 + b2 z^-2 ) / ( 1 + a1 z^-1 + a2 z^-2 )
+		struct BiquadCoefficients {
+			double b0, b1, b2;
+			double a1, a2;
+
+			// Designs from the Audio EQ Cookbook (frequencies in Hz, gains in dB)
+			static BiquadCoefficients lowPass( double sampleRate, double frequency, double q = 0.7071067811865476 );
+			static BiquadCoefficients highPass( double sampleRate, double frequency, double q = 0.7071067811865476 );
+			static BiquadCoefficients bandPass( double sampleRate, double frequency, double q );
+			static BiquadCoefficients notch( double sampleRate, double frequency, double q );
+			static BiquadCoefficients peaking( double sampleRate, double frequency, double q, double gain );
+			static BiquadCoefficients lowShelf( double sampleRate, double frequency, double gain );
+			static BiquadCoefficients highShelf( double sampleRate, double frequency, double gain );
+		};
+
+		// Cascade of second order IIR sections, each in transposed direct form II
+		// Each section filters a whole buffer before the next one runs, with two channels at a time in SIMD registers
+		class BiquadCascade {
+		public:
+			BiquadCascade( const BiquadCoefficients * sections, unsigned int sectionCount, unsigned int channelCount = 1 );
+
+			unsigned int sectionCount() const { return (unsigned int)m_sections.size(); }
+			unsigned int channelCount() const { return m_channelCount; }
+
+			// Filters frameCount frames from input to output (which may be the same buffer)
+			void process( const double * input, double * output, unsigned int frameCount );
+			// Clears the state of every section
+			void reset();
+
+		private:
+			unsigned int m_channelCount;
+			std::vector< BiquadCoefficients > m_sections;
+			std::vector< double > m_state;					// z1 and z2 of each channel of each section
+		};
+
+		// Sample rate converter with an arbitrary ratio, using a polyphase windowed-sinc filter
+		// Each output is a dot product of tapCount inputs with a filter phase interpolated from a table of PhaseCount phases.
+		// Output sample m is input time m * inputRate / outputRate, delayed by tapCount / 2 - 1 input samples.
+		class Resampler {
+		public:
+			static const unsigned int PhaseCount = 256;
+
+			// tapCount must be a multiple of 4; more taps give a sharper anti-aliasing filter
+			Resampler( double inputRate, double outputRate, unsigned int channelCount = 1, unsigned int tapCount = 32 );
+
+			unsigned int channelCount() const { return m_channelCount; }
+			unsigned int tapCount() const { return m_tapCount; }
+
+			// Number of frames that the next inputFrameCount input frames will produce
+			unsigned int outputCount( unsigned int inputFrameCount ) const;
+
+			// Adds inputFrameCount frames of input and writes the frames that they complete to output
+			// output must have room for outputCount( inputFrameCount ) frames; returns the number of frames written
+			unsigned int process( const double * input, unsigned int inputFrameCount, double * output );
+			// Clears the previous inputs and restarts at output time 0
+			void reset();
+
+		private:
+			unsigned int m_channelCount;
+			unsigned int m_tapCount;
+			unsigned long long m_step;						// input samples per output sample, with 32 fractional bits
+			unsigned long long m_position;					// input time of the next output within m_history, with 32 fractional bits
+			unsigned int m_filled;							// number of inputs in m_history (per channel)
+			std::vector< double > m_phases;					// ( PhaseCount + 1 ) rows of tapCount coefficients
+			std::vector< double > m_history;				// per channel: the inputs from the first one needed by the next output
+		};
+
+		// Uniformly partitioned convolution with a long impulse response (overlap-save, with a frequency-domain delay line)
+		// The response is cut into partitions of blockSize samples whose spectra are computed once. Each block then costs one real
+		// transform and one inverse of 2 * blockSize samples per channel, plus a complex multiply-add of every partition with the
+		// spectrum of the input that many blocks ago. Output is not delayed: each block of output includes its own block of input.
+		class Convolver {
+		public:
+			// blockSize must be a power of 2; every channel is convolved with the same response
+			Convolver( const double * impulseResponse, unsigned int length, unsigned int blockSize, unsigned int channelCount = 1 );
+
+			unsigned int blockSize() const { return m_blockSize; }
+			unsigned int channelCount() const { return m_channelCount; }
+			unsigned int partitionCount() const { return m_partitionCount; }
+
+			// Convolves blockSize() frames from input to output (which may be the same buffer)
+			void process( const double * input, double * output );
+			// Clears the previous inputs
+			void reset();
+
+		private:
+			unsigned int m_blockSize;
+			unsigned int m_channelCount;
+			unsigned int m_partitionCount;
+			unsigned int m_binStride;						// bins per spectrum, padded to whole SIMD registers
+			unsigned int m_newest;							// slot of the newest input spectrum in each channel's delay line
+			RealFFTPlan m_forward;
+			RealFFTPlan m_inverse;
+			std::vector< ComplexData > m_partitions;		// spectra of the response partitions, scaled by the inverse's 1 / ( 2 * blockSize )
+			std::vector< ComplexData > m_delayLine;			// per channel: the spectra of the last partitionCount() input windows
+			std::vector< ComplexData > m_sum;
+			std::vector< double > m_windows;				// per channel: the previous block of input, then the current one
+			std::vector< double > m_result;
+		};
+
 		// Fast Fourier Transform
+		// Returns a new array of FourierDecimation elements that the caller must delete []
 		ComplexData * FFT( ComplexData * data, unsigned int FourierDecimation );
 
-		double ** generatePowerSpectrum( ComplexData * data, unsigned int N, unsigned int FourierDecimation, unsigned int PowerResolution );
-
 	}
 
 }
 
 
-#endif
\ No newline at end of file
+#endif
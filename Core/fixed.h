@@ -0,0 +1,135 @@
+
+#ifndef Rocket_Core_Fixed_H
+#define Rocket_Core_Fixed_H
+
+#include <stdint.h>
+#include <limits>
+#include <string>
+#include <sstream>
+#include <iostream>
+
+namespace Rocket {
+	namespace Core {
+
+		// Storage for a fixed< IntBits, FracBits > value: the smallest signed integer that holds IntBits + FracBits bits,
+		// and an integer twice as wide for the intermediate results of multiplication and division
+		template< unsigned int Bits, bool Fits32 = ( Bits <= 32 ) > struct fixed_storage {
+#if defined( __SIZEOF_INT128__ )
+			static_assert( Bits <= 64, "Fixed-point values are limited to 64 bits" );
+			typedef int64_t type;
+			typedef __int128 wideType;
+#else
+			static_assert( Bits <= 32, "Fixed-point values wider than 32 bits require a compiler with 128-bit integers" );
+#endif
+		};
+		template< unsigned int Bits > struct fixed_storage< Bits, true > {
+			typedef int32_t type;
+			typedef int64_t wideType;
+		};
+
+		// Binary fixed-point number with IntBits integer bits (including the sign bit) and FracBits fractional bits
+		// The value is stored as an integer scaled by 2^FracBits, so all scaling is resolved at compile time:
+		// multiplication and division are a widening multiply (or divide) and a shift, and comparisons are plain integer comparisons.
+		// Results are bit-identical on every platform, which makes this suitable for deterministic simulation.
+		template< unsigned int IntBits, unsigned int FracBits > class fixed {
+			static_assert( IntBits > 0, "IntBits includes the sign bit and must be at least 1" );
+			static_assert( FracBits > 0, "FracBits must be at least 1" );
+
+		public:
+			typedef typename fixed_storage< IntBits + FracBits >::type storageType;
+			typedef typename fixed_storage< IntBits + FracBits >::wideType wideStorageType;
+
+			static const unsigned int IntegerBits = IntBits;
+			static const unsigned int FractionalBits = FracBits;
+
+			storageType m_value;		// the real value multiplied by 2^FracBits
+
+			// Constructors
+			constexpr fixed() : m_value( 0 ) {}
+			constexpr fixed( int value ) : m_value( storageType( wideStorageType( value ) * scale() ) ) {}
+			constexpr fixed( double value ) : m_value( storageType( value * double( scale() ) + ( value < 0.0 ? -0.5 : 0.5 ) ) ) {}
+			constexpr fixed( float value ) : fixed( double( value ) ) {}
+
+			// Conversion from another fixed-point format (extra fractional bits are truncated towards negative infinity)
+			template< unsigned int IntBits2, unsigned int FracBits2 >
+			constexpr explicit fixed( const fixed< IntBits2, FracBits2 > & other ) : m_value( convertRaw< IntBits2 + FracBits2, FracBits2 >( other.m_value ) ) {}
+
+			// Returns the fixed-point number whose stored integer is raw
+			static constexpr fixed fromRaw( storageType raw ) { return fixed( raw, RawTag() ); }
+
+			// Limits
+			static constexpr fixed maximum() { return fromRaw( std::numeric_limits< storageType >::max() ); }
+			static constexpr fixed minimum() { return fromRaw( std::numeric_limits< storageType >::min() ); }
+			static constexpr fixed epsilon() { return fromRaw( 1 ); }		// smallest positive value
+
+			// Arithmetic
+			constexpr fixed operator - () const { return fromRaw( -m_value ); }
+
+			constexpr fixed operator + ( const fixed & R ) const { return fromRaw( m_value + R.m_value ); }
+			constexpr fixed operator - ( const fixed & R ) const { return fromRaw( m_value - R.m_value ); }
+			// Product is rounded to the nearest representable value
+			constexpr fixed operator * ( const fixed & R ) const { return fromRaw( storageType( ( wideStorageType( m_value ) * R.m_value + half() ) >> FracBits ) ); }
+			// Quotient is truncated towards zero
+			constexpr fixed operator / ( const fixed & R ) const { return fromRaw( storageType( ( wideStorageType( m_value ) * scale() ) / R.m_value ) ); }
+
+			// Assignment Operators
+			fixed & operator += ( const fixed & R ) { m_value += R.m_value; return *this; }
+			fixed & operator -= ( const fixed & R ) { m_value -= R.m_value; return *this; }
+			fixed & operator *= ( const fixed & R ) { *this = *this * R; return *this; }
+			fixed & operator /= ( const fixed & R ) { *this = *this / R; return *this; }
+
+			// Comparison
+			constexpr bool operator == ( const fixed & R ) const { return m_value == R.m_value; }
+			constexpr bool operator != ( const fixed & R ) const { return m_value != R.m_value; }
+			constexpr bool operator > ( const fixed & R ) const { return m_value > R.m_value; }
+			constexpr bool operator < ( const fixed & R ) const { return m_value < R.m_value; }
+			constexpr bool operator >= ( const fixed & R ) const { return m_value >= R.m_value; }
+			constexpr bool operator <= ( const fixed & R ) const { return m_value <= R.m_value; }
+
+			// Rounding
+			constexpr fixed floor() const { return fromRaw( storageType( wideStorageType( m_value ) & ~fractionMask() ) ); }
+			constexpr fixed ceiling() const { return fromRaw( storageType( ( wideStorageType( m_value ) + fractionMask() ) & ~fractionMask() ) ); }
+			constexpr fixed round() const { return fromRaw( storageType( ( wideStorageType( m_value ) + half() ) & ~fractionMask() ) ); }
+			constexpr fixed abs() const { return fromRaw( m_value < 0 ? -m_value : m_value ); }
+
+			// Conversion
+			constexpr double toDouble() const { return double( m_value ) / double( scale() ); }
+			constexpr float toFloat() const { return float( toDouble() ); }
+			constexpr float toValue() const { return toFloat(); }
+			constexpr int toInt() const { return int( m_value >> FracBits ); }		// rounds towards negative infinity
+
+			std::string toString() const {
+				std::stringstream ss;
+				ss << toDouble();
+				return ss.str();
+			}
+
+			friend std::ostream & operator << ( std::ostream& stream, const fixed & f ) {
+				return stream << f.toDouble();
+			}
+
+		private:
+			struct RawTag {};
+			constexpr fixed( storageType raw, RawTag ) : m_value( raw ) {}
+
+			static constexpr wideStorageType scale() { return wideStorageType( 1 ) << FracBits; }
+			static constexpr wideStorageType half() { return wideStorageType( 1 ) << ( FracBits - 1 ); }
+			static constexpr wideStorageType fractionMask() { return scale() - 1; }
+
+			// Rescales a raw value with FracBits2 fractional bits to FracBits fractional bits
+			template< unsigned int Bits2, unsigned int FracBits2 >
+			static constexpr storageType convertRaw( typename fixed_storage< Bits2 >::type raw ) {
+				return storageType( ( FracBits2 > FracBits ) ?
+					( raw >> ( FracBits2 > FracBits ? FracBits2 - FracBits : 0 ) ) :
+					( wideStorageType( raw ) * ( wideStorageType( 1 ) << ( FracBits > FracBits2 ? FracBits - FracBits2 : 0 ) ) ) );
+			}
+		};
+
+		// Typedefs
+		typedef fixed< 16, 16 > fixed16_16;
+		typedef fixed< 32, 32 > fixed32_32;
+
+	}
+}
+
+#endif
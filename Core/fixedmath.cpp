@@ -0,0 +1,226 @@
+
+#include "fixedmath.h"
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#elif defined( __SSE2__ ) || defined( _M_X64 )
+#include <emmintrin.h>
+#define ROCKET_FIXEDMATH_SSE
+#endif
+
+namespace Rocket {
+	namespace Core {
+		namespace FixedMath {
+
+			const int64_t AtanTable[62] = {
+				3622009729038561421LL, 2138197195906305897LL, 1129764675555192497LL, 573486189672913778LL,
+				287855953345232185LL, 144068303048368715LL, 72051730834756822LL, 36028064038054493LL,
+				18014306884351854LL, 9007187801521084LL, 4503598195715550LL, 2251799634728303LL,
+				1125899884473003LL, 562949950625109LL, 281474976361131LL, 140737488311637LL,
+				70368744172203LL, 35184372088149LL, 17592186044331LL, 8796093022197LL,
+				4398046511103LL, 2199023255552LL, 1099511627776LL, 549755813888LL,
+				274877906944LL, 137438953472LL, 68719476736LL, 34359738368LL,
+				17179869184LL, 8589934592LL, 4294967296LL, 2147483648LL,
+				1073741824LL, 536870912LL, 268435456LL, 134217728LL,
+				67108864LL, 33554432LL, 16777216LL, 8388608LL,
+				4194304LL, 2097152LL, 1048576LL, 524288LL,
+				262144LL, 131072LL, 65536LL, 32768LL,
+				16384LL, 8192LL, 4096LL, 2048LL,
+				1024LL, 512LL, 256LL, 128LL,
+				64LL, 32LL, 16LL, 8LL,
+				4LL, 2LL
+			};
+
+			// fixed16_16 works internally with 28 fractional bits in int32 lanes
+			typedef Internal< int32_t >::type internal16_16;
+			static const unsigned int InternalBits16_16 = Internal< int32_t >::FracBits;
+			static const unsigned int Iterations16_16 = CordicIterations< int32_t, 16 >::value;
+			// Values are prepared and finished in scalar code in blocks of this many, around the SIMD iterations
+			static const unsigned int BlockSize = 64;
+
+#if defined( __AVX2__ ) || defined( ROCKET_FIXEDMATH_SSE )
+#if defined( __AVX2__ )
+			// 8 int32 lanes
+			typedef __m256i lanes;
+			static const unsigned int LaneCount = 8;
+			static inline lanes lanes_load( const int32_t * p ) { return _mm256_loadu_si256( (const __m256i *)p ); }
+			static inline void lanes_store( int32_t * p, lanes v ) { _mm256_storeu_si256( (__m256i *)p, v ); }
+			static inline lanes lanes_set( int32_t v ) { return _mm256_set1_epi32( v ); }
+			static inline lanes lanes_add( lanes a, lanes b ) { return _mm256_add_epi32( a, b ); }
+			static inline lanes lanes_sub( lanes a, lanes b ) { return _mm256_sub_epi32( a, b ); }
+			static inline lanes lanes_and( lanes a, lanes b ) { return _mm256_and_si256( a, b ); }
+			static inline lanes lanes_andnot( lanes a, lanes b ) { return _mm256_andnot_si256( a, b ); }		// ~a & b
+			static inline lanes lanes_or( lanes a, lanes b ) { return _mm256_or_si256( a, b ); }
+			static inline lanes lanes_xor( lanes a, lanes b ) { return _mm256_xor_si256( a, b ); }
+			static inline lanes lanes_greater( lanes a, lanes b ) { return _mm256_cmpgt_epi32( a, b ); }
+			static inline lanes lanes_sra( lanes a, int n ) { return _mm256_sra_epi32( a, _mm_cvtsi32_si128( n ) ); }
+			static inline lanes lanes_srl( lanes a, int n ) { return _mm256_srl_epi32( a, _mm_cvtsi32_si128( n ) ); }
+			static inline lanes lanes_sll( lanes a, int n ) { return _mm256_sll_epi32( a, _mm_cvtsi32_si128( n ) ); }
+#else
+			// 4 int32 lanes
+			typedef __m128i lanes;
+			static const unsigned int LaneCount = 4;
+			static inline lanes lanes_load( const int32_t * p ) { return _mm_loadu_si128( (const __m128i *)p ); }
+			static inline void lanes_store( int32_t * p, lanes v ) { _mm_storeu_si128( (__m128i *)p, v ); }
+			static inline lanes lanes_set( int32_t v ) { return _mm_set1_epi32( v ); }
+			static inline lanes lanes_add( lanes a, lanes b ) { return _mm_add_epi32( a, b ); }
+			static inline lanes lanes_sub( lanes a, lanes b ) { return _mm_sub_epi32( a, b ); }
+			static inline lanes lanes_and( lanes a, lanes b ) { return _mm_and_si128( a, b ); }
+			static inline lanes lanes_andnot( lanes a, lanes b ) { return _mm_andnot_si128( a, b ); }		// ~a & b
+			static inline lanes lanes_or( lanes a, lanes b ) { return _mm_or_si128( a, b ); }
+			static inline lanes lanes_xor( lanes a, lanes b ) { return _mm_xor_si128( a, b ); }
+			static inline lanes lanes_greater( lanes a, lanes b ) { return _mm_cmpgt_epi32( a, b ); }
+			static inline lanes lanes_sra( lanes a, int n ) { return _mm_sra_epi32( a, _mm_cvtsi32_si128( n ) ); }
+			static inline lanes lanes_srl( lanes a, int n ) { return _mm_srl_epi32( a, _mm_cvtsi32_si128( n ) ); }
+			static inline lanes lanes_sll( lanes a, int n ) { return _mm_sll_epi32( a, _mm_cvtsi32_si128( n ) ); }
+#endif
+
+			// The SIMD kernels below perform exactly the same integer operations as the scalar templates in fixedmath.h,
+			// so they return the same bits; the remainder that doesn't fill a set of lanes goes through the scalar code
+
+			// Same as cordicRotate()
+			static void cordicRotateBlock( internal16_16 * x, internal16_16 * y, internal16_16 * z, unsigned int count ) {
+				const internal16_16 * angles = cordicAngles< internal16_16, InternalBits16_16 >();
+				unsigned int i = 0;
+				for ( ; i + LaneCount <= count; i += LaneCount ) {
+					lanes vx = lanes_load( x + i ), vy = lanes_load( y + i ), vz = lanes_load( z + i );
+					for ( unsigned int n = 0; n < Iterations16_16; n++ ) {
+						lanes m = lanes_sra( vz, 31 );
+						lanes dx = lanes_sub( lanes_xor( lanes_sra( vx, n ), m ), m );
+						lanes dy = lanes_sub( lanes_xor( lanes_sra( vy, n ), m ), m );
+						lanes dz = lanes_sub( lanes_xor( lanes_set( angles[n] ), m ), m );
+						vx = lanes_sub( vx, dy );
+						vy = lanes_add( vy, dx );
+						vz = lanes_sub( vz, dz );
+					}
+					lanes_store( x + i, vx );
+					lanes_store( y + i, vy );
+					lanes_store( z + i, vz );
+				}
+				for ( ; i < count; i++ ) cordicRotate< internal16_16 >( x[i], y[i], z[i], Iterations16_16, angles );
+			}
+
+			// Same as cordicVector()
+			static void cordicVectorBlock( internal16_16 * x, internal16_16 * y, internal16_16 * z, unsigned int count ) {
+				const internal16_16 * angles = cordicAngles< internal16_16, InternalBits16_16 >();
+				const lanes ones = lanes_set( -1 );
+				unsigned int i = 0;
+				for ( ; i + LaneCount <= count; i += LaneCount ) {
+					lanes vx = lanes_load( x + i ), vy = lanes_load( y + i ), vz = lanes_load( z + i );
+					for ( unsigned int n = 0; n < Iterations16_16; n++ ) {
+						lanes m = lanes_xor( lanes_sra( vy, 31 ), ones );
+						lanes dx = lanes_sub( lanes_xor( lanes_sra( vx, n ), m ), m );
+						lanes dy = lanes_sub( lanes_xor( lanes_sra( vy, n ), m ), m );
+						lanes dz = lanes_sub( lanes_xor( lanes_set( angles[n] ), m ), m );
+						vx = lanes_sub( vx, dy );
+						vy = lanes_add( vy, dx );
+						vz = lanes_sub( vz, dz );
+					}
+					lanes_store( x + i, vx );
+					lanes_store( y + i, vy );
+					lanes_store( z + i, vz );
+				}
+				for ( ; i < count; i++ ) cordicVector< internal16_16 >( x[i], y[i], z[i], Iterations16_16, angles );
+			}
+
+			// floor( sqrt( raw << 16 ) ), 0 for negative values (the same result as the scalar sqrt(), which is exact)
+			// Restoring square root two bits at a time: 16 steps consume the bits of raw and 8 more consume the 16 zero bits below it
+			static void sqrtBlock( const int32_t * in, int32_t * out, unsigned int count ) {
+				const lanes zero = lanes_set( 0 ), one = lanes_set( 1 ), three = lanes_set( 3 );
+				unsigned int i = 0;
+				for ( ; i + LaneCount <= count; i += LaneCount ) {
+					lanes raw = lanes_load( in + i );
+					raw = lanes_andnot( lanes_greater( zero, raw ), raw );
+					lanes remainder = zero, root = zero;
+					for ( int n = 0; n < 24; n++ ) {
+						lanes digits = ( n < 16 ) ? lanes_and( lanes_srl( raw, 30 - 2*n ), three ) : zero;
+						remainder = lanes_or( lanes_sll( remainder, 2 ), digits );
+						lanes trial = lanes_or( lanes_sll( root, 2 ), one );
+						lanes less = lanes_greater( trial, remainder );
+						remainder = lanes_sub( remainder, lanes_andnot( less, trial ) );
+						root = lanes_or( lanes_sll( root, 1 ), lanes_andnot( less, one ) );
+					}
+					lanes_store( out + i, root );
+				}
+				for ( ; i < count; i++ ) out[i] = sqrt( fixed16_16::fromRaw( in[i] ) ).m_value;
+			}
+#else
+			static void cordicRotateBlock( internal16_16 * x, internal16_16 * y, internal16_16 * z, unsigned int count ) {
+				const internal16_16 * angles = cordicAngles< internal16_16, InternalBits16_16 >();
+				for ( unsigned int i = 0; i < count; i++ ) cordicRotate< internal16_16 >( x[i], y[i], z[i], Iterations16_16, angles );
+			}
+			static void cordicVectorBlock( internal16_16 * x, internal16_16 * y, internal16_16 * z, unsigned int count ) {
+				const internal16_16 * angles = cordicAngles< internal16_16, InternalBits16_16 >();
+				for ( unsigned int i = 0; i < count; i++ ) cordicVector< internal16_16 >( x[i], y[i], z[i], Iterations16_16, angles );
+			}
+			static void sqrtBlock( const int32_t * in, int32_t * out, unsigned int count ) {
+				for ( unsigned int i = 0; i < count; i++ ) out[i] = sqrt( fixed16_16::fromRaw( in[i] ) ).m_value;
+			}
+#endif
+
+			void sqrt( const fixed16_16 * in, fixed16_16 * out, unsigned int count ) {
+				static_assert( sizeof( fixed16_16 ) == sizeof( int32_t ), "fixed16_16 arrays are processed as int32 arrays" );
+				sqrtBlock( &in->m_value, &out->m_value, count );
+			}
+
+			void rsqrt( const fixed16_16 * in, fixed16_16 * out, unsigned int count ) {
+				for ( unsigned int i = 0; i < count; i++ ) out[i] = rsqrt( in[i] );
+			}
+
+			void sincos( const fixed16_16 * in, fixed16_16 * sinOut, fixed16_16 * cosOut, unsigned int count ) {
+				internal16_16 x[BlockSize], y[BlockSize], z[BlockSize];
+				int quadrant[BlockSize];
+				const internal16_16 gain = constant< internal16_16 >( CordicGain, InternalBits16_16 );
+				for ( unsigned int start = 0; start < count; start += BlockSize ) {
+					unsigned int n = ( count - start < BlockSize ) ? count - start : BlockSize;
+					for ( unsigned int i = 0; i < n; i++ ) {
+						reduceAngle< 16, 16 >( in[start + i].m_value, z[i], quadrant[i] );
+						x[i] = gain;
+						y[i] = 0;
+					}
+					cordicRotateBlock( x, y, z, n );
+					for ( unsigned int i = 0; i < n; i++ ) {
+						internal16_16 s, c;
+						applyQuadrant< internal16_16 >( quadrant[i], x[i], y[i], s, c );
+						if ( sinOut ) sinOut[start + i] = fixed16_16::fromRaw( fromInternal< 16, 16 >( s ) );
+						if ( cosOut ) cosOut[start + i] = fixed16_16::fromRaw( fromInternal< 16, 16 >( c ) );
+					}
+				}
+			}
+
+			void sin( const fixed16_16 * in, fixed16_16 * out, unsigned int count ) {
+				sincos( in, out, 0, count );
+			}
+
+			void cos( const fixed16_16 * in, fixed16_16 * out, unsigned int count ) {
+				sincos( in, 0, out, count );
+			}
+
+			void atan2( const fixed16_16 * y, const fixed16_16 * x, fixed16_16 * out, unsigned int count ) {
+				internal16_16 cx[BlockSize], cy[BlockSize], z[BlockSize], offset[BlockSize];
+				bool defined[BlockSize];
+				for ( unsigned int start = 0; start < count; start += BlockSize ) {
+					unsigned int n = ( count - start < BlockSize ) ? count - start : BlockSize;
+					for ( unsigned int i = 0; i < n; i++ ) {
+						defined[i] = prepareAtan2< 16, 16 >( y[start + i].m_value, x[start + i].m_value, cx[i], cy[i], offset[i] );
+						if ( !defined[i] ) cx[i] = cy[i] = offset[i] = 0;
+						z[i] = 0;
+					}
+					cordicVectorBlock( cx, cy, z, n );
+					for ( unsigned int i = 0; i < n; i++ ) {
+						out[start + i] = fixed16_16::fromRaw( defined[i] ? fromInternal< 16, 16 >( z[i] + offset[i] ) : 0 );
+					}
+				}
+			}
+
+			void exp( const fixed16_16 * in, fixed16_16 * out, unsigned int count ) {
+				for ( unsigned int i = 0; i < count; i++ ) out[i] = exp( in[i] );
+			}
+
+			void log( const fixed16_16 * in, fixed16_16 * out, unsigned int count ) {
+				for ( unsigned int i = 0; i < count; i++ ) out[i] = log( in[i] );
+			}
+
+		}
+	}
+}
@@ -0,0 +1,327 @@
+
+#ifndef Rocket_Core_FixedMath_H
+#define Rocket_Core_FixedMath_H
+
+#include <stdint.h>
+
+#include "fixed.h"
+
+namespace Rocket {
+	namespace Core {
+		namespace FixedMath {
+
+			// Deterministic fixed-point functions
+			// Everything below is computed with integer arithmetic only (CORDIC, digit-by-digit square roots and integer series),
+			// so results are bit-identical on every machine and compiler.
+			// The batch versions for fixed16_16 (see the end of this file) run the iterations in SSE2/AVX2 integer lanes and return
+			// exactly the same bits as the scalar versions.
+
+			// Constants with 62 fractional bits
+			const int64_t HalfPi = 7244019458077122842LL;
+			const int64_t CordicGain = 2800459870029452954LL;		// product of cos( atan( 2^-i ) ) over all i
+			const int64_t Ln2 = 3196577161300663915LL;
+			extern const int64_t AtanTable[62];						// atan( 2^-i )
+
+			// Internal helpers
+
+			// Working format for each storage size: results are computed with InternalFracBits fractional bits, then rounded
+			template< class S > struct Internal;
+			template<> struct Internal< int32_t > {
+				typedef int32_t type;
+				typedef int64_t wideType;
+				typedef uint64_t unsignedWideType;
+				static const unsigned int FracBits = 28;
+			};
+#if defined( __SIZEOF_INT128__ )
+			template<> struct Internal< int64_t > {
+				typedef int64_t type;
+				typedef __int128 wideType;
+				typedef unsigned __int128 unsignedWideType;
+				static const unsigned int FracBits = 60;
+			};
+#endif
+
+			// v / 2^shift, rounded to nearest
+			template< class V > inline V roundShift( V v, unsigned int shift ) {
+				return ( shift == 0 ) ? v : ( ( v + ( V( 1 ) << ( shift - 1 ) ) ) >> shift );
+			}
+			// v * 2^shift (shift may be negative)
+			template< class V > inline V scaleShift( V v, int shift ) {
+				return ( shift >= 0 ) ? v * ( V( 1 ) << shift ) : roundShift( v, -shift );
+			}
+			// A Q62 constant with fracBits fractional bits
+			template< class V > inline V constant( int64_t q62, unsigned int fracBits ) {
+				return V( roundShift( q62, 62 - fracBits ) );
+			}
+			// floor( a / b ) for b > 0
+			template< class V > inline V floorDivide( V a, V b ) {
+				V q = a / b;
+				return ( ( a % b != 0 ) && ( a < 0 ) ) ? q - 1 : q;
+			}
+			// Number of bits needed to hold v (v >= 0)
+			template< class V > inline int bitLength( V v ) {
+				int n = 0;
+				while ( v != 0 ) { v >>= 1; n++; }
+				return n;
+			}
+			// floor( sqrt( n ) )
+			template< class U > inline U isqrt( U n ) {
+				U root = 0;
+				U bit = U( 1 ) << ( sizeof( U ) * 8 - 2 );
+				while ( bit > n ) bit >>= 2;
+				while ( bit != 0 ) {
+					if ( n >= root + bit ) {
+						n -= root + bit;
+						root = ( root >> 1 ) + bit;
+					} else {
+						root >>= 1;
+					}
+					bit >>= 2;
+				}
+				return root;
+			}
+
+			// Per-type table of atan( 2^-i ) with fracBits fractional bits
+			template< class C, unsigned int fracBits > const C * cordicAngles() {
+				struct Table {
+					C angles[62];
+					Table() { for ( unsigned int i = 0; i < 62; i++ ) angles[i] = constant< C >( AtanTable[i], fracBits ); }
+				};
+				static const Table table;
+				return table.angles;
+			}
+
+			// Number of CORDIC iterations for a format with FracBits fractional bits (a few guard iterations past the output precision)
+			template< class S, unsigned int FracBits > struct CordicIterations {
+				static const unsigned int value = ( FracBits + 4 < Internal< S >::FracBits ) ? FracBits + 4 : Internal< S >::FracBits;
+			};
+
+			// CORDIC rotation mode: rotates ( x, y ) by z, driving z to 0 (branch-free, so that it maps directly onto SIMD lanes)
+			template< class C > inline void cordicRotate( C & x, C & y, C & z, unsigned int iterations, const C * angles ) {
+				for ( unsigned int i = 0; i < iterations; i++ ) {
+					C m = z >> ( sizeof( C ) * 8 - 1 );		// -1 if z < 0, else 0; ( v ^ m ) - m negates v when z < 0
+					C dx = ( ( x >> i ) ^ m ) - m;
+					C dy = ( ( y >> i ) ^ m ) - m;
+					C dz = ( angles[i] ^ m ) - m;
+					x -= dy;
+					y += dx;
+					z -= dz;
+				}
+			}
+			// CORDIC vectoring mode: rotates ( x, y ) onto the x axis, accumulating the angle in z
+			template< class C > inline void cordicVector( C & x, C & y, C & z, unsigned int iterations, const C * angles ) {
+				for ( unsigned int i = 0; i < iterations; i++ ) {
+					C m = ~( y >> ( sizeof( C ) * 8 - 1 ) );		// 0 if y < 0, else -1
+					C dx = ( ( x >> i ) ^ m ) - m;
+					C dy = ( ( y >> i ) ^ m ) - m;
+					C dz = ( angles[i] ^ m ) - m;
+					x -= dy;
+					y += dx;
+					z -= dz;
+				}
+			}
+
+			// Converts a value with Internal FracBits fractional bits to the raw value of fixed< IntBits, FracBits >
+			template< unsigned int IntBits, unsigned int FracBits >
+			inline typename fixed< IntBits, FracBits >::storageType fromInternal( typename Internal< typename fixed< IntBits, FracBits >::storageType >::wideType v ) {
+				typedef typename fixed< IntBits, FracBits >::storageType S;
+				return S( scaleShift( v, int( FracBits ) - int( Internal< S >::FracBits ) ) );
+			}
+
+			// Reduces an angle to r in [-pi/4, pi/4] (with Internal FracBits fractional bits) and the quadrant ( angle = r + quadrant * pi/2 )
+			template< unsigned int IntBits, unsigned int FracBits >
+			inline void reduceAngle( typename fixed< IntBits, FracBits >::storageType angle, typename Internal< typename fixed< IntBits, FracBits >::storageType >::type & r, int & quadrant ) {
+				typedef typename fixed< IntBits, FracBits >::storageType S;
+				typedef typename fixed< IntBits, FracBits >::wideStorageType W;
+				typedef typename Internal< S >::type C;
+				// Reduce with 28 extra bits of precision so that large angles still reduce accurately
+				const unsigned int reductionBits = ( FracBits + 28 < 60 ) ? FracBits + 28 : 60;
+				W a = W( angle ) * ( W( 1 ) << ( reductionBits - FracBits ) );
+				W halfPi = constant< W >( HalfPi, reductionBits );
+				W q = floorDivide< W >( a + halfPi / 2, halfPi );
+				quadrant = int( q & 3 );
+				r = C( scaleShift< W >( a - q * halfPi, int( Internal< S >::FracBits ) - int( reductionBits ) ) );
+			}
+
+			// Maps cos and sin of the reduced angle to the final quadrant
+			template< class C > inline void applyQuadrant( int quadrant, C x, C y, C & s, C & c ) {
+				switch ( quadrant ) {
+				case 0: c = x; s = y; break;
+				case 1: c = -y; s = x; break;
+				case 2: c = -x; s = -y; break;
+				default: c = y; s = -x; break;
+				}
+			}
+
+			// Prepares atan2( y, x ) for CORDIC vectoring: folds x < 0 into the right half plane (returning the angle offset)
+			// and scales ( x, y ) so that the larger magnitude is just under 0.5 in the internal format
+			// Returns false if x and y are both 0
+			template< unsigned int IntBits, unsigned int FracBits >
+			inline bool prepareAtan2( typename fixed< IntBits, FracBits >::storageType y, typename fixed< IntBits, FracBits >::storageType x,
+									  typename Internal< typename fixed< IntBits, FracBits >::storageType >::type & cx,
+									  typename Internal< typename fixed< IntBits, FracBits >::storageType >::type & cy,
+									  typename Internal< typename fixed< IntBits, FracBits >::storageType >::type & offset ) {
+				typedef typename fixed< IntBits, FracBits >::storageType S;
+				typedef typename Internal< S >::type C;
+				typedef typename Internal< S >::wideType W;
+				const unsigned int internalBits = Internal< S >::FracBits;
+				if ( x == 0 && y == 0 ) return false;
+
+				W X = x, Y = y;
+				offset = 0;
+				if ( X < 0 ) {
+					X = -X;
+					Y = -Y;
+					C pi = constant< C >( HalfPi, internalBits ) * 2;
+					offset = ( y >= 0 ) ? pi : -pi;
+				}
+				W magnitude = ( X > ( Y < 0 ? -Y : Y ) ) ? X : ( Y < 0 ? -Y : Y );
+				int shift = int( internalBits ) - 1 - bitLength( magnitude );
+				cx = C( ( shift >= 0 ) ? X * ( W( 1 ) << shift ) : ( X >> -shift ) );
+				cy = C( ( shift >= 0 ) ? Y * ( W( 1 ) << shift ) : ( Y >> -shift ) );
+				return true;
+			}
+
+
+			// Square root (0 for negative values; exact, rounded down)
+			template< unsigned int IntBits, unsigned int FracBits >
+			fixed< IntBits, FracBits > sqrt( const fixed< IntBits, FracBits > & x ) {
+				typedef typename fixed< IntBits, FracBits >::storageType S;
+				typedef typename Internal< S >::unsignedWideType U;
+				if ( x.m_value <= 0 ) return fixed< IntBits, FracBits >();
+				return fixed< IntBits, FracBits >::fromRaw( S( isqrt< U >( U( x.m_value ) << FracBits ) ) );
+			}
+
+			// Reciprocal square root (maximum() for values <= 0 or results that are out of range; rounded down)
+			template< unsigned int IntBits, unsigned int FracBits >
+			fixed< IntBits, FracBits > rsqrt( const fixed< IntBits, FracBits > & x ) {
+				typedef typename fixed< IntBits, FracBits >::storageType S;
+				typedef typename Internal< S >::unsignedWideType U;
+				static_assert( 3 * FracBits <= sizeof( U ) * 8 - 2, "rsqrt needs 3 * FracBits bits of intermediate precision" );
+				if ( x.m_value <= 0 ) return fixed< IntBits, FracBits >::maximum();
+				// rsqrt( raw / 2^F ) * 2^F = sqrt( 2^3F / raw )
+				U r = isqrt< U >( ( U( 1 ) << ( 3 * FracBits ) ) / U( x.m_value ) );
+				if ( r > U( fixed< IntBits, FracBits >::maximum().m_value ) ) return fixed< IntBits, FracBits >::maximum();
+				return fixed< IntBits, FracBits >::fromRaw( S( r ) );
+			}
+
+			// Sine and cosine of an angle in radians
+			template< unsigned int IntBits, unsigned int FracBits >
+			void sincos( const fixed< IntBits, FracBits > & angle, fixed< IntBits, FracBits > & s, fixed< IntBits, FracBits > & c ) {
+				typedef typename fixed< IntBits, FracBits >::storageType S;
+				typedef typename Internal< S >::type C;
+				const unsigned int internalBits = Internal< S >::FracBits;
+
+				C r;
+				int quadrant;
+				reduceAngle< IntBits, FracBits >( angle.m_value, r, quadrant );
+
+				C x = constant< C >( CordicGain, internalBits ), y = 0;
+				cordicRotate< C >( x, y, r, CordicIterations< S, FracBits >::value, cordicAngles< C, internalBits >() );
+
+				C sinValue, cosValue;
+				applyQuadrant< C >( quadrant, x, y, sinValue, cosValue );
+				s = fixed< IntBits, FracBits >::fromRaw( fromInternal< IntBits, FracBits >( sinValue ) );
+				c = fixed< IntBits, FracBits >::fromRaw( fromInternal< IntBits, FracBits >( cosValue ) );
+			}
+			template< unsigned int IntBits, unsigned int FracBits >
+			fixed< IntBits, FracBits > sin( const fixed< IntBits, FracBits > & angle ) {
+				fixed< IntBits, FracBits > s, c;
+				sincos( angle, s, c );
+				return s;
+			}
+			template< unsigned int IntBits, unsigned int FracBits >
+			fixed< IntBits, FracBits > cos( const fixed< IntBits, FracBits > & angle ) {
+				fixed< IntBits, FracBits > s, c;
+				sincos( angle, s, c );
+				return c;
+			}
+
+			// Angle of ( x, y ) in [-pi, pi] (0 if both are 0)
+			template< unsigned int IntBits, unsigned int FracBits >
+			fixed< IntBits, FracBits > atan2( const fixed< IntBits, FracBits > & y, const fixed< IntBits, FracBits > & x ) {
+				typedef typename fixed< IntBits, FracBits >::storageType S;
+				typedef typename Internal< S >::type C;
+				const unsigned int internalBits = Internal< S >::FracBits;
+
+				C cx, cy, offset;
+				if ( prepareAtan2< IntBits, FracBits >( y.m_value, x.m_value, cx, cy, offset ) == false ) return fixed< IntBits, FracBits >();
+				C z = 0;
+				cordicVector< C >( cx, cy, z, CordicIterations< S, FracBits >::value, cordicAngles< C, internalBits >() );
+				return fixed< IntBits, FracBits >::fromRaw( fromInternal< IntBits, FracBits >( z + offset ) );
+			}
+
+			// e^x (saturates to maximum())
+			template< unsigned int IntBits, unsigned int FracBits >
+			fixed< IntBits, FracBits > exp( const fixed< IntBits, FracBits > & x ) {
+				typedef typename fixed< IntBits, FracBits >::storageType S;
+				typedef typename Internal< S >::wideType W;
+				const unsigned int P = Internal< S >::FracBits;
+				const W one = W( 1 ) << P;
+
+				// e^x = 2^k * e^r, with k = round( x / ln2 ) and |r| <= ln2 / 2
+				const W ln2 = constant< W >( Ln2, P );
+				W X = scaleShift< W >( x.m_value, int( P ) - int( FracBits ) );
+				W k = floorDivide< W >( X + ln2 / 2, ln2 );
+				if ( k > W( IntBits ) ) return fixed< IntBits, FracBits >::maximum();
+				if ( k < -W( FracBits + 2 ) ) return fixed< IntBits, FracBits >();
+				W r = X - k * ln2;
+
+				// Taylor series of e^r
+				W sum = one, term = one;
+				for ( W n = 1; term != 0; n++ ) {
+					term = roundShift< W >( term * r, P ) / n;
+					sum += term;
+				}
+
+				int shift = int( FracBits ) - int( P ) + int( k );
+				if ( shift > 0 && sum > ( W( fixed< IntBits, FracBits >::maximum().m_value ) >> shift ) ) return fixed< IntBits, FracBits >::maximum();
+				return fixed< IntBits, FracBits >::fromRaw( S( scaleShift< W >( sum, shift ) ) );
+			}
+
+			// Natural logarithm (minimum() for values <= 0)
+			template< unsigned int IntBits, unsigned int FracBits >
+			fixed< IntBits, FracBits > log( const fixed< IntBits, FracBits > & x ) {
+				typedef typename fixed< IntBits, FracBits >::storageType S;
+				typedef typename Internal< S >::wideType W;
+				const unsigned int P = Internal< S >::FracBits;
+				const W one = W( 1 ) << P;
+				if ( x.m_value <= 0 ) return fixed< IntBits, FracBits >::minimum();
+
+				// x = m * 2^e with m in [1, 2)
+				int topBit = bitLength< W >( x.m_value ) - 1;
+				int e = topBit - int( FracBits );
+				W m = scaleShift< W >( x.m_value, int( P ) - topBit );
+
+				// log( m ) = 2 * atanh( s ), with s = ( m - 1 ) / ( m + 1 ) in [0, 1/3)
+				W s = ( ( m - one ) << P ) / ( m + one );
+				W s2 = roundShift< W >( s * s, P );
+				W sum = s, power = s;
+				for ( W n = 3; ; n += 2 ) {
+					power = roundShift< W >( power * s2, P );
+					W term = power / n;
+					if ( term == 0 ) break;
+					sum += term;
+				}
+
+				W result = 2 * sum + W( e ) * constant< W >( Ln2, P );
+				return fixed< IntBits, FracBits >::fromRaw( S( scaleShift< W >( result, int( FracBits ) - int( P ) ) ) );
+			}
+
+
+			// Batch functions for fixed16_16 (out may be the same array as in)
+			// sqrt, sin, cos, sincos and atan2 run in SIMD integer lanes; rsqrt, exp and log are scalar loops
+			void sqrt( const fixed16_16 * in, fixed16_16 * out, unsigned int count );
+			void rsqrt( const fixed16_16 * in, fixed16_16 * out, unsigned int count );
+			void sin( const fixed16_16 * in, fixed16_16 * out, unsigned int count );
+			void cos( const fixed16_16 * in, fixed16_16 * out, unsigned int count );
+			void sincos( const fixed16_16 * in, fixed16_16 * sinOut, fixed16_16 * cosOut, unsigned int count );
+			void atan2( const fixed16_16 * y, const fixed16_16 * x, fixed16_16 * out, unsigned int count );
+			void exp( const fixed16_16 * in, fixed16_16 * out, unsigned int count );
+			void log( const fixed16_16 * in, fixed16_16 * out, unsigned int count );
+
+		}
+	}
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include <string>
 #include <cmath>
 
+#include "fixed.h"
+
 using namespace std;
 
 namespace Rocket {
@@ -17,10 +19,16 @@ namespace Rocket {
 		static const int FixedPoint_DefaultScalingFactor = 1;
 		static const int FixedPoint_DefaultPrecision = 4;
 
+		// Compatibility wrapper around fixed< 32, 32 > (see fixed.h), for code written against the old decimal fixedpoint
+		// The value is held in binary fixed point, so arithmetic no longer depends on the scaling factor or precision;
+		// they are only kept so that the old interface (getScalingFactor(), convert(), ...) still works.
 		class fixedpoint {
 		public:
+			typedef fixed32_32 valueType;
+
 			fixedpoint( FixedPoint_OutputType value = 0.0f );	// value is assumed to have a scaling factor of FixedPoint_OutputTypeScalingFactor and will be converted to FixedPoint_DefaultScalingFactor
-			fixedpoint( long baseFactor, int scalingFactor, int precision = FixedPoint_DefaultPrecision );
+			fixedpoint( long baseFactor, int scalingFactor, int precision = FixedPoint_DefaultPrecision );		// value = baseFactor * scalingFactor / 10^precision
+			fixedpoint( const valueType & value, int scalingFactor = FixedPoint_DefaultScalingFactor, int precision = FixedPoint_DefaultPrecision );
 
 			fixedpoint & operator = ( const fixedpoint & rhs );
 
@@ -44,13 +52,14 @@ namespace Rocket {
 			bool operator >= ( const fixedpoint & rhs ) const;
 			bool operator <= ( const fixedpoint & rhs ) const;
 
-			fixedpoint floor();
-			fixedpoint ceiling();
-			fixedpoint round();
-			fixedpoint roundToNearest( const fixedpoint & nearestNumber );
+			fixedpoint floor() const;
+			fixedpoint ceiling() const;
+			fixedpoint round() const;
+			fixedpoint roundToNearest( const fixedpoint & nearestNumber ) const;
 
-			FixedPoint_OutputType toValue();
-			string toString();
+			FixedPoint_OutputType toValue() const;
+			string toString() const;
+			const valueType & value() const;
 
 			static FixedPoint_OutputType sqrt( const fixedpoint input );
 
@@ -62,9 +71,9 @@ namespace Rocket {
 			fixedpoint convert( int scalingFactor, int precision ) const;
 
 		private:
-			long m_baseFactor;
+			valueType m_value;
 			int m_scalingFactor;
-			int m_precision;			// Use left-hand precision for all arithmetic.  m_precision is the number of decimal places this numbe is accurate to.
+			int m_precision;			// number of decimal places this number was declared accurate to
 		};
 
 	}
@@ -0,0 +1,152 @@
+
+#include "fixedvector.h"
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#elif defined( __SSE4_1__ )
+#include <smmintrin.h>
+#define ROCKET_FIXEDVECTOR_SSE
+#elif defined( __SSE2__ ) || defined( _M_X64 )
+#include <emmintrin.h>
+#define ROCKET_FIXEDVECTOR_SSE
+#endif
+
+namespace Rocket {
+	namespace Core {
+		namespace FixedLinear {
+
+			// Each kernel computes out[r * stride] = round( rows[r] . v ) for 4-element rows, where round() adds half an ulp and
+			// shifts the exact 64-bit sum right by fracBits; the low 32 bits of the shifted sum are the same whether the shift is
+			// arithmetic (scalar) or logical (SIMD), so all versions return the same bits
+
+			// Scalar version of one row
+			static inline int32_t dotRow( const int32_t * row, const int32_t * v, int64_t half, unsigned int fracBits ) {
+				int64_t sum = int64_t( row[0] ) * v[0] + int64_t( row[1] ) * v[1] + int64_t( row[2] ) * v[2] + int64_t( row[3] ) * v[3];
+				return int32_t( ( sum + half ) >> fracBits );
+			}
+
+#if defined( __AVX2__ )
+			// Four rows, widened to 64-bit lanes once so that they can be applied to any number of vectors
+			class RowDot4 {
+			public:
+				RowDot4( const int32_t * rows, unsigned int fracBits ) :
+					m_halves( _mm256_set1_epi64x( int64_t( 1 ) << ( fracBits - 1 ) ) ), m_shift( _mm_cvtsi32_si128( int( fracBits ) ) ) {
+					for ( unsigned int r = 0; r < 4; r++ ) m_rows[r] = _mm256_cvtepi32_epi64( _mm_loadu_si128( (const __m128i *)( rows + r*4 ) ) );
+				}
+
+				// Rounded dot products of the four rows with v
+				__m128i operator () ( const int32_t * v ) const {
+					__m256i v64 = _mm256_cvtepi32_epi64( _mm_loadu_si128( (const __m128i *)v ) );
+					__m256i p0 = _mm256_mul_epi32( m_rows[0], v64 );
+					__m256i p1 = _mm256_mul_epi32( m_rows[1], v64 );
+					__m256i p2 = _mm256_mul_epi32( m_rows[2], v64 );
+					__m256i p3 = _mm256_mul_epi32( m_rows[3], v64 );
+					// ( p0[0] + p0[1], p1[0] + p1[1] | p0[2] + p0[3], p1[2] + p1[3] )
+					__m256i t01 = _mm256_add_epi64( _mm256_unpacklo_epi64( p0, p1 ), _mm256_unpackhi_epi64( p0, p1 ) );
+					__m256i t23 = _mm256_add_epi64( _mm256_unpacklo_epi64( p2, p3 ), _mm256_unpackhi_epi64( p2, p3 ) );
+					__m256i sums = _mm256_add_epi64( _mm256_permute2x128_si256( t01, t23, 0x20 ), _mm256_permute2x128_si256( t01, t23, 0x31 ) );
+					sums = _mm256_srl_epi64( _mm256_add_epi64( sums, m_halves ), m_shift );
+					// Low 32 bits of each sum
+					return _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( sums, _mm256_setr_epi32( 0, 2, 4, 6, 0, 2, 4, 6 ) ) );
+				}
+
+			private:
+				__m256i m_rows[4];
+				__m256i m_halves;
+				__m128i m_shift;
+			};
+#elif defined( ROCKET_FIXEDVECTOR_SSE )
+			// Signed 32 x 32 -> 64-bit products of lanes 0 and 2
+			static inline __m128i multiplyEven( __m128i a, __m128i b ) {
+#if defined( __SSE4_1__ )
+				return _mm_mul_epi32( a, b );
+#else
+				// Unsigned product, corrected for negative inputs: a * b = ua * ub - 2^32 * ( ( a < 0 ? ub : 0 ) + ( b < 0 ? ua : 0 ) )
+				__m128i correction = _mm_add_epi32( _mm_and_si128( _mm_srai_epi32( a, 31 ), b ), _mm_and_si128( _mm_srai_epi32( b, 31 ), a ) );
+				return _mm_sub_epi64( _mm_mul_epu32( a, b ), _mm_slli_epi64( correction, 32 ) );
+#endif
+			}
+
+			// Four rows, with their odd elements moved into the even lanes once so that they can be applied to any number of vectors
+			class RowDot4 {
+			public:
+				RowDot4( const int32_t * rows, unsigned int fracBits ) :
+					m_halves( _mm_set1_epi64x( int64_t( 1 ) << ( fracBits - 1 ) ) ), m_shift( _mm_cvtsi32_si128( int( fracBits ) ) ) {
+					for ( unsigned int r = 0; r < 4; r++ ) {
+						m_rows[r] = _mm_loadu_si128( (const __m128i *)( rows + r*4 ) );
+						m_rowsOdd[r] = _mm_srli_epi64( m_rows[r], 32 );
+					}
+				}
+
+				// Rounded dot products of the four rows with v
+				__m128i operator () ( const int32_t * v ) const {
+					__m128i vector = _mm_loadu_si128( (const __m128i *)v );
+					__m128i vOdd = _mm_srli_epi64( vector, 32 );
+					__m128i s01 = _mm_srl_epi64( _mm_add_epi64( dotPair( 0, vector, vOdd ), m_halves ), m_shift );
+					__m128i s23 = _mm_srl_epi64( _mm_add_epi64( dotPair( 2, vector, vOdd ), m_halves ), m_shift );
+					// Low 32 bits of each sum
+					return _mm_unpacklo_epi64( _mm_shuffle_epi32( s01, _MM_SHUFFLE( 3, 1, 2, 0 ) ), _mm_shuffle_epi32( s23, _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+				}
+
+			private:
+				__m128i m_rows[4];
+				__m128i m_rowsOdd[4];
+				__m128i m_halves;
+				__m128i m_shift;
+
+				// ( row[r] . v, row[r + 1] . v ) as 64-bit lanes
+				__m128i dotPair( unsigned int r, __m128i vector, __m128i vOdd ) const {
+					__m128i sa = _mm_add_epi64( multiplyEven( m_rows[r], vector ), multiplyEven( m_rowsOdd[r], vOdd ) );
+					__m128i sb = _mm_add_epi64( multiplyEven( m_rows[r + 1], vector ), multiplyEven( m_rowsOdd[r + 1], vOdd ) );
+					return _mm_add_epi64( _mm_unpacklo_epi64( sa, sb ), _mm_unpackhi_epi64( sa, sb ) );
+				}
+			};
+#endif
+
+			// out[r * stride] = round( rows[r] . v )
+			static void dotRows( const int32_t * rows, unsigned int rowCount, const int32_t * v, int32_t * out, unsigned int stride, unsigned int fracBits ) {
+				const int64_t half = int64_t( 1 ) << ( fracBits - 1 );
+				unsigned int r = 0;
+#if defined( __AVX2__ ) || defined( ROCKET_FIXEDVECTOR_SSE )
+				for ( ; r + 4 <= rowCount; r += 4 ) {
+					__m128i result = RowDot4( rows + r*4, fracBits )( v );
+					if ( stride == 1 ) {
+						_mm_storeu_si128( (__m128i *)( out + r ), result );
+					} else {
+						int32_t values[4];
+						_mm_storeu_si128( (__m128i *)values, result );
+						for ( unsigned int i = 0; i < 4; i++ ) out[( r + i )*stride] = values[i];
+					}
+				}
+#endif
+				for ( ; r < rowCount; r++ ) out[r*stride] = dotRow( rows + r*4, v, half, fracBits );
+			}
+
+			void multiplyInner4( const int32_t * a, const int32_t * b, int32_t * out, unsigned int rows, unsigned int cols, unsigned int fracBits ) {
+				for ( unsigned int c = 0; c < cols; c++ ) {
+					int32_t column[4] = { b[c], b[cols + c], b[2*cols + c], b[3*cols + c] };
+					dotRows( a, rows, column, out + c, cols, fracBits );
+				}
+			}
+
+		}
+
+		void transform( const fmat4 & m, const fvec4 * in, fvec4 * out, unsigned int count ) {
+			static_assert( sizeof( fvec4 ) == 4 * sizeof( int32_t ), "fvec4 arrays are processed as int32 arrays" );
+			if ( count == 0 ) return;
+			const int32_t * rows = &m.m_matrix[0][0].m_value;
+			const int32_t * src = &in[0][0].m_value;
+			int32_t * dst = &out[0][0].m_value;
+#if defined( __AVX2__ ) || defined( ROCKET_FIXEDVECTOR_SSE )
+			FixedLinear::RowDot4 dot( rows, fixed16_16::FractionalBits );
+			for ( unsigned int i = 0; i < count; i++ ) _mm_storeu_si128( (__m128i *)( dst + i*4 ), dot( src + i*4 ) );
+#else
+			for ( unsigned int i = 0; i < count; i++ ) {
+				int32_t v[4] = { src[i*4], src[i*4 + 1], src[i*4 + 2], src[i*4 + 3] };
+				FixedLinear::dotRows( rows, 4, v, dst + i*4, 1, fixed16_16::FractionalBits );
+			}
+#endif
+		}
+
+	}
+}
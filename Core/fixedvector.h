@@ -0,0 +1,397 @@
+
+#ifndef Rocket_Core_FixedVector_H
+#define Rocket_Core_FixedVector_H
+
+#include <stdint.h>
+#include <iostream>
+
+#include "matrix.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "fixed.h"
+#include "fixedmath.h"
+
+namespace Rocket {
+	namespace Core {
+
+		// Fixed-point specializations of T_vec, T_mat and T_quat
+		// Sums of products (dot products, cross products, matrix and quaternion products) accumulate the exact wide products
+		// and round to nearest once, so every result is independent of evaluation order and bit-identical on every machine.
+		// Formats with 32-bit storage (fixed16_16) run 4-wide sums of products in packed integer SIMD (see fixedvector.cpp),
+		// with exactly the same results as the scalar code.
+
+		namespace FixedLinear {
+
+			// Exact product of two fixed-point values, with 2 * FracBits fractional bits
+			template< class T > typename T::wideStorageType product( const T & a, const T & b ) {
+				return typename T::wideStorageType( a.m_value ) * b.m_value;
+			}
+			// Rounds an exact sum of products to the nearest T
+			template< class T > T round( typename T::wideStorageType sum ) {
+				return T::fromRaw( typename T::storageType( ( sum + ( typename T::wideStorageType( 1 ) << ( T::FractionalBits - 1 ) ) ) >> T::FractionalBits ) );
+			}
+			template< class T > T dot( const T * a, const T * b, unsigned int n ) {
+				typename T::wideStorageType sum = 0;
+				for ( unsigned int i = 0; i < n; i++ ) sum += product( a[i], b[i] );
+				return round< T >( sum );
+			}
+
+			// Raw kernel for formats with 32-bit storage (vectorized in fixedvector.cpp)
+			// out = a * b, where a is rows x 4 and b is 4 x cols (both row-major; out must not alias a or b)
+			void multiplyInner4( const int32_t * a, const int32_t * b, int32_t * out, unsigned int rows, unsigned int cols, unsigned int fracBits );
+
+			// out = a * b, where a is rows x inner and b is inner x cols (both row-major; out must not alias a or b)
+			// Single matrix-vector products stay inline, where the compiler vectorizes them as well as the kernel does
+			template< class T > void multiply( const T * a, const T * b, T * out, unsigned int rows, unsigned int inner, unsigned int cols ) {
+				if ( sizeof( typename T::storageType ) == sizeof( int32_t ) && inner == 4 && cols > 1 ) {
+					static_assert( sizeof( T ) == sizeof( typename T::storageType ), "fixed-point arrays are processed as integer arrays" );
+					multiplyInner4( (const int32_t *)a, (const int32_t *)b, (int32_t *)out, rows, cols, T::FractionalBits );
+					return;
+				}
+				for ( unsigned int r = 0; r < rows; r++ ) {
+					for ( unsigned int c = 0; c < cols; c++ ) {
+						typename T::wideStorageType sum = 0;
+						for ( unsigned int k = 0; k < inner; k++ ) sum += product( a[r*inner + k], b[k*cols + c] );
+						out[r*cols + c] = round< T >( sum );
+					}
+				}
+			}
+
+		}
+
+		// Fixed-point vector
+		template< unsigned int IntBits, unsigned int FracBits, unsigned int N > class T_vec< fixed< IntBits, FracBits >, N > {
+			static_assert( N > 1, "Number of elements must be greater than 1" );
+
+		public:
+			typedef fixed< IntBits, FracBits > T;
+			typedef T Scalar;
+
+			T m_elements[N];
+
+			// Constructors
+			T_vec() { for ( unsigned int i = 0; i < N; i++ ) m_elements[i] = T(); }
+
+			// Constructor that takes N number of elements
+			template< typename... Args >
+			T_vec( T first, Args... args ) {
+				setElements< 0 >( first, args... );
+			}
+
+			// Conversion from a floating point vector (each element is rounded to the nearest fixed-point value)
+			template< class U >
+			explicit T_vec( const T_vec< U, N > & v ) { for ( unsigned int i = 0; i < N; i++ ) m_elements[i] = T( double( v[i] ) ); }
+
+			// Sets the elements from index I onward
+			template< unsigned int I >
+			void setElements() {
+				static_assert( I == N, "Invalid number of elements" );
+			}
+			template< unsigned int I, typename... Args >
+			void setElements( T head, Args... tail ) {
+				static_assert( I < N, "Invalid number of elements" );
+				m_elements[I] = head;
+				setElements< I + 1 >( tail... );
+			}
+
+			// Access Operators and Functions
+			T & operator [] ( int index ) { return m_elements[index]; }
+			const T & operator [] ( int index ) const { return m_elements[index]; }
+
+			T x() const { return m_elements[0]; }
+			T y() const { return m_elements[1]; }
+			T z() const {
+				static_assert( N > 2, "Element z does not exist in this vector" );
+				return m_elements[2];
+			}
+			T w() const {
+				static_assert( N > 3, "Element w does not exist in this vector" );
+				return m_elements[3];
+			}
+
+			void x( T v ) { m_elements[0] = v; }
+			void y( T v ) { m_elements[1] = v; }
+			void z( T v ) {
+				static_assert( N > 2, "Element z does not exist in this vector" );
+				m_elements[2] = v;
+			}
+			void w( T v ) {
+				static_assert( N > 3, "Element w does not exist in this vector" );
+				m_elements[3] = v;
+			}
+
+			// Arithmetic
+			T_vec operator - () const { T_vec r; for ( unsigned int i = 0; i < N; i++ ) r[i] = -m_elements[i]; return r; }
+			T_vec operator + ( const T_vec & R ) const { T_vec r; for ( unsigned int i = 0; i < N; i++ ) r[i] = m_elements[i] + R[i]; return r; }
+			T_vec operator - ( const T_vec & R ) const { T_vec r; for ( unsigned int i = 0; i < N; i++ ) r[i] = m_elements[i] - R[i]; return r; }
+			T_vec operator * ( T value ) const { T_vec r; for ( unsigned int i = 0; i < N; i++ ) r[i] = m_elements[i] * value; return r; }
+			T_vec operator / ( T value ) const { T_vec r; for ( unsigned int i = 0; i < N; i++ ) r[i] = m_elements[i] / value; return r; }
+			friend T_vec operator * ( T value, const T_vec & v ) { return v * value; }
+
+			// Assignment Operators
+			T_vec & operator += ( const T_vec & R ) { for ( unsigned int i = 0; i < N; i++ ) m_elements[i] += R[i]; return *this; }
+			T_vec & operator -= ( const T_vec & R ) { for ( unsigned int i = 0; i < N; i++ ) m_elements[i] -= R[i]; return *this; }
+			T_vec & operator *= ( T value ) { *this = *this * value; return *this; }
+			T_vec & operator /= ( T value ) { *this = *this / value; return *this; }
+
+			// Equality
+			bool operator == ( const T_vec & R ) const {
+				for ( unsigned int i = 0; i < N; i++ ) {
+					if ( m_elements[i] != R[i] ) return false;
+				}
+				return true;
+			}
+			bool operator != ( const T_vec & R ) const { return !( *this == R ); }
+
+			// Vector Operations
+			T dot( const T_vec & R ) const { return FixedLinear::dot( m_elements, R.m_elements, N ); }
+			T_vec cross( const T_vec & R ) const {
+				static_assert( N == 3, "Cross product is only defined for 3-vectors" );
+				using FixedLinear::product;
+				return T_vec( FixedLinear::round< T >( product( y(), R.z() ) - product( z(), R.y() ) ),
+							  FixedLinear::round< T >( product( z(), R.x() ) - product( x(), R.z() ) ),
+							  FixedLinear::round< T >( product( x(), R.y() ) - product( y(), R.x() ) ) );
+			}
+			T lengthSquared() const { return dot( *this ); }
+			// Exact (rounded down) square root of the exact sum of squares
+			T length() const {
+				typedef typename FixedMath::Internal< typename T::storageType >::unsignedWideType U;
+				U sum = 0;
+				for ( unsigned int i = 0; i < N; i++ ) sum += U( FixedLinear::product( m_elements[i], m_elements[i] ) );
+				return T::fromRaw( typename T::storageType( FixedMath::isqrt< U >( sum ) ) );
+			}
+			T norm() const { return length(); }
+			T_vec normalized() const {
+				T l = length();
+				return ( l == T() ) ? *this : *this / l;
+			}
+			void normalize() { *this = normalized(); }
+
+			// Conversion
+			T_vec< float, N > toFloat() const {
+				T_vec< float, N > r;
+				for ( unsigned int i = 0; i < N; i++ ) r[i] = m_elements[i].toFloat();
+				return r;
+			}
+
+			friend std::ostream & operator << ( std::ostream& stream, const T_vec & v ) {
+				return stream << v.toFloat();
+			}
+		};
+
+		// Fixed-point matrix (row-major, like T_mat)
+		template< unsigned int IntBits, unsigned int FracBits, unsigned int R, unsigned int C > class T_mat< fixed< IntBits, FracBits >, R, C > {
+		public:
+			typedef fixed< IntBits, FracBits > T;
+
+			T m_matrix[R][C];
+
+			// Constructors
+
+			// Default is identity matrix
+			T_mat() {
+				for ( unsigned int r = 0; r < R; r++ ) {
+					for ( unsigned int c = 0; c < C; c++ ) m_matrix[r][c] = T( r == c ? 1 : 0 );
+				}
+			}
+
+			// Constructor that takes in R x C number of elements
+			template< typename... Args >
+			T_mat( T first, Args... args ) {
+				static_assert( sizeof...( Args ) == R * C - 1, "Invalid number of elements" );
+				T elements[R * C] = { first, T( args )... };
+				for ( unsigned int i = 0; i < R * C; i++ ) m_matrix[i / C][i % C] = elements[i];
+			}
+
+			// Conversion from a floating point matrix (each element is rounded to the nearest fixed-point value)
+			template< class U >
+			explicit T_mat( const T_mat< U, R, C > & m ) {
+				for ( unsigned int r = 0; r < R; r++ ) {
+					for ( unsigned int c = 0; c < C; c++ ) m_matrix[r][c] = T( double( m( r, c ) ) );
+				}
+			}
+
+			// Array Subscript
+			T & operator () ( unsigned int row, unsigned col ) { return m_matrix[row][col]; }
+			const T & operator () ( unsigned int row, unsigned col ) const { return m_matrix[row][col]; }
+
+			// Arithmetic
+			// M * V
+			T_vec< T, R > operator * ( const T_vec< T, C > & v ) const {
+				T_vec< T, R > r;
+				FixedLinear::multiply( &m_matrix[0][0], v.m_elements, r.m_elements, R, C, 1 );
+				return r;
+			}
+			// M * M
+			template< unsigned int C2 >
+			T_mat< T, R, C2 > operator * ( const T_mat< T, C, C2 > & m ) const {
+				T_mat< T, R, C2 > r;
+				FixedLinear::multiply( &m_matrix[0][0], &m.m_matrix[0][0], &r.m_matrix[0][0], R, C, C2 );
+				return r;
+			}
+
+			// Assignment Operators
+			T_mat & operator *= ( const T_mat & m ) { *this = *this * m; return *this; }
+
+			// Equality
+			bool operator == ( const T_mat & m ) const {
+				for ( unsigned int r = 0; r < R; r++ ) {
+					for ( unsigned int c = 0; c < C; c++ ) {
+						if ( m_matrix[r][c] != m.m_matrix[r][c] ) return false;
+					}
+				}
+				return true;
+			}
+			bool operator != ( const T_mat & m ) const { return !( *this == m ); }
+
+			// Matrix Operations
+			T_mat< T, C, R > transposed() const {
+				T_mat< T, C, R > t;
+				for ( unsigned int r = 0; r < R; r++ ) {
+					for ( unsigned int c = 0; c < C; c++ ) t.m_matrix[c][r] = m_matrix[r][c];
+				}
+				return t;
+			}
+			void transpose() { *this = transposed(); }
+
+			// Conversion
+			T_mat< float, R, C > toFloat() const {
+				T_mat< float, R, C > m;
+				for ( unsigned int r = 0; r < R; r++ ) {
+					for ( unsigned int c = 0; c < C; c++ ) m( r, c ) = m_matrix[r][c].toFloat();
+				}
+				return m;
+			}
+
+			friend std::ostream & operator << ( std::ostream& stream, const T_mat & m ) {
+				return stream << m.toFloat();
+			}
+		};
+
+		// Fixed-point quaternion
+		template< unsigned int IntBits, unsigned int FracBits > class T_quat< fixed< IntBits, FracBits > > {
+		public:
+			typedef fixed< IntBits, FracBits > T;
+
+			T_vec< T, 4 > m_coefficients;		// x, y, z, w
+
+			// Constructors
+
+			// Default is the identity rotation
+			T_quat() : m_coefficients( T( 0 ), T( 0 ), T( 0 ), T( 1 ) ) {}
+			T_quat( T x, T y, T z, T w ) : m_coefficients( x, y, z, w ) {}
+			explicit T_quat( const T_vec< T, 4 > & v ) : m_coefficients( v ) {}
+
+			// Rotation of angle (radians) around axis (axis does not need to be normalized)
+			T_quat( T angle, const T_vec< T, 3 > & axis ) {
+				T axisLength = axis.length();
+				if ( axisLength > T() ) {
+					T s, c;
+					FixedMath::sincos( angle * T( 0.5 ), s, c );
+					m_coefficients = T_vec< T, 4 >( axis.x() * s / axisLength, axis.y() * s / axisLength, axis.z() * s / axisLength, c );
+				} else {
+					*this = T_quat();
+				}
+			}
+
+			// Conversion from a floating point quaternion (each coefficient is rounded to the nearest fixed-point value)
+			template< class U >
+			explicit T_quat( const T_quat< U > & q ) : m_coefficients( T( double( q.x() ) ), T( double( q.y() ) ), T( double( q.z() ) ), T( double( q.w() ) ) ) {}
+
+			// Access Functions
+			T x() const { return m_coefficients[0]; }
+			T y() const { return m_coefficients[1]; }
+			T z() const { return m_coefficients[2]; }
+			T w() const { return m_coefficients[3]; }
+
+			const T_vec< T, 4 > & xyzw() const { return m_coefficients; }
+
+			// Arithmetic
+			// Hamilton product: (a * b) rotates by b, then by a
+			// Computed as a 4x4 matrix built from a times the coefficients of b
+			T_quat operator * ( const T_quat & R ) const {
+				T_mat< T, 4, 4 > left(	 w(),	-z(),	 y(),	 x(),
+										 z(),	 w(),	-x(),	 y(),
+										-y(),	 x(),	 w(),	 z(),
+										-x(),	-y(),	-z(),	 w() );
+				return T_quat( left * R.m_coefficients );
+			}
+			T_quat & operator *= ( const T_quat & R ) { *this = *this * R; return *this; }
+
+			// Rotate a vector
+			T_vec< T, 3 > operator * ( const T_vec< T, 3 > & v ) const { return toMatrix3() * v; }
+
+			// Equality
+			bool operator == ( const T_quat & R ) const { return m_coefficients == R.m_coefficients; }
+			bool operator != ( const T_quat & R ) const { return m_coefficients != R.m_coefficients; }
+
+			// Quaternion Operations
+			T length() const { return m_coefficients.length(); }
+			T dot( const T_quat & R ) const { return m_coefficients.dot( R.m_coefficients ); }
+			void normalize() { m_coefficients.normalize(); }
+			T_quat normalized() const { return T_quat( m_coefficients.normalized() ); }
+			T_quat conjugate() const { return T_quat( -x(), -y(), -z(), w() ); }
+			T_quat inverse() const {
+				T lengthSquared = dot( *this );
+				return T_quat( conjugate().m_coefficients / lengthSquared );
+			}
+
+			// Rotation matrices built directly from this quaternion (assumed to be normalized)
+			T_mat< T, 3, 3 > toMatrix3() const {
+				using FixedLinear::product;
+				typedef typename T::wideStorageType W;
+				W xx = product( x(), x() ), yy = product( y(), y() ), zz = product( z(), z() );
+				W xy = product( x(), y() ), xz = product( x(), z() ), yz = product( y(), z() );
+				W wx = product( w(), x() ), wy = product( w(), y() ), wz = product( w(), z() );
+				T one( 1 );
+				return T_mat< T, 3, 3 >(	one - FixedLinear::round< T >( 2 * ( yy + zz ) ),	FixedLinear::round< T >( 2 * ( xy - wz ) ),			FixedLinear::round< T >( 2 * ( xz + wy ) ),
+											FixedLinear::round< T >( 2 * ( xy + wz ) ),			one - FixedLinear::round< T >( 2 * ( xx + zz ) ),	FixedLinear::round< T >( 2 * ( yz - wx ) ),
+											FixedLinear::round< T >( 2 * ( xz - wy ) ),			FixedLinear::round< T >( 2 * ( yz + wx ) ),			one - FixedLinear::round< T >( 2 * ( xx + yy ) ) );
+			}
+			T_mat< T, 4, 4 > toMatrix() const {
+				T_mat< T, 3, 3 > m = toMatrix3();
+				T_mat< T, 4, 4 > r;
+				for ( unsigned int row = 0; row < 3; row++ ) {
+					for ( unsigned int col = 0; col < 3; col++ ) r( row, col ) = m( row, col );
+				}
+				return r;
+			}
+
+			// Conversion
+			T_quat< float > toFloat() const { return T_quat< float >( x().toFloat(), y().toFloat(), z().toFloat(), w().toFloat() ); }
+
+			friend std::ostream & operator << ( std::ostream& stream, const T_quat & q ) {
+				return stream << q.m_coefficients;
+			}
+		};
+
+		// Typedefs
+		typedef T_vec< fixed16_16, 2 > fvec2;
+		typedef T_vec< fixed16_16, 3 > fvec3;
+		typedef T_vec< fixed16_16, 4 > fvec4;
+
+		typedef T_mat< fixed16_16, 3, 3 > fmat3;
+		typedef T_mat< fixed16_16, 4, 4 > fmat4;
+
+		typedef T_quat< fixed16_16 > fquat;
+
+		// fixed32_32 resolves 2^-32 instead of 2^-16, for state that accumulates small steps (e.g. velocity from per-frame acceleration)
+		typedef T_vec< fixed32_32, 3 > fvec3_32;
+		typedef T_quat< fixed32_32 > fquat_32;
+
+		// External Vector Operations
+		template< unsigned int IntBits, unsigned int FracBits, unsigned int N >
+		fixed< IntBits, FracBits > dot( const T_vec< fixed< IntBits, FracBits >, N > & a, const T_vec< fixed< IntBits, FracBits >, N > & b ) { return a.dot( b ); }
+		template< unsigned int IntBits, unsigned int FracBits >
+		T_vec< fixed< IntBits, FracBits >, 3 > cross( const T_vec< fixed< IntBits, FracBits >, 3 > & a, const T_vec< fixed< IntBits, FracBits >, 3 > & b ) { return a.cross( b ); }
+		template< unsigned int IntBits, unsigned int FracBits, unsigned int N >
+		T_vec< fixed< IntBits, FracBits >, N > normalize( const T_vec< fixed< IntBits, FracBits >, N > & v ) { return v.normalized(); }
+
+		// Batch Transforms
+		// out[i] = m * in[i] for count vectors (in and out may be the same array), in packed integer SIMD
+		void transform( const fmat4 & m, const fvec4 * in, fvec4 * out, unsigned int count );
+
+	}
+}
+
+#endif
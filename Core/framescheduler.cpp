@@ -0,0 +1,121 @@
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <thread>
+
+#include "framescheduler.h"
+#include "timer.h"
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#include <immintrin.h>
+#define FrameScheduler_Pause() _mm_pause()
+#else
+#define FrameScheduler_Pause() std::this_thread::yield()
+#endif
+
+namespace Rocket {
+	namespace Core {
+
+		FrameScheduler::FrameScheduler( double simulationRate, double renderRate, unsigned int maxSteps ) {
+			m_step = (unsigned long long)( 1000000000.0 / simulationRate + 0.5 );
+			m_period = ( renderRate > 0.0 ) ? (unsigned long long)( 1000000000.0 / renderRate + 0.5 ) : 0;
+			m_maxSteps = maxSteps;
+
+			// A sleep is assumed to take 2 ms until some have been measured
+			m_sleepMean = 2000000.0;
+			m_sleepM2 = 0.0;
+			m_sleepCount = 0;
+
+			reset();
+		}
+
+		void FrameScheduler::reset() {
+			m_accumulator = 0;
+			m_lastFrame = timer_ns();
+			m_deadline = m_lastFrame + m_period;
+			m_frames = 0;
+			m_missedDeadlines = 0;
+			m_droppedNanoseconds = 0;
+		}
+
+		unsigned int FrameScheduler::beginFrame() {
+			unsigned long long now = timer_ns();
+			if ( m_period > 0 ) {
+				if ( now < m_deadline ) {
+					waitUntil( m_deadline );
+					now = timer_ns();
+				}
+				// A frame that begins more than an eighth of a period late is followed by a whole period, rather than by an early
+				// frame to catch up
+				unsigned long long late = now - m_deadline;
+				if ( late >= m_period ) m_missedDeadlines++;
+				if ( late > m_period / 8 ) m_deadline = now;
+				m_deadline += m_period;
+			}
+
+			unsigned long long elapsed = now - m_lastFrame;
+			m_lastFrame = now;
+			m_frameTimes[ m_frames % StatsWindow ] = elapsed;
+			m_frames++;
+			return advance( elapsed );
+		}
+
+		unsigned int FrameScheduler::advance( unsigned long long elapsedNanoseconds ) {
+			m_accumulator += elapsedNanoseconds;
+			unsigned long long steps = m_accumulator / m_step;
+			m_accumulator -= steps * m_step;
+			if ( steps > m_maxSteps ) {
+				m_droppedNanoseconds += ( steps - m_maxSteps ) * m_step;
+				steps = m_maxSteps;
+			}
+			return (unsigned int)steps;
+		}
+
+		void FrameScheduler::waitUntil( unsigned long long deadline ) {
+			// Sleep while the time left is longer than the mean plus one standard deviation of the sleeps so far
+			unsigned long long now = timer_ns();
+			while ( now < deadline ) {
+				double estimate = m_sleepMean + ( ( m_sleepCount > 1 ) ? sqrt( m_sleepM2 / ( m_sleepCount - 1 ) ) : 0.0 );
+				if ( double( deadline - now ) <= estimate ) break;
+
+				std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+				unsigned long long woken = timer_ns();
+				double observed = double( woken - now );
+				now = woken;
+
+				// The estimate follows changes (e.g. in the timer resolution) because the count stops growing
+				if ( m_sleepCount < 1000 ) m_sleepCount++;
+				double delta = observed - m_sleepMean;
+				m_sleepMean += delta / m_sleepCount;
+				m_sleepM2 += delta * ( observed - m_sleepMean );
+				if ( m_sleepCount == 1000 ) m_sleepM2 *= 999.0 / 1000.0;
+			}
+
+			while ( timer_ns() < deadline ) FrameScheduler_Pause();
+		}
+
+		FrameStats FrameScheduler::stats() const {
+			FrameStats result = { m_frames, 0, 0, 0, 0, 0, 0, m_missedDeadlines, m_droppedNanoseconds };
+			unsigned int count = (unsigned int)std::min< unsigned long long >( m_frames, StatsWindow );
+			if ( count == 0 ) return result;
+
+			result.last = m_frameTimes[ ( m_frames - 1 ) % StatsWindow ];
+			unsigned long long sorted[ StatsWindow ];
+			std::copy( m_frameTimes, m_frameTimes + count, sorted );
+			std::sort( sorted, sorted + count );
+			result.min = sorted[0];
+			result.max = sorted[ count - 1 ];
+			result.p99 = sorted[ ( count * 99 + 99 ) / 100 - 1 ];
+
+			double sum = 0.0;
+			for ( unsigned int i = 0; i < count; i++ ) sum += double( sorted[i] );
+			double mean = sum / count, variance = 0.0;
+			for ( unsigned int i = 0; i < count; i++ ) variance += ( double( sorted[i] ) - mean ) * ( double( sorted[i] ) - mean );
+			result.mean = (unsigned long long)( mean + 0.5 );
+			result.jitter = (unsigned long long)( sqrt( variance / count ) + 0.5 );
+			return result;
+		}
+
+	}
+}
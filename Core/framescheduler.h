@@ -0,0 +1,83 @@
+
+#ifndef Rocket_Core_FrameScheduler_H
+#define Rocket_Core_FrameScheduler_H
+
+namespace Rocket {
+	namespace Core {
+
+		// Frame times over the last FrameScheduler::StatsWindow frames, in ns
+		struct FrameStats {
+			unsigned long long frames;						// frames since the scheduler was reset
+			unsigned long long last;
+			unsigned long long mean;
+			unsigned long long min;
+			unsigned long long max;
+			unsigned long long p99;
+			unsigned long long jitter;						// standard deviation
+			unsigned long long missedDeadlines;				// frames that began more than a whole render period late, since the reset
+			unsigned long long droppedNanoseconds;			// simulation time discarded by frames that needed more than maxSteps steps, since the reset
+		};
+
+		// Main loop timing with a fixed simulation timestep, decoupled from the render rate
+		// Each frame's elapsed time goes into an accumulator, from which the simulation takes as many whole steps as it holds; the
+		// remainder, as a fraction of a step, is the alpha with which to interpolate between the last two simulation states:
+		//
+		//	FrameScheduler scheduler( 120.0, 60.0 );
+		//	while ( running ) {
+		//		for ( unsigned int steps = scheduler.beginFrame(); steps > 0; steps-- ) simulate( scheduler.stepMilliseconds() );
+		//		render( scheduler.alpha() );
+		//	}
+		//
+		// Frames are paced on timer_ns(): the scheduler sleeps while the time left is longer than a sleep has been taking, then spins
+		// for the rest, so frames begin within microseconds of their deadlines.
+		class FrameScheduler {
+		public:
+			static const unsigned int StatsWindow = 128;
+
+			// simulationRate in steps per second; renderRate in frames per second, or 0 to not wait (e.g. when swapping buffers waits for vsync)
+			// maxSteps limits the steps of one frame, so that a slow frame does not cause ever more steps in the next ones
+			FrameScheduler( double simulationRate, double renderRate = 0.0, unsigned int maxSteps = 8 );
+
+			// Restarts timing from now, with an empty accumulator (e.g. after loading)
+			void reset();
+
+			// Waits until the next frame is due, then returns the number of simulation steps to run before rendering it
+			unsigned int beginFrame();
+			// Adds elapsedNanoseconds to the accumulator and returns the number of steps to run (beginFrame() without the clock)
+			unsigned int advance( unsigned long long elapsedNanoseconds );
+
+			// Fraction of a step left in the accumulator, in [0, 1): render previous + ( current - previous ) * alpha()
+			double alpha() const { return double( m_accumulator ) / double( m_step ); }
+			unsigned long long stepNanoseconds() const { return m_step; }
+			float stepMilliseconds() const { return float( m_step / 1000000.0 ); }
+			// Render period in ns, or 0 if frames are not paced
+			unsigned long long framePeriod() const { return m_period; }
+
+			FrameStats stats() const;
+
+			// Returns when timer_ns() reaches deadline
+			void waitUntil( unsigned long long deadline );
+
+		private:
+			unsigned long long m_step;
+			unsigned long long m_period;
+			unsigned int m_maxSteps;
+			unsigned long long m_accumulator;
+			unsigned long long m_lastFrame;					// timer_ns() at the beginning of the last frame
+			unsigned long long m_deadline;					// timer_ns() at which the next frame is due
+
+			unsigned long long m_frames;
+			unsigned long long m_frameTimes[ StatsWindow ];	// ring of the last frame times
+			unsigned long long m_missedDeadlines;
+			unsigned long long m_droppedNanoseconds;
+
+			// Running mean and sum of squared deviations (Welford) of how long sleeping for 1 ms takes
+			double m_sleepMean;
+			double m_sleepM2;
+			unsigned long long m_sleepCount;
+		};
+
+	}
+}
+
+#endif
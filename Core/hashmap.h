@@ -0,0 +1,521 @@
+
+#ifndef Rocket_Core_HashMap_H
+#define Rocket_Core_HashMap_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <string>
+#include <string.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined( __SSE2__ ) || defined( _M_X64 )
+#include <emmintrin.h>
+#define ROCKET_HASHMAP_SSE2
+#endif
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+#include "allocators.h"
+#include "rstring.h"
+#include "stringid.h"
+
+namespace Rocket {
+	namespace Core {
+
+		// Open addressing hash table (in the style of Swiss tables)
+		// Each slot has a control byte, which is empty, deleted, or 7 bits of the hash of the slot's key. Slots are probed 16 at a
+		// time: one SSE2 comparison of a group's control bytes finds the slots that may hold the key, so that keys are compared
+		// about once per lookup, and a group with an empty slot ends the search. Erasing never moves elements, so iterators to the
+		// other elements stay valid (and erasing while iterating works), but inserting may rehash, which invalidates all iterators.
+		//
+		// FlatHashMap keeps the elements in the table, which is the fastest, and moves them when it grows.
+		// NodeHashMap keeps each element in its own block (from a SharedPool), so that pointers and references to elements are
+		// stable handles for as long as the elements are in the map.
+		// With a transparent Hash and Equal (such as StringHash and StringEqual), find(), count() and erase() take any key type
+		// that they accept, e.g. a table keyed by std::string can be searched with a const char * without building a string.
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		class HashTable;
+
+		template < typename Key, typename Value >
+		struct HashMap_FlatSlots;
+		template < typename Key, typename Value >
+		struct HashMap_NodeSlots;
+
+		template < typename Key, typename Value, typename Hash = std::hash< Key >, typename Equal = std::equal_to< Key > >
+		using FlatHashMap = HashTable< Key, Value, Hash, Equal, HashMap_FlatSlots< Key, Value > >;
+		template < typename Key, typename Value, typename Hash = std::hash< Key >, typename Equal = std::equal_to< Key > >
+		using NodeHashMap = HashTable< Key, Value, Hash, Equal, HashMap_NodeSlots< Key, Value > >;
+
+		// The characters of a string, without owning them
+		struct StringKey {
+			StringKey( const char * s ) : data( s ), length( strlen( s ) ) {}
+			StringKey( const char * s, size_t n ) : data( s ), length( n ) {}
+			StringKey( const std::string & s ) : data( s.data() ), length( s.length() ) {}
+			StringKey( const rstring & s ) : data( s.c_str() ), length( s.length() ) {}
+			StringKey( const StringBuilder & s ) : data( s.c_str() ), length( s.length() ) {}
+
+			const char * data;
+			size_t length;
+		};
+
+		// Transparent hash and equality of strings, for tables keyed by std::string that are searched with other strings
+		struct StringHash {
+			typedef void is_transparent;
+			size_t operator () ( StringKey key ) const { return (size_t)fnv1a( key.data, key.length ); }
+		};
+		struct StringEqual {
+			typedef void is_transparent;
+			bool operator () ( StringKey lhs, StringKey rhs ) const { return lhs.length == rhs.length && memcmp( lhs.data, rhs.data, lhs.length ) == 0; }
+		};
+
+		// --------------------------------------------------------------------------------------------------------------------
+		// Control bytes and groups
+		// --------------------------------------------------------------------------------------------------------------------
+
+		typedef signed char HashMap_Control;
+		static const HashMap_Control HashMap_Empty = -128;
+		static const HashMap_Control HashMap_Deleted = -2;
+		static const size_t HashMap_GroupSize = 16;
+
+		// Control bytes of the tables that have not allocated yet: one group of empty slots, so that lookups need no check
+		inline const HashMap_Control * HashMap_EmptyGroup() {
+			alignas( 16 ) static const HashMap_Control group[ HashMap_GroupSize ] = {
+				HashMap_Empty, HashMap_Empty, HashMap_Empty, HashMap_Empty, HashMap_Empty, HashMap_Empty, HashMap_Empty, HashMap_Empty,
+				HashMap_Empty, HashMap_Empty, HashMap_Empty, HashMap_Empty, HashMap_Empty, HashMap_Empty, HashMap_Empty, HashMap_Empty
+			};
+			return group;
+		}
+
+		inline unsigned int HashMap_LowestBit( unsigned int mask ) {
+#if defined( _MSC_VER )
+			unsigned long lowest;
+			_BitScanForward( &lowest, mask );
+			return (unsigned int)lowest;
+#else
+			return __builtin_ctz( mask );
+#endif
+		}
+
+		// Finalizer of the hash of a key, so that hashes which are just the value of an integer or pointer (as std::hash's are)
+		// spread over the 7 bits in the control bytes and the bits that choose the group
+		inline size_t HashMap_Mix( size_t hash ) {
+			unsigned long long mixed = hash;
+			mixed ^= mixed >> 33;
+			mixed *= 0xff51afd7ed558ccdull;
+			mixed ^= mixed >> 33;
+			return (size_t)mixed;
+		}
+
+		// The control bytes of 16 slots, and masks with bit i set for each slot i that matches
+		struct HashMap_Group {
+#if defined( ROCKET_HASHMAP_SSE2 )
+			explicit HashMap_Group( const HashMap_Control * control ) : bytes( _mm_loadu_si128( (const __m128i *)control ) ) {}
+
+			unsigned int match( HashMap_Control hash ) const { return (unsigned int)_mm_movemask_epi8( _mm_cmpeq_epi8( bytes, _mm_set1_epi8( hash ) ) ); }
+			unsigned int matchEmpty() const { return match( HashMap_Empty ); }
+			// Empty or deleted, which are the control bytes with the sign bit set
+			unsigned int matchFree() const { return (unsigned int)_mm_movemask_epi8( bytes ); }
+
+			__m128i bytes;
+#else
+			explicit HashMap_Group( const HashMap_Control * control ) : bytes( control ) {}
+
+			unsigned int match( HashMap_Control hash ) const {
+				unsigned int mask = 0;
+				for ( unsigned int i = 0; i < HashMap_GroupSize; i++ ) mask |= (unsigned int)( bytes[i] == hash ) << i;
+				return mask;
+			}
+			unsigned int matchEmpty() const { return match( HashMap_Empty ); }
+			unsigned int matchFree() const {
+				unsigned int mask = 0;
+				for ( unsigned int i = 0; i < HashMap_GroupSize; i++ ) mask |= (unsigned int)( bytes[i] < 0 ) << i;
+				return mask;
+			}
+
+			const HashMap_Control * bytes;
+#endif
+		};
+
+		// --------------------------------------------------------------------------------------------------------------------
+		// Slots
+		// --------------------------------------------------------------------------------------------------------------------
+
+		// Elements in the slots. The key is stored without const, so that it can be moved when the table grows, and it is given
+		// out as the const key of a std::pair< const Key, Value >, which has the same layout.
+		template < typename Key, typename Value >
+		struct HashMap_FlatSlots {
+			typedef std::pair< const Key, Value > value_type;
+			typedef std::pair< Key, Value > Slot;
+
+			static value_type & element( Slot & slot ) { return reinterpret_cast< value_type & >( slot ); }
+			static const Key & key( const Slot & slot ) { return slot.first; }
+			template < typename... Arguments >
+			static void construct( Slot * slot, Arguments &&... arguments ) { new ( slot ) Slot( std::forward< Arguments >( arguments )... ); }
+			static void destroy( Slot & slot ) { slot.~Slot(); }
+			static void transfer( Slot * to, Slot & from ) {
+				new ( to ) Slot( std::move( from ) );
+				from.~Slot();
+			}
+		};
+
+		// Pointers to elements in blocks of a SharedPool, which do not move when the table grows
+		template < typename Key, typename Value >
+		struct HashMap_NodeSlots {
+			typedef std::pair< const Key, Value > value_type;
+			typedef value_type * Slot;
+
+			static value_type & element( Slot & slot ) { return *slot; }
+			static const Key & key( const Slot & slot ) { return slot->first; }
+			template < typename... Arguments >
+			static void construct( Slot * slot, Arguments &&... arguments ) {
+				*slot = PoolAllocator< value_type >().allocate( 1 );
+				new ( *slot ) value_type( std::forward< Arguments >( arguments )... );
+			}
+			static void destroy( Slot & slot ) {
+				slot->~value_type();
+				PoolAllocator< value_type >().deallocate( slot, 1 );
+			}
+			static void transfer( Slot * to, Slot & from ) { *to = from; }
+		};
+
+		// --------------------------------------------------------------------------------------------------------------------
+		// HashTable
+		// --------------------------------------------------------------------------------------------------------------------
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		class HashTable {
+			typedef typename Slots::Slot Slot;
+
+		public:
+			typedef Key key_type;
+			typedef Value mapped_type;
+			typedef typename Slots::value_type value_type;
+			typedef size_t size_type;
+
+			template < bool Constant >
+			class Iterator {
+			public:
+				typedef typename std::conditional< Constant, const value_type, value_type >::type Element;
+				typedef typename std::conditional< Constant, const HashTable, HashTable >::type Table;
+
+				Iterator() : m_table( nullptr ), m_index( 0 ) {}
+				Iterator( Table * table, size_t index ) : m_table( table ), m_index( index ) {}
+				// An iterator converts to a const_iterator
+				template < bool OtherConstant, typename = typename std::enable_if< Constant && !OtherConstant >::type >
+				Iterator( const Iterator< OtherConstant > & other ) : m_table( other.m_table ), m_index( other.m_index ) {}
+
+				Element & operator * () const { return Slots::element( m_table->m_slots[ m_index ] ); }
+				Element * operator -> () const { return &**this; }
+
+				Iterator & operator ++ () {
+					m_index = m_table->nextFull( m_index + 1 );
+					return *this;
+				}
+				Iterator operator ++ ( int ) {
+					Iterator previous = *this;
+					++*this;
+					return previous;
+				}
+
+				bool operator == ( const Iterator & rhs ) const { return m_index == rhs.m_index; }
+				bool operator != ( const Iterator & rhs ) const { return m_index != rhs.m_index; }
+
+			private:
+				friend class HashTable;
+				friend class Iterator< true >;
+
+				Table * m_table;
+				size_t m_index;
+			};
+			typedef Iterator< false > iterator;
+			typedef Iterator< true > const_iterator;
+
+			HashTable() : m_control( const_cast< HashMap_Control * >( HashMap_EmptyGroup() ) ), m_slots( nullptr ), m_capacity( 0 ), m_groupMask( 0 ), m_size( 0 ), m_growthLeft( 0 ) {}
+			explicit HashTable( size_t capacity ) : HashTable() { reserve( capacity ); }
+			HashTable( const HashTable & other );
+			HashTable( HashTable && other );
+			~HashTable();
+
+			HashTable & operator = ( const HashTable & other );
+			HashTable & operator = ( HashTable && other );
+
+			iterator begin() { return iterator( this, nextFull( 0 ) ); }
+			iterator end() { return iterator( this, capacity() ); }
+			const_iterator begin() const { return const_iterator( this, nextFull( 0 ) ); }
+			const_iterator end() const { return const_iterator( this, capacity() ); }
+
+			size_t size() const { return m_size; }
+			bool empty() const { return m_size == 0; }
+			// Number of slots; the table grows when it would be more than 7/8 full
+			size_t capacity() const { return m_capacity; }
+
+			iterator find( const Key & key ) { return iterator( this, findIndex( key ) ); }
+			const_iterator find( const Key & key ) const { return const_iterator( this, findIndex( key ) ); }
+			size_t count( const Key & key ) const { return findIndex( key ) != capacity() ? 1 : 0; }
+			template < typename K, typename H = Hash, typename = typename H::is_transparent >
+			iterator find( const K & key ) { return iterator( this, findIndex( key ) ); }
+			template < typename K, typename H = Hash, typename = typename H::is_transparent >
+			const_iterator find( const K & key ) const { return const_iterator( this, findIndex( key ) ); }
+			template < typename K, typename H = Hash, typename = typename H::is_transparent >
+			size_t count( const K & key ) const { return findIndex( key ) != capacity() ? 1 : 0; }
+
+			// Inserts Value( arguments... ) if key is not in the table; the bool is true if it inserted
+			template < typename... Arguments >
+			std::pair< iterator, bool > try_emplace( const Key & key, Arguments &&... arguments );
+			template < typename... Arguments >
+			std::pair< iterator, bool > try_emplace( Key && key, Arguments &&... arguments );
+			std::pair< iterator, bool > insert( const value_type & value ) { return try_emplace( value.first, value.second ); }
+			std::pair< iterator, bool > insert( value_type && value ) { return try_emplace( value.first, std::move( value.second ) ); }
+			Value & operator [] ( const Key & key ) { return try_emplace( key ).first->second; }
+			Value & operator [] ( Key && key ) { return try_emplace( std::move( key ) ).first->second; }
+
+			// Returns the iterator to the next element
+			iterator erase( const_iterator position );
+			iterator erase( iterator position ) { return erase( const_iterator( position ) ); }
+			size_t erase( const Key & key ) { return eraseKey( key ); }
+			template < typename K, typename H = Hash, typename = typename H::is_transparent >
+			size_t erase( const K & key ) { return eraseKey( key ); }
+
+			// Keeps the memory of the table
+			void clear();
+			// Makes room for count elements, so that inserting up to that many does not rehash
+			void reserve( size_t count );
+
+		private:
+			template < typename K >
+			size_t findIndex( const K & key ) const { return findIndex( key, HashMap_Mix( m_hash( key ) ) ); }
+			// Index of the slot holding key, or capacity()
+			// Probes the groups from the one chosen by the hash, in triangular steps (1, 2, 3...), which visit every group once
+			// when there is a power of 2 of them. Defined here so that it is inlined into find().
+			template < typename K >
+			size_t findIndex( const K & key, size_t hash ) const {
+				HashMap_Control h2 = HashMap_Control( hash & 0x7f );
+				size_t group = ( hash >> 7 ) & m_groupMask;
+				for ( size_t step = 1; ; step++ ) {
+					HashMap_Group controls( m_control + group * HashMap_GroupSize );
+					for ( unsigned int matches = controls.match( h2 ); matches != 0; matches &= matches - 1 ) {
+						size_t index = group * HashMap_GroupSize + HashMap_LowestBit( matches );
+						if ( m_equal( Slots::key( m_slots[ index ] ), key ) ) return index;
+					}
+					// The key would have been put in this group's empty slot
+					if ( controls.matchEmpty() != 0 ) return m_capacity;
+					group = ( group + step ) & m_groupMask;
+				}
+			}
+			// Index of a free slot for a key with that hash, which must not be in the table, made ready for Slots::construct()
+			size_t prepareInsert( size_t hash );
+			template < typename K, typename... Arguments >
+			std::pair< iterator, bool > emplaceKey( K && key, Arguments &&... arguments );
+			template < typename K >
+			size_t eraseKey( const K & key );
+
+			size_t findFree( size_t hash ) const;
+			size_t nextFull( size_t index ) const;
+			void eraseIndex( size_t index );
+			void resize( size_t capacity );
+			void destroyAll();
+
+			static size_t maxLoad( size_t capacity ) { return capacity - capacity / 8; }
+
+			HashMap_Control * m_control;	// m_capacity control bytes, or the empty group
+			Slot * m_slots;					// in the same allocation as the control bytes
+			size_t m_capacity;
+			size_t m_groupMask;				// groups - 1, or 0 for the empty group
+			size_t m_size;
+			size_t m_growthLeft;			// empty slots that can be filled before the table must grow
+			Hash m_hash;
+			Equal m_equal;
+		};
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		HashTable< Key, Value, Hash, Equal, Slots >::HashTable( const HashTable & other ) : HashTable() {
+			*this = other;
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		HashTable< Key, Value, Hash, Equal, Slots >::HashTable( HashTable && other ) : HashTable() {
+			*this = std::move( other );
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		HashTable< Key, Value, Hash, Equal, Slots >::~HashTable() {
+			destroyAll();
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		HashTable< Key, Value, Hash, Equal, Slots > & HashTable< Key, Value, Hash, Equal, Slots >::operator = ( const HashTable & other ) {
+			if ( this == &other ) return *this;
+			clear();
+			reserve( other.size() );
+			for ( const value_type & element : other ) try_emplace( element.first, element.second );
+			return *this;
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		HashTable< Key, Value, Hash, Equal, Slots > & HashTable< Key, Value, Hash, Equal, Slots >::operator = ( HashTable && other ) {
+			if ( this == &other ) return *this;
+			destroyAll();
+			m_control = other.m_control;
+			m_slots = other.m_slots;
+			m_capacity = other.m_capacity;
+			m_groupMask = other.m_groupMask;
+			m_size = other.m_size;
+			m_growthLeft = other.m_growthLeft;
+			other.m_control = const_cast< HashMap_Control * >( HashMap_EmptyGroup() );
+			other.m_slots = nullptr;
+			other.m_capacity = 0;
+			other.m_groupMask = 0;
+			other.m_size = 0;
+			other.m_growthLeft = 0;
+			return *this;
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		size_t HashTable< Key, Value, Hash, Equal, Slots >::findFree( size_t hash ) const {
+			size_t group = ( hash >> 7 ) & m_groupMask;
+			for ( size_t step = 1; ; step++ ) {
+				unsigned int free = HashMap_Group( m_control + group * HashMap_GroupSize ).matchFree();
+				if ( free != 0 ) return group * HashMap_GroupSize + HashMap_LowestBit( free );
+				group = ( group + step ) & m_groupMask;
+			}
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		size_t HashTable< Key, Value, Hash, Equal, Slots >::prepareInsert( size_t hash ) {
+			size_t index = findFree( hash );
+			// A deleted slot can be reused without growing, as it does not take away an empty slot that ends searches
+			if ( m_growthLeft == 0 && m_control[ index ] != HashMap_Deleted ) {
+				// Rehash at the same size when at least half the load is deleted slots
+				size_t slots = capacity();
+				resize( ( slots == 0 ) ? HashMap_GroupSize : ( m_size * 2 <= maxLoad( slots ) ) ? slots : slots * 2 );
+				index = findFree( hash );
+			}
+			if ( m_control[ index ] == HashMap_Empty ) m_growthLeft--;
+			m_control[ index ] = HashMap_Control( hash & 0x7f );
+			m_size++;
+			return index;
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		template < typename K, typename... Arguments >
+		std::pair< typename HashTable< Key, Value, Hash, Equal, Slots >::iterator, bool > HashTable< Key, Value, Hash, Equal, Slots >::emplaceKey( K && key, Arguments &&... arguments ) {
+			size_t hash = HashMap_Mix( m_hash( key ) );
+			size_t index = findIndex( key, hash );
+			if ( index != capacity() ) return std::make_pair( iterator( this, index ), false );
+			index = prepareInsert( hash );
+			Slots::construct( &m_slots[ index ], std::piecewise_construct, std::forward_as_tuple( std::forward< K >( key ) ), std::forward_as_tuple( std::forward< Arguments >( arguments )... ) );
+			return std::make_pair( iterator( this, index ), true );
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		template < typename... Arguments >
+		std::pair< typename HashTable< Key, Value, Hash, Equal, Slots >::iterator, bool > HashTable< Key, Value, Hash, Equal, Slots >::try_emplace( const Key & key, Arguments &&... arguments ) {
+			return emplaceKey( key, std::forward< Arguments >( arguments )... );
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		template < typename... Arguments >
+		std::pair< typename HashTable< Key, Value, Hash, Equal, Slots >::iterator, bool > HashTable< Key, Value, Hash, Equal, Slots >::try_emplace( Key && key, Arguments &&... arguments ) {
+			return emplaceKey( std::move( key ), std::forward< Arguments >( arguments )... );
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		typename HashTable< Key, Value, Hash, Equal, Slots >::iterator HashTable< Key, Value, Hash, Equal, Slots >::erase( const_iterator position ) {
+			eraseIndex( position.m_index );
+			return iterator( this, nextFull( position.m_index + 1 ) );
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		template < typename K >
+		size_t HashTable< Key, Value, Hash, Equal, Slots >::eraseKey( const K & key ) {
+			size_t index = findIndex( key );
+			if ( index == capacity() ) return 0;
+			eraseIndex( index );
+			return 1;
+		}
+
+		// A slot in a group that has an empty slot can be emptied too: the group has not been full since the last rehash, so no
+		// search has gone on past it. Otherwise the slot is marked deleted, so that searches still go on past it.
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		void HashTable< Key, Value, Hash, Equal, Slots >::eraseIndex( size_t index ) {
+			Slots::destroy( m_slots[ index ] );
+			m_size--;
+			if ( HashMap_Group( m_control + ( index & ~( HashMap_GroupSize - 1 ) ) ).matchEmpty() != 0 ) {
+				m_control[ index ] = HashMap_Empty;
+				m_growthLeft++;
+			} else {
+				m_control[ index ] = HashMap_Deleted;
+			}
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		size_t HashTable< Key, Value, Hash, Equal, Slots >::nextFull( size_t index ) const {
+			while ( index < m_capacity && m_control[ index ] < 0 ) index++;
+			return index;
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		void HashTable< Key, Value, Hash, Equal, Slots >::clear() {
+			size_t slots = capacity();
+			for ( size_t i = 0; i < slots; i++ ) {
+				if ( m_control[i] >= 0 ) Slots::destroy( m_slots[i] );
+			}
+			if ( slots > 0 ) memset( m_control, HashMap_Empty, slots );
+			m_size = 0;
+			m_growthLeft = maxLoad( slots );
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		void HashTable< Key, Value, Hash, Equal, Slots >::reserve( size_t count ) {
+			size_t slots = HashMap_GroupSize;
+			while ( maxLoad( slots ) < count ) slots *= 2;
+			if ( slots > capacity() ) resize( slots );
+		}
+
+		// Moves the elements into a new table of capacity slots (a power of 2, at least a group)
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		void HashTable< Key, Value, Hash, Equal, Slots >::resize( size_t capacity ) {
+			static_assert( alignof( Slot ) <= alignof( std::max_align_t ), "HashTable: over-aligned elements are not supported" );
+			size_t slotsOffset = ( capacity + alignof( Slot ) - 1 ) & ~( alignof( Slot ) - 1 );
+			char * memory = (char *)::operator new( slotsOffset + capacity * sizeof( Slot ) );
+
+			HashMap_Control * oldControl = m_control;
+			Slot * oldSlots = m_slots;
+			size_t oldCapacity = m_capacity;
+			m_control = (HashMap_Control *)memory;
+			m_slots = (Slot *)( memory + slotsOffset );
+			m_capacity = capacity;
+			m_groupMask = capacity / HashMap_GroupSize - 1;
+			memset( m_control, HashMap_Empty, capacity );
+
+			for ( size_t i = 0; i < oldCapacity; i++ ) {
+				if ( oldControl[i] < 0 ) continue;
+				size_t hash = HashMap_Mix( m_hash( Slots::key( oldSlots[i] ) ) );
+				size_t index = findFree( hash );
+				m_control[ index ] = HashMap_Control( hash & 0x7f );
+				Slots::transfer( &m_slots[ index ], oldSlots[i] );
+			}
+			m_growthLeft = maxLoad( capacity ) - m_size;
+			if ( oldSlots != nullptr ) ::operator delete( oldControl );
+		}
+
+		template < typename Key, typename Value, typename Hash, typename Equal, typename Slots >
+		void HashTable< Key, Value, Hash, Equal, Slots >::destroyAll() {
+			if ( m_slots == nullptr ) return;
+			clear();
+			::operator delete( m_control );
+			m_control = const_cast< HashMap_Control * >( HashMap_EmptyGroup() );
+			m_slots = nullptr;
+			m_capacity = 0;
+			m_groupMask = 0;
+			m_growthLeft = 0;
+		}
+
+	}
+}
+
+#endif
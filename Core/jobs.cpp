@@ -0,0 +1,333 @@
+
+#include "jobs.h"
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#include <immintrin.h>
+#define JobSystem_Pause() _mm_pause()
+#else
+#define JobSystem_Pause() std::this_thread::yield()
+#endif
+
+namespace Rocket {
+	namespace Core {
+
+		// Chase-Lev work-stealing deque of fixed capacity (with the C11 memory orderings of Le, Pop, Cohen and Zappa Nardelli, 2013)
+		// The owner pushes and pops at the bottom; any thread can steal from the top
+		struct JobSystem_Queue {
+			std::atomic< long long > top;
+			std::atomic< long long > bottom;
+			std::atomic< Job * > jobs[ JobSystem::PoolSize ];
+
+			JobSystem_Queue() : top( 0 ), bottom( 0 ) {}
+
+			bool push( Job * job ) {
+				long long b = bottom.load( std::memory_order_relaxed );
+				long long t = top.load( std::memory_order_acquire );
+				if ( b - t >= (long long)JobSystem::PoolSize ) return false;
+				jobs[ b & ( JobSystem::PoolSize - 1 ) ].store( job, std::memory_order_relaxed );
+				bottom.store( b + 1, std::memory_order_release );
+				return true;
+			}
+
+			Job * pop() {
+				long long b = bottom.load( std::memory_order_relaxed ) - 1;
+				bottom.store( b, std::memory_order_relaxed );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				long long t = top.load( std::memory_order_relaxed );
+				Job * job = nullptr;
+				if ( t <= b ) {
+					job = jobs[ b & ( JobSystem::PoolSize - 1 ) ].load( std::memory_order_relaxed );
+					if ( t == b ) {
+						// Last job: race the thieves for it
+						if ( top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) == false ) job = nullptr;
+						bottom.store( b + 1, std::memory_order_relaxed );
+					}
+				} else {
+					bottom.store( b + 1, std::memory_order_relaxed );
+				}
+				return job;
+			}
+
+			Job * steal() {
+				long long t = top.load( std::memory_order_acquire );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				long long b = bottom.load( std::memory_order_acquire );
+				if ( t >= b ) return nullptr;
+				Job * job = jobs[ t & ( JobSystem::PoolSize - 1 ) ].load( std::memory_order_relaxed );
+				if ( top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) == false ) return nullptr;
+				return job;
+			}
+
+			bool empty() const {
+				return bottom.load( std::memory_order_relaxed ) <= top.load( std::memory_order_relaxed );
+			}
+		};
+
+		// Deque and job pool of one thread (or, behind ownerMutex, of every thread that is not part of the JobSystem)
+		struct JobSystem_Thread {
+			JobSystem_Queue queue;
+			Job pool[ JobSystem::PoolSize ];
+			unsigned int nextJob;
+			unsigned int random;							// state of the xorshift that picks which deque to steal from first
+			bool shared;
+			std::mutex ownerMutex;
+		};
+
+		// The JobSystem and deque of the calling thread
+		struct JobSystem_Context {
+			JobSystem * system;
+			JobSystem_Thread * thread;
+		};
+		static thread_local JobSystem_Context JobSystem_Current = { nullptr, nullptr };
+
+		unsigned int JobSystem::defaultWorkerCount() {
+			unsigned int threads = std::thread::hardware_concurrency();
+			return ( threads > 1 ) ? threads - 1 : 0;
+		}
+
+		JobSystem::JobSystem( unsigned int workerCount ) : m_running( true ), m_sleepers( 0 ), m_wakeEpoch( 0 ) {
+			for ( unsigned int t = 0; t < workerCount + 2; t++ ) {
+				JobSystem_Thread * thread = new JobSystem_Thread();
+				for ( auto & job : thread->pool ) {
+					job.system = this;
+					job.unfinished.store( 0, std::memory_order_relaxed );
+					job.pending.store( 0, std::memory_order_relaxed );
+					job.generation.store( 0, std::memory_order_relaxed );
+					job.inUse.store( false, std::memory_order_relaxed );
+					job.locked.store( false, std::memory_order_relaxed );
+				}
+				thread->nextJob = 0;
+				thread->random = 2463534242u + t * 7919u;
+				thread->shared = ( t == workerCount + 1 );
+				m_threads.push_back( thread );
+			}
+
+			JobSystem_Current.system = this;
+			JobSystem_Current.thread = m_threads[0];
+			for ( unsigned int w = 0; w < workerCount; w++ ) {
+				JobSystem_Thread * thread = m_threads[ w + 1 ];
+				m_workers.push_back( std::thread( [ this, thread ] () { workerLoop( thread ); } ) );
+			}
+		}
+
+		JobSystem::~JobSystem() {
+			// Run whatever is still queued, then stop the workers
+			JobSystem_Thread * self = currentThread();
+			while ( Job * job = find( self ) ) execute( job );
+
+			m_running.store( false );
+			{
+				std::lock_guard< std::mutex > lock( m_wakeMutex );
+				m_wakeEpoch++;
+			}
+			m_wakeCondition.notify_all();
+			for ( auto & worker : m_workers ) worker.join();
+
+			if ( JobSystem_Current.system == this ) JobSystem_Current.system = nullptr;
+			for ( auto thread : m_threads ) delete thread;
+		}
+
+		JobSystem_Thread * JobSystem::currentThread() {
+			return ( JobSystem_Current.system == this ) ? JobSystem_Current.thread : m_threads.back();
+		}
+
+		bool JobSystem::localQueueEmpty() {
+			return currentThread()->queue.empty();
+		}
+
+		Job * JobSystem::allocate( Job * parent ) {
+			JobSystem_Thread * thread = currentThread();
+			Job * job = nullptr;
+			while ( job == nullptr ) {
+				{
+					std::unique_lock< std::mutex > lock( thread->ownerMutex, std::defer_lock );
+					if ( thread->shared ) lock.lock();
+					for ( unsigned int i = 0; i < PoolSize; i++ ) {
+						Job * candidate = &thread->pool[ ( thread->nextJob + i ) & ( PoolSize - 1 ) ];
+						if ( candidate->inUse.load( std::memory_order_acquire ) == false ) {
+							thread->nextJob += i + 1;
+							candidate->inUse.store( true, std::memory_order_relaxed );
+							job = candidate;
+							break;
+						}
+					}
+				}
+				if ( job == nullptr ) {
+					// Every job of this thread is still queued or running: help them finish
+					Job * other = find( thread );
+					if ( other != nullptr ) execute( other ); else JobSystem_Pause();
+				}
+			}
+
+			// The generation changes first, so that handles to the job's last use see it as done from now on
+			bool expected = false;
+			while ( job->locked.compare_exchange_weak( expected, true, std::memory_order_acquire ) == false ) expected = false;
+			job->generation.fetch_add( 1, std::memory_order_release );
+			job->finished = false;
+			job->continuationCount = 0;
+			job->locked.store( false, std::memory_order_release );
+
+			job->parent = parent;
+			if ( parent != nullptr ) parent->unfinished.fetch_add( 1, std::memory_order_relaxed );
+			job->pending.store( 1, std::memory_order_relaxed );
+			job->unfinished.store( 1, std::memory_order_release );
+			return job;
+		}
+
+		JobHandle JobSystem::submit( Job * job, const JobHandle * dependencies, unsigned int dependencyCount ) {
+			JobHandle handle( job, job->generation.load( std::memory_order_relaxed ) );
+			for ( unsigned int d = 0; d < dependencyCount; d++ ) {
+				Job * dependency = dependencies[d].m_job;
+				if ( dependencies[d].done() ) continue;
+
+				bool expected = false, added = false, full = false;
+				while ( dependency->locked.compare_exchange_weak( expected, true, std::memory_order_acquire ) == false ) expected = false;
+				if ( dependency->generation.load( std::memory_order_relaxed ) == dependencies[d].m_generation && dependency->finished == false ) {
+					if ( dependency->continuationCount < Job::MaxContinuations ) {
+						dependency->continuations[ dependency->continuationCount++ ] = job;
+						job->pending.fetch_add( 1, std::memory_order_relaxed );
+						added = true;
+					} else {
+						full = true;
+					}
+				}
+				dependency->locked.store( false, std::memory_order_release );
+
+				// No room to be started by the dependency: wait for it here instead
+				if ( full && added == false ) wait( dependencies[d] );
+			}
+
+			if ( job->pending.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) push( job );
+			return handle;
+		}
+
+		void JobSystem::push( Job * job ) {
+			JobSystem_Thread * thread = currentThread();
+			bool pushed;
+			if ( thread->shared ) {
+				std::lock_guard< std::mutex > lock( thread->ownerMutex );
+				pushed = thread->queue.push( job );
+			} else {
+				pushed = thread->queue.push( job );
+			}
+			if ( pushed == false ) {
+				// The deque is full: run the job now
+				execute( job );
+				return;
+			}
+
+			// Wake a sleeping worker; the push and this check are ordered against the worker's registering and checking the deques
+			std::atomic_thread_fence( std::memory_order_seq_cst );
+			if ( m_sleepers.load( std::memory_order_relaxed ) > 0 ) {
+				{
+					std::lock_guard< std::mutex > lock( m_wakeMutex );
+					m_wakeEpoch++;
+				}
+				m_wakeCondition.notify_one();
+			}
+		}
+
+		// A job from the thread's own deque, or stolen from another
+		Job * JobSystem::find( JobSystem_Thread * thread ) {
+			Job * job;
+			if ( thread->shared ) {
+				std::lock_guard< std::mutex > lock( thread->ownerMutex );
+				job = thread->queue.pop();
+			} else {
+				job = thread->queue.pop();
+			}
+			if ( job != nullptr ) return job;
+
+			thread->random ^= thread->random << 13;
+			thread->random ^= thread->random >> 17;
+			thread->random ^= thread->random << 5;
+			unsigned int count = (unsigned int)m_threads.size();
+			unsigned int first = thread->random % count;
+			for ( unsigned int i = 0; i < count; i++ ) {
+				JobSystem_Thread * victim = m_threads[ ( first + i ) % count ];
+				if ( victim == thread ) continue;
+				job = victim->queue.steal();
+				if ( job != nullptr ) return job;
+			}
+			return nullptr;
+		}
+
+		void JobSystem::execute( Job * job ) {
+			job->function( job );
+			finish( job );
+		}
+
+		void JobSystem::finish( Job * job ) {
+			if ( job->unfinished.fetch_sub( 1, std::memory_order_acq_rel ) != 1 ) return;
+
+			// Done: no continuation can be added from now on
+			bool expected = false;
+			while ( job->locked.compare_exchange_weak( expected, true, std::memory_order_acquire ) == false ) expected = false;
+			job->finished = true;
+			unsigned int continuationCount = job->continuationCount;
+			Job * continuations[ Job::MaxContinuations ];
+			for ( unsigned int c = 0; c < continuationCount; c++ ) continuations[c] = job->continuations[c];
+			job->locked.store( false, std::memory_order_release );
+
+			Job * parent = job->parent;
+			job->inUse.store( false, std::memory_order_release );
+
+			for ( unsigned int c = 0; c < continuationCount; c++ ) {
+				if ( continuations[c]->pending.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) push( continuations[c] );
+			}
+			if ( parent != nullptr ) finish( parent );
+		}
+
+		void JobSystem::wait( JobHandle job ) {
+			JobSystem_Thread * thread = currentThread();
+			unsigned int idle = 0;
+			while ( job.done() == false ) {
+				Job * other = find( thread );
+				if ( other != nullptr ) {
+					execute( other );
+					idle = 0;
+				} else if ( ++idle < 64 ) {
+					JobSystem_Pause();
+				} else {
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		void JobSystem::workerLoop( JobSystem_Thread * thread ) {
+			JobSystem_Current.system = this;
+			JobSystem_Current.thread = thread;
+
+			unsigned int idle = 0;
+			while ( m_running.load( std::memory_order_relaxed ) ) {
+				Job * job = find( thread );
+				if ( job != nullptr ) {
+					execute( job );
+					idle = 0;
+					continue;
+				}
+				if ( ++idle < 256 ) {
+					JobSystem_Pause();
+					continue;
+				}
+
+				// Sleep until a job is pushed, unless one was pushed since the deques were last checked
+				std::unique_lock< std::mutex > lock( m_wakeMutex );
+				unsigned long long epoch = m_wakeEpoch;
+				m_sleepers.fetch_add( 1, std::memory_order_relaxed );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				bool empty = true;
+				for ( auto other : m_threads ) {
+					if ( other->queue.empty() == false ) empty = false;
+				}
+				if ( empty && m_running.load() ) {
+					m_wakeCondition.wait( lock, [ this, epoch ] () { return m_wakeEpoch != epoch; } );
+				}
+				m_sleepers.fetch_sub( 1, std::memory_order_relaxed );
+				idle = 0;
+			}
+			JobSystem_Current.system = nullptr;
+		}
+
+	}
+}
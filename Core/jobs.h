@@ -0,0 +1,182 @@
+
+#ifndef Rocket_Core_Jobs_H
+#define Rocket_Core_Jobs_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace Rocket {
+	namespace Core {
+
+		class JobSystem;
+
+		// A function queued on a JobSystem, with its captures stored inline (used by JobSystem)
+		struct Job {
+			static const unsigned int PayloadSize = 64;
+			static const unsigned int MaxContinuations = 6;
+
+			void ( *function )( Job * job );				// runs and destroys the payload
+			JobSystem * system;
+			Job * parent;									// finishes only once this job has
+			std::atomic< int > unfinished;					// 1 until the function has returned, plus 1 per unfinished child
+			std::atomic< int > pending;						// dependencies still running, plus 1 while they are being added
+			std::atomic< unsigned int > generation;			// incremented each time the job is reused, to tell old handles apart
+			std::atomic< bool > inUse;
+			std::atomic< bool > locked;						// guards finished and continuations
+			bool finished;
+			unsigned int continuationCount;
+			Job * continuations[ MaxContinuations ];		// jobs that depend on this one
+			alignas( 16 ) unsigned char payload[ PayloadSize ];
+		};
+
+		// Reference to a job; a default constructed handle refers to no job and is always done
+		class JobHandle {
+		public:
+			JobHandle() : m_job( nullptr ), m_generation( 0 ) {}
+
+			bool done() const {
+				return m_job == nullptr || m_job->generation.load( std::memory_order_acquire ) != m_generation ||
+					m_job->unfinished.load( std::memory_order_acquire ) == 0;
+			}
+
+		private:
+			friend class JobSystem;
+			JobHandle( Job * job, unsigned int generation ) : m_job( job ), m_generation( generation ) {}
+
+			Job * m_job;
+			unsigned int m_generation;
+		};
+
+		struct JobSystem_Thread;
+
+		// Fixed pool of worker threads running jobs from per-thread work-stealing deques
+		// Each thread pushes the jobs it creates onto its own deque and takes them back newest first, while idle threads steal the
+		// oldest jobs of the others. The thread that created the JobSystem has a deque too and runs jobs while it waits for one
+		// (wait() and parallel_for()); other threads can queue jobs, through a shared deque behind a mutex.
+		// Creating a job does not allocate: jobs come from a pool of PoolSize per thread, which waits for an old job to finish if
+		// they are all in use. All jobs must be done before the JobSystem is destroyed.
+		class JobSystem {
+		public:
+			static const unsigned int PoolSize = 1024;		// jobs per thread (a power of 2), and the capacity of each deque
+
+			// One worker per hardware thread besides the calling thread
+			static unsigned int defaultWorkerCount();
+
+			explicit JobSystem( unsigned int workerCount = defaultWorkerCount() );
+			~JobSystem();
+
+			unsigned int workerCount() const { return (unsigned int)m_workers.size(); }
+
+			// Queues function() to run on any thread; function is copied into the job, so its captures must fit in Job::PayloadSize
+			template < typename Function >
+			JobHandle run( const Function & function ) { return run( function, nullptr, 0 ); }
+			// Queues function() to run once dependency is done
+			template < typename Function >
+			JobHandle run( const Function & function, JobHandle dependency ) { return run( function, &dependency, 1 ); }
+			// Queues function() to run once every one of dependencyCount dependencies is done
+			template < typename Function >
+			JobHandle run( const Function & function, const JobHandle * dependencies, unsigned int dependencyCount );
+
+			// Runs queued jobs on the calling thread until job is done
+			void wait( JobHandle job );
+
+			// Calls function( first, last ) on subranges covering [begin, end) on every thread, and returns once they have all returned
+			// Each thread halves the rest of its range for others to steal whenever its own deque is empty (lazy binary splitting), so
+			// ranges are only split as much as the load requires; grain is the smallest range that is split (0 picks one).
+			template < typename Function >
+			void parallel_for( unsigned int begin, unsigned int end, const Function & function, unsigned int grain = 0 );
+
+		private:
+			std::vector< JobSystem_Thread * > m_threads;	// the creating thread, the workers, then the shared deque of other threads
+			std::vector< std::thread > m_workers;
+			std::atomic< bool > m_running;
+
+			// Idle workers sleep until the epoch changes
+			std::atomic< unsigned int > m_sleepers;
+			std::mutex m_wakeMutex;
+			std::condition_variable m_wakeCondition;
+			unsigned long long m_wakeEpoch;
+
+			Job * allocate( Job * parent );
+			JobHandle submit( Job * job, const JobHandle * dependencies, unsigned int dependencyCount );
+			void push( Job * job );
+			Job * find( JobSystem_Thread * thread );
+			void execute( Job * job );
+			void finish( Job * job );
+			bool localQueueEmpty();
+			JobSystem_Thread * currentThread();
+			void workerLoop( JobSystem_Thread * thread );
+
+			template < typename Function >
+			struct Range {
+				const Function * function;
+				unsigned int begin;
+				unsigned int end;
+				unsigned int grain;
+			};
+			template < typename Function >
+			static void runRange( Job * job );
+		};
+
+		template < typename Function >
+		JobHandle JobSystem::run( const Function & function, const JobHandle * dependencies, unsigned int dependencyCount ) {
+			static_assert( sizeof( Function ) <= Job::PayloadSize, "the job's captures do not fit in Job::PayloadSize: capture a pointer to them instead" );
+			static_assert( alignof( Function ) <= 16, "the job's captures need a larger alignment than its payload has" );
+			Job * job = allocate( nullptr );
+			new ( job->payload ) Function( function );
+			job->function = [] ( Job * self ) {
+				Function * function = (Function *)self->payload;
+				( *function )();
+				function->~Function();
+			};
+			return submit( job, dependencies, dependencyCount );
+		}
+
+		template < typename Function >
+		void JobSystem::runRange( Job * job ) {
+			Range< Function > range = *(Range< Function > *)job->payload;
+			JobSystem * system = job->system;
+			while ( range.end - range.begin > range.grain ) {
+				if ( system->localQueueEmpty() ) {
+					// Offer the upper half to idle threads
+					unsigned int middle = range.begin + ( range.end - range.begin ) / 2;
+					Job * child = system->allocate( job );
+					Range< Function > upper = { range.function, middle, range.end, range.grain };
+					new ( child->payload ) Range< Function >( upper );
+					child->function = &runRange< Function >;
+					system->submit( child, nullptr, 0 );
+					range.end = middle;
+				} else {
+					( *range.function )( range.begin, range.begin + range.grain );
+					range.begin += range.grain;
+				}
+			}
+			if ( range.begin < range.end ) ( *range.function )( range.begin, range.end );
+		}
+
+		template < typename Function >
+		void JobSystem::parallel_for( unsigned int begin, unsigned int end, const Function & function, unsigned int grain ) {
+			if ( begin >= end ) return;
+			if ( grain == 0 ) {
+				grain = ( end - begin ) / ( 64 * ( workerCount() + 1 ) );
+				if ( grain == 0 ) grain = 1;
+			}
+
+			// The whole range starts on this thread, and the others steal halves of it
+			Job * root = allocate( nullptr );
+			Range< Function > range = { &function, begin, end, grain };
+			new ( root->payload ) Range< Function >( range );
+			root->function = &runRange< Function >;
+			JobHandle handle( root, root->generation.load( std::memory_order_relaxed ) );
+			execute( root );
+			wait( handle );
+		}
+
+	}
+}
+
+#endif
@@ -0,0 +1,109 @@
+
+#include "matrix.h"
+
+#if defined( __AVX__ )
+#include <immintrin.h>
+#elif defined( __SSE2__ ) || defined( _M_X64 )
+#include <emmintrin.h>
+#define ROCKET_MATRIX_SSE
+#endif
+
+namespace Rocket {
+	namespace Core {
+
+#if defined( __AVX__ )
+		// Multiply-add that compiles to a single FMA instruction when available
+		static inline __m256 matrix_madd( __m256 a, __m256 b, __m256 c ) {
+#if defined( __FMA__ )
+			return _mm256_fmadd_ps( a, b, c );
+#else
+			return _mm256_add_ps( _mm256_mul_ps( a, b ), c );
+#endif
+		}
+		// The same for the last vec4 of an odd count, so that a vector's result does not depend on its position
+		static inline __m128 matrix_madd( __m128 a, __m128 b, __m128 c ) {
+#if defined( __FMA__ )
+			return _mm_fmadd_ps( a, b, c );
+#else
+			return _mm_add_ps( _mm_mul_ps( a, b ), c );
+#endif
+		}
+
+		// Transforms two vec4s at a time, with the columns of the matrix duplicated in both 128-bit lanes
+		static void transformColumns( const float columns[4][4], const vec4 * in, vec4 * out, unsigned int count ) {
+			__m256 c0 = _mm256_broadcast_ps( (const __m128 *)columns[0] );
+			__m256 c1 = _mm256_broadcast_ps( (const __m128 *)columns[1] );
+			__m256 c2 = _mm256_broadcast_ps( (const __m128 *)columns[2] );
+			__m256 c3 = _mm256_broadcast_ps( (const __m128 *)columns[3] );
+
+			const float * src = in->m_elements.data();
+			float * dst = out->m_elements.data();
+			unsigned int i = 0;
+			for ( ; i + 2 <= count; i += 2 ) {
+				__m256 v = _mm256_loadu_ps( src + i*4 );
+				__m256 r = _mm256_mul_ps( c0, _mm256_permute_ps( v, 0x00 ) );
+				r = matrix_madd( c1, _mm256_permute_ps( v, 0x55 ), r );
+				r = matrix_madd( c2, _mm256_permute_ps( v, 0xAA ), r );
+				r = matrix_madd( c3, _mm256_permute_ps( v, 0xFF ), r );
+				_mm256_storeu_ps( dst + i*4, r );
+			}
+			if ( i < count ) {
+				__m128 v = _mm_loadu_ps( src + i*4 );
+				__m128 r = _mm_mul_ps( _mm256_castps256_ps128( c0 ), _mm_permute_ps( v, 0x00 ) );
+				r = matrix_madd( _mm256_castps256_ps128( c1 ), _mm_permute_ps( v, 0x55 ), r );
+				r = matrix_madd( _mm256_castps256_ps128( c2 ), _mm_permute_ps( v, 0xAA ), r );
+				r = matrix_madd( _mm256_castps256_ps128( c3 ), _mm_permute_ps( v, 0xFF ), r );
+				_mm_storeu_ps( dst + i*4, r );
+			}
+		}
+#elif defined( ROCKET_MATRIX_SSE )
+		// Transforms one vec4 at a time
+		static void transformColumns( const float columns[4][4], const vec4 * in, vec4 * out, unsigned int count ) {
+			__m128 c0 = _mm_loadu_ps( columns[0] );
+			__m128 c1 = _mm_loadu_ps( columns[1] );
+			__m128 c2 = _mm_loadu_ps( columns[2] );
+			__m128 c3 = _mm_loadu_ps( columns[3] );
+
+			const float * src = in->m_elements.data();
+			float * dst = out->m_elements.data();
+			for ( unsigned int i = 0; i < count; i++ ) {
+				__m128 v = _mm_loadu_ps( src + i*4 );
+				__m128 r = _mm_mul_ps( c0, _mm_shuffle_ps( v, v, 0x00 ) );
+				r = _mm_add_ps( r, _mm_mul_ps( c1, _mm_shuffle_ps( v, v, 0x55 ) ) );
+				r = _mm_add_ps( r, _mm_mul_ps( c2, _mm_shuffle_ps( v, v, 0xAA ) ) );
+				r = _mm_add_ps( r, _mm_mul_ps( c3, _mm_shuffle_ps( v, v, 0xFF ) ) );
+				_mm_storeu_ps( dst + i*4, r );
+			}
+		}
+#else
+		// Scalar fallback
+		static void transformColumns( const float columns[4][4], const vec4 * in, vec4 * out, unsigned int count ) {
+			for ( unsigned int i = 0; i < count; i++ ) {
+				float x = in[i].x(), y = in[i].y(), z = in[i].z(), w = in[i].w();
+				for ( unsigned int r = 0; r < 4; r++ ) {
+					out[i][r] = columns[0][r]*x + columns[1][r]*y + columns[2][r]*z + columns[3][r]*w;
+				}
+			}
+		}
+#endif
+
+		void transform( const mat4 & m, const vec4 * in, vec4 * out, unsigned int count ) {
+			float columns[4][4];
+			for ( unsigned int c = 0; c < 4; c++ ) {
+				for ( unsigned int r = 0; r < 4; r++ ) columns[c][r] = m.m_matrix( r, c );
+			}
+			transformColumns( columns, in, out, count );
+		}
+
+		void transformAffine( const mat4 & m, const vec4 * in, vec4 * out, unsigned int count ) {
+			// Replace the bottom row with (0, 0, 0, 1) so that w is passed through
+			float columns[4][4];
+			for ( unsigned int c = 0; c < 4; c++ ) {
+				for ( unsigned int r = 0; r < 3; r++ ) columns[c][r] = m.m_matrix( r, c );
+				columns[c][3] = ( c == 3 ) ? 1.0f : 0.0f;
+			}
+			transformColumns( columns, in, out, count );
+		}
+
+	}
+}
@@ -46,23 +46,32 @@ namespace Rocket {
 				eigenCommaExpand( commaInit, std::forward< T >( args )... );
 			}
 
-			// Constructor that takes in R number of C-vectors
+			// Constructor that takes in R number of C-vectors (one per row)
 			template< typename... Args >
-			T_mat< T, R, C >( T_vec< T, C > first, Args &&... args ) {
-				m_matrix.block( 0, 0, 1, C ) << first.m_elements;
-				std::vector< T_vec< T, C > > otherVectors = { std::forward< T_vec< T, C > >( args )... };
-				for ( unsigned int i = 1; i < otherVectors.size(); i++ ) {
-					m_matrix.block( 0, i, 1, C ) << otherVectors[i].m_elements;
-				}
+			T_mat< T, R, C >( const T_vec< T, C > & first, Args &&... args ) {
+				static_assert( sizeof...( Args ) == R - 1, "Invalid number of rows" );
+				setRows< 0 >( first, std::forward< Args >( args )... );
+			}
+
+			// Sets the rows from index I onward
+			template< unsigned int I >
+			void setRows() {}
+			template< unsigned int I, typename... Args >
+			void setRows( const T_vec< T, C > & head, Args &&... tail ) {
+				m_matrix.row( I ) = head.m_elements.transpose();
+				setRows< I + 1 >( std::forward< Args >( tail )... );
 			}
 
 			// Array Subscript
 			T & operator () ( unsigned int row, unsigned col ) { return m_matrix( row, col ); }
+			const T & operator () ( unsigned int row, unsigned col ) const { return m_matrix( row, col ); }
 
 			// Arithmetic
 			// M * V
-			T_vec< T, C > operator * ( const T_vec< T, C > & vector ) const {
-				return T_vec< T, C >( m_matrix * vector.m_elements );
+			// Accepts T_vec expressions, which Eigen evaluates once before the product
+			template< class D >
+			T_vec< T, R > operator * ( const T_vec_base< D, T, C > & vector ) const {
+				return T_vec< T, R >( Eigen::Matrix< T, R, 1 >( m_matrix * vector.derived().expression() ) );
 			}
 			// M * M
 			template< unsigned int R2, unsigned int C2 >
@@ -81,8 +90,8 @@ namespace Rocket {
 
 			// Returns this matrix with row and col removed
 			// (minor) is required because sysmacros.h defines minor as a macro
-			T_mat< T, R - 1, C - 1 > * (minor)( unsigned int row, unsigned int col ) {
-				T_mat< T, R - 1, C - 1 > m = new T_mat< T, R - 1, C - 1 >();
+			T_mat< T, R - 1, C - 1 > (minor)( unsigned int row, unsigned int col ) const {
+				T_mat< T, R - 1, C - 1 > m;
 				int x = 0, y = 0;
 				for ( unsigned int r = 0; r < R; r++) {
 					if ( r != row ) {
@@ -184,6 +193,43 @@ namespace Rocket {
 			}
 		}
 
+		// Batch Transforms
+
+		// transform() - out[i] = m * in[i] for count vectors (in and out may be the same array)
+		template< class T > void transform( const T_mat< T, 4, 4 > & m, const T_vec< T, 4 > * in, T_vec< T, 4 > * out, unsigned int count ) {
+			for ( unsigned int i = 0; i < count; i++ ) {
+				out[i] = m * in[i];
+			}
+		}
+		// transformAffine() - Same as transform(), but the bottom row of m is assumed to be (0, 0, 0, 1), so w is passed through unchanged
+		template< class T > void transformAffine( const T_mat< T, 4, 4 > & m, const T_vec< T, 4 > * in, T_vec< T, 4 > * out, unsigned int count ) {
+			for ( unsigned int i = 0; i < count; i++ ) {
+				T w = in[i].w();
+				out[i] = T_vec< T, 4 >( Eigen::Matrix< T, 4, 1 >( m.m_matrix.template block< 4, 3 >( 0, 0 ) * in[i].m_elements.template head< 3 >() + m.m_matrix.col( 3 ) * w ) );
+				out[i].w( w );
+			}
+		}
+		// Float overloads are vectorized with AVX (with FMA when compiled for it) or SSE2 when available (see matrix.cpp)
+		void transform( const mat4 & m, const vec4 * in, vec4 * out, unsigned int count );
+		void transformAffine( const mat4 & m, const vec4 * in, vec4 * out, unsigned int count );
+
+		// Structure-of-arrays versions (out must not be the same batch as in)
+		template< class T > void transform( const T_mat< T, 4, 4 > & m, const T_vec_batch< T, 4 > & in, T_vec_batch< T, 4 > & out ) {
+			out.resize( in.size() );
+			for ( unsigned int r = 0; r < 4; r++ ) {
+				out.m_elements.col( r ) = m.m_matrix( r, 0 ) * in.m_elements.col( 0 ) + m.m_matrix( r, 1 ) * in.m_elements.col( 1 )
+					+ m.m_matrix( r, 2 ) * in.m_elements.col( 2 ) + m.m_matrix( r, 3 ) * in.m_elements.col( 3 );
+			}
+		}
+		// Transforms xyz points (w = 1) by the affine part of m
+		template< class T > void transformAffine( const T_mat< T, 4, 4 > & m, const T_vec_batch< T, 3 > & in, T_vec_batch< T, 3 > & out ) {
+			out.resize( in.size() );
+			for ( unsigned int r = 0; r < 3; r++ ) {
+				out.m_elements.col( r ) = m.m_matrix( r, 0 ) * in.m_elements.col( 0 ) + m.m_matrix( r, 1 ) * in.m_elements.col( 1 )
+					+ m.m_matrix( r, 2 ) * in.m_elements.col( 2 ) + m.m_matrix( r, 3 );
+			}
+		}
+
 		template< class T > T_vec< T, 3 > QuaternionToUnitVector( const T_vec< T, 4 > & quat ) {
 			T_vec< T, 4 > r = QuaternionRotate( quat ) * T_vec< T, 4 >( 0.0f, 0.0f, -1.0f, 0.0f );
 			return T_vec< T, 3 >( -r.x(), -r.y(), r.z() );
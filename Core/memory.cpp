@@ -0,0 +1,198 @@
+
+#include <mutex>
+#include <stdio.h>
+#include <vector>
+
+#include "memory.h"
+#include "metrics.h"
+#include "timer.h"
+
+namespace Rocket {
+	namespace Core {
+
+		Memory::TagTotals Memory::s_totals[ Memory::TagCount ];
+		thread_local std::atomic< unsigned long long > * Memory::t_counts = nullptr;
+
+		static const char * Memory_TagNames[ Memory::TagCount ] = { "core", "network", "graphics", "audio", "scene" };
+
+		// Counts of one thread
+		struct Memory_ThreadShard {
+			std::atomic< unsigned long long > counts[ 2 * Memory::TagCount ];
+			std::atomic< bool > inUse;						// false once the owning thread has exited, so that a new thread can take it
+		};
+
+		// Created on first use and never destroyed, so that static initializers and destructors in other files can allocate
+		struct Memory_Registry {
+			std::mutex mutex;
+			std::vector< Memory_ThreadShard * > shards;
+		};
+		static Memory_Registry & Memory_Get() {
+			static Memory_Registry * registry = new Memory_Registry();
+			return *registry;
+		}
+
+		// Counts of threads whose shard has been released, shared by all of them; zero-initialized like s_totals
+		static std::atomic< unsigned long long > Memory_ExitedCounts[ 2 * Memory::TagCount ];
+		static thread_local bool Memory_Exited = false;
+
+		// Releases the thread's shard when the thread exits; its counts still count towards the totals
+		// thread_local objects constructed before the thread's first recorded allocation are destroyed after this one, so later
+		// counts of the thread go to Memory_ExitedCounts instead of a shard another thread may have taken
+		struct Memory_ThreadSlot {
+			Memory_ThreadShard * shard;
+			Memory_ThreadSlot() : shard( nullptr ) {}
+			~Memory_ThreadSlot() {
+				Memory::t_counts = nullptr;
+				Memory_Exited = true;
+				if ( shard != nullptr ) shard->inUse.store( false, std::memory_order_release );
+			}
+		};
+		static thread_local Memory_ThreadSlot Memory_Slot;
+
+		void Memory::countUnattached( unsigned int index ) {
+			if ( Memory_Exited ) {
+				Memory_ExitedCounts[ index ].fetch_add( 1, std::memory_order_relaxed );
+				return;
+			}
+
+			Memory_Registry & registry = Memory_Get();
+			std::lock_guard< std::mutex > lock( registry.mutex );
+			Memory_ThreadShard * shard = nullptr;
+			bool created = false;
+			for ( auto candidate : registry.shards ) {
+				bool expected = false;
+				if ( candidate->inUse.compare_exchange_strong( expected, true ) ) {
+					shard = candidate;
+					break;
+				}
+			}
+			if ( shard == nullptr ) {
+				shard = new Memory_ThreadShard();
+				for ( auto & count : shard->counts ) count.store( 0, std::memory_order_relaxed );
+				shard->inUse.store( true );
+				registry.shards.push_back( shard );
+				created = true;
+			}
+			Memory_Slot.shard = shard;
+			t_counts = shard->counts;
+			t_counts[ index ].store( t_counts[ index ].load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+			if ( created ) recordAllocation( MemoryTag::Core, sizeof( Memory_ThreadShard ) );
+		}
+
+		// Periodic dumps; Memory_NextDump is read by update() without taking the mutex
+		static std::mutex Memory_DumpMutex;
+		static std::atomic< unsigned long long > Memory_DumpInterval( 0 );
+		static std::atomic< unsigned long long > Memory_NextDump( 0 );
+		static std::string Memory_DumpFile;
+
+		// The gauges update() sets, created on its first call
+		struct Memory_Gauges {
+			Gauge * live[ Memory::TagCount ];
+			Gauge * peak[ Memory::TagCount ];
+			Memory_Gauges() {
+				for ( unsigned int i = 0; i < Memory::TagCount; i++ ) {
+					std::string name = std::string( "memory." ) + Memory_TagNames[i];
+					live[i] = &Metrics::gauge( ( name + ".live_bytes" ).c_str() );
+					peak[i] = &Metrics::gauge( ( name + ".peak_bytes" ).c_str() );
+				}
+			}
+		};
+
+		const char * Memory::tagName( MemoryTag tag ) {
+			return ( (unsigned int)tag < TagCount ) ? Memory_TagNames[ (unsigned int)tag ] : "unknown";
+		}
+
+		MemorySnapshot Memory::snapshot() {
+			MemorySnapshot result;
+			result.time = timer_ns();
+			for ( unsigned int i = 0; i < TagCount; i++ ) {
+				MemorySnapshot::Tag tag = { Memory_TagNames[i], s_totals[i].live.load( std::memory_order_relaxed ), s_totals[i].peak.load( std::memory_order_relaxed ), 0, 0 };
+				result.tags.push_back( tag );
+			}
+			for ( unsigned int i = 0; i < TagCount; i++ ) {
+				result.tags[i].allocations += Memory_ExitedCounts[i].load( std::memory_order_relaxed );
+				result.tags[i].frees += Memory_ExitedCounts[ TagCount + i ].load( std::memory_order_relaxed );
+			}
+			Memory_Registry & registry = Memory_Get();
+			std::lock_guard< std::mutex > lock( registry.mutex );
+			for ( auto shard : registry.shards ) {
+				for ( unsigned int i = 0; i < TagCount; i++ ) {
+					result.tags[i].allocations += shard->counts[i].load( std::memory_order_relaxed );
+					result.tags[i].frees += shard->counts[ TagCount + i ].load( std::memory_order_relaxed );
+				}
+			}
+			return result;
+		}
+
+		void Memory::resetPeaks() {
+			for ( unsigned int i = 0; i < TagCount; i++ ) {
+				s_totals[i].peak.store( s_totals[i].live.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+			}
+		}
+
+		void Memory::setDumpInterval( unsigned long long interval, const char * file ) {
+			std::lock_guard< std::mutex > lock( Memory_DumpMutex );
+			Memory_DumpFile = ( file != nullptr ) ? file : "";
+			Memory_DumpInterval.store( interval, std::memory_order_relaxed );
+			Memory_NextDump.store( ( interval > 0 ) ? timer_ns() + interval : 0, std::memory_order_relaxed );
+		}
+
+		void Memory::update() {
+			static Memory_Gauges gauges;
+			for ( unsigned int i = 0; i < TagCount; i++ ) {
+				gauges.live[i]->set( s_totals[i].live.load( std::memory_order_relaxed ) );
+				gauges.peak[i]->set( s_totals[i].peak.load( std::memory_order_relaxed ) );
+			}
+
+			unsigned long long next = Memory_NextDump.load( std::memory_order_relaxed );
+			if ( next == 0 ) return;
+			unsigned long long now = timer_ns();
+			if ( now < next ) return;
+
+			std::lock_guard< std::mutex > lock( Memory_DumpMutex );
+			unsigned long long interval = Memory_DumpInterval.load( std::memory_order_relaxed );
+			if ( interval == 0 ) return;
+			Memory_NextDump.store( now + interval, std::memory_order_relaxed );
+			if ( Memory_DumpFile.empty() ) {
+				fputs( snapshot().text().c_str(), stderr );
+				return;
+			}
+			FILE * out = fopen( Memory_DumpFile.c_str(), "a" );
+			if ( out == nullptr ) {
+				fprintf( stderr, "Couldn't write memory snapshot to %s.\n", Memory_DumpFile.c_str() );
+				return;
+			}
+			fprintf( out, "%s\n", snapshot().json().c_str() );
+			fclose( out );
+		}
+
+		std::string MemorySnapshot::text() const {
+			std::string result;
+			char buffer[ 256 ];
+			for ( auto & tag : tags ) {
+				snprintf( buffer, sizeof( buffer ), " live=%lld peak=%lld allocations=%llu frees=%llu\n", tag.liveBytes, tag.peakBytes, tag.allocations, tag.frees );
+				result += "memory " + tag.name + buffer;
+			}
+			return result;
+		}
+
+		std::string MemorySnapshot::json() const {
+			std::string result;
+			char buffer[ 256 ];
+			snprintf( buffer, sizeof( buffer ), "{ \"time\": %llu, \"memory\": {", time );
+			result += buffer;
+			for ( size_t i = 0; i < tags.size(); i++ ) {
+				const Tag & tag = tags[i];
+				// Tag names are plain identifiers, so need no escaping
+				result += ( i == 0 ) ? " \"" : ", \"";
+				result += tag.name;
+				snprintf( buffer, sizeof( buffer ), "\": { \"live\": %lld, \"peak\": %lld, \"allocations\": %llu, \"frees\": %llu }",
+					tag.liveBytes, tag.peakBytes, tag.allocations, tag.frees );
+				result += buffer;
+			}
+			result += " } }";
+			return result;
+		}
+
+	}
+}
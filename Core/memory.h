@@ -0,0 +1,169 @@
+#ifndef Rocket_Core_Memory_H
+#define Rocket_Core_Memory_H
+
+#include <atomic>
+#include <new>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace Rocket {
+	namespace Core {
+
+		// Subsystems that heap memory is accounted to
+		enum class MemoryTag : unsigned int {
+			Core = 0,		// allocators' blocks and chunks (and so whatever is taken from pools and arenas), metrics and profiler buffers
+			Network,
+			Graphics,		// meshes' copies of their vertices
+			Audio,			// decoded sounds
+			Scene,			// draw lists
+			END_OF_MEMORY_TAGS
+		};
+
+		// Heap usage of every tag at one point in time
+		struct MemorySnapshot {
+			struct Tag {
+				std::string name;
+				long long liveBytes;
+				long long peakBytes;
+				unsigned long long allocations;
+				unsigned long long frees;
+			};
+
+			unsigned long long time;						// timer_ns() when the snapshot was taken
+			std::vector< Tag > tags;						// in the order of MemoryTag
+
+			const Tag & operator [] ( MemoryTag tag ) const { return tags[ (unsigned int)tag ]; }
+
+			// One line per tag: "memory name live=... peak=... allocations=... frees=..."
+			std::string text() const;
+			// { "time": ..., "memory": { name: { "live": ..., "peak": ..., "allocations": ..., "frees": ... }, ... } }
+			std::string json() const;
+		};
+
+		// Accounting of heap memory by tag, cheap enough to be always enabled
+		// Only allocations that are recorded are counted: the subsystems record their large or long-lived buffers, where they take
+		// them from the heap, and each byte counts once. The live bytes of a tag are one atomic, so that its peak is exact; the
+		// numbers of allocations and frees are sharded per thread, as Metrics' counters are. Values read while other threads
+		// allocate may be a few allocations behind.
+		class Memory {
+		public:
+			static const unsigned int TagCount = (unsigned int)MemoryTag::END_OF_MEMORY_TAGS;
+
+			static void recordAllocation( MemoryTag tag, size_t bytes ) {
+				TagTotals & totals = s_totals[ (unsigned int)tag ];
+				long long live = totals.live.fetch_add( (long long)bytes, std::memory_order_relaxed ) + (long long)bytes;
+				long long peak = totals.peak.load( std::memory_order_relaxed );
+				while ( live > peak && !totals.peak.compare_exchange_weak( peak, live, std::memory_order_relaxed ) ) {}
+				count( (unsigned int)tag );
+			}
+			static void recordFree( MemoryTag tag, size_t bytes ) {
+				s_totals[ (unsigned int)tag ].live.fetch_sub( (long long)bytes, std::memory_order_relaxed );
+				count( TagCount + (unsigned int)tag );
+			}
+
+			// Raw memory from operator new, recorded against tag; deallocate() must be given the same tag and size
+			static void * allocate( MemoryTag tag, size_t bytes ) {
+				void * p = ::operator new( bytes );
+				recordAllocation( tag, bytes );
+				return p;
+			}
+			static void deallocate( MemoryTag tag, void * p, size_t bytes ) {
+				if ( p == nullptr ) return;
+				recordFree( tag, bytes );
+				::operator delete( p );
+			}
+
+			// new T[count] and delete [], recorded against tag
+			template < typename T >
+			static T * newArray( MemoryTag tag, size_t count ) {
+				T * p = new T[ count ];
+				recordAllocation( tag, count * sizeof( T ) );
+				return p;
+			}
+			template < typename T >
+			static void deleteArray( MemoryTag tag, T * p, size_t count ) {
+				if ( p == nullptr ) return;
+				recordFree( tag, count * sizeof( T ) );
+				delete [] p;
+			}
+
+			static const char * tagName( MemoryTag tag );
+			static long long liveBytes( MemoryTag tag ) { return s_totals[ (unsigned int)tag ].live.load( std::memory_order_relaxed ); }
+			static long long peakBytes( MemoryTag tag ) { return s_totals[ (unsigned int)tag ].peak.load( std::memory_order_relaxed ); }
+
+			static MemorySnapshot snapshot();
+			// Starts measuring peaks again from the bytes live now (e.g. at the start of a level)
+			static void resetPeaks();
+
+			// Writes a snapshot every interval ns, from update(): as text to stderr if file is nullptr, otherwise as a line of JSON
+			// appended to file. An interval of 0 stops the dumps.
+			static void setDumpInterval( unsigned long long interval, const char * file = nullptr );
+			// Called once per frame: sets the gauges "memory.<tag>.live_bytes" and "memory.<tag>.peak_bytes", so that metrics
+			// snapshots include them, and dumps a snapshot when one is due
+			static void update();
+
+		private:
+			// A cache line per tag, so that subsystems allocating on different threads do not contend
+			struct alignas( 64 ) TagTotals {
+				std::atomic< long long > live;
+				std::atomic< long long > peak;
+			};
+			// Zero-initialized before any constructor runs, so that static initializers in other files can allocate
+			static TagTotals s_totals[ TagCount ];
+
+			// Counts an allocation (index < TagCount) or a free (TagCount + tag) in the calling thread's shard, which only it writes
+			static void count( unsigned int index ) {
+				std::atomic< unsigned long long > * counts = t_counts;
+				if ( counts != nullptr ) {
+					counts[ index ].store( counts[ index ].load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+				} else {
+					countUnattached( index );
+				}
+			}
+			// Attaches the thread to a shard, or, once its shard has been released at thread exit (before the thread's other
+			// thread_local objects may be destroyed), counts in shared atomics
+			static void countUnattached( unsigned int index );
+
+			// The calling thread's allocation counts of each tag, followed by its free counts; nullptr until the thread is attached
+			// and after it has exited
+			static thread_local std::atomic< unsigned long long > * t_counts;
+			friend struct Memory_ThreadSlot;
+		};
+
+		// Deleter for shared_ptr< T > to an array from Memory::newArray< T >( tag, count )
+		template < typename T >
+		struct tagged_array_deleter {
+			MemoryTag tag;
+			size_t count;
+			tagged_array_deleter( MemoryTag t, size_t n ) : tag( t ), count( n ) {}
+			void operator () ( T * p ) const {
+				Memory::deleteArray( tag, p, count );
+			}
+		};
+
+		// Standard allocator that records what containers take from operator new against Tag
+		template < typename T, MemoryTag Tag >
+		class TaggedAllocator {
+		public:
+			typedef T value_type;
+			template < typename U >
+			struct rebind { typedef TaggedAllocator< U, Tag > other; };
+
+			TaggedAllocator() {}
+			template < typename U >
+			TaggedAllocator( const TaggedAllocator< U, Tag > & ) {}
+
+			T * allocate( size_t count ) { return (T *)Memory::allocate( Tag, count * sizeof( T ) ); }
+			void deallocate( T * p, size_t count ) { Memory::deallocate( Tag, p, count * sizeof( T ) ); }
+		};
+
+		template < typename T, typename U, MemoryTag Tag >
+		bool operator == ( const TaggedAllocator< T, Tag > &, const TaggedAllocator< U, Tag > & ) { return true; }
+		template < typename T, typename U, MemoryTag Tag >
+		bool operator != ( const TaggedAllocator< T, Tag > &, const TaggedAllocator< U, Tag > & ) { return false; }
+
+	}
+}
+
+#endif
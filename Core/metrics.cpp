@@ -0,0 +1,270 @@
+
+#include <math.h>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+
+#include "metrics.h"
+#include "memory.h"
+#include "timer.h"
+#include "debug.h"
+
+namespace Rocket {
+	namespace Core {
+
+		thread_local std::atomic< unsigned long long > * Metrics::t_slots = nullptr;
+
+		// Slots of one thread
+		struct Metrics_ThreadShard {
+			std::atomic< unsigned long long > slots[ Metrics::SlotCount ];
+			std::atomic< bool > inUse;						// false once the owning thread has exited, so that a new thread can take it
+		};
+
+		// Metrics that do not fit write to the last Histogram::SlotCount slots, which readers never sum, so that they read 0
+		static const unsigned int Metrics_DiscardSlot = Metrics::SlotCount - Histogram::SlotCount;
+		static_assert( Metrics_DiscardSlot >= 12 * Histogram::SlotCount, "Metrics::SlotCount no longer holds the 12 histograms it documents" );
+
+		struct Metrics_Registry {
+			std::mutex mutex;
+			std::vector< Metrics_ThreadShard * > shards;
+			std::vector< Counter * > counters;
+			std::vector< Gauge * > gauges;
+			std::vector< Histogram * > histograms;
+			unsigned int nextSlot = 0;
+		};
+
+		// Created on first use, so that metrics can be registered by static initializers in other files, and never destroyed,
+		// so that they can be updated by static destructors and threads that outlive main()
+		static Metrics_Registry & Metrics_Get() {
+			static Metrics_Registry * registry = new Metrics_Registry();
+			return *registry;
+		}
+
+		// Releases the thread's shard when the thread exits; its values still count towards the totals
+		struct Metrics_ThreadSlot {
+			Metrics_ThreadShard * shard;
+			Metrics_ThreadSlot() : shard( nullptr ) {}
+			~Metrics_ThreadSlot() { if ( shard != nullptr ) shard->inUse.store( false, std::memory_order_release ); }
+		};
+		static thread_local Metrics_ThreadSlot Metrics_Slot;
+
+		// A shard taken from an exited thread, or allocated
+		Metrics_ThreadShard * Metrics::reserveThread() {
+			Metrics_Registry & registry = Metrics_Get();
+			std::lock_guard< std::mutex > lock( registry.mutex );
+			for ( auto candidate : registry.shards ) {
+				bool expected = false;
+				if ( candidate->inUse.compare_exchange_strong( expected, true ) ) return candidate;
+			}
+			Metrics_ThreadShard * shard = new Metrics_ThreadShard();
+			Memory::recordAllocation( MemoryTag::Core, sizeof( Metrics_ThreadShard ) );
+			for ( auto & slot : shard->slots ) slot.store( 0, std::memory_order_relaxed );
+			shard->inUse.store( true );
+			registry.shards.push_back( shard );
+			return shard;
+		}
+
+		void Metrics::attachThread( Metrics_ThreadShard * reserved ) {
+			if ( t_slots == nullptr ) {
+				Metrics_Slot.shard = reserved;
+				t_slots = reserved->slots;
+			} else if ( reserved != Metrics_Slot.shard ) {
+				reserved->inUse.store( false, std::memory_order_release );
+			}
+		}
+
+		std::atomic< unsigned long long > * Metrics::attachNewThread() {
+			attachThread( reserveThread() );
+			return t_slots;
+		}
+
+		unsigned long long Metrics::total( unsigned int slot ) {
+			if ( slot >= Metrics_DiscardSlot ) return 0;
+			Metrics_Registry & registry = Metrics_Get();
+			std::lock_guard< std::mutex > lock( registry.mutex );
+			unsigned long long sum = 0;
+			for ( auto shard : registry.shards ) sum += shard->slots[ slot ].load( std::memory_order_relaxed );
+			return sum;
+		}
+
+		// First of count free slots (called with the registry's mutex held)
+		static unsigned int Metrics_TakeSlots( Metrics_Registry & registry, const char * name, unsigned int count ) {
+			if ( registry.nextSlot + count > Metrics_DiscardSlot ) {
+				Debug_ThrowError( "Error: too many metrics for Metrics::SlotCount; this one will always read 0.", name );
+				return Metrics_DiscardSlot;
+			}
+			unsigned int slot = registry.nextSlot;
+			registry.nextSlot += count;
+			return slot;
+		}
+
+		template < typename MetricType >
+		static MetricType * Metrics_Find( const std::vector< MetricType * > & metrics, const char * name ) {
+			for ( auto metric : metrics ) {
+				if ( metric->name() == name ) return metric;
+			}
+			return nullptr;
+		}
+
+		Counter & Metrics::counter( const char * name ) {
+			Metrics_Registry & registry = Metrics_Get();
+			std::lock_guard< std::mutex > lock( registry.mutex );
+			Counter * counter = Metrics_Find( registry.counters, name );
+			if ( counter == nullptr ) {
+				counter = new Counter( name, Metrics_TakeSlots( registry, name, 1 ) );
+				registry.counters.push_back( counter );
+			}
+			return *counter;
+		}
+
+		Gauge & Metrics::gauge( const char * name ) {
+			Metrics_Registry & registry = Metrics_Get();
+			std::lock_guard< std::mutex > lock( registry.mutex );
+			Gauge * gauge = Metrics_Find( registry.gauges, name );
+			if ( gauge == nullptr ) {
+				gauge = new Gauge( name );
+				registry.gauges.push_back( gauge );
+			}
+			return *gauge;
+		}
+
+		Histogram & Metrics::histogram( const char * name ) {
+			Metrics_Registry & registry = Metrics_Get();
+			std::lock_guard< std::mutex > lock( registry.mutex );
+			Histogram * histogram = Metrics_Find( registry.histograms, name );
+			if ( histogram == nullptr ) {
+				histogram = new Histogram( name, Metrics_TakeSlots( registry, name, Histogram::SlotCount ) );
+				registry.histograms.push_back( histogram );
+			}
+			return *histogram;
+		}
+
+		unsigned long long Histogram::bucketLimit( unsigned int bucket ) {
+			if ( bucket < ( 1u << SubBucketBits ) ) return bucket;
+			if ( bucket >= BucketCount - 1 ) return ~0ull;
+			unsigned int shift = ( bucket >> SubBucketBits ) - 1;
+			unsigned long long lowest = (unsigned long long)( ( 1u << SubBucketBits ) + ( bucket & ( ( 1u << SubBucketBits ) - 1 ) ) ) << shift;
+			return lowest + ( 1ull << shift ) - 1;
+		}
+
+		// Summary of the histogram whose slots start at slot (called with the registry's mutex held)
+		static MetricsSnapshot::Distribution Metrics_Summarize( const Metrics_Registry & registry, const Histogram & histogram, unsigned int slot ) {
+			MetricsSnapshot::Distribution result = { histogram.name(), 0, 0, 0, 0, 0, 0, 0 };
+			if ( slot >= Metrics_DiscardSlot ) return result;
+			std::vector< unsigned long long > buckets( Histogram::BucketCount, 0 );
+			for ( auto shard : registry.shards ) {
+				const std::atomic< unsigned long long > * slots = shard->slots + slot;
+				for ( unsigned int b = 0; b < Histogram::BucketCount; b++ ) buckets[b] += slots[b].load( std::memory_order_relaxed );
+				result.sum += slots[ Histogram::BucketCount ].load( std::memory_order_relaxed );
+				unsigned long long max = slots[ Histogram::BucketCount + 1 ].load( std::memory_order_relaxed );
+				if ( max > result.max ) result.max = max;
+			}
+			for ( auto count : buckets ) result.count += count;
+			if ( result.count == 0 ) return result;
+
+			// Each percentile is the first bucket at which the running count reaches that fraction of the total
+			const double fractions[4] = { 0.5, 0.9, 0.99, 0.999 };
+			unsigned long long * percentiles[4] = { &result.p50, &result.p90, &result.p99, &result.p999 };
+			unsigned long long running = 0;
+			unsigned int p = 0;
+			for ( unsigned int b = 0; b < Histogram::BucketCount && p < 4; b++ ) {
+				running += buckets[b];
+				while ( p < 4 && running > 0 && running >= (unsigned long long)ceil( fractions[p] * result.count ) ) {
+					unsigned long long limit = Histogram::bucketLimit( b );
+					*percentiles[ p++ ] = limit < result.max ? limit : result.max;
+				}
+			}
+			return result;
+		}
+
+		MetricsSnapshot::Distribution Histogram::summary() const {
+			Metrics_Registry & registry = Metrics_Get();
+			std::lock_guard< std::mutex > lock( registry.mutex );
+			return Metrics_Summarize( registry, *this, m_slot );
+		}
+
+		MetricsSnapshot Metrics::snapshot() {
+			MetricsSnapshot result;
+			result.time = timer_ns();
+			Metrics_Registry & registry = Metrics_Get();
+			std::lock_guard< std::mutex > lock( registry.mutex );
+			for ( auto counter : registry.counters ) {
+				unsigned long long sum = 0;
+				if ( counter->m_slot < Metrics_DiscardSlot ) {
+					for ( auto shard : registry.shards ) sum += shard->slots[ counter->m_slot ].load( std::memory_order_relaxed );
+				}
+				MetricsSnapshot::Value value = { counter->name(), (long long)sum };
+				result.counters.push_back( value );
+			}
+			for ( auto gauge : registry.gauges ) {
+				MetricsSnapshot::Value value = { gauge->name(), gauge->value() };
+				result.gauges.push_back( value );
+			}
+			for ( auto histogram : registry.histograms ) {
+				result.histograms.push_back( Metrics_Summarize( registry, *histogram, histogram->m_slot ) );
+			}
+			return result;
+		}
+
+		std::string MetricsSnapshot::text() const {
+			std::string result;
+			char buffer[ 256 ];
+			for ( auto & counter : counters ) {
+				snprintf( buffer, sizeof( buffer ), " %lld\n", counter.value );
+				result += "counter " + counter.name + buffer;
+			}
+			for ( auto & gauge : gauges ) {
+				snprintf( buffer, sizeof( buffer ), " %lld\n", gauge.value );
+				result += "gauge " + gauge.name + buffer;
+			}
+			for ( auto & histogram : histograms ) {
+				snprintf( buffer, sizeof( buffer ), " count=%llu sum=%llu max=%llu p50=%llu p90=%llu p99=%llu p999=%llu\n",
+					histogram.count, histogram.sum, histogram.max, histogram.p50, histogram.p90, histogram.p99, histogram.p999 );
+				result += "histogram " + histogram.name + buffer;
+			}
+			return result;
+		}
+
+		// name as a JSON string
+		static void Metrics_AppendJSONString( std::string & json, const std::string & name ) {
+			json += '"';
+			for ( char c : name ) {
+				if ( c == '"' || c == '\\' ) json += '\\';
+				json += c;
+			}
+			json += '"';
+		}
+
+		std::string MetricsSnapshot::json() const {
+			std::string result;
+			char buffer[ 256 ];
+			snprintf( buffer, sizeof( buffer ), "{ \"time\": %llu, \"counters\": {", time );
+			result += buffer;
+			for ( size_t i = 0; i < counters.size(); i++ ) {
+				result += ( i == 0 ) ? " " : ", ";
+				Metrics_AppendJSONString( result, counters[i].name );
+				snprintf( buffer, sizeof( buffer ), ": %lld", counters[i].value );
+				result += buffer;
+			}
+			result += " }, \"gauges\": {";
+			for ( size_t i = 0; i < gauges.size(); i++ ) {
+				result += ( i == 0 ) ? " " : ", ";
+				Metrics_AppendJSONString( result, gauges[i].name );
+				snprintf( buffer, sizeof( buffer ), ": %lld", gauges[i].value );
+				result += buffer;
+			}
+			result += " }, \"histograms\": {";
+			for ( size_t i = 0; i < histograms.size(); i++ ) {
+				const Distribution & histogram = histograms[i];
+				result += ( i == 0 ) ? " " : ", ";
+				Metrics_AppendJSONString( result, histogram.name );
+				snprintf( buffer, sizeof( buffer ), ": { \"count\": %llu, \"sum\": %llu, \"max\": %llu, \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu }",
+					histogram.count, histogram.sum, histogram.max, histogram.p50, histogram.p90, histogram.p99, histogram.p999 );
+				result += buffer;
+			}
+			result += " } }";
+			return result;
+		}
+
+	}
+}
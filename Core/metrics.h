@@ -0,0 +1,170 @@
+
+#ifndef Rocket_Core_Metrics_H
+#define Rocket_Core_Metrics_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace Rocket {
+	namespace Core {
+
+		class Counter;
+		class Gauge;
+		class Histogram;
+		struct Metrics_ThreadShard;
+
+		// Values of every metric at one point in time
+		struct MetricsSnapshot {
+			struct Value {
+				std::string name;
+				long long value;
+			};
+			struct Distribution {
+				std::string name;
+				unsigned long long count;
+				unsigned long long sum;
+				unsigned long long max;
+				unsigned long long p50, p90, p99, p999;		// percentiles, as the largest value of the bucket they fall in
+			};
+
+			unsigned long long time;						// timer_ns() when the snapshot was taken
+			std::vector< Value > counters;
+			std::vector< Value > gauges;
+			std::vector< Distribution > histograms;
+
+			// One line per metric: "kind name value", with "count=... sum=... max=... p50=..." for histograms
+			std::string text() const;
+			// { "time": ..., "counters": { name: value, ... }, "gauges": { ... }, "histograms": { name: { "count": ..., ... }, ... } }
+			std::string json() const;
+		};
+
+		// Registry of named counters, gauges and histograms, which are always enabled
+		// Counters and histograms are sharded per thread: each thread that updates them owns a block of SlotCount slots, and only that
+		// thread writes to it, with a relaxed load and store instead of a locked read-modify-write. Reading a metric sums the slots of
+		// every thread, so values read while other threads update them may be a few updates behind.
+		// Metrics are never destroyed, so the references returned below can be kept, e.g. in a function-local static.
+		class Metrics {
+		public:
+			// Budget of slots shared by every counter (1 slot each) and histogram (Histogram::SlotCount, 594 slots each), less one
+			// histogram's worth kept for metrics that do not fit: room for 12 histograms and a few hundred counters, at 64 KB per
+			// thread. Registering a metric past it asserts in debug builds, and the metric then always reads 0.
+			static const unsigned int SlotCount = 8192;
+
+			// Returns the metric called name, creating it on the first call
+			static Counter & counter( const char * name );
+			static Gauge & gauge( const char * name );
+			static Histogram & histogram( const char * name );
+
+			static MetricsSnapshot snapshot();
+
+			// A thread's first update takes a shard, which locks and may allocate. Threads that must never block or allocate (such
+			// as real-time audio callbacks) can be given one reserved on another thread: attachThread() only keeps the pointer, and
+			// releases reserved if the thread already has a shard.
+			static Metrics_ThreadShard * reserveThread();
+			static void attachThread( Metrics_ThreadShard * reserved );
+
+			// Used by Counter and Histogram: the calling thread's slots, which it receives on its first update
+			static std::atomic< unsigned long long > * threadSlots() {
+				std::atomic< unsigned long long > * slots = t_slots;
+				return slots != nullptr ? slots : attachNewThread();
+			}
+			// Adds value to a slot of the calling thread
+			static void add( std::atomic< unsigned long long > & slot, unsigned long long value ) {
+				slot.store( slot.load( std::memory_order_relaxed ) + value, std::memory_order_relaxed );
+			}
+			// Sum of one slot over all threads
+			static unsigned long long total( unsigned int slot );
+
+		private:
+			static thread_local std::atomic< unsigned long long > * t_slots;
+			static std::atomic< unsigned long long > * attachNewThread();
+		};
+
+		// Monotonic count of events or amounts (e.g. bytes sent)
+		class Counter {
+		public:
+			void add( unsigned long long count = 1 ) { Metrics::add( Metrics::threadSlots()[ m_slot ], count ); }
+			unsigned long long value() const { return Metrics::total( m_slot ); }
+			const std::string & name() const { return m_name; }
+
+		private:
+			friend class Metrics;
+			Counter( const char * name, unsigned int slot ) : m_name( name ), m_slot( slot ) {}
+			Counter( const Counter & ) = delete;
+			Counter & operator = ( const Counter & ) = delete;
+
+			std::string m_name;
+			unsigned int m_slot;
+		};
+
+		// Last value set (e.g. a queue depth); a single atomic shared by all threads
+		class Gauge {
+		public:
+			void set( long long value ) { m_value.store( value, std::memory_order_relaxed ); }
+			long long value() const { return m_value.load( std::memory_order_relaxed ); }
+			const std::string & name() const { return m_name; }
+
+		private:
+			friend class Metrics;
+			Gauge( const char * name ) : m_name( name ), m_value( 0 ) {}
+			Gauge( const Gauge & ) = delete;
+			Gauge & operator = ( const Gauge & ) = delete;
+
+			std::string m_name;
+			std::atomic< long long > m_value;
+		};
+
+		// Distribution of values (e.g. latencies in ns) in log-linear buckets, as in HdrHistogram
+		// Values below 2^SubBucketBits have a bucket each; above that, each power of 2 is split into 2^SubBucketBits buckets, so a value
+		// is known to within 1 / 2^SubBucketBits of itself. Values of 2^MaxValueBits and more share the last bucket.
+		class Histogram {
+		public:
+			static const unsigned int SubBucketBits = 4;
+			static const unsigned int MaxValueBits = 40;	// 2^40 ns is about 18 minutes
+			static const unsigned int BucketCount = ( MaxValueBits - SubBucketBits + 1 ) << SubBucketBits;
+			static const unsigned int SlotCount = BucketCount + 2;	// buckets, sum and max
+
+			void record( unsigned long long value ) {
+				std::atomic< unsigned long long > * slots = Metrics::threadSlots() + m_slot;
+				Metrics::add( slots[ bucket( value ) ], 1 );
+				Metrics::add( slots[ BucketCount ], value );
+				if ( value > slots[ BucketCount + 1 ].load( std::memory_order_relaxed ) ) slots[ BucketCount + 1 ].store( value, std::memory_order_relaxed );
+			}
+
+			MetricsSnapshot::Distribution summary() const;
+			const std::string & name() const { return m_name; }
+
+			// Bucket of value, and the largest value in a bucket
+			static unsigned int bucket( unsigned long long value ) {
+				if ( value < ( 1ull << SubBucketBits ) ) return (unsigned int)value;
+				if ( value >= ( 1ull << MaxValueBits ) ) return BucketCount - 1;
+#if defined( _MSC_VER )
+				unsigned long highest;
+				_BitScanReverse64( &highest, value );
+#else
+				unsigned int highest = 63 - __builtin_clzll( value );
+#endif
+				unsigned int shift = highest - SubBucketBits;
+				return (unsigned int)( ( ( shift + 1 ) << SubBucketBits ) + ( ( value >> shift ) & ( ( 1u << SubBucketBits ) - 1 ) ) );
+			}
+			static unsigned long long bucketLimit( unsigned int bucket );
+
+		private:
+			friend class Metrics;
+			Histogram( const char * name, unsigned int slot ) : m_name( name ), m_slot( slot ) {}
+			Histogram( const Histogram & ) = delete;
+			Histogram & operator = ( const Histogram & ) = delete;
+
+			std::string m_name;
+			unsigned int m_slot;
+		};
+
+	}
+}
+
+#endif
@@ -0,0 +1,294 @@
+
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+
+#include "profiler.h"
+#include "memory.h"
+#include "timer.h"
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#define ROCKET_PROFILER_TSC
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#include <cpuid.h>
+#endif
+#endif
+
+namespace Rocket {
+	namespace Core {
+
+		// Zones per thread between two calls to endFrame() (a power of 2)
+		static const unsigned int Profiler_BufferSize = 8192;
+
+		// Single producer (the owning thread), single consumer (endFrame(), under Profiler_Mutex) ring of finished zones
+		struct Profiler_ThreadBuffer {
+			ProfileEvent events[ Profiler_BufferSize ];
+			std::atomic< unsigned int > head;			// next event to write
+			std::atomic< unsigned int > tail;			// next event to collect
+			std::atomic< bool > inUse;					// false once the owning thread has exited, so that a new thread can take it
+			unsigned int thread;
+		};
+
+		std::atomic< bool > Profiler::g_enabled( false );
+
+		static std::mutex Profiler_Mutex;
+		static std::vector< Profiler_ThreadBuffer * > Profiler_Buffers;
+		static std::atomic< unsigned long long > Profiler_Dropped( 0 );
+		static unsigned int Profiler_ThreadCount = 0;
+
+		// Time stamp counter calibration: ns = Profiler_BaseNanoseconds + ( ticks - Profiler_BaseTicks ) * Profiler_NanosecondsPerTick
+		static std::atomic< bool > Profiler_UseTSC( false );
+		static unsigned long long Profiler_BaseTicks = 0;
+		static unsigned long long Profiler_BaseNanoseconds = 0;
+		static double Profiler_NanosecondsPerTick = 0.0;
+
+		// Results of the last frame, and the capture
+		static std::vector< ProfileEvent > Profiler_FrameEvents;
+		static std::vector< ProfileZoneStats > Profiler_FrameStats;
+		static unsigned long long Profiler_FrameBegin = 0;
+		static unsigned long long Profiler_FrameLength = 0;
+		static bool Profiler_Capturing = false;
+		static unsigned int Profiler_CaptureLimit = 0;
+		static std::vector< ProfileEvent > Profiler_Captured;
+		static std::vector< ProfileEvent > Profiler_CapturedFrames;
+
+		// Releases the thread's buffer when the thread exits
+		struct Profiler_ThreadSlot {
+			Profiler_ThreadBuffer * buffer;
+			Profiler_ThreadSlot() : buffer( nullptr ) {}
+			~Profiler_ThreadSlot() { if ( buffer != nullptr ) buffer->inUse.store( false, std::memory_order_release ); }
+		};
+		static thread_local Profiler_ThreadSlot Profiler_Slot;
+		static thread_local bool Profiler_Detached = false;		// attached to nullptr: zones are dropped
+		static thread_local unsigned int Profiler_Depth = 0;
+
+		// A buffer taken from an exited thread, or allocated
+		Profiler_ThreadBuffer * Profiler::reserveThread() {
+			std::lock_guard< std::mutex > lock( Profiler_Mutex );
+			Profiler_ThreadBuffer * buffer = nullptr;
+			for ( auto candidate : Profiler_Buffers ) {
+				bool expected = false;
+				if ( candidate->inUse.compare_exchange_strong( expected, true ) ) {
+					buffer = candidate;
+					break;
+				}
+			}
+			if ( buffer == nullptr ) {
+				buffer = new Profiler_ThreadBuffer();
+				Memory::recordAllocation( MemoryTag::Core, sizeof( Profiler_ThreadBuffer ) );
+				buffer->head.store( 0 );
+				buffer->tail.store( 0 );
+				buffer->inUse.store( true );
+				Profiler_Buffers.push_back( buffer );
+			}
+			buffer->thread = Profiler_ThreadCount++;
+			return buffer;
+		}
+
+		void Profiler::attachThread( Profiler_ThreadBuffer * reserved ) {
+			Profiler_Detached = ( reserved == nullptr );
+			if ( reserved == nullptr ) return;
+			if ( Profiler_Slot.buffer == nullptr ) {
+				Profiler_Slot.buffer = reserved;
+			} else if ( reserved != Profiler_Slot.buffer ) {
+				reserved->inUse.store( false, std::memory_order_release );
+			}
+		}
+
+		// The calling thread's buffer, reserved on its first zone; nullptr if the thread was attached to nullptr
+		static Profiler_ThreadBuffer * Profiler_ThisThread() {
+			if ( Profiler_Detached ) return nullptr;
+			if ( Profiler_Slot.buffer == nullptr ) Profiler_Slot.buffer = Profiler::reserveThread();
+			return Profiler_Slot.buffer;
+		}
+
+		void Profiler::setEnabled( bool enabled ) {
+			if ( enabled && Profiler::enabled() == false ) {
+				std::lock_guard< std::mutex > lock( Profiler_Mutex );
+				Profiler_FrameBegin = now();
+			}
+			g_enabled.store( enabled, std::memory_order_relaxed );
+		}
+
+		unsigned long long Profiler::now() {
+#if defined( ROCKET_PROFILER_TSC )
+			if ( Profiler_UseTSC.load( std::memory_order_acquire ) ) {
+				return Profiler_BaseNanoseconds + (unsigned long long)( ( __rdtsc() - Profiler_BaseTicks ) * Profiler_NanosecondsPerTick );
+			}
+#endif
+			return timer_ns();
+		}
+
+		bool Profiler::useTimeStampCounter() {
+#if defined( ROCKET_PROFILER_TSC )
+			if ( Profiler_UseTSC.load() ) return true;
+
+			// Only a counter with a constant rate in every power state (CPUID 0x80000007, EDX bit 8) can measure time
+#if defined( _MSC_VER )
+			int registers[4];
+			__cpuid( registers, 0x80000000 );
+			if ( (unsigned int)registers[0] < 0x80000007u ) return false;
+			__cpuid( registers, 0x80000007 );
+			if ( ( registers[3] & ( 1 << 8 ) ) == 0 ) return false;
+#else
+			unsigned int eax, ebx, ecx, edx;
+			if ( __get_cpuid( 0x80000007, &eax, &ebx, &ecx, &edx ) == 0 || ( edx & ( 1 << 8 ) ) == 0 ) return false;
+#endif
+
+			// Rate measured against timer_ns() over 20 ms
+			unsigned long long startNanoseconds = timer_ns(), startTicks = __rdtsc();
+			unsigned long long endNanoseconds = startNanoseconds, endTicks = startTicks;
+			while ( endNanoseconds - startNanoseconds < 20000000ull ) {
+				endNanoseconds = timer_ns();
+				endTicks = __rdtsc();
+			}
+			if ( endTicks <= startTicks ) return false;
+
+			Profiler_NanosecondsPerTick = double( endNanoseconds - startNanoseconds ) / double( endTicks - startTicks );
+			Profiler_BaseTicks = endTicks;
+			Profiler_BaseNanoseconds = endNanoseconds;
+			Profiler_UseTSC.store( true, std::memory_order_release );
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		unsigned int & Profiler::threadDepth() {
+			return Profiler_Depth;
+		}
+
+		void Profiler::record( const char * name, unsigned long long begin, unsigned int depth ) {
+			unsigned long long end = now();
+			Profiler_ThreadBuffer * buffer = Profiler_ThisThread();
+			if ( buffer == nullptr ) return;
+
+			unsigned int head = buffer->head.load( std::memory_order_relaxed );
+			if ( head - buffer->tail.load( std::memory_order_acquire ) == Profiler_BufferSize ) {
+				Profiler_Dropped.fetch_add( 1, std::memory_order_relaxed );
+				return;
+			}
+			ProfileEvent & event = buffer->events[ head & ( Profiler_BufferSize - 1 ) ];
+			event.name = name;
+			event.begin = begin;
+			event.end = end;
+			event.thread = buffer->thread;
+			event.depth = depth;
+			buffer->head.store( head + 1, std::memory_order_release );
+		}
+
+		void Profiler::endFrame() {
+			if ( !enabled() ) return;
+			unsigned long long frameEnd = now();
+			Profiler_ThreadBuffer * frameBuffer = Profiler_ThisThread();
+			unsigned int frameThread = ( frameBuffer != nullptr ) ? frameBuffer->thread : 0;
+			std::lock_guard< std::mutex > lock( Profiler_Mutex );
+
+			Profiler_FrameEvents.clear();
+			for ( auto buffer : Profiler_Buffers ) {
+				unsigned int head = buffer->head.load( std::memory_order_acquire );
+				unsigned int tail = buffer->tail.load( std::memory_order_relaxed );
+				for ( ; tail != head; tail++ ) Profiler_FrameEvents.push_back( buffer->events[ tail & ( Profiler_BufferSize - 1 ) ] );
+				buffer->tail.store( tail, std::memory_order_release );
+			}
+
+			// Totals per name; zones from different files can have equal names at different addresses
+			Profiler_FrameStats.clear();
+			for ( const ProfileEvent & event : Profiler_FrameEvents ) {
+				unsigned long long length = event.end - event.begin;
+				ProfileZoneStats * stats = nullptr;
+				for ( auto & existing : Profiler_FrameStats ) {
+					if ( existing.name == event.name || strcmp( existing.name, event.name ) == 0 ) {
+						stats = &existing;
+						break;
+					}
+				}
+				if ( stats == nullptr ) {
+					ProfileZoneStats added = { event.name, 0, 0, 0 };
+					Profiler_FrameStats.push_back( added );
+					stats = &Profiler_FrameStats.back();
+				}
+				stats->calls++;
+				stats->totalNanoseconds += length;
+				if ( length > stats->maxNanoseconds ) stats->maxNanoseconds = length;
+			}
+
+			if ( Profiler_Capturing ) {
+				ProfileEvent frame = { "Frame", Profiler_FrameBegin, frameEnd, frameThread, 0 };
+				Profiler_CapturedFrames.push_back( frame );
+				for ( const ProfileEvent & event : Profiler_FrameEvents ) {
+					if ( Profiler_Captured.size() >= Profiler_CaptureLimit ) break;
+					Profiler_Captured.push_back( event );
+				}
+			}
+
+			Profiler_FrameLength = frameEnd - Profiler_FrameBegin;
+			Profiler_FrameBegin = frameEnd;
+		}
+
+		const std::vector< ProfileZoneStats > & Profiler::frameStats() {
+			return Profiler_FrameStats;
+		}
+
+		unsigned long long Profiler::frameNanoseconds() {
+			return Profiler_FrameLength;
+		}
+
+		unsigned long long Profiler::droppedEvents() {
+			return Profiler_Dropped.load();
+		}
+
+		void Profiler::startCapture( unsigned int maxEvents ) {
+			std::lock_guard< std::mutex > lock( Profiler_Mutex );
+			Profiler_Captured.clear();
+			Profiler_CapturedFrames.clear();
+			Profiler_Captured.reserve( maxEvents );
+			Profiler_CaptureLimit = maxEvents;
+			Profiler_Capturing = true;
+		}
+
+		void Profiler::stopCapture() {
+			std::lock_guard< std::mutex > lock( Profiler_Mutex );
+			Profiler_Capturing = false;
+		}
+
+		// One complete ("X") event, with times in us from origin
+		static void Profiler_WriteEvent( FILE * file, const ProfileEvent & event, unsigned long long origin, bool first ) {
+			fputs( first ? "\n\t{ \"name\": \"" : ",\n\t{ \"name\": \"", file );
+			for ( const char * c = event.name; *c != 0; c++ ) {
+				if ( *c == '"' || *c == '\\' ) fputc( '\\', file );
+				fputc( *c, file );
+			}
+			fprintf( file, "\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 0, \"tid\": %u }",
+				( event.begin - origin ) / 1000.0, ( event.end - event.begin ) / 1000.0, event.thread );
+		}
+
+		bool Profiler::writeChromeTrace( const char * path ) {
+			FILE * file = fopen( path, "w" );
+			if ( file == nullptr ) return false;
+
+			std::lock_guard< std::mutex > lock( Profiler_Mutex );
+			unsigned long long origin = Profiler_CapturedFrames.empty() ? 0 : Profiler_CapturedFrames[0].begin;
+			for ( const ProfileEvent & event : Profiler_Captured ) {
+				if ( event.begin < origin ) origin = event.begin;
+			}
+
+			fputs( "{ \"displayTimeUnit\": \"ns\", \"traceEvents\": [", file );
+			bool first = true;
+			for ( const ProfileEvent & frame : Profiler_CapturedFrames ) {
+				Profiler_WriteEvent( file, frame, origin, first );
+				first = false;
+			}
+			for ( const ProfileEvent & event : Profiler_Captured ) {
+				Profiler_WriteEvent( file, event, origin, first );
+				first = false;
+			}
+			fputs( "\n] }\n", file );
+			return fclose( file ) == 0;
+		}
+
+	}
+}
@@ -0,0 +1,109 @@
+
+#ifndef Rocket_Core_Profiler_H
+#define Rocket_Core_Profiler_H
+
+#include <atomic>
+#include <vector>
+
+namespace Rocket {
+	namespace Core {
+
+		// One timed zone, with its times in ns
+		struct ProfileEvent {
+			const char * name;
+			unsigned long long begin;
+			unsigned long long end;
+			unsigned int thread;						// order in which the thread first recorded a zone (0, 1, ...)
+			unsigned int depth;							// number of zones open around this one on its thread
+		};
+
+		// Totals of one zone name over one frame
+		struct ProfileZoneStats {
+			const char * name;
+			unsigned int calls;
+			unsigned long long totalNanoseconds;		// inclusive of nested zones
+			unsigned long long maxNanoseconds;
+		};
+
+		struct Profiler_ThreadBuffer;
+
+		// Hierarchical profiler
+		// Zones (see Rocket_Profile_Zone) are recorded into a lock-free ring buffer owned by the thread that runs them, so recording
+		// never blocks or allocates after a thread's first zone. endFrame() collects every thread's zones, totals them per name,
+		// and keeps them for a Chrome trace (chrome://tracing or ui.perfetto.dev) while a capture is running.
+		// Zones are not recorded, and endFrame() does nothing, until the profiler is enabled.
+		class Profiler {
+		public:
+			static void setEnabled( bool enabled );
+			static bool enabled() { return g_enabled.load( std::memory_order_relaxed ); }
+
+			// Current time in ns, from the calibrated time stamp counter if useTimeStampCounter() succeeded, or timer_ns() otherwise
+			static unsigned long long now();
+			// Switches now() to the processor's time stamp counter, which is read in a few cycles instead of a system call
+			// Returns false, leaving timer_ns() in use, if the processor has no invariant time stamp counter
+			static bool useTimeStampCounter();
+
+			// Ends the current frame on the calling thread: collects the zones that every thread finished since the last call
+			static void endFrame();
+			// Totals of each zone name over the last frame, in order of first appearance
+			static const std::vector< ProfileZoneStats > & frameStats();
+			static unsigned long long frameNanoseconds();
+			// Zones that could not be recorded because a thread's buffer was full, since the profiler started
+			static unsigned long long droppedEvents();
+
+			// Keeps the zones of each following frame, up to maxEvents of them, for writeChromeTrace()
+			static void startCapture( unsigned int maxEvents = 1 << 20 );
+			static void stopCapture();
+			// Writes the captured zones and frames as Chrome trace-event JSON; returns false if the file could not be written
+			static bool writeChromeTrace( const char * path );
+
+			// A thread's first zone takes a buffer, which may allocate. Threads that must never block or allocate (such as
+			// real-time audio callbacks) can be given one reserved on another thread: attachThread() only keeps the pointer, and
+			// releases reserved if the thread already has a buffer. A thread attached to nullptr never takes a buffer, and its
+			// zones are dropped.
+			static Profiler_ThreadBuffer * reserveThread();
+			static void attachThread( Profiler_ThreadBuffer * reserved );
+
+			// Used by ProfileZone
+			static void record( const char * name, unsigned long long begin, unsigned int depth );
+			static unsigned int & threadDepth();
+
+		private:
+			static std::atomic< bool > g_enabled;
+		};
+
+		// Times the scope it is declared in
+		class ProfileZone {
+		public:
+			explicit ProfileZone( const char * name ) : m_name( name ), m_begin( 0 ) {
+				if ( Profiler::enabled() ) {
+					m_begin = Profiler::now();
+					m_depth = Profiler::threadDepth()++;
+				}
+			}
+			~ProfileZone() {
+				if ( m_begin != 0 ) {
+					Profiler::threadDepth()--;
+					Profiler::record( m_name, m_begin, m_depth );
+				}
+			}
+
+			ProfileZone( const ProfileZone & ) = delete;
+			ProfileZone & operator = ( const ProfileZone & ) = delete;
+
+		private:
+			const char * m_name;
+			unsigned long long m_begin;
+			unsigned int m_depth;
+		};
+
+		#define Rocket_Profile_Concatenate2( a, b ) a##b
+		#define Rocket_Profile_Concatenate( a, b ) Rocket_Profile_Concatenate2( a, b )
+
+		// Rocket_Profile_Zone( "name" ) times the rest of the enclosing scope; name must be a string literal
+		#define Rocket_Profile_Zone( name ) Rocket::Core::ProfileZone Rocket_Profile_Concatenate( profileZone_, __LINE__ )( "" name )
+
+	}
+}
+
+#endif
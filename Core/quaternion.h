@@ -0,0 +1,122 @@
+
+#ifndef Rocket_Core_Quaternion_H
+#define Rocket_Core_Quaternion_H
+
+#include <math.h>
+#include <iostream>
+
+#include "matrix.h"
+#include "vector.h"
+#include "mathconstants.h"
+
+#include <eigen3/Eigen/Geometry>
+
+namespace Rocket {
+	namespace Core {
+
+		// Rotation quaternion stored as (x, y, z, w), the same layout as the vec4 quaternions used by the older helpers in vector.h/matrix.h
+		// Products are evaluated by Eigen's SIMD Hamilton product
+		template< class T > class T_quat {
+		public:
+			Eigen::Quaternion< T > m_quaternion;
+
+			// Constructors
+
+			// Default is the identity rotation
+			T_quat() { m_quaternion.setIdentity(); }
+			T_quat( const Eigen::Quaternion< T > & quaternion ) : m_quaternion( quaternion ) {}
+			T_quat( T x, T y, T z, T w ) : m_quaternion( w, x, y, z ) {}
+			explicit T_quat( const T_vec< T, 4 > & v ) : m_quaternion( v.w(), v.x(), v.y(), v.z() ) {}
+
+			// Rotation of angle (radians) around axis (axis does not need to be normalized)
+			T_quat( T angle, const T_vec< T, 3 > & axis ) {
+				T axisLength = axis.length();
+				if ( axisLength > MathConstants::ZeroTolerance ) {
+					T halfAngle = angle * T( 0.5 );
+					T s = sin( halfAngle ) / axisLength;
+					m_quaternion = Eigen::Quaternion< T >( cos( halfAngle ), axis.x() * s, axis.y() * s, axis.z() * s );
+				} else {
+					m_quaternion.setIdentity();
+				}
+			}
+
+			// Rotation part (upper 3x3) of a matrix
+			explicit T_quat( const T_mat< T, 4, 4 > & m ) : m_quaternion( Eigen::Matrix< T, 3, 3 >( m.m_matrix.template block< 3, 3 >( 0, 0 ) ) ) {}
+
+			// Access Functions
+			T x() const { return m_quaternion.x(); }
+			T y() const { return m_quaternion.y(); }
+			T z() const { return m_quaternion.z(); }
+			T w() const { return m_quaternion.w(); }
+
+			T_vec< T, 4 > xyzw() const { return T_vec< T, 4 >( Eigen::Matrix< T, 4, 1 >( m_quaternion.coeffs() ) ); }
+
+			// Arithmetic
+			// Hamilton product: (a * b) rotates by b, then by a
+			T_quat operator * ( const T_quat & R ) const { return T_quat( m_quaternion * R.m_quaternion ); }
+			T_quat & operator *= ( const T_quat & R ) { m_quaternion *= R.m_quaternion; return *this; }
+
+			// Rotate a vector
+			T_vec< T, 3 > operator * ( const T_vec< T, 3 > & v ) const { return T_vec< T, 3 >( Eigen::Matrix< T, 3, 1 >( m_quaternion * v.m_elements ) ); }
+
+			// Equality
+			bool operator == ( const T_quat & R ) const { return m_quaternion.coeffs() == R.m_quaternion.coeffs(); }
+			bool operator != ( const T_quat & R ) const { return m_quaternion.coeffs() != R.m_quaternion.coeffs(); }
+
+			// Quaternion Operations
+			T length() const { return m_quaternion.norm(); }
+			T dot( const T_quat & R ) const { return m_quaternion.dot( R.m_quaternion ); }
+			void normalize() { m_quaternion.normalize(); }
+			T_quat normalized() const { return T_quat( m_quaternion.normalized() ); }
+			T_quat conjugate() const { return T_quat( m_quaternion.conjugate() ); }
+			T_quat inverse() const { return T_quat( m_quaternion.inverse() ); }
+
+			// Rotation matrices built directly from this quaternion (assumed to be normalized)
+			T_mat< T, 3, 3 > toMatrix3() const { return T_mat< T, 3, 3 >( m_quaternion.toRotationMatrix() ); }
+			T_mat< T, 4, 4 > toMatrix() const {
+				T_mat< T, 4, 4 > r;
+				r.m_matrix.template block< 3, 3 >( 0, 0 ) = m_quaternion.toRotationMatrix();
+				return r;
+			}
+
+			friend std::ostream & operator << ( std::ostream& stream, const T_quat< T > & q ) {
+				return stream << q.xyzw();
+			}
+		};
+
+		// Typedefs
+		typedef T_quat< float > quat;
+		typedef T_quat< double > quatd;
+
+
+		// External Quaternion Operations
+		template< class T > T dot( const T_quat< T > & a, const T_quat< T > & b ) { return a.dot( b ); }
+
+		template< class T > T_quat< T > normalize( const T_quat< T > & q ) { return q.normalized(); }
+
+		// Normalized linear interpolation (takes the shortest path)
+		template< class T > T_quat< T > nlerp( const T_quat< T > & a, const T_quat< T > & b, T t ) {
+			T sign = ( a.dot( b ) < T( 0 ) ) ? T( -1 ) : T( 1 );
+			Eigen::Quaternion< T > r;
+			r.coeffs() = a.m_quaternion.coeffs() * ( T( 1 ) - t ) + b.m_quaternion.coeffs() * ( t * sign );
+			return T_quat< T >( r.normalized() );
+		}
+
+		// Spherical linear interpolation (takes the shortest path)
+		template< class T > T_quat< T > slerp( const T_quat< T > & a, const T_quat< T > & b, T t ) {
+			return T_quat< T >( a.m_quaternion.slerp( t, b.m_quaternion ) );
+		}
+
+		template< class T > T_mat< T, 4, 4 > QuaternionRotate( const T_quat< T > & quat ) { return quat.toMatrix(); }
+
+		template< class T > T_vec< T, 3 > QuaternionToEuler( const T_quat< T > & quat ) { return QuaternionToEuler( quat.xyzw() ); }
+
+		template< class T > T_vec< T, 3 > QuaternionToUnitVector( const T_quat< T > & quat ) {
+			T_vec< T, 3 > r = quat * T_vec< T, 3 >( 0.0f, 0.0f, -1.0f );
+			return T_vec< T, 3 >( -r.x(), -r.y(), r.z() );
+		}
+
+	}
+}
+
+#endif
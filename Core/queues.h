@@ -0,0 +1,251 @@
+
+#ifndef Rocket_Core_Queues_H
+#define Rocket_Core_Queues_H
+
+#include <atomic>
+#include <new>
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+
+namespace Rocket {
+	namespace Core {
+
+		// Size of a cache line, by which the indices written by different threads are kept apart
+		static const size_t CacheLineSize = 64;
+
+		// Bounded queue from one producer thread to one consumer thread, without locking
+		// Each side owns one index and keeps the last value it read of the other side's, so that it only reads the other's cache
+		// line when the queue looks full (or empty). The capacity is rounded up to a power of 2.
+		template < typename T >
+		class SPSCQueue {
+		public:
+			explicit SPSCQueue( unsigned int capacity );
+			~SPSCQueue();
+
+			// Producer: return false, and leave item alone, when the queue is full
+			bool push( const T & item ) { return emplace( item ); }
+			bool push( T && item ) { return emplace( std::move( item ) ); }
+			template < typename... Arguments >
+			bool emplace( Arguments &&... arguments );
+			// Producer: pushes as many of count items as fit, and returns how many
+			unsigned int push( const T * items, unsigned int count );
+
+			// Consumer: return false when the queue is empty
+			bool pop( T & item );
+			// Consumer: pops up to count items, and returns how many
+			unsigned int pop( T * items, unsigned int count );
+
+			// Exact on either side when the other is idle, and a snapshot otherwise
+			unsigned int size() const { return (unsigned int)( m_tail.load( std::memory_order_acquire ) - m_head.load( std::memory_order_acquire ) ); }
+			bool empty() const { return size() == 0; }
+			unsigned int capacity() const { return m_mask + 1; }
+
+		private:
+			typedef typename std::aligned_storage< sizeof( T ), alignof( T ) >::type Storage;
+
+			SPSCQueue( const SPSCQueue & ) = delete;
+			SPSCQueue & operator = ( const SPSCQueue & ) = delete;
+
+			T * slot( size_t index ) { return (T *)&m_items[ index & m_mask ]; }
+
+			// Consumer
+			alignas( CacheLineSize ) std::atomic< size_t > m_head;
+			size_t m_cachedTail;
+			// Producer
+			alignas( CacheLineSize ) std::atomic< size_t > m_tail;
+			size_t m_cachedHead;
+			// Shared, read-only
+			alignas( CacheLineSize ) Storage * m_items;
+			size_t m_mask;
+		};
+
+		// Bounded queue between any number of producer and consumer threads, without locking
+		// Each slot has a sequence number that tells whether it is ready to be written or read for a given turn around the ring
+		// (Vyukov's queue): a producer or consumer claims a position by advancing the shared index, which only succeeds when the
+		// slot's sequence shows it is free. The capacity is rounded up to a power of 2.
+		template < typename T >
+		class MPMCQueue {
+		public:
+			explicit MPMCQueue( unsigned int capacity );
+			~MPMCQueue();
+
+			// Return false, and leave item alone, when the queue is full
+			bool push( const T & item ) { return emplace( item ); }
+			bool push( T && item ) { return emplace( std::move( item ) ); }
+			template < typename... Arguments >
+			bool emplace( Arguments &&... arguments );
+
+			// Returns false when the queue is empty
+			bool pop( T & item );
+
+			// A snapshot while other threads use the queue
+			unsigned int size() const;
+			bool empty() const { return size() == 0; }
+			unsigned int capacity() const { return (unsigned int)( m_mask + 1 ); }
+
+		private:
+			struct Cell {
+				std::atomic< size_t > sequence;		// position + 1 once written, position + capacity once read
+				typename std::aligned_storage< sizeof( T ), alignof( T ) >::type item;
+			};
+
+			MPMCQueue( const MPMCQueue & ) = delete;
+			MPMCQueue & operator = ( const MPMCQueue & ) = delete;
+
+			alignas( CacheLineSize ) std::atomic< size_t > m_tail;
+			alignas( CacheLineSize ) std::atomic< size_t > m_head;
+			alignas( CacheLineSize ) Cell * m_cells;
+			size_t m_mask;
+		};
+
+		// Smallest power of 2 at least value (and at least 2)
+		inline size_t Queues_Capacity( unsigned int value ) {
+			size_t capacity = 2;
+			while ( capacity < value ) capacity *= 2;
+			return capacity;
+		}
+
+		// --------------------------------------------------------------------------------------------------------------------
+		// SPSCQueue
+		// --------------------------------------------------------------------------------------------------------------------
+
+		template < typename T >
+		SPSCQueue< T >::SPSCQueue( unsigned int capacity ) : m_head( 0 ), m_cachedTail( 0 ), m_tail( 0 ), m_cachedHead( 0 ) {
+			m_mask = Queues_Capacity( capacity ) - 1;
+			m_items = new Storage[ m_mask + 1 ];
+		}
+
+		template < typename T >
+		SPSCQueue< T >::~SPSCQueue() {
+			size_t tail = m_tail.load( std::memory_order_relaxed );
+			for ( size_t i = m_head.load( std::memory_order_relaxed ); i != tail; i++ ) slot( i )->~T();
+			delete [] m_items;
+		}
+
+		template < typename T >
+		template < typename... Arguments >
+		bool SPSCQueue< T >::emplace( Arguments &&... arguments ) {
+			size_t tail = m_tail.load( std::memory_order_relaxed );
+			if ( tail - m_cachedHead > m_mask ) {
+				m_cachedHead = m_head.load( std::memory_order_acquire );
+				if ( tail - m_cachedHead > m_mask ) return false;
+			}
+			new ( slot( tail ) ) T( std::forward< Arguments >( arguments )... );
+			m_tail.store( tail + 1, std::memory_order_release );
+			return true;
+		}
+
+		template < typename T >
+		unsigned int SPSCQueue< T >::push( const T * items, unsigned int count ) {
+			size_t tail = m_tail.load( std::memory_order_relaxed );
+			if ( m_mask + 1 - ( tail - m_cachedHead ) < count ) m_cachedHead = m_head.load( std::memory_order_acquire );
+			size_t space = m_mask + 1 - ( tail - m_cachedHead );
+			if ( count > space ) count = (unsigned int)space;
+			for ( unsigned int i = 0; i < count; i++ ) new ( slot( tail + i ) ) T( items[i] );
+			m_tail.store( tail + count, std::memory_order_release );
+			return count;
+		}
+
+		template < typename T >
+		bool SPSCQueue< T >::pop( T & item ) {
+			size_t head = m_head.load( std::memory_order_relaxed );
+			if ( head == m_cachedTail ) {
+				m_cachedTail = m_tail.load( std::memory_order_acquire );
+				if ( head == m_cachedTail ) return false;
+			}
+			T * p = slot( head );
+			item = std::move( *p );
+			p->~T();
+			m_head.store( head + 1, std::memory_order_release );
+			return true;
+		}
+
+		template < typename T >
+		unsigned int SPSCQueue< T >::pop( T * items, unsigned int count ) {
+			size_t head = m_head.load( std::memory_order_relaxed );
+			if ( m_cachedTail - head < count ) m_cachedTail = m_tail.load( std::memory_order_acquire );
+			size_t available = m_cachedTail - head;
+			if ( count > available ) count = (unsigned int)available;
+			for ( unsigned int i = 0; i < count; i++ ) {
+				T * p = slot( head + i );
+				items[i] = std::move( *p );
+				p->~T();
+			}
+			m_head.store( head + count, std::memory_order_release );
+			return count;
+		}
+
+		// --------------------------------------------------------------------------------------------------------------------
+		// MPMCQueue
+		// --------------------------------------------------------------------------------------------------------------------
+
+		template < typename T >
+		MPMCQueue< T >::MPMCQueue( unsigned int capacity ) : m_tail( 0 ), m_head( 0 ) {
+			m_mask = Queues_Capacity( capacity ) - 1;
+			m_cells = new Cell[ m_mask + 1 ];
+			for ( size_t i = 0; i <= m_mask; i++ ) m_cells[i].sequence.store( i, std::memory_order_relaxed );
+		}
+
+		template < typename T >
+		MPMCQueue< T >::~MPMCQueue() {
+			size_t tail = m_tail.load( std::memory_order_relaxed );
+			for ( size_t i = m_head.load( std::memory_order_relaxed ); i != tail; i++ ) ( (T *)&m_cells[ i & m_mask ].item )->~T();
+			delete [] m_cells;
+		}
+
+		template < typename T >
+		template < typename... Arguments >
+		bool MPMCQueue< T >::emplace( Arguments &&... arguments ) {
+			size_t position = m_tail.load( std::memory_order_relaxed );
+			Cell * cell;
+			for ( ;; ) {
+				cell = &m_cells[ position & m_mask ];
+				ptrdiff_t difference = ptrdiff_t( cell->sequence.load( std::memory_order_acquire ) ) - ptrdiff_t( position );
+				if ( difference == 0 ) {
+					// The slot is free for this turn: claim it
+					if ( m_tail.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) ) break;
+				} else if ( difference < 0 ) {
+					return false;		// the slot still holds the item of the previous turn
+				} else {
+					position = m_tail.load( std::memory_order_relaxed );		// another producer claimed it
+				}
+			}
+			new ( &cell->item ) T( std::forward< Arguments >( arguments )... );
+			cell->sequence.store( position + 1, std::memory_order_release );
+			return true;
+		}
+
+		template < typename T >
+		bool MPMCQueue< T >::pop( T & item ) {
+			size_t position = m_head.load( std::memory_order_relaxed );
+			Cell * cell;
+			for ( ;; ) {
+				cell = &m_cells[ position & m_mask ];
+				ptrdiff_t difference = ptrdiff_t( cell->sequence.load( std::memory_order_acquire ) ) - ptrdiff_t( position + 1 );
+				if ( difference == 0 ) {
+					if ( m_head.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) ) break;
+				} else if ( difference < 0 ) {
+					return false;		// the slot has not been written for this turn
+				} else {
+					position = m_head.load( std::memory_order_relaxed );
+				}
+			}
+			T * p = (T *)&cell->item;
+			item = std::move( *p );
+			p->~T();
+			cell->sequence.store( position + m_mask + 1, std::memory_order_release );
+			return true;
+		}
+
+		template < typename T >
+		unsigned int MPMCQueue< T >::size() const {
+			size_t head = m_head.load( std::memory_order_acquire );
+			size_t tail = m_tail.load( std::memory_order_acquire );
+			return ( tail > head ) ? (unsigned int)( tail - head ) : 0;
+		}
+
+	}
+}
+
+#endif
@@ -1,7 +1,11 @@
 
 #include <string>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
 
 #include "rstring.h"
+#include "stringid.h"
 
 namespace Rocket {
 	namespace Core {
@@ -24,6 +28,11 @@ namespace Rocket {
 			return !(*this == rhs);
 		}
 
+		// FNV-1a, the same hash as StringId
+		size_t rstring::operator() ( const rstring & that ) const {
+			return (size_t)fnv1a( that.m_value.data(), that.m_value.length() );
+		}
+
 		rstring & rstring::operator = ( const rstring & rhs ) {
 			if (this != & rhs) {
 				m_value = rhs.m_value;
@@ -39,37 +48,56 @@ namespace Rocket {
 		}
 
 		rstring & rstring::operator += ( const rstring & rhs ) {
-			m_value = m_value + rhs.m_value;
+			m_value += rhs.m_value;
 			return *this;
 		}
 		rstring & rstring::operator += ( const char & rhs ) {
-			m_value = m_value + rhs;
+			m_value += rhs;
 			return *this;
 		}
 
 		rstring & rstring::operator << ( const rstring & s ) {
-			m_value = rstring( m_value + s.m_value ).m_value;
+			m_value += s.m_value;
+			return *this;
+		}
+		rstring & rstring::operator << ( const char * s ) {
+			m_value += s;
 			return *this;
 		}
 		rstring & rstring::operator << ( const int & i ) {
-			m_value = rstring( m_value + tostring( i ).m_value ).m_value;
+			char buffer[ FormatBufferSize ];
+			m_value.append( buffer, formatSigned( i, buffer ) );
 			return *this;
 		}
 		rstring & rstring::operator << ( const unsigned int & i ) {
-			m_value = rstring( m_value + tostring( i ).m_value ).m_value;
+			char buffer[ FormatBufferSize ];
+			m_value.append( buffer, formatUnsigned( i, buffer ) );
+			return *this;
+		}
+		rstring & rstring::operator << ( const double & d ) {
+			char buffer[ FormatBufferSize ];
+			m_value.append( buffer, formatDouble( d, buffer ) );
+			return *this;
+		}
+
+		rstring & rstring::append( const char * s, size_t length ) {
+			m_value.append( s, length );
 			return *this;
 		}
 
+		void rstring::reserve( size_t capacity ) {
+			m_value.reserve( capacity );
+		}
 
-		unsigned int rstring::length() {
+		unsigned int rstring::length() const {
 			return m_value.length();
 		}
 
-		const char * rstring::c_str() {
+		const char * rstring::c_str() const {
 			return m_value.c_str();
 		}
 
-		string rstring::std_str() {
+		string rstring::std_str() const {
 			return string( m_value );
 		}
 
@@ -77,24 +105,137 @@ namespace Rocket {
 			return atoi(m_value.c_str());
 		}
 		rstring rstring::tostring( int i_int ) {
-			if ( i_int < 0 ) {
-				rstring r = "-";
-				return rstring( "-" ) + tostring( (unsigned int)(-i_int) );
+			char buffer[ FormatBufferSize ];
+			return rstring( CORE_STRING_TYPE( buffer, formatSigned( i_int, buffer ) ) );
+		}
+		rstring rstring::tostring( unsigned int i_uint ) {
+			char buffer[ FormatBufferSize ];
+			return rstring( CORE_STRING_TYPE( buffer, formatUnsigned( i_uint, buffer ) ) );
+		}
+
+		// "00" to "99"
+		static const char DigitPairs[] =
+			"00010203040506070809"
+			"10111213141516171819"
+			"20212223242526272829"
+			"30313233343536373839"
+			"40414243444546474849"
+			"50515253545556575859"
+			"60616263646566676869"
+			"70717273747576777879"
+			"80818283848586878889"
+			"90919293949596979899";
+
+		unsigned int formatUnsigned( unsigned long long value, char * buffer ) {
+			// Digits are produced from the end, two at a time
+			char digits[20];
+			char * end = digits + sizeof( digits );
+			char * p = end;
+			while ( value >= 100 ) {
+				unsigned int pair = (unsigned int)( value % 100 ) * 2;
+				value /= 100;
+				*--p = DigitPairs[ pair + 1 ];
+				*--p = DigitPairs[ pair ];
+			}
+			if ( value >= 10 ) {
+				unsigned int pair = (unsigned int)value * 2;
+				*--p = DigitPairs[ pair + 1 ];
+				*--p = DigitPairs[ pair ];
 			} else {
-				return tostring( (unsigned int)i_int );
+				*--p = char( '0' + value );
 			}
+			unsigned int length = (unsigned int)( end - p );
+			memcpy( buffer, p, length );
+			return length;
 		}
-		void tostringhelper( unsigned int i, rstring & s ) {
-			unsigned int n = i % 10;
-			unsigned int rest = ( i - n ) / 10;
-			if ( rest > 0 ) tostringhelper( rest, s );
-			s += ( '0' + n );
+
+		unsigned int formatSigned( long long value, char * buffer ) {
+			if ( value < 0 ) {
+				buffer[0] = '-';
+				// Negated as unsigned, so that the smallest value does not overflow
+				return 1 + formatUnsigned( 0ull - (unsigned long long)value, buffer + 1 );
+			}
+			return formatUnsigned( (unsigned long long)value, buffer );
 		}
-		rstring rstring::tostring( unsigned int i_uint ) {
-			rstring r( "" );
-			tostringhelper( i_uint, r );
-			return r;
+
+		unsigned int formatDouble( double value, char * buffer, unsigned int precision ) {
+			static const unsigned long long Scales[] = { 1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull };
+			if ( precision > 9 ) precision = 9;
+
+			if ( value != value ) {
+				memcpy( buffer, "nan", 3 );
+				return 3;
+			}
+			unsigned int length = 0;
+			if ( signbit( value ) ) buffer[ length++ ] = '-';
+			double magnitude = fabs( value );
+			if ( magnitude == HUGE_VAL ) {
+				memcpy( buffer + length, "inf", 3 );
+				return length + 3;
+			}
+			if ( magnitude >= 1e15 ) {
+				return length + snprintf( buffer + length, FormatBufferSize - length, "%.*e", precision, magnitude );
+			}
+
+			// The whole part is exact, and so is the fraction before it is scaled
+			unsigned long long whole = (unsigned long long)magnitude;
+			unsigned long long scale = Scales[ precision ];
+			unsigned long long fraction = (unsigned long long)( ( magnitude - whole ) * scale + 0.5 );
+			if ( fraction >= scale ) {
+				whole++;
+				fraction -= scale;
+			}
+			length += formatUnsigned( whole, buffer + length );
+			if ( precision > 0 ) {
+				buffer[ length++ ] = '.';
+				char digits[ FormatBufferSize ];
+				unsigned int count = formatUnsigned( fraction, digits );
+				memset( buffer + length, '0', precision - count );
+				memcpy( buffer + length + precision - count, digits, count );
+				length += precision;
+			}
+			return length;
+		}
+
+		StringBuilder::StringBuilder() : m_data( m_inline ), m_length( 0 ), m_capacity( InlineCapacity - 1 ) {
+			m_inline[0] = 0;
 		}
 
+		StringBuilder::~StringBuilder() {
+			if ( m_data != m_inline ) delete [] m_data;
+		}
+
+		void StringBuilder::reserve( size_t capacity ) {
+			if ( capacity <= m_capacity ) return;
+			if ( capacity < m_capacity * 2 ) capacity = m_capacity * 2;
+			char * data = new char[ capacity + 1 ];
+			memcpy( data, m_data, m_length + 1 );
+			if ( m_data != m_inline ) delete [] m_data;
+			m_data = data;
+			m_capacity = capacity;
+		}
+
+		void StringBuilder::clear() {
+			m_length = 0;
+			m_data[0] = 0;
+		}
+
+		StringBuilder & StringBuilder::append( const char * s, size_t length ) {
+			memcpy( grow( length ), s, length );
+			return formatted( (unsigned int)length );
+		}
+
+		StringBuilder & StringBuilder::operator << ( const char * s ) { return append( s, strlen( s ) ); }
+		StringBuilder & StringBuilder::operator << ( const rstring & s ) { return append( s.c_str(), s.length() ); }
+		StringBuilder & StringBuilder::operator << ( const string & s ) { return append( s.data(), s.length() ); }
+		StringBuilder & StringBuilder::operator << ( char c ) { return append( &c, 1 ); }
+		StringBuilder & StringBuilder::operator << ( int i ) { return formatted( formatSigned( i, grow( FormatBufferSize ) ) ); }
+		StringBuilder & StringBuilder::operator << ( unsigned int i ) { return formatted( formatUnsigned( i, grow( FormatBufferSize ) ) ); }
+		StringBuilder & StringBuilder::operator << ( long i ) { return formatted( formatSigned( i, grow( FormatBufferSize ) ) ); }
+		StringBuilder & StringBuilder::operator << ( unsigned long i ) { return formatted( formatUnsigned( i, grow( FormatBufferSize ) ) ); }
+		StringBuilder & StringBuilder::operator << ( long long i ) { return formatted( formatSigned( i, grow( FormatBufferSize ) ) ); }
+		StringBuilder & StringBuilder::operator << ( unsigned long long i ) { return formatted( formatUnsigned( i, grow( FormatBufferSize ) ) ); }
+		StringBuilder & StringBuilder::operator << ( double d ) { return formatted( formatDouble( d, grow( FormatBufferSize ) ) ); }
+
 	}
-}
\ No newline at end of file
+}
@@ -22,6 +22,7 @@ namespace Rocket {
 			bool operator == ( const rstring & rhs ) const;
 			bool operator != ( const rstring & rhs ) const;
 
+			// Hash of that, so that an rstring can be used as the hash function of unordered containers of rstrings
 			size_t operator() ( const rstring & that ) const;
 
 			rstring & operator = ( const rstring & rhs );
@@ -29,22 +30,29 @@ namespace Rocket {
 			const rstring operator + ( const rstring & other ) const;
 			friend rstring operator + ( const char * str, const rstring & R );
 
+			// Appends in place, growing the buffer geometrically
 			rstring & operator += ( const rstring & rhs );
 			rstring & operator += ( const char & rhs );
 
 			rstring & operator << ( const rstring & s );
+			rstring & operator << ( const char * s );
 			rstring & operator << ( const int & i );
 			rstring & operator << ( const unsigned int & i );
+			rstring & operator << ( const double & d );
 
-			unsigned int length();
+			rstring & append( const char * s, size_t length );
+			// Makes room for capacity characters, so that appends up to that length do not allocate
+			void reserve( size_t capacity );
+
+			unsigned int length() const;
 
 			//string toUpper()
 			//string toLower()
 			//string replace()
 			//string trim(white,quotes,etc)
 
-			const char * c_str();
-			string std_str();
+			const char * c_str() const;
+			string std_str() const;
 
 			int toint();
 			static rstring tostring( int i_int );
@@ -54,6 +62,66 @@ namespace Rocket {
 			CORE_STRING_TYPE m_value;
 		};
 
+		// Number formatting into a caller's buffer, which must have room for FormatBufferSize characters
+		// Integers are written two digits at a time from a table; nothing is allocated and no terminating zero is written
+		// Each function returns the number of characters written
+		static const unsigned int FormatBufferSize = 32;
+		unsigned int formatUnsigned( unsigned long long value, char * buffer );
+		unsigned int formatSigned( long long value, char * buffer );
+		// Fixed notation with precision digits after the point (at most 9), like printf's "%.*f" except that halfway cases round up
+		// Values of 1e15 or more are written in exponent notation ("%.*e"), and infinities and NaNs as "inf", "-inf" and "nan"
+		unsigned int formatDouble( double value, char * buffer, unsigned int precision = 6 );
+
+		// Builds a string with in-place appends, in an inline buffer of InlineCapacity characters until it needs more
+		// For short strings such as addresses and log lines, only str() allocates
+		class StringBuilder {
+		public:
+			static const unsigned int InlineCapacity = 128;
+
+			StringBuilder();
+			StringBuilder( const StringBuilder & ) = delete;
+			StringBuilder & operator = ( const StringBuilder & ) = delete;
+			~StringBuilder();
+
+			StringBuilder & append( const char * s, size_t length );
+			StringBuilder & operator << ( const char * s );
+			StringBuilder & operator << ( const rstring & s );
+			StringBuilder & operator << ( const string & s );
+			StringBuilder & operator << ( char c );
+			StringBuilder & operator << ( int i );
+			StringBuilder & operator << ( unsigned int i );
+			StringBuilder & operator << ( long i );
+			StringBuilder & operator << ( unsigned long i );
+			StringBuilder & operator << ( long long i );
+			StringBuilder & operator << ( unsigned long long i );
+			StringBuilder & operator << ( double d );
+
+			void reserve( size_t capacity );
+			void clear();
+
+			size_t length() const { return m_length; }
+			// Zero terminated
+			const char * c_str() const { return m_data; }
+			rstring str() const { return rstring( CORE_STRING_TYPE( m_data, m_length ) ); }
+
+		private:
+			char m_inline[ InlineCapacity ];
+			char * m_data;							// m_inline, or a heap buffer once the string outgrows it
+			size_t m_length;
+			size_t m_capacity;						// not counting the terminating zero
+
+			// Room for extra more characters, plus the terminating zero
+			char * grow( size_t extra ) {
+				if ( m_length + extra > m_capacity ) reserve( m_length + extra );
+				return m_data + m_length;
+			}
+			StringBuilder & formatted( unsigned int length ) {
+				m_length += length;
+				m_data[ m_length ] = 0;
+				return *this;
+			}
+		};
+
 	}
 }
 
@@ -0,0 +1,45 @@
+
+#include <mutex>
+#include <unordered_map>
+
+#include "stringid.h"
+#include "debug.h"
+
+namespace Rocket {
+	namespace Core {
+
+		unsigned long long fnv1a( const char * s, size_t length ) {
+			unsigned long long hash = 14695981039346656037ull;
+			for ( size_t i = 0; i < length; i++ ) hash = ( hash ^ (unsigned char)s[i] ) * 1099511628211ull;
+			return hash;
+		}
+
+		// hash, text of every interned name
+		static std::mutex StringId_TableMutex;
+		static std::unordered_map< unsigned long long, std::string > & StringId_Table() {
+			static std::unordered_map< unsigned long long, std::string > table;
+			return table;
+		}
+
+		StringId StringId::intern( const std::string & name ) {
+			StringId id( name );
+			std::lock_guard< std::mutex > lock( StringId_TableMutex );
+			auto inserted = StringId_Table().insert( std::make_pair( id.m_hash, name ) );
+			if ( inserted.second == false && inserted.first->second != name ) {
+				Debug_ThrowError( "Error: two names have the same StringId hash.", name, inserted.first->second );
+			}
+			return id;
+		}
+
+		StringId StringId::intern( const char * name ) {
+			return intern( std::string( name ) );
+		}
+
+		const char * StringId::name() const {
+			std::lock_guard< std::mutex > lock( StringId_TableMutex );
+			auto iter = StringId_Table().find( m_hash );
+			return ( iter == StringId_Table().end() ) ? nullptr : iter->second.c_str();
+		}
+
+	}
+}
@@ -0,0 +1,59 @@
+
+#ifndef Rocket_Core_StringId_H
+#define Rocket_Core_StringId_H
+
+#include <string>
+#include <functional>
+#include <stddef.h>
+
+namespace Rocket {
+	namespace Core {
+
+		// 64-bit FNV-1a hash of a zero terminated string, usable in constant expressions
+		constexpr unsigned long long fnv1aContinue( const char * s, unsigned long long hash ) {
+			return ( *s == 0 ) ? hash : fnv1aContinue( s + 1, ( hash ^ (unsigned char)*s ) * 1099511628211ull );
+		}
+		constexpr unsigned long long fnv1a( const char * s ) {
+			return fnv1aContinue( s, 14695981039346656037ull );
+		}
+		// Same hash of length characters (which may include zeros)
+		unsigned long long fnv1a( const char * s, size_t length );
+
+		// A name reduced to its 64-bit hash, so that copies and comparisons are those of an integer
+		// Names given as literals are hashed at compile time wherever a constant is needed, e.g. static constexpr StringId Walk( "walk" );
+		// intern() also records the text of runtime names, for name() and to catch two names with the same hash.
+		class StringId {
+		public:
+			constexpr StringId() : m_hash( fnv1a( "" ) ) {}
+			constexpr StringId( const char * name ) : m_hash( fnv1a( name ) ) {}
+			StringId( const std::string & name ) : m_hash( fnv1a( name.data(), name.length() ) ) {}
+
+			// Hashes name and adds it to the global intern table (thread safe)
+			static StringId intern( const char * name );
+			static StringId intern( const std::string & name );
+
+			constexpr unsigned long long hash() const { return m_hash; }
+			// Text of an interned name, or nullptr if it was never interned
+			const char * name() const;
+
+			constexpr bool operator == ( StringId rhs ) const { return m_hash == rhs.m_hash; }
+			constexpr bool operator != ( StringId rhs ) const { return m_hash != rhs.m_hash; }
+			constexpr bool operator < ( StringId rhs ) const { return m_hash < rhs.m_hash; }
+
+		private:
+			unsigned long long m_hash;
+		};
+
+	}
+}
+
+namespace std {
+	template<> struct hash< Rocket::Core::StringId > {
+		// The hash is already well mixed; it is only folded where size_t is narrower than 64 bits
+		size_t operator () ( Rocket::Core::StringId id ) const {
+			return ( sizeof( size_t ) >= sizeof( unsigned long long ) ) ? (size_t)id.hash() : (size_t)( id.hash() ^ ( id.hash() >> 32 ) );
+		}
+	};
+}
+
+#endif
@@ -7,6 +7,15 @@ namespace Rocket {
 #ifdef OS_WINDOWS
 		unsigned long timer() { return GetTickCount(); }
 		void sleep( int ms ) { Sleep(ms); }
+		unsigned long long timer_ns() {
+			static LARGE_INTEGER frequency = { 0 };
+			if ( frequency.QuadPart == 0 ) QueryPerformanceFrequency( &frequency );
+			LARGE_INTEGER counter;
+			QueryPerformanceCounter( &counter );
+			// Whole seconds and the remainder separately, so that the product does not overflow
+			unsigned long long seconds = counter.QuadPart / frequency.QuadPart, remainder = counter.QuadPart % frequency.QuadPart;
+			return seconds * 1000000000ull + remainder * 1000000000ull / frequency.QuadPart;
+		}
 #else
 		unsigned long timer() {
 			struct timeval t;
@@ -14,6 +23,11 @@ namespace Rocket {
 			return (unsigned long)( t.tv_sec * 1000.0 + t.tv_usec/1000.0 + 0.5 );
 		}
 		void sleep( int ms ) { usleep( ms * 1000 ); }
+		unsigned long long timer_ns() {
+			struct timespec t;
+			clock_gettime( CLOCK_MONOTONIC, &t );
+			return (unsigned long long)t.tv_sec * 1000000000ull + t.tv_nsec;
+		}
 #endif
 
 		unsigned long elapsedtime( unsigned long T ) { return (timer() - T); }
@@ -9,6 +9,7 @@
 
 #else
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 
 #endif
@@ -20,6 +21,7 @@ namespace Rocket {
 
 		unsigned long timer();							// timer in ms resolution
 		unsigned long elapsedtime( unsigned long T );	// elapsed time in ms
+		unsigned long long timer_ns();					// monotonic timer in ns, unaffected by changes to the system clock
 		void sleep( int ms );
 
 		enum CORE_MONTHS : unsigned int {
@@ -7,6 +7,8 @@
 #include <vector>
 
 #define EIGEN_MPL2_ONLY
+// Must match matrix.h: whichever header includes Eigen first decides the default storage order for every matrix type
+#define EIGEN_DEFAULT_TO_ROW_MAJOR
 #include <eigen3/Eigen/Dense>
 
 #include "mathconstants.h"
@@ -14,7 +16,82 @@
 namespace Rocket {
 	namespace Core {
 
-		template< class T, unsigned int N > class T_vec {
+		template< class T, unsigned int N > class T_vec;
+		template< class T, unsigned int N, class Expr > class T_vec_expr;
+
+		// Operations shared by T_vec and T_vec_expr
+		// Derived::expression() returns the Eigen matrix (T_vec) or unevaluated Eigen expression (T_vec_expr) being wrapped
+		template< class Derived, class T, unsigned int N > class T_vec_base {
+		public:
+			typedef T Scalar;
+
+			const Derived & derived() const { return static_cast< const Derived & >( *this ); }
+
+			// Evaluate into a T_vec
+			T_vec< T, N > eval() const { return T_vec< T, N >( Eigen::Matrix< T, N, 1 >( derived().expression() ) ); }
+
+			// Vector Operations
+			T lengthSquared() const { return derived().expression().squaredNorm(); }
+			T normSquared() const { return derived().expression().squaredNorm(); }
+			T length() const { return derived().expression().norm(); }
+			T norm() const { return derived().expression().norm(); }
+			template< class R > T dot( const T_vec_base< R, T, N > & r ) const { return derived().expression().dot( r.derived().expression() ); }		// Dot Product
+			template< class R > T_vec< T, N > cross( const T_vec_base< R, T, N > & r ) const {														// Cross Product
+				return T_vec< T, N >( Eigen::Matrix< T, N, 1 >( derived().expression().cross( r.derived().expression() ) ) );
+			}
+			T_vec< T, N > normalized() const { return T_vec< T, N >( Eigen::Matrix< T, N, 1 >( derived().expression().normalized() ) ); }
+
+			// Swizzle
+			T_vec< T, 2 > xy() const { return T_vec< T, 2 >( derived().x(), derived().y() ); }
+			T_vec< T, 2 > yx() const { return T_vec< T, 2 >( derived().y(), derived().x() ); }
+
+			T_vec< T, 2 > xz() const { return T_vec< T, 2 >( derived().x(), derived().z() ); }
+			T_vec< T, 2 > yz() const { return T_vec< T, 2 >( derived().y(), derived().z() ); }
+			T_vec< T, 2 > zx() const { return T_vec< T, 2 >( derived().z(), derived().x() ); }
+			T_vec< T, 2 > zy() const { return T_vec< T, 2 >( derived().z(), derived().y() ); }
+
+			T_vec< T, 3 > xyz() const { return T_vec< T, 3 >( derived().x(), derived().y(), derived().z() ); }
+			T_vec< T, 3 > zyx() const { return T_vec< T, 3 >( derived().z(), derived().y(), derived().x() ); }
+
+			T_vec< T, 4 > xyzw() const { return T_vec< T, 4 >( derived().x(), derived().y(), derived().z(), derived().w() ); }
+			T_vec< T, 4 > wzyx() const { return T_vec< T, 4 >( derived().w(), derived().z(), derived().y(), derived().x() ); }
+		};
+
+		// Unevaluated vector arithmetic (the result of +, - and * on T_vec)
+		// Chains of operators build a single Eigen expression that is evaluated in one pass when it is converted to a T_vec,
+		// so expressions must not outlive the vectors they were built from (don't store them with auto)
+		template< class T, unsigned int N, class Expr > class T_vec_expr : public T_vec_base< T_vec_expr< T, N, Expr >, T, N > {
+		public:
+			Expr m_expression;
+
+			explicit T_vec_expr( const Expr & expression ) : m_expression( expression ) {}
+
+			const Expr & expression() const { return m_expression; }
+
+			// Access Operators and Functions
+			T operator [] ( int index ) const { return m_expression.coeff( index ); }
+
+			T x() const { return m_expression.coeff( 0 ); }
+			T y() const { return m_expression.coeff( 1 ); }
+			T z() const {
+				static_assert( N > 2, "Element z does not exist in this vector" );
+				return m_expression.coeff( 2 );
+			}
+			T w() const {
+				static_assert( N > 3, "Element w does not exist in this vector" );
+				return m_expression.coeff( 3 );
+			}
+
+			friend std::ostream & operator << ( std::ostream& stream, const T_vec_expr & v ) {
+				return stream << v.eval();
+			}
+		};
+
+		template< class T, unsigned int N, class Expr > T_vec_expr< T, N, Expr > makeVecExpr( const Expr & expression ) {
+			return T_vec_expr< T, N, Expr >( expression );
+		}
+
+		template< class T, unsigned int N > class T_vec : public T_vec_base< T_vec< T, N >, T, N > {
 			static_assert( N > 1, "Number of elements must be greater than 1" );
 
 		public:
@@ -24,6 +101,10 @@ namespace Rocket {
 			T_vec() { m_elements.setZero(); }
 			T_vec( Eigen::Matrix< T, N, 1 > elements ) { m_elements = elements; }
 
+			// Evaluates an expression built from T_vec arithmetic
+			template< class Expr >
+			T_vec( const T_vec_expr< T, N, Expr > & expression ) : m_elements( expression.m_expression ) {}
+
 			// Constructor that takes N number of elements
 			template< typename... Args >
 			T_vec( T first, Args &&... args ) {
@@ -31,31 +112,28 @@ namespace Rocket {
 				m_elements = Eigen::Matrix< T, N, 1 >( first, args... );
 			}
 
-			// Constructor that appends right vector to left vector
-			template< unsigned int Nleft, unsigned int Nright >
-			T_vec( const T_vec< T, Nleft > & left, const T_vec< T, Nright > & right ) {
-				static_assert( Nleft + Nright == N, "Left and Right vectors do not contain the right number of elements" );
-				m_elements = Eigen::Matrix< T, N, 1 >();
-				for ( unsigned int i = 0; i < Nleft; i++ ) {
-					m_elements[i] = left[i];
-				}
-				for ( unsigned int i = Nleft; i < N; i++ ) {
-					m_elements[i] = right[ i - Nleft ];
-				}
-			}
-
-			// Constructor that appends N - N2 number of elements to the initial vector
+			// Constructor that appends elements and/or vectors to the initial vector (ie. vec4( v.xyz(), 1.0f ) or vec4( a.xy(), b.xy() ))
 			template< unsigned int N2, typename... Args >
 			T_vec( const T_vec< T, N2 > & v, Args &&... args ) {
-				static_assert( sizeof...( Args ) == N - N2, "Invalid number of arguments" );
-				m_elements = Eigen::Matrix< T, N, 1 >();
-				for ( unsigned int i = 0; i < N2; i++ ) {
-					m_elements[i] = v[i];
-				}
-				std::vector< T > argsVector = { args... };
-				for ( unsigned int i = N2; i < N; i++ ) {
-					m_elements[i] = argsVector[ i - N2 ];
-				}
+				setElements< 0 >( v, std::forward< Args >( args )... );
+			}
+
+			// Sets the elements from index I onward (expands the constructor arguments without building a temporary container)
+			template< unsigned int I >
+			void setElements() {
+				static_assert( I == N, "Invalid number of elements" );
+			}
+			template< unsigned int I, typename... Args >
+			void setElements( T head, Args &&... tail ) {
+				static_assert( I < N, "Invalid number of elements" );
+				m_elements[I] = head;
+				setElements< I + 1 >( std::forward< Args >( tail )... );
+			}
+			template< unsigned int I, unsigned int M, typename... Args >
+			void setElements( const T_vec< T, M > & head, Args &&... tail ) {
+				static_assert( I + M <= N, "Invalid number of elements" );
+				m_elements.template segment< M >( I ) = head.m_elements;
+				setElements< I + M >( std::forward< Args >( tail )... );
 			}
 
 			// Access Operators and Functions
@@ -84,49 +162,15 @@ namespace Rocket {
 				m_elements[3] = v;
 			}
 
-			// Unary Operators
-			T_vec operator - () const { return T_vec( -m_elements ); }
-
-			// Arithmetic
-			T_vec operator + ( const T_vec & R ) const { return T_vec( m_elements + R.m_elements ); }
-			T_vec operator - ( const T_vec & R ) const { return T_vec( m_elements - R.m_elements ); }
-			T_vec operator * ( T value ) const { return T_vec( m_elements * value ); }					// Left hand T_vec
-			friend T_vec operator * ( T value, const T_vec & R ) { return T_vec( R * value ); }			// Right hand T_vec
-
-			// Equality
-			bool operator == ( const T_vec & R ) const { return m_elements == R.m_elements; }
-			bool operator != ( const T_vec & R ) const { return m_elements != R.m_elements; }
+			const Eigen::Matrix< T, N, 1 > & expression() const { return m_elements; }
 
 			// Assignment Operators
-			T_vec & operator += ( const T_vec & R ) { m_elements += R.m_elements; return *this; }
-			T_vec & operator -= ( const T_vec & R ) { m_elements -= R.m_elements; return *this; }
+			template< class R > T_vec & operator += ( const T_vec_base< R, T, N > & r ) { m_elements += r.derived().expression(); return *this; }
+			template< class R > T_vec & operator -= ( const T_vec_base< R, T, N > & r ) { m_elements -= r.derived().expression(); return *this; }
 			T_vec & operator *= ( T value ) { m_elements *= value; return *this; }
 
 			// Vector Operations
-			T lengthSquared() const { return m_elements.squaredNorm(); }
-			T normSquared() const { return m_elements.squaredNorm(); }
-			T length() const { return m_elements.norm(); }
-			T norm() const { return m_elements.norm(); }
-			T dot( const T_vec & R ) const { return m_elements.dot( R.m_elements ); }				// Dot Product
-			T operator * ( const T_vec & R ) const { return dot( R ); }								// Dot Product
-			T_vec cross( const T_vec & R ) const { return m_elements.cross( R.m_elements ); }		// Cross Product
 			void normalize() { m_elements.normalize(); }
-			T_vec normalized() const { return T_vec( m_elements.normalized() ); }
-
-			// Swizzle
-			T_vec< T, 2 > xy() const { return T_vec< T, 2 >( x(), y() ); }
-			T_vec< T, 2 > yx() const { return T_vec< T, 2 >( y(), x() ); }
-
-			T_vec< T, 2 > xz() const { return T_vec< T, 2 >( x(), z() ); }
-			T_vec< T, 2 > yz() const { return T_vec< T, 2 >( y(), z() ); }
-			T_vec< T, 2 > zx() const { return T_vec< T, 2 >( z(), x() ); }
-			T_vec< T, 2 > zy() const { return T_vec< T, 2 >( z(), y() ); }
-
-			T_vec< T, 3 > xyz() const { return T_vec< T, 3 >( x(), y(), z() ); }
-			T_vec< T, 3 > zyx() const { return T_vec< T, 3 >( z(), y(), x() ); }
-
-			T_vec< T, 4 > xyzw() const { return T_vec< T, 4 >( x(), y(), z(), w() ); }
-			T_vec< T, 4 > wzyx() const { return T_vec< T, 4 >( w(), z(), y(), x() ); }
 
 			// Conversion Operators
 			operator Eigen::Matrix< T, N, 1 >() const { return m_elements; }
@@ -158,15 +202,53 @@ namespace Rocket {
 		typedef T_vec< int, 4 > vec4i;
 		
 
+		// Arithmetic
+		// These return T_vec_expr, so that a chain of operators is evaluated without intermediate temporaries
+		template< class L, class T, unsigned int N >
+		auto operator - ( const T_vec_base< L, T, N > & l ) -> decltype( makeVecExpr< T, N >( -l.derived().expression() ) ) {
+			return makeVecExpr< T, N >( -l.derived().expression() );
+		}
+
+		template< class L, class R, class T, unsigned int N >
+		auto operator + ( const T_vec_base< L, T, N > & l, const T_vec_base< R, T, N > & r ) -> decltype( makeVecExpr< T, N >( l.derived().expression() + r.derived().expression() ) ) {
+			return makeVecExpr< T, N >( l.derived().expression() + r.derived().expression() );
+		}
+
+		template< class L, class R, class T, unsigned int N >
+		auto operator - ( const T_vec_base< L, T, N > & l, const T_vec_base< R, T, N > & r ) -> decltype( makeVecExpr< T, N >( l.derived().expression() - r.derived().expression() ) ) {
+			return makeVecExpr< T, N >( l.derived().expression() - r.derived().expression() );
+		}
+
+		template< class L, class T, unsigned int N >		// Left hand T_vec
+		auto operator * ( const T_vec_base< L, T, N > & l, typename T_vec_base< L, T, N >::Scalar value ) -> decltype( makeVecExpr< T, N >( l.derived().expression() * value ) ) {
+			return makeVecExpr< T, N >( l.derived().expression() * value );
+		}
+
+		template< class R, class T, unsigned int N >		// Right hand T_vec
+		auto operator * ( typename T_vec_base< R, T, N >::Scalar value, const T_vec_base< R, T, N > & r ) -> decltype( makeVecExpr< T, N >( r.derived().expression() * value ) ) {
+			return makeVecExpr< T, N >( r.derived().expression() * value );
+		}
+
+		template< class L, class R, class T, unsigned int N >		// Dot Product
+		T operator * ( const T_vec_base< L, T, N > & l, const T_vec_base< R, T, N > & r ) { return l.dot( r ); }
+
+		// Equality
+		template< class L, class R, class T, unsigned int N >
+		bool operator == ( const T_vec_base< L, T, N > & l, const T_vec_base< R, T, N > & r ) { return l.derived().expression() == r.derived().expression(); }
+
+		template< class L, class R, class T, unsigned int N >
+		bool operator != ( const T_vec_base< L, T, N > & l, const T_vec_base< R, T, N > & r ) { return l.derived().expression() != r.derived().expression(); }
+
+
 		// External Vector Operations
-		template< class T, unsigned int N >
-		T dot( const T_vec< T, N > & a, const T_vec< T, N > & b ) { return a.dot( b ); }
+		template< class L, class R, class T, unsigned int N >
+		T dot( const T_vec_base< L, T, N > & a, const T_vec_base< R, T, N > & b ) { return a.dot( b ); }
 
-		template< class T, unsigned int N > T_vec< T, N >
-		cross( const T_vec< T, N > & a, const T_vec< T, N > & b ) { return a.cross( b ); }
+		template< class L, class R, class T, unsigned int N > T_vec< T, N >
+		cross( const T_vec_base< L, T, N > & a, const T_vec_base< R, T, N > & b ) { return a.cross( b ); }
 
-		template< class T, unsigned int N > T_vec< T, N >
-		normalize( const T_vec< T, N > & v ) { return v.normalized(); }
+		template< class D, class T, unsigned int N > T_vec< T, N >
+		normalize( const T_vec_base< D, T, N > & v ) { return v.normalized(); }
 
 		template< class T > T_vec< T, 4 >
 		Quaternion( T angle, const T_vec< T, 3 > & axis ) {
@@ -216,7 +298,122 @@ namespace Rocket {
 
 			return T_vec< T, 3 >( pitch, yaw, roll );
 		}
-		
+
+
+		// Structure-of-arrays container for large numbers of N-element vectors
+		// Each component is stored in its own contiguous (aligned) column, so the batch operations
+		// below are evaluated by Eigen as packed SSE/AVX arithmetic over the whole batch at once.
+		template< class T, unsigned int N > class T_vec_batch {
+			static_assert( N > 1, "Number of elements must be greater than 1" );
+
+		public:
+			typedef Eigen::Array< T, Eigen::Dynamic, N, Eigen::ColMajor > batchType;
+			typedef Eigen::Array< T, Eigen::Dynamic, 1 > scalarBatchType;
+
+			batchType m_elements;
+
+			// Constructors
+			T_vec_batch() {}
+			T_vec_batch( unsigned int size ) { resize( size ); }
+
+			// Constructor that converts from an array-of-T_vec layout (see fromArray())
+			template< unsigned int M >
+			T_vec_batch( const T_vec< T, M > * vectors, unsigned int count ) { fromArray( vectors, count ); }
+
+			void resize( unsigned int size ) { m_elements.resize( size, N ); }
+			unsigned int size() const { return m_elements.rows(); }
+
+			// Access Operators and Functions
+			T * component( unsigned int c ) { return m_elements.col( c ).data(); }
+			const T * component( unsigned int c ) const { return m_elements.col( c ).data(); }
+
+			T_vec< T, N > operator [] ( unsigned int index ) const { return get( index ); }
+			T_vec< T, N > get( unsigned int index ) const { return T_vec< T, N >( Eigen::Matrix< T, N, 1 >( m_elements.row( index ).transpose().matrix() ) ); }
+			void set( unsigned int index, const T_vec< T, N > & v ) { m_elements.row( index ) = v.m_elements.transpose().array(); }
+
+			// Conversion from an array-of-T_vec layout
+			// M may be larger than N, in which case only the first N elements of each vector are used (ie. xyz of a vec4)
+			template< unsigned int M >
+			void fromArray( const T_vec< T, M > * vectors, unsigned int count ) {
+				static_assert( M >= N, "Source vectors must contain at least N elements" );
+				static_assert( sizeof( T_vec< T, M > ) == M * sizeof( T ), "T_vec must be tightly packed" );
+				if ( count == 0 ) {
+					resize( 0 );
+					return;
+				}
+				m_elements = Eigen::Map< const Eigen::Array< T, Eigen::Dynamic, M, Eigen::RowMajor > >( vectors->m_elements.data(), count, M ).template leftCols< N >();
+			}
+
+			// Conversion to an array-of-T_vec layout (vectors must hold size() elements)
+			// M may be smaller than N, in which case each vector receives only the first M elements
+			template< unsigned int M >
+			void toArray( T_vec< T, M > * vectors ) const {
+				static_assert( M <= N, "Destination vectors must not contain more than N elements" );
+				static_assert( sizeof( T_vec< T, M > ) == M * sizeof( T ), "T_vec must be tightly packed" );
+				if ( size() == 0 ) return;
+				Eigen::Map< Eigen::Array< T, Eigen::Dynamic, M, Eigen::RowMajor > >( vectors->m_elements.data(), size(), M ) = m_elements.template leftCols< M >();
+			}
+		};
+
+		// Typedefs
+		typedef T_vec_batch< float, 2 > vec2_batch;
+		typedef T_vec_batch< double, 2 > vec2d_batch;
+
+		typedef T_vec_batch< float, 3 > vec3_batch;
+		typedef T_vec_batch< double, 3 > vec3d_batch;
+
+		typedef T_vec_batch< float, 4 > vec4_batch;
+		typedef T_vec_batch< double, 4 > vec4d_batch;
+
+
+		// Batch Vector Operations
+		// Each operation is applied element-wise over the whole batch; out is resized to match the inputs.
+
+		template< class T, unsigned int N >
+		void add( const T_vec_batch< T, N > & a, const T_vec_batch< T, N > & b, T_vec_batch< T, N > & out ) { out.m_elements = a.m_elements + b.m_elements; }
+
+		template< class T, unsigned int N >
+		void subtract( const T_vec_batch< T, N > & a, const T_vec_batch< T, N > & b, T_vec_batch< T, N > & out ) { out.m_elements = a.m_elements - b.m_elements; }
+
+		template< class T, unsigned int N >
+		void scale( const T_vec_batch< T, N > & a, T value, T_vec_batch< T, N > & out ) { out.m_elements = a.m_elements * value; }
+
+		template< class T, unsigned int N >
+		void lengthSquared( const T_vec_batch< T, N > & v, typename T_vec_batch< T, N >::scalarBatchType & out ) {
+			out = v.m_elements.col( 0 ).square();
+			for ( unsigned int i = 1; i < N; i++ ) out += v.m_elements.col( i ).square();
+		}
+
+		template< class T, unsigned int N >
+		void length( const T_vec_batch< T, N > & v, typename T_vec_batch< T, N >::scalarBatchType & out ) {
+			lengthSquared( v, out );
+			out = out.sqrt();
+		}
+
+		template< class T, unsigned int N >
+		void dot( const T_vec_batch< T, N > & a, const T_vec_batch< T, N > & b, typename T_vec_batch< T, N >::scalarBatchType & out ) {
+			out = a.m_elements.col( 0 ) * b.m_elements.col( 0 );
+			for ( unsigned int i = 1; i < N; i++ ) out += a.m_elements.col( i ) * b.m_elements.col( i );
+		}
+
+		template< class T >
+		void cross( const T_vec_batch< T, 3 > & a, const T_vec_batch< T, 3 > & b, T_vec_batch< T, 3 > & out ) {
+			// out must not alias a or b
+			out.resize( a.size() );
+			out.m_elements.col( 0 ) = a.m_elements.col( 1 ) * b.m_elements.col( 2 ) - a.m_elements.col( 2 ) * b.m_elements.col( 1 );
+			out.m_elements.col( 1 ) = a.m_elements.col( 2 ) * b.m_elements.col( 0 ) - a.m_elements.col( 0 ) * b.m_elements.col( 2 );
+			out.m_elements.col( 2 ) = a.m_elements.col( 0 ) * b.m_elements.col( 1 ) - a.m_elements.col( 1 ) * b.m_elements.col( 0 );
+		}
+
+		// Zero-length vectors are left as zero (out may be v)
+		template< class T, unsigned int N >
+		void normalize( const T_vec_batch< T, N > & v, T_vec_batch< T, N > & out ) {
+			typename T_vec_batch< T, N >::scalarBatchType inverseLength;
+			lengthSquared( v, inverseLength );
+			inverseLength = ( inverseLength > T( 0 ) ).select( inverseLength.rsqrt(), T( 0 ) );
+			out.m_elements = v.m_elements.colwise() * inverseLength;
+		}
+
 	}
 }
 
@@ -21,7 +21,7 @@ namespace Rocket {
 		}
 
 		//! Set an animation for one of this Button's states
-		void Button::setStateAnimation( Button_ButtonState state, string animationName ) {
+		void Button::setStateAnimation( Button_ButtonState state, StringId animationName ) {
 			m_stateAnimations[ (int)state ] = animationName;
 		}
 		//! Remove the animation from the given Button's state
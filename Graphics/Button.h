@@ -31,7 +31,7 @@ namespace Rocket {
 			void bind( Input * input, int button );
 			void unbind( Input * input, int button );
 
-			void setStateAnimation( Button_ButtonState state, string animationName );
+			void setStateAnimation( Button_ButtonState state, StringId animationName );
 			void unsetStateAnimation( Button_ButtonState state );
 
 			virtual void setState( Button_ButtonState state );
@@ -51,7 +51,7 @@ namespace Rocket {
 			Button_ButtonState m_buttonState;
 			bool m_animationChange;
 
-			unordered_map< int, string > m_stateAnimations;
+			unordered_map< int, StringId > m_stateAnimations;
 
 		};
 
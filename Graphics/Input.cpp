@@ -1,6 +1,4 @@
 
-#include <unordered_map>
-
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
@@ -65,15 +63,15 @@ namespace Rocket {
 			Otherwise, the current state is returned normally.
 		*/
 		Input_ButtonState Input::getKey( int key ) {
-			std::unordered_map< int, Input_ButtonState >::iterator iter = m_keyboard.find( key );
+			Core::FlatHashMap< int, Input_ButtonState >::iterator iter = m_keyboard.find( key );
 			if (iter == m_keyboard.end()) {
 				return Input_ButtonState::NotPressed;
 			} else {
 				if ((*iter).second == Input_ButtonState::Hit) {
-					m_keyboard[ key ] = Input_ButtonState::Pressed;
+					(*iter).second = Input_ButtonState::Pressed;
 					return Input_ButtonState::Hit;
 				} else if ((*iter).second == Input_ButtonState::Released) {
-					m_keyboard[ key ] = Input_ButtonState::NotPressed;
+					(*iter).second = Input_ButtonState::NotPressed;
 					return Input_ButtonState::Released;
 				}
 				return (*iter).second;
@@ -82,7 +80,7 @@ namespace Rocket {
 
 		//! Returns true if the key is Hit or Pressed
 		bool Input::getKeySimple( int key ) {
-			std::unordered_map< int, Input_ButtonState >::iterator iter = m_keyboard.find( key );
+			Core::FlatHashMap< int, Input_ButtonState >::iterator iter = m_keyboard.find( key );
 			if (iter == m_keyboard.end()) {
 				return false;
 			} else {
@@ -128,15 +126,15 @@ namespace Rocket {
 			Otherwise, the current state is returned normally.
 		*/
 		Input_ButtonState Input::getMouseButton( int button ) {
-			std::unordered_map< int, Input_ButtonState >::iterator iter = m_mouse.find( button );
+			Core::FlatHashMap< int, Input_ButtonState >::iterator iter = m_mouse.find( button );
 			if (iter == m_mouse.end()) {
 				return Input_ButtonState::NotPressed;
 			} else {
 				if ((*iter).second == Input_ButtonState::Hit) {
-					m_mouse[ button ] = Input_ButtonState::Pressed;
+					(*iter).second = Input_ButtonState::Pressed;
 					return Input_ButtonState::Hit;
 				} else if ((*iter).second == Input_ButtonState::Released) {
-					m_mouse[ button ] = Input_ButtonState::NotPressed;
+					(*iter).second = Input_ButtonState::NotPressed;
 					return Input_ButtonState::Released;
 				}
 				return (*iter).second;
@@ -144,7 +142,7 @@ namespace Rocket {
 		}
 		//! Returns true if the mouse button is Hit or Pressed
 		bool Input::getMouseButtonSimple( int button ) {
-			std::unordered_map< int, Input_ButtonState >::iterator iter = m_mouse.find( button );
+			Core::FlatHashMap< int, Input_ButtonState >::iterator iter = m_mouse.find( button );
 			if (iter == m_mouse.end()) {
 				return false;
 			} else {
@@ -207,7 +205,7 @@ namespace Rocket {
 			}
 
 			// Update mouse bindings for all buttons
-			std::unordered_map< int, Input_ButtonState >::iterator iterButton;
+			Core::FlatHashMap< int, Input_ButtonState >::iterator iterButton;
 			for ( iterButton = Global_Input->m_mouse.begin(); iterButton != Global_Input->m_mouse.end(); iterButton++ ) {
 				std::vector< Input_Mouse* > bindingsToButton = Global_Input->m_mouseBindings[ (*iterButton).first ];
 				for ( auto binding : bindingsToButton ) {
@@ -2,13 +2,13 @@
 #ifndef Rocket_Graphics_Input_H
 #define Rocket_Graphics_Input_H
 
-#include <unordered_map>
 #include <vector>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
 #include "rocket/Core/vector.h"
+#include "rocket/Core/hashmap.h"
 #include "Input_Interactable.h"
 
 namespace Rocket {
@@ -51,11 +51,11 @@ namespace Rocket {
 			static Input * Global_Input;
 			GLFWwindow * m_window;
 			
-			std::unordered_map< int, Input_ButtonState > m_keyboard;
-			std::unordered_map< int, std::vector< Input_Keyboard* > > m_keyboardBindings;
+			Core::FlatHashMap< int, Input_ButtonState > m_keyboard;
+			Core::FlatHashMap< int, std::vector< Input_Keyboard* > > m_keyboardBindings;
 
-			std::unordered_map< int, Input_ButtonState > m_mouse;
-			std::unordered_map< int, std::vector< Input_Mouse* > > m_mouseBindings;
+			Core::FlatHashMap< int, Input_ButtonState > m_mouse;
+			Core::FlatHashMap< int, std::vector< Input_Mouse* > > m_mouseBindings;
 
 			bool m_mouseEnabled;
 			Core::vec2i m_mousePosition;
@@ -4,6 +4,8 @@
 
 #include "rocket/Core/vector.h"
 #include "rocket/Core/debug.h"
+#include "rocket/Core/metrics.h"
+#include "rocket/Core/memory.h"
 #include "Mesh.h"
 #include "Shader.h"
 #include "Universe.h"
@@ -12,6 +14,16 @@
 namespace Rocket {
 	namespace Graphics {
 
+		static Core::Counter & Mesh_DrawCalls = Core::Metrics::counter( "graphics.draw_calls" );
+		static Core::Counter & Mesh_Polygons = Core::Metrics::counter( "graphics.polygons" );
+		static Core::Counter & Mesh_StateChanges = Core::Metrics::counter( "graphics.state_changes" );
+
+		//! Bytes of the CPU copies of a Mesh's vertices, normals and UV coordinates, which it keeps after passing them to the GPU
+		static size_t Mesh_VertexBytes( int vertexCount, const Core::vec3 * normals ) {
+			size_t perVertex = sizeof( Core::vec4 ) + sizeof( Core::vec2 ) + ( ( normals != nullptr ) ? sizeof( Core::vec3 ) : 0 );
+			return perVertex * (size_t)vertexCount;
+		}
+
 		//! Generate the VertexArrayObject and VertexBufferObjects for this Mesh
 		void Mesh::generateBufferObjects() {
 			glGenVertexArrays( 1, &m_vao );
@@ -30,6 +42,7 @@ namespace Rocket {
 			if ( m_uv == nullptr ) {
 				m_uv = new Core::vec2[m_vertexCount];
 			}
+			Core::Memory::recordAllocation( Core::MemoryTag::Graphics, Mesh_VertexBytes( m_vertexCount, m_normals ) );
 
 			generateBufferObjects();
 
@@ -39,6 +52,7 @@ namespace Rocket {
 			m_shader = shader->shared_from_this();
 
 			load_OBJ( OBJ_Wavefront_File );
+			Core::Memory::recordAllocation( Core::MemoryTag::Graphics, Mesh_VertexBytes( m_vertexCount, m_normals ) );
 
 			generateBufferObjects();
 
@@ -56,6 +70,7 @@ namespace Rocket {
 			Core::Debug_Scramble( m_vertices, m_vertexCount );
 			Core::Debug_Scramble( m_normals, m_vertexCount );
 			Core::Debug_Scramble( m_uv, m_vertexCount );
+			Core::Memory::recordFree( Core::MemoryTag::Graphics, Mesh_VertexBytes( m_vertexCount, m_normals ) );
 			delete [] m_vertices;
 			delete [] m_normals;
 			delete [] m_uv;
@@ -81,6 +96,8 @@ namespace Rocket {
 		void Mesh::drawCurrentPass( const Core::mat4 * cameraProjection, const Core::mat4 * cameraOrientation ) {
 			m_shader->useShaderProgram();
 			glBindVertexArray( getVertexArrayObject() );
+			Mesh_StateChanges.add();
+			unsigned int drawCalls = 0;
 
 			// Orientation of the camera
 			*m_shader->getCameraOrientation() = cameraOrientation;
@@ -93,14 +110,17 @@ namespace Rocket {
 				Object * obj = (*objIter).get();
 				if ( obj->isVisible() == true ) {
 					// Orientation of the object
-					*m_shader->getObjectTransform() = &(obj->getFinalOrientation());
+					*m_shader->getObjectTransform() = &(obj->getFinalOrientationMatrix());
 
 					m_shader->passUniformDataToGPU( obj->getShaderUniforms() );
 
 					int vertexCount = getVertexCount();
 					glDrawArrays( GL_TRIANGLES, 0, vertexCount );
+					drawCalls++;
 				}
 			}
+			Mesh_DrawCalls.add( drawCalls );
+			Mesh_Polygons.add( (unsigned long long)( getVertexCount() / 3 ) * drawCalls );
 
 #ifdef ENABLE_DEBUG
 			unsigned int vertexCount = getVertexCount();
@@ -154,8 +174,8 @@ namespace Rocket {
 		}
 
 		//! Add the given Scene to this Mesh's render list
-		std::unordered_map< Scene*, renderPassListType >::iterator Mesh::addSceneToUserList( Scene * scene ) {
-			auto mapIter = m_objectUsers.insert( std::pair< Scene*, renderPassListType >( scene, renderPassListType() ) ).first;
+		sceneUsersListType::iterator Mesh::addSceneToUserList( Scene * scene ) {
+			auto mapIter = m_objectUsers.try_emplace( scene ).first;
 			for ( unsigned int i = 0; i < (unsigned int)MeshDrawPasses::END_OF_DRAW_PASSES; i++ ) {
 				mapIter->second.push_back( objectUsersListType() );
 			}
@@ -2,7 +2,6 @@
 #ifndef Rocket_Graphics_Mesh_H
 #define Rocket_Graphics_Mesh_H
 
-#include <unordered_map>
 #include <map>
 #include <vector>
 #include <memory>
@@ -13,6 +12,8 @@ using namespace std;
 #include <GLFW/glfw3.h>
 
 #include "rocket/Core/vector.h"
+#include "rocket/Core/hashmap.h"
+#include "rocket/Core/memory.h"
 #include "Shader.h"
 #include "rocket/Core/debug.h"
 
@@ -29,11 +30,15 @@ namespace Rocket {
 		
 		class Object;
 		
-		typedef std::vector< shared_ptr< Object > > objectUsersListType;
-		typedef std::vector< objectUsersListType > renderPassListType;
+		// Each Scene's draw lists, accounted to the Scene's memory
+		typedef std::vector< shared_ptr< Object >, Core::TaggedAllocator< shared_ptr< Object >, Core::MemoryTag::Scene > > objectUsersListType;
+		typedef std::vector< objectUsersListType, Core::TaggedAllocator< objectUsersListType, Core::MemoryTag::Scene > > renderPassListType;
 
 		class Scene;
 		class Universe;
+		// Nodes, so that m_currentPassIterator stays valid when another Scene starts using the Mesh
+		typedef Core::NodeHashMap< Scene*, renderPassListType > sceneUsersListType;
+
 		class Mesh : public enable_shared_from_this< Mesh > {
 		public:
 			Mesh( Shader * shader, int numVertices, Core::vec4 * vertices = nullptr, Core::vec3 * normals = nullptr, Core::vec2 * uvCoords = nullptr );
@@ -44,7 +49,7 @@ namespace Rocket {
 			void drawCurrentPass( const Core::mat4 * cameraProjection, const Core::mat4 * cameraOrientation );
 
 			void addMeshUser( Object * object );
-			std::unordered_map< Scene*, renderPassListType >::iterator addSceneToUserList( Scene * scene );
+			sceneUsersListType::iterator addSceneToUserList( Scene * scene );
 			void removeMeshUserFromScene( const Object * meshUser, Scene * scene );
 
 			GLuint getVertexArrayObject();
@@ -64,7 +69,7 @@ namespace Rocket {
 			GLuint m_vao;				// vertex array object
 			GLuint m_vbo[MESH_VBO_NUM];	// vertex buffer object
 
-			std::unordered_map< Scene*, renderPassListType > m_objectUsers;
+			sceneUsersListType m_objectUsers;
 			renderPassListType::iterator m_currentPassIterator;
 
 			void generateBufferObjects();
@@ -8,6 +8,7 @@
 
 #include "Mesh.h"
 #include "rocket/Core/vector.h"
+#include "rocket/Core/allocators.h"
 
 #include "rocket/Core/system.h"
 #ifdef OS_WINDOWS
@@ -33,11 +34,13 @@ namespace Rocket {
 
 		//! Load a .obj file and store the vertex data into this Mesh
 		void Mesh::load_OBJ( const char * file ) {
-			// Storage for raw data.
-			std::vector<Core::vec4> vertices;
-			std::vector<Core::vec3> vertex_normals;
-			std::vector<Core::vec2> tex_coords;
-			std::vector<std::vector<int>> faces;
+			// Storage for raw data, freed with the scope.
+			Core::Arena & arena = Core::scratchArena();
+			Core::ArenaScope scope( arena );
+			std::vector< Core::vec4, Core::ArenaAllocator< Core::vec4 > > vertices( ( Core::ArenaAllocator< Core::vec4 >( arena ) ) );
+			std::vector< Core::vec3, Core::ArenaAllocator< Core::vec3 > > vertex_normals( ( Core::ArenaAllocator< Core::vec3 >( arena ) ) );
+			std::vector< Core::vec2, Core::ArenaAllocator< Core::vec2 > > tex_coords( ( Core::ArenaAllocator< Core::vec2 >( arena ) ) );
+			std::vector< int, Core::ArenaAllocator< int > > faces( ( Core::ArenaAllocator< int >( arena ) ) );		// vertex, texture coordinate and normal index of each point
 
 			// Read lines from file.
 			std::ifstream myfile( file );
@@ -75,11 +78,9 @@ namespace Rocket {
 						// Face
 						for ( unsigned int n = 1; n < curr_line.size(); n++ ) {
 							std::vector<std::string> point = split( curr_line[n], '/' );
-							std::vector<int> p;
-							for ( std::vector<std::string>::iterator it = point.begin(); it != point.end(); it++ ) {
-								p.push_back(atoi(it->c_str()));
-							}
-							faces.push_back(p);
+							faces.push_back( atoi( point.at(0).c_str() ) );
+							faces.push_back( atoi( point.at(1).c_str() ) );
+							faces.push_back( atoi( point.at(2).c_str() ) );
 						}	
 					} else {
 						continue;
@@ -91,37 +92,16 @@ namespace Rocket {
 				std::cerr << "Unable to open file.\n";
 			}
 
-			// Order the raw data into ordered vectors.
-			std::vector<Core::vec4> vertices_ordered;
-			std::vector<Core::vec3> vertex_normals_ordered;
-			std::vector<Core::vec2> tex_coords_ordered;
+			// Copy the data of each face point, in order, to dynamically allocated arrays.
+			m_vertexCount = faces.size() / 3;
+			m_vertices = new Core::vec4[m_vertexCount];
+			m_normals = new Core::vec3[m_vertexCount];
+			m_uv = new Core::vec2[m_vertexCount];
 
-			for ( std::vector<std::vector<int>>::iterator it = faces.begin(); it != faces.end(); it++ ) {
-				vertices_ordered.push_back( vertices[it->at(0) - 1] );
-				tex_coords_ordered.push_back( tex_coords[it->at(1) - 1] );
-				vertex_normals_ordered.push_back( vertex_normals[it->at(2) - 1] );
-			}
-
-			// Copy ordered data to dynamically allocated arrays.
-			m_vertexCount = vertices_ordered.size();
-			m_vertices = new Core::vec4[vertices_ordered.size()];
-			m_normals = new Core::vec3[vertex_normals_ordered.size()];
-			m_uv = new Core::vec2[tex_coords_ordered.size()];
-
-			int vIndex = 0;
-			for ( auto vertex : vertices_ordered ) {
-				m_vertices[vIndex] = vertex;
-				vIndex++;
-			}
-			int vnIndex = 0;
-			for ( auto normal : vertex_normals_ordered ) {
-				m_normals[vnIndex] = normal;
-				vnIndex++;
-			}
-			int uvIndex = 0;
-			for(std::vector<Core::vec2>::iterator it = tex_coords_ordered.begin(); it != tex_coords_ordered.end(); it++) {
-				m_uv[uvIndex] = *it;
-				uvIndex++;
+			for ( int i = 0; i < m_vertexCount; i++ ) {
+				m_vertices[i] = vertices[faces[3*i] - 1];
+				m_uv[i] = tex_coords[faces[3*i + 1] - 1];
+				m_normals[i] = vertex_normals[faces[3*i + 2] - 1];
 			}
 		}
 
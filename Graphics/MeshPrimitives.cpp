@@ -3,6 +3,7 @@
 
 #include "rocket/Core/vector.h"
 #include "rocket/Core/mathconstants.h"
+#include "rocket/Core/allocators.h"
 #include "Mesh.h"
 #include "Shader.h"
 #include "Universe.h"
@@ -10,8 +11,12 @@
 namespace Rocket {
 	namespace Graphics {
 
+		// Vertices and normals of a primitive before they are copied to its Mesh, in the scratch arena
+		typedef std::vector< Core::vec4, Core::ArenaAllocator< Core::vec4 > > MeshPrimitives_Vertices;
+		typedef std::vector< Core::vec3, Core::ArenaAllocator< Core::vec3 > > MeshPrimitives_Normals;
+
 		//! Create a triangle (3 vertices and perpendicular normals for each vertex)
-		void triangle( const Core::vec4 & a, const Core::vec4 & b, const Core::vec4 & c, int * vertexCount, std::vector<Core::vec4> * verticesList, std::vector<Core::vec3> * normalsList ) {
+		void triangle( const Core::vec4 & a, const Core::vec4 & b, const Core::vec4 & c, int * vertexCount, MeshPrimitives_Vertices * verticesList, MeshPrimitives_Normals * normalsList ) {
 			Core::vec3 normal = Core::normalize( Core::cross( (b-a).xyz(), (c-b).xyz() ) );
 
 			normalsList->push_back( normal );	verticesList->push_back( a );
@@ -85,28 +90,26 @@ namespace Rocket {
 				{3,7,6}
 			};
 
-			int * numVertices = new int(0);
-			std::vector<Core::vec4> * verticesList = new std::vector<Core::vec4>;
-			std::vector<Core::vec3> * normalsList = new std::vector<Core::vec3>;
+			Core::ArenaScope scope( Core::scratchArena() );
+			int numverts = 0;
+			MeshPrimitives_Vertices verticesList( ( Core::ArenaAllocator< Core::vec4 >( Core::scratchArena() ) ) );
+			MeshPrimitives_Normals normalsList( ( Core::ArenaAllocator< Core::vec3 >( Core::scratchArena() ) ) );
+			verticesList.reserve( 36 );
+			normalsList.reserve( 36 );
 
 			for (int i = 0; i < 12; i++) {
-				triangle( seedPoints[seedTriangles[i][0]], seedPoints[seedTriangles[i][1]], seedPoints[seedTriangles[i][2]], numVertices, verticesList, normalsList );
+				triangle( seedPoints[seedTriangles[i][0]], seedPoints[seedTriangles[i][1]], seedPoints[seedTriangles[i][2]], &numverts, &verticesList, &normalsList );
 			}
 
 			// Create vertex and normals lists
-			Core::vec4 * vertices = new Core::vec4[*numVertices];
-			Core::vec3 * normals = new Core::vec3[*numVertices];
+			Core::vec4 * vertices = new Core::vec4[numverts];
+			Core::vec3 * normals = new Core::vec3[numverts];
 
-			for (int i = 0; i < *numVertices; i++) {
-				vertices[i] = (*verticesList)[i];
-				normals[i] = (*normalsList)[i];
+			for (int i = 0; i < numverts; i++) {
+				vertices[i] = verticesList[i];
+				normals[i] = normalsList[i];
 			}
 
-			delete verticesList;
-			delete normalsList;
-			int numverts = *numVertices;
-			delete numVertices;
-
 			// todo: add UV coords
 			auto newMesh = make_shared< Mesh >( shader, numverts, vertices, normals, nullptr );
 			world->addMesh( meshName, newMesh.get() );
@@ -127,7 +130,7 @@ namespace Rocket {
 			return t;
 		}
 
-		void divide_triangle( const Core::vec4 & a, const Core::vec4 & b, const Core::vec4 & c, int divisions, int * vertexCount, std::vector<Core::vec4> * verticesList, std::vector<Core::vec3> * normalsList ) {
+		void divide_triangle( const Core::vec4 & a, const Core::vec4 & b, const Core::vec4 & c, int divisions, int * vertexCount, MeshPrimitives_Vertices * verticesList, MeshPrimitives_Normals * normalsList ) {
 			if ( divisions > 0 ) {
 				Core::vec4 v1 = unit( a + b );
 				Core::vec4 v2 = unit( a + c );
@@ -146,9 +149,13 @@ namespace Rocket {
 		Mesh * generatePrimitive_Sphere( Universe * world, const char * meshName, int divisions, Shader * shader ) {
 			if (divisions < 0) divisions = 0;
 
-			int * numVertices = new int(0);
-			std::vector<Core::vec4> * verticesList = new std::vector<Core::vec4>;
-			std::vector<Core::vec3> * normalsList = new std::vector<Core::vec3>;
+			Core::ArenaScope scope( Core::scratchArena() );
+			int numverts = 0;
+			MeshPrimitives_Vertices verticesList( ( Core::ArenaAllocator< Core::vec4 >( Core::scratchArena() ) ) );
+			MeshPrimitives_Normals normalsList( ( Core::ArenaAllocator< Core::vec3 >( Core::scratchArena() ) ) );
+			// Memory given up when a vector grows is only freed with the arena, so reserve the 4 * 4^divisions triangles
+			verticesList.reserve( 12 << ( 2 * divisions ) );
+			normalsList.reserve( 12 << ( 2 * divisions ) );
 
 			// Base tetrahedron points
 			Core::vec4 seedPoints[4] = {
@@ -158,27 +165,22 @@ namespace Rocket {
 				Core::vec4( 0.816497f, -0.471405f, -0.333333f, 1.0f ),
 			};
 
-			divide_triangle(seedPoints[0], seedPoints[1], seedPoints[2], divisions, numVertices, verticesList, normalsList );
-			divide_triangle(seedPoints[3], seedPoints[2], seedPoints[1], divisions, numVertices, verticesList, normalsList );
-			divide_triangle(seedPoints[0], seedPoints[3], seedPoints[1], divisions, numVertices, verticesList, normalsList );
-			divide_triangle(seedPoints[0], seedPoints[2], seedPoints[3], divisions, numVertices, verticesList, normalsList );
+			divide_triangle(seedPoints[0], seedPoints[1], seedPoints[2], divisions, &numverts, &verticesList, &normalsList );
+			divide_triangle(seedPoints[3], seedPoints[2], seedPoints[1], divisions, &numverts, &verticesList, &normalsList );
+			divide_triangle(seedPoints[0], seedPoints[3], seedPoints[1], divisions, &numverts, &verticesList, &normalsList );
+			divide_triangle(seedPoints[0], seedPoints[2], seedPoints[3], divisions, &numverts, &verticesList, &normalsList );
 
 			// Create vertex and normals lists
-			Core::vec4 * vertices = new Core::vec4[*numVertices];
-			Core::vec3 * normals = new Core::vec3[*numVertices];
-			Core::vec2 * uvs = new Core::vec2[*numVertices];
+			Core::vec4 * vertices = new Core::vec4[numverts];
+			Core::vec3 * normals = new Core::vec3[numverts];
+			Core::vec2 * uvs = new Core::vec2[numverts];
 
-			for (int i = 0; i < *numVertices; i++) {
-				vertices[i] = (*verticesList)[i];
-				normals[i] = (*normalsList)[i];
+			for (int i = 0; i < numverts; i++) {
+				vertices[i] = verticesList[i];
+				normals[i] = normalsList[i];
 				uvs[i] = Core::vec2( vertices[i].x(), vertices[i].y() );
 			}
 
-			delete verticesList;
-			delete normalsList;
-			int numverts = *numVertices;
-			delete numVertices;
-
 			auto newMesh = make_shared< Mesh >( shader, numverts, vertices, normals, uvs );
 			world->addMesh( meshName, newMesh.get() );
 			return newMesh.get();
@@ -186,10 +188,9 @@ namespace Rocket {
 
 		//! Generate blended normals based on the center of a sphere
 		void Mesh::generateSphericalNormals( Mesh * mesh ) {
-			for (int i = 0; i < mesh->m_vertexCount; i++) {
-				Core::vec4 normal = normalize( mesh->m_vertices[i] );
-				mesh->m_normals[i] = Core::vec3( normal.x(), normal.y(), normal.z() );
-			}
+			Core::vec4_batch normals( mesh->m_vertices, mesh->m_vertexCount );
+			Core::normalize( normals, normals );
+			normals.toArray( mesh->m_normals );
 		}
 
 	}
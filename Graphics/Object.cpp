@@ -9,6 +9,7 @@
 #include "Transform.h"
 #include "Scene.h"
 #include "rocket/Core/debug.h"
+#include "rocket/Core/allocators.h"
 
 namespace Rocket {
 	namespace Graphics {
@@ -19,7 +20,7 @@ namespace Rocket {
 			} else {
 				m_mesh = mesh->shared_from_this();
 			}
-			m_shaderUniforms = make_shared< ShaderUniforms >();
+			m_shaderUniforms = allocate_shared< ShaderUniforms >( Core::PoolAllocator< ShaderUniforms >() );
 
 			disableTransparency();
 		}
@@ -61,7 +62,7 @@ namespace Rocket {
 		}
 
 		//! Calculate the Object's world matrices before drawing
-		void Object::calculateTransforms( float elapsedMilliseconds, const Core::mat4 & parent_orientation, bool parentCacheIsClean, bool applyUpdates ) {
+		void Object::calculateTransforms( float elapsedMilliseconds, const Core::affine & parent_orientation, bool parentCacheIsClean, bool applyUpdates ) {
 			Transform::calculateTransforms( elapsedMilliseconds, parent_orientation, parentCacheIsClean, applyUpdates );
 		}
 
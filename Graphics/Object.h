@@ -25,7 +25,7 @@ namespace Rocket {
 			shared_ptr< Object > clone();
 			shared_ptr< Object > cloneInScene( Scene * scene, Transform * parent, Core::vec3 scale, Core::vec4 rotation, Core::vec3 position );
 
-			void calculateTransforms( float elapsedMilliseconds, const Core::mat4 & parent_orientation, bool parentCacheIsClean, bool applyUpdates ) override;
+			void calculateTransforms( float elapsedMilliseconds, const Core::affine & parent_orientation, bool parentCacheIsClean, bool applyUpdates ) override;
 
 			Mesh * getMesh();
 
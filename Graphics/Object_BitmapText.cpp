@@ -1,6 +1,7 @@
 
 #include "Object_BitmapText.h"
 #include "Universe.h"
+#include "rocket/Core/allocators.h"
 
 namespace Rocket {
 	namespace Graphics {
@@ -121,7 +122,7 @@ namespace Rocket {
 						quad->Raster::show();
 						quad->setSize( spriteSize );
 					} else {
-						quad = make_shared< Sprite >( m_bitmap.get(), spriteSize.x(), spriteSize.y() );
+						quad = allocate_shared< Sprite >( Core::PoolAllocator< Sprite >(), m_bitmap.get(), spriteSize.x(), spriteSize.y() );
 						this->addChild( quad.get(), true );
 
 						if ( m_transparency == true ) {
@@ -7,6 +7,8 @@
 #include "Object_Newton.h"
 #include "Scene.h"
 #include "rocket/Core/matrix.h"
+#include "rocket/Core/quaternion.h"
+#include "rocket/Core/fixedvector.h"
 
 namespace Rocket {
 	namespace Graphics {
@@ -14,20 +16,20 @@ namespace Rocket {
 		Object_Newton::Object_Newton( Mesh * mesh ) : Object( mesh ) {
 			setMass( 1.0f );
 			setInertia( 1.0f );
-			setVelocity( Core::vec3( 0, 0, 0 ) );
-			setAngularVelocity( Core::vec3( 0, 0, 0 ) );
+			setVelocity( Core::fvec3_32( 0, 0, 0 ) );
+			setAngularVelocity( Core::fvec3_32( 0, 0, 0 ) );
 
-			m_frame_a = Core::vec3( 0, 0, 0 );
-			m_frame_alpha = Core::vec3( 0, 0, 0 );
+			m_frame_a = Core::fvec3_32( 0, 0, 0 );
+			m_frame_alpha = Core::fvec3_32( 0, 0, 0 );
 		}
 		Object_Newton::Object_Newton( const Object & base ) : Object( base ) {
 			setMass( 1.0f );
 			setInertia( 1.0f );
-			setVelocity( Core::vec3( 0, 0, 0 ) );
-			setAngularVelocity( Core::vec3( 0, 0, 0 ) );
+			setVelocity( Core::fvec3_32( 0, 0, 0 ) );
+			setAngularVelocity( Core::fvec3_32( 0, 0, 0 ) );
 
-			m_frame_a = Core::vec3( 0, 0, 0 );
-			m_frame_alpha = Core::vec3( 0, 0, 0 );
+			m_frame_a = Core::fvec3_32( 0, 0, 0 );
+			m_frame_alpha = Core::fvec3_32( 0, 0, 0 );
 		}
 
 		Object_Newton::~Object_Newton() {
@@ -48,19 +50,37 @@ namespace Rocket {
 
 		//! Sets this Object_Newton's velocity relative to its parent's space
 		void Object_Newton::setVelocity( const Core::vec3 & v ) {
+			setVelocity( Core::fvec3_32( v ) );
+		}
+		void Object_Newton::setVelocity( const Core::fvec3_32 & v ) {
 			m_v = v;
 		}
+		const Core::fvec3_32 & Object_Newton::getVelocity() const {
+			return m_v;
+		}
 		//! Sets this Object_Newton's local angular velocity
 		void Object_Newton::setAngularVelocity( const Core::vec3 & rv ) {
+			setAngularVelocity( Core::fvec3_32( rv ) );
+		}
+		void Object_Newton::setAngularVelocity( const Core::fvec3_32 & rv ) {
 			m_omega = rv;
 		}
+		const Core::fvec3_32 & Object_Newton::getAngularVelocity() const {
+			return m_omega;
+		}
 
 		//! Applies acceleration relative to this Object_Newton's parent's space
 		void Object_Newton::applyAcceleration( const Core::vec3 & a ) {
+			applyAcceleration( Core::fvec3_32( a ) );
+		}
+		void Object_Newton::applyAcceleration( const Core::fvec3_32 & a ) {
 			m_frame_a += a;
 		}
 		//! Applies local angular acceleration
 		void Object_Newton::applyAngularAcceleration( const Core::vec3 & ra ) {
+			applyAngularAcceleration( Core::fvec3_32( ra ) );
+		}
+		void Object_Newton::applyAngularAcceleration( const Core::fvec3_32 & ra ) {
 			m_frame_alpha += ra;
 		}
 		//! Applies the given force relative to this Object_Newton's parent's space
@@ -78,18 +98,20 @@ namespace Rocket {
 
 		//! Updates this Object_Newton's rendering state
 		void Object_Newton::update( bool recursive, float elapsedMilliseconds ) {
-			// todo: update velocity with acceleration (based on elapsed time)
-			m_v += m_frame_a * elapsedMilliseconds;
-			m_omega += m_frame_alpha * elapsedMilliseconds;
+			// Integrate in fixed-point; only the result handed to the Transform is converted to float
+			Core::fixed32_32 dt( elapsedMilliseconds );
+			m_v += m_frame_a * dt;
+			m_omega += m_frame_alpha * dt;
 
-			move( m_v );
-			rotate( Core::MatrixToQuaternion( Core::Rotate( m_omega.z(), Core::vec3(0,0,1) ) * Core::Rotate( m_omega.y(), Core::vec3(0,1,0) ) * Core::Rotate( m_omega.x(), Core::vec3(1,0,0) ) ) );
+			move( m_v.toFloat() );
+			Core::fquat_32 spin = Core::fquat_32( m_omega.z(), Core::fvec3_32(0,0,1) ) * Core::fquat_32( m_omega.y(), Core::fvec3_32(0,1,0) ) * Core::fquat_32( m_omega.x(), Core::fvec3_32(1,0,0) );
+			rotate( spin.toFloat() );
 
 			Object::update( recursive, elapsedMilliseconds );
 
 			// reset acceleration data
-			m_frame_a = Core::vec3( 0, 0, 0 );
-			m_frame_alpha = Core::vec3( 0, 0, 0 );
+			m_frame_a = Core::fvec3_32( 0, 0, 0 );
+			m_frame_alpha = Core::fvec3_32( 0, 0, 0 );
 		}
 
 		shared_ptr< Object_Newton > Object_Newton::cloneNewton() {
@@ -3,6 +3,7 @@
 #define Rocket_Graphics_Object_Newton_H
 
 #include "rocket/Core/matrix.h"
+#include "rocket/Core/fixedvector.h"
 #include "Mesh.h"
 #include "Transform.h"
 #include "Object.h"
@@ -23,12 +24,20 @@ namespace Rocket {
 			void setInertia( float I );
 			float getInertia();
 
+			// Motion state is kept in fixed32_32 so that it evolves identically on every machine and resolves accelerations
+			// as small as float inputs usually carry (the float overloads round to the nearest fixed-point value)
 			void setVelocity( const Core::vec3 & v );
+			void setVelocity( const Core::fvec3_32 & v );
+			const Core::fvec3_32 & getVelocity() const;
 			void setAngularVelocity( const Core::vec3 & rv );
+			void setAngularVelocity( const Core::fvec3_32 & rv );
+			const Core::fvec3_32 & getAngularVelocity() const;
 
 			// Acceleration is applied for elapsedMilliseconds of time when update() is called
 			void applyAcceleration( const Core::vec3 & a );
+			void applyAcceleration( const Core::fvec3_32 & a );
 			void applyAngularAcceleration( const Core::vec3 & ra );
+			void applyAngularAcceleration( const Core::fvec3_32 & ra );
 			void applyForce( const Core::vec3 & F );
 			void applyTorque( const Core::vec3 & T );
 			void applyTorque( const Core::vec3 & r, const Core::vec3 & F );
@@ -42,12 +51,12 @@ namespace Rocket {
 			float m_mass;
 			float m_inertia;
 
-			Core::vec3 m_v;		// velocity
-			Core::vec3 m_omega;	// angular velocity
+			Core::fvec3_32 m_v;		// velocity
+			Core::fvec3_32 m_omega;	// angular velocity
 
 			// m_frame_* members are reinitialized every frame
-			Core::vec3 m_frame_a;		// acceleration
-			Core::vec3 m_frame_alpha;	// angular acceleration
+			Core::fvec3_32 m_frame_a;		// acceleration
+			Core::fvec3_32 m_frame_alpha;	// angular acceleration
 
 		};
 
@@ -12,13 +12,14 @@
 #include "Object.h"
 
 #include "rocket/Core/debug.h"
+#include "rocket/Core/profiler.h"
 
 namespace Rocket {
 	namespace Graphics {
 
 		void Scene::Init() {
 			m_camera_position = Core::vec3(0,0,0);
-			m_camera_rotation = Core::Quaternion( 0.0f, Core::vec3(0,1,0) );
+			m_camera_rotation = Core::quat();
 			m_cache_camera_orientationIsClean = false;
 			m_cache_camera_orientationInverseIsClean = false;
 
@@ -109,6 +110,7 @@ namespace Rocket {
 
 		//! Renders all Objects in this Scene, interpolating movement using elapsedMilliseconds since the last call to draw()
 		void Scene::draw( float elapsedMilliseconds, bool clearScreen ) {
+			Rocket_Profile_Zone( "Scene::draw" );
 			glBindFramebuffer( GL_FRAMEBUFFER, m_frameBufferObject );
 			if ( m_glDepthTest == true ) {
 				glEnable( GL_DEPTH_TEST );
@@ -125,7 +127,7 @@ namespace Rocket {
 
 			// Calculate transforms and update all nodes
 			for ( auto child : m_children ) {
-				child->calculateTransforms( elapsedMilliseconds, Core::mat4(), false, true );
+				child->calculateTransforms( elapsedMilliseconds, Core::affine(), false, true );
 			}
 
 			// Prepare meshes for drawing passes
@@ -206,12 +208,13 @@ namespace Rocket {
 
 		//! Calculates the camera's new position given a new orientation matrix
 		void Scene::calculateNewPosition( Core::mat4 orientation ) {
-			Core::vec4 pos = orientation.inverse() * Core::vec4( -orientation(0,3), -orientation(1,3), -orientation(2,3), 0.0f );
-			m_camera_position = pos.xyz();
+			// The orientation is a rotation (possibly scaled) and a translation, so its inverse needs no general 4x4 inverse
+			Core::affine orientationInverse = Core::affine( orientation ).inverseScaled();
+			m_camera_position = orientationInverse.transformVector( Core::vec3( -orientation(0,3), -orientation(1,3), -orientation(2,3) ) );
 		}
 		//! Calculates the camera's new rotation given a new orientation matrix
 		void Scene::calculateNewRotation( Core::mat4 orientation ) {
-			m_camera_rotation = Core::MatrixToQuaternion( orientation );
+			m_camera_rotation = Core::quat( orientation ).normalized();
 		}
 
 		//! Returns the camera's current orientation matrix
@@ -227,7 +230,7 @@ namespace Rocket {
 		const Core::mat4 & Scene::getCameraOrientationInverse() {
 			if ( m_cache_camera_orientationInverseIsClean == false ) {
 				m_cache_camera_orientationInverseIsClean = true;
-				m_cache_camera_orientationInverse = m_cache_camera_orientation.inverse();
+				m_cache_camera_orientationInverse = Core::affine( m_cache_camera_orientation ).inverseScaled().toMatrix();
 			}
 			return m_cache_camera_orientationInverse;
 		}
@@ -241,9 +244,12 @@ namespace Rocket {
 
 		//! Rotates the camera by the given angle around the specified axis
 		void Scene::Camera_Rotate( float angle, Core::vec3 axis ) {
-			Core::mat4 cameraOrientation = getCameraOrientation();
-			setCameraOrientation( Core::Rotate( angle, axis ) * cameraOrientation );
-			calculateNewRotation( m_cache_camera_orientation );
+			// Rotating the orientation matrix rotates both its rotation and its translation
+			Core::quat rotation( angle, axis );
+			const Core::mat4 & cameraOrientation = getCameraOrientation();
+			Core::vec3 translation = rotation * Core::vec3( cameraOrientation(0,3), cameraOrientation(1,3), cameraOrientation(2,3) );
+			m_camera_rotation = ( rotation * m_camera_rotation ).normalized();
+			setCameraOrientation( Core::Translate( translation ) * Core::QuaternionRotate( m_camera_rotation ) );
 		}
 		//! Moves the camera forward by distance
 		void Scene::Camera_Move( float distance ) {
@@ -279,6 +285,7 @@ namespace Rocket {
 		void Scene::Camera_Orient( Core::mat4 orientation ) {
 			setCameraOrientation( orientation );
 			calculateNewPosition( m_cache_camera_orientation );
+			calculateNewRotation( m_cache_camera_orientation );
 		}
 
 		//! Sets the camera's position
@@ -291,9 +298,13 @@ namespace Rocket {
 		}
 
 		//! Sets the camera's rotation using a quaternion
+		void Scene::Camera_SetRotation( Core::quat quaternion ) {
+			m_camera_rotation = quaternion.normalized();
+			setCameraOrientation( Translate( getCameraPosition() ) * Core::QuaternionRotate( m_camera_rotation ) );
+		}
+		//! Sets the camera's rotation using a quaternion stored as a vec4
 		void Scene::Camera_SetRotation( Core::vec4 quaternion ) {
-			setCameraOrientation( Translate( getCameraPosition() ) * Core::QuaternionRotate( quaternion ) );
-			calculateNewRotation( m_cache_camera_orientation );
+			Camera_SetRotation( Core::quat( quaternion ) );
 		}
 
 		//! Sets the camera's controls to be bound to the specified Input
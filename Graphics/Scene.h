@@ -74,6 +74,7 @@ namespace Rocket {
 
 			void Camera_Orient( Core::mat4 orientation );
 			void Camera_Position( Core::vec3 position );
+			void Camera_SetRotation( Core::quat quaternion );
 			void Camera_SetRotation( Core::vec4 quaternion );
 
 			void setCameraInput( Input * input );
@@ -123,7 +124,7 @@ namespace Rocket {
 			// Camera Data
 			Core::vec3 m_camera_position;
 			void calculateNewPosition( Core::mat4 orientation );	// sets m_camera_position and updates m_cache_camera_orientation
-			Core::vec4 m_camera_rotation;							// Quaterion
+			Core::quat m_camera_rotation;
 			void calculateNewRotation( Core::mat4 orientation );	// sets m_camera_rotation and updates m_cache_camera_orientation
 
 			bool m_cache_camera_orientationIsClean;
@@ -10,6 +10,8 @@
 #include "Universe.h"
 #include "Shader.h"
 #include "rocket/Core/matrix.h"
+#include "rocket/Core/metrics.h"
+#include "rocket/Core/allocators.h"
 #include "Texture.h"
 
 namespace Rocket {
@@ -17,6 +19,8 @@ namespace Rocket {
 
 		unsigned int Shader::Global_InUseShaderProgram = 0;
 
+		static Core::Counter & Shader_StateChanges = Core::Metrics::counter( "graphics.state_changes" );
+
 		/*! Create a Shader_UniformTexture using a Texture as a uniform in the specified texture slot with the given properties
 			wrapS - GL wrap value for the S-Axis
 			wrapT - GL wrap value for the T-Axis
@@ -81,7 +85,7 @@ namespace Rocket {
 
 		//! Returns a copy of this ShaderUniforms
 		shared_ptr< ShaderUniforms > ShaderUniforms::clone() {
-			auto r = make_shared< ShaderUniforms >();
+			auto r = allocate_shared< ShaderUniforms >( Core::PoolAllocator< ShaderUniforms >() );
 			return r;
 		}
 
@@ -239,6 +243,7 @@ namespace Rocket {
 			if ( Global_InUseShaderProgram != m_shaderNumber ) {
 				Global_InUseShaderProgram = m_shaderNumber;
 				glUseProgram( Global_InUseShaderProgram );
+				Shader_StateChanges.add();
 				refreshUniformLocationCache();
 			}
 		}
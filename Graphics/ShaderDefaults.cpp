@@ -1,12 +1,16 @@
 
 #include "ShaderDefaults.h"
 #include "rocket/Core/debug.h"
+#include "rocket/Core/metrics.h"
+#include "rocket/Core/allocators.h"
 
 namespace Rocket {
 	namespace Graphics {
 
 		namespace ShaderDefaults {
 
+			static Core::Counter & ShaderDefaults_StateChanges = Core::Metrics::counter( "graphics.state_changes" );
+
 			ShaderUniforms_Texture::ShaderUniforms_Texture() {
 			}
 			ShaderUniforms_Texture::~ShaderUniforms_Texture() {
@@ -14,7 +18,7 @@ namespace Rocket {
 
 			//! Returns a copy of this ShaderUniforms_Texture (but not the texture itself)
 			shared_ptr< ShaderUniforms > ShaderUniforms_Texture::clone() {
-				auto r = make_shared< ShaderUniforms_Texture >();
+				auto r = allocate_shared< ShaderUniforms_Texture >( Core::PoolAllocator< ShaderUniforms_Texture >() );
 
 				r->m_texture = m_texture;
 				r->m_textureScale = m_textureScale;
@@ -71,6 +75,7 @@ namespace Rocket {
 					// Active texture (GL_TEXTURE0, etc...)
 					glActiveTexture( GL_TEXTURE0 + m_texture->m_textureSlot );
 					glBindTexture( GL_TEXTURE_2D, m_texture->m_texture->getID() );
+					ShaderDefaults_StateChanges.add();
 					// Texture properties
 					glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_texture->m_wrapS );
 					glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_texture->m_wrapT );
@@ -101,7 +106,7 @@ namespace Rocket {
 												vec3 objectRGBColor,
 												bool transparencyEnabled, float alphaTest, float alphaTransparency )
 			{
-				auto uniforms = make_shared< ShaderUniforms_Texture >();
+				auto uniforms = allocate_shared< ShaderUniforms_Texture >( Core::PoolAllocator< ShaderUniforms_Texture >() );
 				uniforms->m_texture = textureData;
 				uniforms->m_textureScale = textureScale;
 				uniforms->m_textureOffset = textureOffset;
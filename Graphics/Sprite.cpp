@@ -119,11 +119,11 @@ namespace Rocket {
 		- animationName - The name used to retrieve this animation for playing.  The animation name is only unique to this Sprite.
 		- frames - List of coordinates of each animation frame in this order: { left, top, right, bottom }
 		*/
-		void Sprite::addAnimation( string animationName, vector< vec4i > frames ) {
+		void Sprite::addAnimation( StringId animationName, vector< vec4i > frames ) {
 			m_frames[ animationName ] = frames;
 		}
 		//! Play the specified animation for the given length of time
-		void Sprite::playAnimation( string animationName, float timeMilliseconds, bool repeat, int startFrame ) {
+		void Sprite::playAnimation( StringId animationName, float timeMilliseconds, bool repeat, int startFrame ) {
 			auto frames = m_frames.find( animationName );
 			if ( frames != m_frames.end() ) {
 				m_animationPlaying = true;
@@ -14,6 +14,7 @@ using namespace std;
 #include "Shader.h"
 #include "Scene.h"
 #include "rocket/Core/vector.h"
+#include "rocket/Core/stringid.h"
 
 using namespace Rocket::Core;
 
@@ -37,8 +38,8 @@ namespace Rocket {
 			void setUV( float left, float top, float right, float bottom );
 			Core::vec4i getUV();
 
-			void addAnimation( string animationName, vector< vec4i > frames );
-			void playAnimation( string animationName, float timeMilliseconds, bool repeat = true, int startFrame = 0 );
+			void addAnimation( StringId animationName, vector< vec4i > frames );
+			void playAnimation( StringId animationName, float timeMilliseconds, bool repeat = true, int startFrame = 0 );
 			void pauseAnimation();
 			int currentFrame();
 
@@ -49,7 +50,7 @@ namespace Rocket {
 			static int g_SpriteCount;
 			
 			shared_ptr< Texture > m_texture;
-			unordered_map< string, vector< vec4i > > m_frames;
+			unordered_map< StringId, vector< vec4i > > m_frames;
 
 			bool m_animationPlaying;
 			vector< vec4i > m_animationFrames;
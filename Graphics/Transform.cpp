@@ -6,6 +6,7 @@
 #include "Scene.h"
 #include "rocket/Core/matrix.h"
 #include "rocket/Core/debug.h"
+#include "rocket/Core/profiler.h"
 #include <sstream>
 
 namespace Rocket {
@@ -18,7 +19,7 @@ namespace Rocket {
 
 			scale( Core::vec3(1,1,1) );
 			position( Core::vec3(0,0,0) );
-			m_rotation = Core::Quaternion( 0.0f, Core::vec3(0,1,0) );
+			m_rotation = Core::quat();
 
 			m_hidden = false;
 			m_updated = false;
@@ -72,7 +73,7 @@ namespace Rocket {
 		bool Transform::cleanParentOrientationCache() {
 			if ( m_parent == nullptr ) {
 				if ( m_cache_descendantOrientationIsClean == false ) {
-					calculateTransforms( 0.0f, Core::mat4(), false, false );
+					calculateTransforms( 0.0f, Core::affine(), false, false );
 					return false;
 				}
 				return true;
@@ -87,23 +88,26 @@ namespace Rocket {
 			}
 		}
 		//! Returns the concatenation of all of this Transform's ancestors' matrices
-		const Core::mat4 & Transform::getParentOrientation() {
+		const Core::affine & Transform::getParentOrientation() {
 			cleanParentOrientationCache();
 			return m_cache_parentOrientation;
 		}
 
 		//! Rotate this Transform using a quaternion (local rotation)
-		void Transform::rotate( const Core::vec4 & quaternion ) {
-			m_rotation = Core::MatrixToQuaternion( QuaternionRotate( quaternion ) * Core::QuaternionRotate( m_rotation ) );
+		void Transform::rotate( const Core::quat & quaternion ) {
+			m_rotation = ( quaternion * m_rotation ).normalized();
 			setOrientationCacheAsDirty();
 		}
+		//! Rotate this Transform using a quaternion stored as a vec4 (local rotation)
+		void Transform::rotate( const Core::vec4 & quaternion ) {
+			rotate( Core::quat( quaternion ) );
+		}
 		//! Rotate this Transform by the specified angle around the given axis (local rotation)
 		void Transform::rotate( float angle, Core::vec3 axisOfRotation ) {
 			if ( (axisOfRotation.x() == 0.0f) && (axisOfRotation.y() == 0.0f) && (axisOfRotation.z() == 0.0f) ) {
 				axisOfRotation.y( 1.0f );
 			}
-			m_rotation = Core::MatrixToQuaternion( Rotate( angle, axisOfRotation ) * Core::QuaternionRotate( m_rotation ) );
-			setOrientationCacheAsDirty();
+			rotate( Core::quat( angle, axisOfRotation ) );
 		}
 		//! Pitch-rotate (X-Axis) this Transform by the given angle (local rotation)
 		void Transform::rotatePitch( float pitch ) {
@@ -122,14 +126,14 @@ namespace Rocket {
 			return QuaternionToEuler( m_rotation );
 		}
 		//! Returns this Transform's local rotation as a quaternion
-		const Core::vec4 & Transform::rotation_quaternion() {
+		const Core::quat & Transform::rotation_quaternion() {
 			return m_rotation;
 		}
 
 		//! Returns this Transform's orientation matrix
-		const Core::mat4 & Transform::orientation() {
+		const Core::affine & Transform::orientation() {
 			if ( m_cache_orientationIsClean == false ) {
-				m_cache_orientation = Translate( m_position ) * QuaternionRotate( m_rotation ) * Scale( m_scale );
+				m_cache_orientation = Core::affine( m_position, m_rotation, m_scale );
 				m_cache_orientationIsClean = true;
 			}
 			return m_cache_orientation;
@@ -137,8 +141,7 @@ namespace Rocket {
 
 		//! Move this Transform forward by the given distance
 		void Transform::move( float distance ) {
-			Core::vec4 pos = QuaternionRotate( m_rotation ) * Core::vec4( 0.0f, 0.0f, distance, 0.0f );
-			position( pos.xyz() + position() );
+			position( m_rotation * Core::vec3( 0.0f, 0.0f, distance ) + position() );
 		}
 
 		//! Move this Transform by the given vector
@@ -176,12 +179,14 @@ namespace Rocket {
 		}
 
 		//! Calculate and cache this Transforms matrices
-		void Transform::calculateTransforms( float elapsedMilliseconds, const Core::mat4 & parent_orientation, bool parentCacheIsClean, bool applyUpdates ) {
+		void Transform::calculateTransforms( float elapsedMilliseconds, const Core::affine & parent_orientation, bool parentCacheIsClean, bool applyUpdates ) {
+			Rocket_Profile_Zone( "Transform::calculateTransforms" );
 			// don't save parent matrix if the cache is clean!
 			bool nextParentCacheIsClean = true;
 			if ( parentCacheIsClean == false ) {
 				m_cache_parentOrientation = parent_orientation;
 				m_cache_finalOrientationIsClean = false;
+				m_cache_finalOrientationMatrixIsClean = false;
 			}
 
 			if ( applyUpdates == true ) {
@@ -207,16 +212,25 @@ namespace Rocket {
 			m_cache_orientationIsClean = false;
 			m_cache_descendantOrientationIsClean = false;
 			m_cache_finalOrientationIsClean = false;
+			m_cache_finalOrientationMatrixIsClean = false;
 		}
 
 		//! Return this Transform's orientation concatenated with all ancestors' matrices
-		const Core::mat4 & Transform::getFinalOrientation() {
+		const Core::affine & Transform::getFinalOrientation() {
 			if ( m_cache_finalOrientationIsClean == false ) {
 				m_cache_finalOrientation = m_cache_parentOrientation * orientation();
 				m_cache_finalOrientationIsClean = true;
 			}
 			return m_cache_finalOrientation;
 		}
+		//! Return this Transform's final orientation as a 4x4 matrix (only needed when uploading to the GPU)
+		const Core::mat4 & Transform::getFinalOrientationMatrix() {
+			if ( m_cache_finalOrientationMatrixIsClean == false ) {
+				m_cache_finalOrientationMatrix = getFinalOrientation().toMatrix();
+				m_cache_finalOrientationMatrixIsClean = true;
+			}
+			return m_cache_finalOrientationMatrix;
+		}
 
 		// Z-Indexing Functions
 		//! Adds this Transform to a zIndexer at the given location
@@ -10,6 +10,8 @@
 using namespace std;
 
 #include "rocket/Core/matrix.h"
+#include "rocket/Core/quaternion.h"
+#include "rocket/Core/affine.h"
 
 namespace Rocket {
 	namespace Graphics {
@@ -31,18 +33,20 @@ namespace Rocket {
 			void position( const Core::vec3 & offset );
 			const Core::vec3 & position();
 
-			const Core::mat4 & getParentOrientation();
-			const Core::mat4 & getFinalOrientation();
+			const Core::affine & getParentOrientation();
+			const Core::affine & getFinalOrientation();
+			const Core::mat4 & getFinalOrientationMatrix();		// getFinalOrientation() expanded to 4x4 for uploading to the GPU
 
+			void rotate( const Core::quat & quaternion );
 			void rotate( const Core::vec4 & quaternion );
 			void rotate( float angle, Core::vec3 axisOfRotation );
 			void rotatePitch( float pitch );
 			void rotateYaw( float yaw );
 			void rotateRoll( float roll );
-			const Core::vec4 & rotation_quaternion();
+			const Core::quat & rotation_quaternion();
 			Core::vec3 rotation_euler();		// todo: doesn't work (see vector.h)
 
-			const Core::mat4 & orientation();	// scale + position + rotation
+			const Core::affine & orientation();	// scale + position + rotation
 
 			void move( float distance );
 			void move( const Core::vec3 & v );
@@ -53,7 +57,7 @@ namespace Rocket {
 
 			virtual void update( bool recursive, float elapsedMilliseconds );
 
-			virtual void calculateTransforms( float elapsedMilliseconds, const Core::mat4 & parent_orientation, bool parentCacheIsClean, bool applyUpdates );
+			virtual void calculateTransforms( float elapsedMilliseconds, const Core::affine & parent_orientation, bool parentCacheIsClean, bool applyUpdates );
 
 			// Optional z-indexing functions
 			void zIndexer_Add( zIndexerType * zIndexer, int zIndexTag );
@@ -74,21 +78,24 @@ namespace Rocket {
 			vector< shared_ptr< Transform > > m_children;
 
 			bool m_cache_orientationIsClean;		// true if this Transform's own orientation cache is up-to-date
-			Core::mat4 m_cache_orientation;
+			Core::affine m_cache_orientation;
 
 			bool m_cache_descendantOrientationIsClean;		// true if this Tranform's children have up-to-date parent orientation
-			Core::mat4 m_cache_parentOrientation;		// cache for the concatenation of orientation matrices of all parent nodes
+			Core::affine m_cache_parentOrientation;		// cache for the concatenation of orientation matrices of all parent nodes
 			bool cleanParentOrientationCache();			// recalculates m_cache_descendantOrientation if needed. returns false if an update was required
 
 			bool m_cache_finalOrientationIsClean;
-			Core::mat4 m_cache_finalOrientation;		// m_cache_descendantOrientation * orientation()
+			Core::affine m_cache_finalOrientation;		// m_cache_descendantOrientation * orientation()
+
+			bool m_cache_finalOrientationMatrixIsClean;
+			Core::mat4 m_cache_finalOrientationMatrix;		// m_cache_finalOrientation.toMatrix()
 
 			void setOrientationCacheAsDirty();
-			//const Core::mat4 & getFinalOrientation();
+			//const Core::affine & getFinalOrientation();
 
 			Core::vec3 m_scale;
 			Core::vec3 m_position;
-			Core::vec4 m_rotation;		// quaternion
+			Core::quat m_rotation;
 
 			// Optional z-indexing members
 			zIndexerType * m_zIndexer;						// The zIndexer that this Transform belongs to (optional; nullptr if it does not belong to any)
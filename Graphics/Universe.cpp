@@ -1,6 +1,5 @@
 
 #include <vector>
-#include <unordered_map>
 #include <string>
 
 #include <GL/glew.h>
@@ -10,6 +9,7 @@
 #include "Scene.h"
 #include "Texture.h"
 #include "Shader.h"
+#include "rocket/Core/profiler.h"
 
 namespace Rocket {
 	namespace Graphics {
@@ -31,10 +31,10 @@ namespace Rocket {
 
 		//! Load and compile a shader program file
 		void Universe::addShader( const char * shaderName, Shader * shader ) {
-			m_shaders[ shaderName ] = shader->shared_from_this();
+			m_shaders[ Core::StringId::intern( shaderName ) ] = shader->shared_from_this();
 		}
 		//! Get an existing shader program
-		shared_ptr< Shader > Universe::getShader( const char * shaderName ) {
+		shared_ptr< Shader > Universe::getShader( Core::StringId shaderName ) {
 			auto iter = m_shaders.find( shaderName );
 			if (iter == m_shaders.end()) {
 				return nullptr;
@@ -45,10 +45,11 @@ namespace Rocket {
 
 		//! Load a Mesh into memory. If a Mesh with the same name already exists, return a pointer to that Mesh.
 		shared_ptr< Mesh > Universe::loadMesh( const char * meshName, const char * file, Shader * shader ) {
-			auto iter = m_meshes.find( meshName );
+			Core::StringId id = Core::StringId::intern( meshName );
+			auto iter = m_meshes.find( id );
 			if (iter == m_meshes.end()) {
 				auto mesh = make_shared< Mesh >( file, shader );
-				m_meshes[ meshName ] = mesh;
+				m_meshes[ id ] = mesh;
 				return mesh;
 			} else {
 				return (*iter).second;
@@ -56,15 +57,16 @@ namespace Rocket {
 		}
 		//! Add a Mesh if it doesn't already exist
 		void Universe::addMesh( const char * meshName, Mesh * mesh ) {
-			auto iter = m_meshes.find( meshName );
+			Core::StringId id = Core::StringId::intern( meshName );
+			auto iter = m_meshes.find( id );
 			if (iter == m_meshes.end()) {
-				m_meshes[ meshName ] = mesh->shared_from_this();
+				m_meshes[ id ] = mesh->shared_from_this();
 			} else {
 				Debug_ThrowError( "Warning/Error: Mesh already added to universe!", 0 );
 			}
 		}
 		//! Retrieve an already loaded Mesh
-		shared_ptr< Mesh > Universe::getMesh( const char * meshName ) {
+		shared_ptr< Mesh > Universe::getMesh( Core::StringId meshName ) {
 			auto iter = m_meshes.find( meshName );
 			if (iter == m_meshes.end()) {
 				return nullptr;
@@ -75,17 +77,18 @@ namespace Rocket {
 
 		//! Load a Texture into memory.  If the Texture already exists in memory, return a pointer to that Texture.
 		shared_ptr< Texture > Universe::loadTexture( const char * textureName, const char * file, bool mipmap, bool invertY ) {
-			auto iter = m_textures.find( textureName );
+			Core::StringId id = Core::StringId::intern( textureName );
+			auto iter = m_textures.find( id );
 			if (iter == m_textures.end()) {
 				auto texture = make_shared< Texture >( file, mipmap, invertY );
-				m_textures[ textureName ] = texture;
+				m_textures[ id ] = texture;
 				return texture;
 			} else {
 				return (*iter).second;
 			}
 		}
 		//! Retrieve an already loaded Texture
-		shared_ptr< Texture > Universe::getTexture( const char * textureName ) {
+		shared_ptr< Texture > Universe::getTexture( Core::StringId textureName ) {
 			auto iter = m_textures.find( textureName );
 			if (iter == m_textures.end()) {
 				return shared_ptr< Texture >();
@@ -96,6 +99,7 @@ namespace Rocket {
 
 		//! Render everything in this Universe given the number of milliseconds since the last draw
 		void Universe::display( float elapsedMilliseconds ) {
+			Rocket_Profile_Zone( "Universe::display" );
 			glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 
 			bool clearScreen = true;
@@ -3,7 +3,6 @@
 #define Rocket_Graphics_Universe_H
 
 #include <vector>
-#include <unordered_map>
 #include <string>
 #include <memory>
 
@@ -17,6 +16,8 @@ using namespace std;
 #include "Texture.h"
 #include "Shader.h"
 #include "rocket/Core/vector.h"
+#include "rocket/Core/stringid.h"
+#include "rocket/Core/hashmap.h"
 
 namespace Rocket {
 	namespace Graphics {
@@ -41,15 +42,16 @@ namespace Rocket {
 
 			void addRenderPass( Scene * renderPass );
 
+			// Assets are registered by name (which is interned), and looked up by StringId, so that lookups of literal names do not hash strings
 			void addShader( const char * shaderName, Shader * shader );
-			shared_ptr< Shader > getShader( const char * shaderName );
+			shared_ptr< Shader > getShader( Core::StringId shaderName );
 
 			shared_ptr< Mesh > loadMesh( const char * meshName, const char * file, Shader * shader );
 			void addMesh( const char * meshName, Mesh * mesh );
-			shared_ptr< Mesh > getMesh( const char * meshName );
+			shared_ptr< Mesh > getMesh( Core::StringId meshName );
 
 			shared_ptr< Texture > loadTexture( const char * textureName, const char * file, bool mipmap, bool invertY );
-			shared_ptr< Texture > getTexture( const char * textureName );
+			shared_ptr< Texture > getTexture( Core::StringId textureName );
 
 			void display( float elapsedMilliseconds );
 			// elapsedMilliseconds since the last call to display(). This value is used to correctly sync interpolating within all render passes.
@@ -62,9 +64,9 @@ namespace Rocket {
 		private:
 			vector< shared_ptr< Scene > > m_renderPasses;
 
-			unordered_map< string, shared_ptr< Shader > > m_shaders;
-			unordered_map< string, shared_ptr< Mesh > > m_meshes;
-			unordered_map< string, shared_ptr< Texture > > m_textures;
+			Core::FlatHashMap< Core::StringId, shared_ptr< Shader > > m_shaders;
+			Core::FlatHashMap< Core::StringId, shared_ptr< Mesh > > m_meshes;
+			Core::FlatHashMap< Core::StringId, shared_ptr< Texture > > m_textures;
 		};
 
 	}
@@ -3,6 +3,9 @@
 #define _CRT_SECURE_NO_DEPRECATE
 
 #include "rocket/Core/timer.h"
+#include "rocket/Core/profiler.h"
+#include "rocket/Core/memory.h"
+#include "rocket/Core/framescheduler.h"
 
 #include <stdlib.h>
 
@@ -209,20 +212,30 @@ Rocket_UnitTest ( all_Graphics ) {
 	mainScene->setCameraMoveSpeed( vec3( Camera_Move_Speed, Camera_Move_Speed, Camera_Move_Speed ) );
 	mainScene->setCameraTurnSpeed( vec3( Camera_Turn_Speed, Camera_Turn_Speed, Camera_Turn_Speed ) );
 
-	unsigned long tick_timer = Core::timer();
+	// Camera controls and animation run in fixed steps of 1/120 s; frames are paced to 60 per second
+	Core::FrameScheduler scheduler( 120.0, 60.0 );
+	// Heap usage of each subsystem, every 10 s
+	Core::Memory::setDumpInterval( 10000000000ull );
+	// Time of each profiled zone, shown below the frame rate
+	Core::Profiler::useTimeStampCounter();
+	Core::Profiler::setEnabled( true );
 	int running = 1;
 	while( running ) {
 		//Core::Debug_StartTimer( "MAIN" );
-		unsigned long elapsed = Core::elapsedtime( tick_timer );
-		tick_timer = Core::timer();
-		if ( elapsed == 0 ) elapsed = 1;
+		unsigned int steps = scheduler.beginFrame();
+		float elapsed = steps * scheduler.stepMilliseconds();
+		Core::FrameStats frameStats = scheduler.stats();
 
 		rstring debug;
 		debug << "FPS: ";
-		debug << (int)(1000.0 / (elapsed*1.0));
+		// No frame has been measured yet on the first one
+		debug << ( ( frameStats.mean > 0 ) ? (int)( 1000000000.0 / frameStats.mean + 0.5 ) : 0 );
 		debug << "\n";
+		debug << "Frame jitter (us): " << (int)( frameStats.jitter / 1000 ) << "\n";
 
-		mainScene->ControlCamera( (float)elapsed );
+		for ( unsigned int step = 0; step < steps; step++ ) {
+			mainScene->ControlCamera( scheduler.stepMilliseconds() );
+		}
 
 		// orbit glass panes around blue cube
 		vec3 orbitForce = Rocket::Core::normalize( testCube->position() - testObject->position() );
@@ -254,8 +267,13 @@ Rocket_UnitTest ( all_Graphics ) {
 		//Core::Debug_StopTimer( "MAIN" );
 
 		// OpenGL rendering goes here...
-		world->display( (float)elapsed );
+		world->display( elapsed );
+		Core::Profiler::endFrame();
+		Core::Memory::update();
 
+		for ( auto & zone : Core::Profiler::frameStats() ) {
+			debug << zone.name << " (us): " << (int)( zone.totalNanoseconds / 1000 ) << "\n";
+		}
 		debug << "Polys(tris): " << world->m_cache_renderedPolygons << "\n";
 		debug << "Objects: ";
 		debug << world->m_cache_renderedObjects;
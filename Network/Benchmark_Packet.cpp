@@ -0,0 +1,50 @@
+#include "rocket/Benchmark.h"
+
+#include "Packet.h"
+
+using namespace Rocket::Network;
+
+static const unsigned int BenchmarkPacket_Count = 1000;
+
+// Build a Test packet, as sent every update, counted in packets
+Rocket_Benchmark( Packet_Build ) {
+	m_items = BenchmarkPacket_Count;
+	for ( unsigned int i = 0; i < BenchmarkPacket_Count; i++ ) {
+		Packet * packet = new Packet( PacketTypes::Test );
+		packet->add( "player" );
+		packet->add( fvec3( 1.5, -2.25, 100.0 ) );
+		packet->add( (int)i );
+		char * data;
+		unsigned int size;
+		packet->out( data, size );
+		Rocket::Test::doNotOptimize( data[ size - 1 ] );
+		delete packet;
+	}
+}
+
+// Read back the elements of a received Test packet, counted in packets
+Rocket_Benchmark( Packet_Parse ) {
+	m_items = BenchmarkPacket_Count;
+	static char received[ 256 ];
+	static unsigned int receivedSize = 0;
+	if ( receivedSize == 0 ) {
+		Packet packet( PacketTypes::Test );
+		packet.add( "player" );
+		packet.add( fvec3( 1.5, -2.25, 100.0 ) );
+		packet.add( 7 );
+		char * data;
+		packet.out( data, receivedSize );
+		memcpy( received, data, receivedSize );
+	}
+
+	for ( unsigned int i = 0; i < BenchmarkPacket_Count; i++ ) {
+		Packet * packet = new Packet( received, receivedSize );
+		rstring name = packet->getString();
+		fvec3 position = packet->getfvec3();
+		int value = packet->getInt();
+		Rocket::Test::doNotOptimize( name );
+		Rocket::Test::doNotOptimize( position );
+		Rocket::Test::doNotOptimize( value );
+		delete packet;
+	}
+}
@@ -2,6 +2,8 @@
 #include <string>
 
 #include "../Core/debug.h"
+#include "../Core/profiler.h"
+#include "../Core/metrics.h"
 #include "Network.h"
 
 #include <fcntl.h>
@@ -12,6 +14,13 @@ using namespace Rocket::Core;
 namespace Rocket {
 	namespace Network {
 
+		// Traffic of every Network, and packets waiting in their PacketAccumulators after the last update()
+		static Counter & Network_BytesSent = Metrics::counter( "network.bytes_sent" );
+		static Counter & Network_BytesReceived = Metrics::counter( "network.bytes_received" );
+		static Counter & Network_PacketsSent = Metrics::counter( "network.packets_sent" );
+		static Gauge & Network_InboundQueue = Metrics::gauge( "network.inbound_queue" );
+		static Gauge & Network_OutboundQueue = Metrics::gauge( "network.outbound_queue" );
+
 		// Setup a minimal network
 		Network::Network( int networkSettings, unsigned int updateTimeout ) {
 #ifdef OS_WINDOWS
@@ -32,7 +41,7 @@ namespace Rocket {
 		// Cleanup unneeded network information
 		Network::~Network() {
 			// Close all open TCP connections
-			std::unordered_map< SOCKET*, PacketAccumulator* >::iterator iter;
+			TCPConnections::iterator iter;
 			for ( iter = m_TCP_connections.begin(); iter != m_TCP_connections.end(); ) {
 				SOCKET * s = (*iter).first;
 				iter++;
@@ -142,8 +151,9 @@ namespace Rocket {
 			//Debug_AddToLog( IP.c_str() );
 
 			Rocket::Network::PacketAccumulator * conn = new PacketAccumulator( ConnectionTypes::Connection_UDP, IP, port );
-			rstring IPandPort = (IP << ":" << port);
-			m_UDP_connections[ IPandPort.std_str() ] = conn;
+			Rocket::Core::StringBuilder IPandPort;
+			IPandPort << IP << ":" << port;
+			m_UDP_connections[ std::string( IPandPort.c_str(), IPandPort.length() ) ] = conn;
 			return conn;
 		}
 
@@ -187,6 +197,7 @@ namespace Rocket {
 		// send all packets in the queue of the PacketAccumulators
 		// If this network is a server and a new TCP connection is accepted, update() will return a PacketAccumulator for that connection; otherwise, update() returns nullptr
 		PacketAccumulator * Network::update() {
+			Rocket_Profile_Zone( "Network::update" );
 			PacketAccumulator * newConnection = nullptr;
 
 			// Receive all data
@@ -207,7 +218,7 @@ namespace Rocket {
 				}
 
 				// Receive everything on all TCP sockets
-				std::unordered_map< SOCKET*, PacketAccumulator* >::iterator iter;
+				TCPConnections::iterator iter;
 				for ( iter = m_TCP_connections.begin(); iter != m_TCP_connections.end(); ) {
 					SOCKET * s = (*iter).first;
 					iter++;
@@ -259,9 +270,22 @@ namespace Rocket {
 				Debug_ThrowError( "Error: select() failed", err_s.std_str() );
 			}
 
+			// Queue depths before sending
+			size_t inbound = 0, outbound = 0;
+			for ( auto & connection : m_UDP_connections ) {
+				inbound += connection.second->m_packets_inbound.size();
+				outbound += connection.second->m_packets_outbound.size();
+			}
+			for ( auto & connection : m_TCP_connections ) {
+				inbound += connection.second->m_packets_inbound.size();
+				outbound += connection.second->m_packets_outbound.size();
+			}
+			Network_InboundQueue.set( (long long)inbound );
+			Network_OutboundQueue.set( (long long)outbound );
+
 			// Send all packets
 			// Send on the UDP socket
-			std::unordered_map< std::string, PacketAccumulator* >::iterator iter_UDP;
+			UDPConnections::iterator iter_UDP;
 			for ( iter_UDP = m_UDP_connections.begin(); iter_UDP != m_UDP_connections.end(); iter_UDP++ ) {
 				Packet * p = nullptr;
 				char * data;
@@ -270,12 +294,14 @@ namespace Rocket {
 					sockaddr_in destination = iter_UDP->second->getDestination();
 					p->out( data, size );
 					sendto( m_UDP_socket, data, size, 0, (struct sockaddr*)&destination, sizeof(sockaddr_in) );
+					Network_BytesSent.add( size );
+					Network_PacketsSent.add();
 					delete p;
 				}
 			}
 
 			// Send everything on all TCP sockets
-			std::unordered_map< SOCKET*, PacketAccumulator* >::iterator iter_TCP;
+			TCPConnections::iterator iter_TCP;
 			for ( iter_TCP = m_TCP_connections.begin(); iter_TCP != m_TCP_connections.end(); iter_TCP++ ) {
 				Packet * p = nullptr;
 				char * data;
@@ -283,6 +309,8 @@ namespace Rocket {
 				while ( ( p = iter_TCP->second->toSocket() ) != nullptr ) {
 					p->out( data, size );
 					send( *(iter_TCP->first), data, size, 0 );
+					Network_BytesSent.add( size );
+					Network_PacketsSent.add();
 					delete p;
 				}
 			}
@@ -301,6 +329,7 @@ namespace Rocket {
 			// Receive data on this socket
 			addrlen = sizeof( sockaddr );
 			r = recvfrom( m_UDP_socket, buffer, NETWORK_PACKET_BUFFER_SIZE, 0, (sockaddr*)&addr, &addrlen );
+			if ( r > 0 ) Network_BytesReceived.add( r );
 			if ( addr.ss_family == AF_INET ) {
 				inet_ntop( addr.ss_family, &(((struct sockaddr_in *)&addr)->sin_addr), ipstr, INET6_ADDRSTRLEN );
 			} else {
@@ -308,14 +337,14 @@ namespace Rocket {
 			}
 
 			// Append port to ip to make search string
-			rstring fromip = ipstr;
-			if ( fromip == "" ) fromip = "127.0.0.1";
+			Rocket::Core::StringBuilder fromip;
+			fromip << ( ( ipstr[0] == 0 ) ? "127.0.0.1" : ipstr ) << ":";
 			if ( addr.ss_family == AF_INET ) {
-				fromip = fromip << ":" << ntohs( ((struct sockaddr_in *)&addr)->sin_port );
+				fromip << ntohs( ((struct sockaddr_in *)&addr)->sin_port );
 			} else {
-				fromip = fromip << ":" << ntohs( ((struct sockaddr_in6 *)&addr)->sin6_port );
+				fromip << ntohs( ((struct sockaddr_in6 *)&addr)->sin6_port );
 			}
-			std::unordered_map< std::string, PacketAccumulator* >::iterator from = m_UDP_connections.find( fromip.std_str() );
+			UDPConnections::iterator from = m_UDP_connections.find( fromip );
 			if ( from != m_UDP_connections.end() ) {
 				// Add buffer to PacketAccumulator
 				from->second->fromSocket( buffer, r );
@@ -332,8 +361,9 @@ namespace Rocket {
 			r = recv( *s, buffer, NETWORK_PACKET_BUFFER_SIZE, 0 );
 
 			if ( r > 0 ) {
+				Network_BytesReceived.add( r );
 				// Pass data to PacketAccumulator
-				std::unordered_map< SOCKET*, PacketAccumulator* >::iterator iter = m_TCP_connections.find( s );
+				TCPConnections::iterator iter = m_TCP_connections.find( s );
 				if ( iter != m_TCP_connections.end() ) {
 					iter->second->fromSocket( buffer, r );
 				} else {
@@ -351,7 +381,7 @@ namespace Rocket {
 		}
 
 		void Network::close_TCP( SOCKET * socket ) {
-			std::unordered_map< SOCKET*, PacketAccumulator* >::iterator iter = m_TCP_connections.find( socket );
+			TCPConnections::iterator iter = m_TCP_connections.find( socket );
 			if ( iter != m_TCP_connections.end() ) {
 				closeSocket( iter->first );
 				delete iter->first;
@@ -429,7 +459,7 @@ namespace Rocket {
 			// Check all connections and FD_SET them
 			if ( m_settings & (int)NetworkSettings::TCP_Enabled ) {
 				// Add TCP client connections
-				std::unordered_map< SOCKET*, PacketAccumulator* >::iterator iter;
+				TCPConnections::iterator iter;
 				for ( iter = m_TCP_connections.begin(); iter != m_TCP_connections.end(); iter++ ) {
 					int fd = *((*iter).first);
 					FD_SET( fd, &ReadFDs );
@@ -2,13 +2,13 @@
 #ifndef Rocket_Network_Network_H
 #define Rocket_Network_Network_H
 
-#include <unordered_map>
 #include <string>
 #include <deque>
 #include <string.h>
 
 #include "rocket/Core/system.h"
 #include "rocket/Core/rstring.h"
+#include "rocket/Core/hashmap.h"
 
 #ifdef OS_WINDOWS
 #include <winsock2.h>
@@ -81,16 +81,20 @@ namespace Rocket {
 			static unsigned int findOpenPort( unsigned int startingPort, unsigned int numberOfTries );
 
 		private:
+			typedef Core::FlatHashMap< std::string, PacketAccumulator*, Core::StringHash, Core::StringEqual > UDPConnections;
+			typedef Core::FlatHashMap< SOCKET*, PacketAccumulator* > TCPConnections;
+
 			int m_settings;
 
 			unsigned int m_UDP_port;
 			SOCKET m_UDP_socket;
 			// the std::string is the IP and port of a connection with this format: 'IP.IP.IP.IP:PORT'
-			std::unordered_map< std::string, PacketAccumulator* > m_UDP_connections;
+			// (searched for with the address of each received datagram, without copying it into a std::string)
+			UDPConnections m_UDP_connections;
 
 			unsigned int m_TCP_listenPort;
 			SOCKET m_TCP_listenSocket;
-			std::unordered_map< SOCKET*, PacketAccumulator* > m_TCP_connections;
+			TCPConnections m_TCP_connections;
 
 			void receive_UDP( SOCKET * s );
 			void receive_TCP( SOCKET * s );
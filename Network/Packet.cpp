@@ -1,10 +1,30 @@
 
+#include <algorithm>
+
 #include "../Core/debug.h"
+#include "../Core/allocators.h"
+#include "../Core/memory.h"
 #include "Packet.h"
 
 namespace Rocket {
 	namespace Network {
 
+		// Data buffers of up to PoolBufferSize bytes share one pool, whatever their size, so a packet can grow within it for free
+		// (the pool's chunks count towards Core's memory, and larger buffers towards Network's)
+		static char * Packet_AllocateBuffer( unsigned int size ) {
+			if ( size <= Packet::PoolBufferSize ) return (char*)SharedPool< Packet::PoolBufferSize, 1 >::allocate();
+			return Core::Memory::newArray< char >( Core::MemoryTag::Network, size );
+		}
+
+		static void Packet_FreeBuffer( char * data, unsigned int size ) {
+			if ( data == nullptr ) return;
+			if ( size <= Packet::PoolBufferSize ) {
+				SharedPool< Packet::PoolBufferSize, 1 >::deallocate( data );
+			} else {
+				Core::Memory::deleteArray( Core::MemoryTag::Network, data, size );
+			}
+		}
+
 		// --------------------------------------------------------------------------------------------------------------------
 		// Packet Constructors/Destructors
 		// --------------------------------------------------------------------------------------------------------------------
@@ -68,7 +88,15 @@ namespace Rocket {
 		}
 
 		Packet::~Packet() {
-			delete [] m_data;
+			Packet_FreeBuffer( m_data, m_maxsize );
+		}
+
+		void * Packet::operator new( size_t size ) {
+			return SharedPool< sizeof( Packet ), alignof( Packet ) >::allocate();
+		}
+
+		void Packet::operator delete( void * p ) {
+			SharedPool< sizeof( Packet ), alignof( Packet ) >::deallocate( p );
 		}
 
 
@@ -82,27 +110,32 @@ namespace Rocket {
 
 		void Packet::setPacketSize( unsigned int size ) {
 			if ( size > 0 ) {
-				m_maxsize = size;
-				char * olddata = m_data;
-				m_data = new char[ size ];
-
 				if ( m_size > size ) m_size = size;
+				// A pooled buffer already holds any size up to PoolBufferSize
+				if ( m_data != nullptr && m_maxsize <= PoolBufferSize && size <= PoolBufferSize ) {
+					m_maxsize = size;
+					return;
+				}
+
+				char * olddata = m_data;
+				m_data = Packet_AllocateBuffer( size );
 				if ( olddata != nullptr ) {
 					memcpy( m_data, olddata, m_size );
-					delete [] olddata;
+					Packet_FreeBuffer( olddata, m_maxsize );
 				}
+				m_maxsize = size;
 			}
 		}
 
 		
 		
 		// add( c, size ) appends the array of bytes to the end of this packet
-		// If the packet's memory allocation isn't large enough, more space is allocated to fit the new data
+		// If the packet's memory allocation isn't large enough, it is at least doubled to fit the new data
 		// (Tip: For increased efficiency, call setPacketSize() prior to adding packet elements
 		void Packet::add( char * c, unsigned int size ) {
 			// append c to m_data
 			if ( size > 0 ) {
-				if ( m_size + size > m_maxsize ) setPacketSize( m_size + size );
+				if ( m_size + size > m_maxsize ) setPacketSize( std::max( m_size + size, 2 * m_maxsize ) );
 				memcpy( &(m_data[ m_size ]), c, size );
 				m_size += size;
 			}
@@ -141,15 +174,20 @@ namespace Rocket {
 			if ( nextElementMatches( type ) ) {
 				if ( m_explicitPacketElements == true ) add( (char*)(&type), 1 );
 				
-				fswap cf;
-				cf.f = f.toValue();
-				int nbo_i = htonl( cf.i );
-				add( (char*)(&nbo_i), PACKET_INT_SIZE );
+				// high word first, each in network byte order
+				int64_t raw = f.value().m_value;
+				unsigned int nbo_words[2] = { htonl( (unsigned int)( uint64_t( raw ) >> 32 ) ), htonl( (unsigned int)( uint64_t( raw ) & 0xffffffff ) ) };
+				add( (char*)(nbo_words), PACKET_FIXEDPOINT_SIZE );
 
 				( m_nestedElements == 0 ) ? m_current_element++ : m_nestedElements--;
 			}
 		}
 
+		// fvec3 is widened to fixedpoint without loss, so the vector is received bit-exact
+		void Packet::add( const fvec3 & v ) {
+			for ( unsigned int i = 0; i < 3; i++ ) add( fixedpoint( fixedpoint::valueType( v[i] ) ) );
+		}
+
 		void Packet::add( rstring s ) {
 			PacketElementTypes type = PacketElementTypes::char_string;
 			if ( nextElementMatches( type ) ) {
@@ -215,20 +253,24 @@ namespace Rocket {
 		fixedpoint Packet::getfixedpoint() {
 			char type = 0;
 			if ( ( m_explicitPacketElements == false ) || (nextElementMatches( (PacketElementTypes)(type = getByte()) )) ) {
-				fswap cf;
-				int nbo_i;
-				memcpy( &nbo_i, &(m_data[m_seek]), PACKET_INT_SIZE );
-				cf.i =  ntohl( nbo_i );
-				FixedPoint_OutputType f = cf.f;
+				unsigned int nbo_words[2];
+				memcpy( nbo_words, &(m_data[m_seek]), PACKET_FIXEDPOINT_SIZE );
+				int64_t raw = int64_t( ( uint64_t( ntohl( nbo_words[0] ) ) << 32 ) | ntohl( nbo_words[1] ) );
 
-				m_seek += PACKET_INT_SIZE;
+				m_seek += PACKET_FIXEDPOINT_SIZE;
 				( m_nestedElements == 0 ) ? m_current_element++ : m_nestedElements--;
-				return f;
+				return fixedpoint( fixedpoint::valueType::fromRaw( raw ) );
 			} else {
 				return 0;
 			}
 		}
 
+		fvec3 Packet::getfvec3() {
+			fvec3 v;
+			for ( unsigned int i = 0; i < 3; i++ ) v[i] = fixed16_16( getfixedpoint().value() );
+			return v;
+		}
+
 		rstring Packet::getString() {
 			char type = 0;
 			if ( ( m_explicitPacketElements == false ) || (nextElementMatches( (PacketElementTypes)(type = getByte()) )) ) {
@@ -237,13 +279,13 @@ namespace Rocket {
 				nestedElement( s_length = getUInt() );
 
 				// get string data
-				char * c = new char[ s_length + 1 ];
+				ArenaScope scope( scratchArena() );
+				char * c = scratchArena().allocate< char >( s_length + 1 );
 				memcpy( c, &(m_data[m_seek]), s_length );
 				c[ s_length ] = '\0';
 
 				m_seek += s_length;
 				rstring r = c;
-				delete [] c;
 
 				( m_nestedElements == 0 ) ? m_current_element++ : m_nestedElements--;
 				return r;
@@ -5,6 +5,7 @@
 #include "rocket/Core/system.h"
 #include "rocket/Core/rstring.h"
 #include "rocket/Core/fixedpoint.h"
+#include "rocket/Core/fixedvector.h"
 
 #ifdef OS_WINDOWS
 #include <WinSock2.h>
@@ -16,21 +17,16 @@
 #endif
 
 #define PACKET_INT_SIZE 4
+#define PACKET_FIXEDPOINT_SIZE 8
 
 using namespace Rocket::Core;
 
 namespace Rocket {
 	namespace Network {
 
-		// fswap is used to attain byte access to a float
-		union fswap {
-			float f;
-			int i;
-		};
-
 		// Base types denote how the data is stored:
 			// char - readable ascii characters
-			// raw - data type is its exact byte representation
+			// raw - data type is its exact byte representation (raw_fixedpoint is the 64-bit fixed-point value, so it is bit-exact)
 			// comp - compressed data type
 		// empty is NOT to be used as a packet element type and is there
 		// only for processing purposes
@@ -70,6 +66,8 @@ namespace Rocket {
 		// --------------------------------------------------------------------------------------------------------------------
 		class Packet {
 		public:
+			static const unsigned int PoolBufferSize = 256;
+
 			void init();
 			// Create a new packet; it's type must be set (the type will be added to the packet automatically)
 			Packet( PacketTypes type, bool explicitPacketElements = false );
@@ -80,8 +78,12 @@ namespace Rocket {
 			// denote that element's type.
 			~Packet();
 
+			// Packets are short-lived, so they come from a pool rather than the heap
+			static void * operator new( size_t size );
+			static void operator delete( void * p );
+
 			unsigned int getPacketSize();
-			// The the maximum memory allocated for this packet.  Newly allocated space appended to the end of the packet is not zeroed out.
+			// The the maximum memory allocated for this packet (buffers of up to PoolBufferSize bytes come from a pool).  Newly allocated space appended to the end of the packet is not zeroed out.
 			// If the maximum is less that what is currently written, the data will be truncated.  
 			void setPacketSize( unsigned int size );
 
@@ -92,6 +94,7 @@ namespace Rocket {
 			void add( int i );
 			void add( unsigned int u );
 			void add( fixedpoint f );			// idea: add bool flag for optional compression
+			void add( const fvec3 & v );		// three raw_fixedpoint elements
 			void add( rstring s );
 
 
@@ -101,6 +104,7 @@ namespace Rocket {
 			int getInt();
 			unsigned int getUInt();
 			fixedpoint getfixedpoint();
+			fvec3 getfvec3();
 			rstring getString();
 
 
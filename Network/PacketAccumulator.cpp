@@ -1,15 +1,19 @@
 
 #include "Network.h"
+#include "../Core/metrics.h"
+#include "../Core/memory.h"
 
 namespace Rocket {
 	namespace Network {
 
+		static Core::Counter & Network_PacketsReceived = Core::Metrics::counter( "network.packets_received" );
+
 		PacketAccumulator::PacketAccumulator( ConnectionTypes protocol, rstring IP, unsigned int port ) {
 			m_protocol = protocol;
 			m_destination_IP = IP;
 			m_destination_port = port;
 
-			m_packets_buffer = new char[ NETWORK_BUFFER_SIZE ];
+			m_packets_buffer = Core::Memory::newArray< char >( Core::MemoryTag::Network, NETWORK_BUFFER_SIZE );
 			m_packets_buffer_index = 0;
 		}
 
@@ -20,7 +24,7 @@ namespace Rocket {
 			for ( auto outboundPacket : m_packets_outbound ) {
 				delete outboundPacket;
 			}
-			delete [] m_packets_buffer;
+			Core::Memory::deleteArray( Core::MemoryTag::Network, m_packets_buffer, NETWORK_BUFFER_SIZE );
 		}
 
 		// Queue a packet for sending
@@ -70,6 +74,7 @@ namespace Rocket {
 				// create new Packet and queue it up for reading
 				Packet * newPacket = new Packet( m_packets_buffer, packet_size );
 				m_packets_inbound.push_back( newPacket );
+				Network_PacketsReceived.add();
 
 				shiftBuffer( packet_size );
 			}
@@ -1,6 +1,8 @@
 
 #include "rocket/UnitTest.h"
 
+#include <string>
+
 #include "Packet.h"
 
 Rocket_UnitTest ( Packet_Simple ) {
@@ -22,4 +24,65 @@ Rocket_UnitTest ( Packet_Simple ) {
 	Rocket_UnitTest_Check_FloatEqual( p2->getfixedpoint().toValue(), 99.9f, 0.001f );
 	Rocket_UnitTest_Check_FloatEqual( p2->getfixedpoint().toValue(), -1337.0f, 0.001f );
 	Rocket_UnitTest_Check_Equal( p2->getInt(), -1 );
-}
\ No newline at end of file
+}
+
+Rocket_UnitTest ( Packet_FixedPointExact ) {
+	// Fixed-point elements are sent as their raw value, so they arrive bit-exact
+	Rocket::Core::fvec3 position( 1.0 / 3.0, -12345.678, Rocket::Core::fixed16_16::epsilon() );
+	Rocket::Network::Packet * p1 = new Rocket::Network::Packet( Rocket::Network::PacketTypes::Test );
+	p1->add( "Position" );
+	p1->add( position );
+	p1->add( 7 );
+
+	char * data;
+	unsigned int size;
+	p1->out( data, size );
+
+	Rocket::Network::Packet * p2 = new Rocket::Network::Packet( data, size );
+	Rocket_UnitTest_Check_CharStringEqual( p2->getString().c_str(), "Position" );
+	Rocket_UnitTest_Check_Expression( p2->getfvec3() == position );
+	Rocket_UnitTest_Check_Equal( p2->getInt(), 7 );
+
+	Rocket::Core::fixedpoint f( Rocket::Core::fixed32_32::fromRaw( -0x123456789abcdefLL ) );
+	Rocket::Network::Packet * p3 = new Rocket::Network::Packet( Rocket::Network::PacketTypes::Test );
+	p3->add( "Raw" );
+	p3->add( f );
+	p3->add( -f );
+	p3->add( Rocket::Core::fixedpoint( Rocket::Core::fixed32_32::epsilon() ) );
+	p3->add( 0 );
+	p3->out( data, size );
+
+	Rocket::Network::Packet * p4 = new Rocket::Network::Packet( data, size );
+	Rocket_UnitTest_Check_CharStringEqual( p4->getString().c_str(), "Raw" );
+	Rocket_UnitTest_Check_Expression( p4->getfixedpoint().value() == f.value() );
+	Rocket_UnitTest_Check_Expression( p4->getfixedpoint().value() == -f.value() );
+	Rocket_UnitTest_Check_Expression( p4->getfixedpoint().value() == Rocket::Core::fixed32_32::epsilon() );
+}
+Rocket_UnitTest ( Packet_Growth ) {
+	// A packet outgrows its pooled buffer, and shrinks back into one
+	std::string text( 1000, 'x' );
+	text[ 999 ] = 'y';
+	Rocket::Network::Packet * p1 = new Rocket::Network::Packet( Rocket::Network::PacketTypes::Test );
+	p1->add( text.c_str() );
+	p1->add( (Rocket::Core::fixedpoint)1.0f );
+	p1->add( (Rocket::Core::fixedpoint)2.0f );
+	p1->add( (Rocket::Core::fixedpoint)3.0f );
+	p1->add( 5 );
+
+	char * data;
+	unsigned int size;
+	p1->out( data, size );
+	Rocket_UnitTest_Check_Equal( size, 4u + 1u + 4u + 1000u + 3u * PACKET_FIXEDPOINT_SIZE + 4u );
+
+	Rocket::Network::Packet * p2 = new Rocket::Network::Packet( data, size );
+	Rocket_UnitTest_Check_CharStringEqual( p2->getString().c_str(), text.c_str() );
+	Rocket_UnitTest_Check_FloatEqual( p2->getfixedpoint().toValue(), 1.0f, 0.001f );
+	p2->getfixedpoint();
+	p2->getfixedpoint();
+	Rocket_UnitTest_Check_Equal( p2->getInt(), 5 );
+
+	p2->setPacketSize( 5 );
+	Rocket_UnitTest_Check_Equal( p2->getPacketSize(), 5u );
+	delete p1;
+	delete p2;
+}
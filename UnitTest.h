@@ -32,6 +32,10 @@ namespace Rocket {
 		void UnitTests_runAll();
 		void UnitTests_cleanup();
 
+		// Number of heap allocations (operator new) made by the calling thread so far
+		// Defined in UnitTest_allocations.cpp, which only unit test targets link; always 0 unless built with ROCKET_TRACK_ALLOCATIONS
+		unsigned long long UnitTests_allocationCount();
+
 	}
 }
 
@@ -78,6 +82,18 @@ do { \
 	} \
 } while (0)
 
+// Check that a statement does not allocate on the heap (the statement may contain commas)
+#define Rocket_UnitTest_Check_NoAllocations( ... ) \
+do { \
+	unsigned long long allocationsBefore = Rocket::Test::UnitTests_allocationCount(); \
+	__VA_ARGS__; \
+	unsigned long long allocations = Rocket::Test::UnitTests_allocationCount() - allocationsBefore; \
+	if ( allocations != 0 ) { \
+		std::cerr << __FILE__ << "(" << __LINE__ << ") \n\t[Check_NoAllocations] : " << #__VA_ARGS__ << " made " << allocations << " heap allocation(s).\n"; \
+		m_result = Rocket::Test::Test_Fail; return; \
+	} \
+} while (0)
+
 // Compare Char String Equality
 #define Rocket_UnitTest_Check_CharStringEqual( str1, str2 ) \
 do { \
@@ -0,0 +1,48 @@
+#include <new>
+#include <stdlib.h>
+
+#include "UnitTest.h"
+
+// Linked into unit test targets only (see add_test), so that the replacement allocation functions below never ship in the
+// library or the application
+
+namespace Rocket {
+	namespace Test {
+
+#ifdef ROCKET_TRACK_ALLOCATIONS
+		static thread_local unsigned long long allocationCount = 0;
+
+		unsigned long long UnitTests_allocationCount() {
+			return allocationCount;
+		}
+
+		static void * trackedAllocate( std::size_t size ) {
+			allocationCount++;
+			void * p = malloc( size == 0 ? 1 : size );
+			if ( p == nullptr ) throw std::bad_alloc();
+			return p;
+		}
+#else
+		unsigned long long UnitTests_allocationCount() {
+			return 0;
+		}
+#endif
+
+	}
+}
+
+#ifdef ROCKET_TRACK_ALLOCATIONS
+// Replacement global allocation functions that count allocations per thread (see Rocket_UnitTest_Check_NoAllocations)
+void * operator new ( std::size_t size ) { return Rocket::Test::trackedAllocate( size ); }
+void * operator new[] ( std::size_t size ) { return Rocket::Test::trackedAllocate( size ); }
+void * operator new ( std::size_t size, const std::nothrow_t & ) noexcept {
+	try { return Rocket::Test::trackedAllocate( size ); } catch ( ... ) { return nullptr; }
+}
+void * operator new[] ( std::size_t size, const std::nothrow_t & ) noexcept {
+	try { return Rocket::Test::trackedAllocate( size ); } catch ( ... ) { return nullptr; }
+}
+void operator delete ( void * p ) noexcept { free( p ); }
+void operator delete[] ( void * p ) noexcept { free( p ); }
+void operator delete ( void * p, const std::nothrow_t & ) noexcept { free( p ); }
+void operator delete[] ( void * p, const std::nothrow_t & ) noexcept { free( p ); }
+#endif
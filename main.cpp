@@ -1,10 +1,12 @@
 
 #include "UnitTest.h"
+#include "Benchmark.h"
 
-int main() {
+int main( int argc, char ** argv ) {
 	Rocket::Test::UnitTests_runAll();
+	int regressions = Rocket::Test::Benchmarks_runAll( argc, argv );
 #ifdef OS_WINDOWS
 	system("pause");
 #endif
-	return 0;
+	return ( regressions > 0 ) ? 1 : 0;
 }